@@ -457,6 +457,7 @@ static const struct ltc_hash_descriptor *get_hash_descriptor( enum alg_id alg_id
 
 #define HASH_FLAG_HMAC      0x01
 #define HASH_FLAG_REUSABLE  0x02
+#define HASH_FLAG_PREPARED  0x04
 struct hash
 {
     struct object     hdr;
@@ -467,6 +468,9 @@ struct hash
     ULONG             secret_len;
     hash_state        outer;
     hash_state        inner;
+    /* keyed hmac states, saved for reusable hashes */
+    hash_state        outer_init;
+    hash_state        inner_init;
 };
 
 #define BLOCK_LENGTH_RC4        1
@@ -956,6 +960,13 @@ static void hash_prepare( struct hash *hash )
     UCHAR buffer[MAX_HASH_BLOCK_BITS / 8] = {0};
     int block_bytes, i;
 
+    if (hash->flags & HASH_FLAG_PREPARED)
+    {
+        hash->inner = hash->inner_init;
+        hash->outer = hash->outer_init;
+        return;
+    }
+
     /* initialize hash */
     hash->desc->init( &hash->inner );
     if (!(hash->flags & HASH_FLAG_HMAC)) return;
@@ -976,6 +987,13 @@ static void hash_prepare( struct hash *hash )
     hash->desc->process( &hash->outer, buffer, block_bytes );
     for (i = 0; i < block_bytes; i++) buffer[i] ^= (0x5c ^ 0x36);
     hash->desc->process( &hash->inner, buffer, block_bytes );
+
+    if (hash->flags & HASH_FLAG_REUSABLE)
+    {
+        hash->inner_init = hash->inner;
+        hash->outer_init = hash->outer;
+        hash->flags |= HASH_FLAG_PREPARED;
+    }
 }
 
 static NTSTATUS hash_create( const struct algorithm *alg, UCHAR *secret, ULONG secret_len, ULONG flags,
@@ -1122,17 +1140,19 @@ NTSTATUS WINAPI BCryptFinishHash( BCRYPT_HASH_HANDLE handle, UCHAR *output, ULON
 static NTSTATUS hash_single( struct algorithm *alg, UCHAR *secret, ULONG secret_len, UCHAR *input, ULONG input_len,
                              UCHAR *output, ULONG output_len )
 {
-    struct hash *hash;
-    NTSTATUS status;
+    struct hash hash = {{ 0 }};
 
-    if ((status = hash_create( alg, secret, secret_len, 0, &hash ))) return status;
-    if (input_len && hash->desc->process( &hash->inner, input, input_len ))
-    {
-        hash_destroy( hash );
-        return STATUS_INVALID_PARAMETER;
-    }
-    hash_finalize( hash, output );
-    hash_destroy( hash );
+    /* one-shot hashing doesn't need a heap object or a copy of the secret */
+    if (!(hash.desc = get_hash_descriptor( alg->id ))) return STATUS_NOT_IMPLEMENTED;
+    hash.hdr.magic  = MAGIC_HASH;
+    hash.alg_id     = alg->id;
+    if (alg->flags & BCRYPT_ALG_HANDLE_HMAC_FLAG) hash.flags = HASH_FLAG_HMAC;
+    hash.secret     = secret;
+    hash.secret_len = secret_len;
+
+    hash_prepare( &hash );
+    if (input_len && hash.desc->process( &hash.inner, input, input_len )) return STATUS_INVALID_PARAMETER;
+    hash_finalize( &hash, output );
     return STATUS_SUCCESS;
 }
 
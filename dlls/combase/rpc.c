@@ -1226,23 +1226,16 @@ static HRESULT WINAPI ClientRpcChannelBuffer_GetBuffer(LPRPCCHANNELBUFFER iface,
                                   &message_state->params.iface);
     if (hr == S_OK)
     {
-        /* stub, chan, iface and iid are unneeded in multi-threaded case as we go
-         * via the RPC runtime */
-        if (apt->multi_threaded)
+        /* the server is in this process, so the call doesn't need to go
+         * through the RPC runtime. multi-threaded apartment calls are executed
+         * directly on a thread pool thread */
+        message_state->params.bypass_rpcrt = TRUE;
+        if (!apt->multi_threaded)
         {
-            IRpcStubBuffer_Release(message_state->params.stub);
-            message_state->params.stub = NULL;
-            IRpcChannelBuffer_Release(message_state->params.chan);
-            message_state->params.chan = NULL;
-            message_state->params.iface = NULL;
-        }
-        else
-        {
-            message_state->params.bypass_rpcrt = TRUE;
             message_state->target_hwnd = apartment_getwindow(apt);
             message_state->target_tid = apt->tid;
-            /* we assume later on that this being non-NULL is the indicator that
-             * means call directly instead of going through RPC runtime */
+            /* calls to single-threaded apartments are posted to the apartment
+             * window */
             if (!message_state->target_hwnd)
                 ERR("window for apartment %s is NULL\n", wine_dbgstr_longlong(apt->oxid));
         }
@@ -1253,7 +1246,7 @@ static HRESULT WINAPI ClientRpcChannelBuffer_GetBuffer(LPRPCCHANNELBUFFER iface,
      * ClientRpcChannelBuffer_SendReceive */
 
     /* shortcut the RPC runtime */
-    if (message_state->target_hwnd)
+    if (message_state->params.bypass_rpcrt)
     {
         msg->Buffer = malloc(msg->BufferLength);
         if (msg->Buffer)
@@ -1344,6 +1337,31 @@ static DWORD WINAPI rpc_sendreceive_thread(LPVOID param)
     return 0;
 }
 
+/* this thread executes an RPC to an in-process multi-threaded apartment */
+static DWORD WINAPI rpc_execute_mta_thread(LPVOID param)
+{
+    struct dispatch_params *data = param;
+    struct tlsdata *tlsdata;
+    BOOL joined = FALSE;
+
+    if (FAILED(data->hr = com_get_tlsdata(&tlsdata)))
+    {
+        SetEvent(data->handle);
+        return 0;
+    }
+
+    if (!tlsdata->apt)
+    {
+        enter_apartment(tlsdata, COINIT_MULTITHREADED);
+        joined = TRUE;
+    }
+    rpc_execute_call(data);
+    if (joined)
+        leave_apartment(tlsdata);
+
+    return 0;
+}
+
 static inline HRESULT ClientRpcChannelBuffer_IsCorrectApartment(ClientRpcChannelBuffer *This, const struct apartment *apt)
 {
     if (!apt)
@@ -1410,7 +1428,21 @@ static HRESULT WINAPI ClientRpcChannelBuffer_SendReceive(LPRPCCHANNELBUFFER ifac
      * from DllMain */
 
     message_state->params.msg = olemsg;
-    if (message_state->params.bypass_rpcrt)
+    if (message_state->params.bypass_rpcrt && !message_state->target_hwnd)
+    {
+        TRACE("Calling multi-threaded apartment directly...\n");
+
+        msg->ProcNum &= ~RPC_FLAGS_VALID_BIT;
+
+        if (!QueueUserWorkItem(rpc_execute_mta_thread, &message_state->params, WT_EXECUTEDEFAULT))
+        {
+            ERR("QueueUserWorkItem failed with error %lu\n", GetLastError());
+            hr = E_UNEXPECTED;
+        }
+        else
+            hr = S_OK;
+    }
+    else if (message_state->params.bypass_rpcrt)
     {
         TRACE("Calling apartment thread %#lx...\n", message_state->target_tid);
 
@@ -5555,7 +5555,6 @@ static BOOL LISTVIEW_DeleteAllItems(LISTVIEW_INFO *infoPtr, BOOL destroy)
     HDPA hdpaSubItems = NULL;
     BOOL suppress = FALSE;
     ITEMHDR *hdrItem;
-    ITEM_INFO *lpItem;
     ITEM_ID *lpID;
     INT i, j;
 
@@ -5586,12 +5585,6 @@ static BOOL LISTVIEW_DeleteAllItems(LISTVIEW_INFO *infoPtr, BOOL destroy)
 	       and if it is not a virtual listview */
 	    if (!suppress) notify_deleteitem(infoPtr, i);
 	    hdpaSubItems = DPA_GetPtr(infoPtr->hdpaItems, i);
-	    lpItem = DPA_GetPtr(hdpaSubItems, 0);
-	    /* free id struct */
-	    j = DPA_GetPtrIndex(infoPtr->hdpaItemIds, lpItem->id);
-	    lpID = DPA_GetPtr(infoPtr->hdpaItemIds, j);
-	    DPA_DeletePtr(infoPtr->hdpaItemIds, j);
-	    Free(lpID);
 	    /* both item and subitem start with ITEMHDR header */
 	    for (j = 0; j < DPA_GetPtrCount(hdpaSubItems); j++)
 	    {
@@ -5606,6 +5599,14 @@ static BOOL LISTVIEW_DeleteAllItems(LISTVIEW_INFO *infoPtr, BOOL destroy)
 	DPA_DeletePtr(infoPtr->hdpaPosY, i);
 	infoPtr->nItemCount --;
     }
+
+    /* free id structs all at once, looking them up for each item is quadratic */
+    for (i = 0; i < DPA_GetPtrCount(infoPtr->hdpaItemIds); i++)
+    {
+        lpID = DPA_GetPtr(infoPtr->hdpaItemIds, i);
+        Free(lpID);
+    }
+    DPA_DeleteAllPtrs(infoPtr->hdpaItemIds);
     
     if (!destroy)
     {
@@ -5885,8 +5886,8 @@ static BOOL LISTVIEW_DeleteItem(LISTVIEW_INFO *infoPtr, INT nItem)
 	hdpaSubItems = DPA_DeletePtr(infoPtr->hdpaItems, nItem);
 	lpItem = DPA_GetPtr(hdpaSubItems, 0);
 
-	/* free id struct */
-	i = DPA_GetPtrIndex(infoPtr->hdpaItemIds, lpItem->id);
+	/* free id struct, the array is sorted by id */
+	i = DPA_Search(infoPtr->hdpaItemIds, lpItem->id, -1, MapIdSearchCompare, 0, DPAS_SORTED);
 	lpID = DPA_GetPtr(infoPtr->hdpaItemIds, i);
 	DPA_DeletePtr(infoPtr->hdpaItemIds, i);
 	Free(lpID);
@@ -9374,12 +9375,14 @@ struct sorting_context
     LPARAM lParam;
 };
 
+/* The sorted array holds item indices, so that LVM_SORTITEMSEX doesn't have to look them up. */
+
 /* DPA_Sort() callback used for LVM_SORTITEMS */
 static INT WINAPI LISTVIEW_CallBackCompare(LPVOID first, LPVOID second, LPARAM lParam)
 {
     struct sorting_context *context = (struct sorting_context *)lParam;
-    ITEM_INFO* lv_first = DPA_GetPtr( first, 0 );
-    ITEM_INFO* lv_second = DPA_GetPtr( second, 0 );
+    ITEM_INFO* lv_first = DPA_GetPtr( DPA_GetPtr( context->items, (INT_PTR)first ), 0 );
+    ITEM_INFO* lv_second = DPA_GetPtr( DPA_GetPtr( context->items, (INT_PTR)second ), 0 );
 
     return context->compare_func(lv_first->lParam, lv_second->lParam, context->lParam);
 }
@@ -9388,10 +9391,8 @@ static INT WINAPI LISTVIEW_CallBackCompare(LPVOID first, LPVOID second, LPARAM l
 static INT WINAPI LISTVIEW_CallBackCompareEx(LPVOID first, LPVOID second, LPARAM lParam)
 {
     struct sorting_context *context = (struct sorting_context *)lParam;
-    INT first_idx  = DPA_GetPtrIndex( context->items, first  );
-    INT second_idx = DPA_GetPtrIndex( context->items, second );
 
-    return context->compare_func(first_idx, second_idx, context->lParam);
+    return context->compare_func((INT_PTR)first, (INT_PTR)second, context->lParam);
 }
 
 /***
@@ -9413,10 +9414,9 @@ static BOOL LISTVIEW_SortItems(LISTVIEW_INFO *infoPtr, PFNLVCOMPARE pfnCompare,
 {
     HDPA hdpaSubItems, hdpaItems;
     ITEM_INFO *lpItem;
-    LPVOID selectionMarkItem = NULL;
-    LPVOID focusedItem = NULL;
+    INT selectionMark = -1, focusedItem = -1;
     struct sorting_context context;
-    int i;
+    int i, index;
 
     TRACE("pfnCompare %p, lParamSort %Ix\n", pfnCompare, lParamSort);
 
@@ -9428,16 +9428,11 @@ static BOOL LISTVIEW_SortItems(LISTVIEW_INFO *infoPtr, PFNLVCOMPARE pfnCompare,
     /* if there are 0 or 1 items, there is no need to sort */
     if (infoPtr->nItemCount < 2) return TRUE;
     if (!(hdpaItems = DPA_Clone(infoPtr->hdpaItems, NULL))) return FALSE;
+    for (i = 0; i < infoPtr->nItemCount; i++) DPA_SetPtr(hdpaItems, i, (void *)(INT_PTR)i);
 
     /* clear selection */
     ranges_clear(infoPtr->selectionRanges);
 
-    /* save selection mark and focused item */
-    if (infoPtr->nSelectionMark >= 0)
-        selectionMarkItem = DPA_GetPtr(infoPtr->hdpaItems, infoPtr->nSelectionMark);
-    if (infoPtr->nFocusedItem >= 0)
-        focusedItem = DPA_GetPtr(infoPtr->hdpaItems, infoPtr->nFocusedItem);
-
     context.items = infoPtr->hdpaItems;
     context.compare_func = pfnCompare;
     context.lParam = lParamSort;
@@ -9445,21 +9440,25 @@ static BOOL LISTVIEW_SortItems(LISTVIEW_INFO *infoPtr, PFNLVCOMPARE pfnCompare,
         DPA_Sort(hdpaItems, LISTVIEW_CallBackCompareEx, (LPARAM)&context);
     else
         DPA_Sort(hdpaItems, LISTVIEW_CallBackCompare, (LPARAM)&context);
-    DPA_Destroy(infoPtr->hdpaItems);
-    infoPtr->hdpaItems = hdpaItems;
 
-    /* restore selection ranges */
+    /* replace the indices by the items, and restore selection ranges,
+     * selection mark and focused item */
     for (i=0; i < infoPtr->nItemCount; i++)
     {
-        hdpaSubItems = DPA_GetPtr(infoPtr->hdpaItems, i);
+        index = (INT_PTR)DPA_GetPtr(hdpaItems, i);
+        hdpaSubItems = DPA_GetPtr(infoPtr->hdpaItems, index);
+        DPA_SetPtr(hdpaItems, i, hdpaSubItems);
         lpItem = DPA_GetPtr(hdpaSubItems, 0);
 
 	if (lpItem->state & LVIS_SELECTED)
 	    ranges_additem(infoPtr->selectionRanges, i);
+        if (index == infoPtr->nSelectionMark) selectionMark = i;
+        if (index == infoPtr->nFocusedItem) focusedItem = i;
     }
-    /* restore selection mark and focused item */
-    infoPtr->nSelectionMark = DPA_GetPtrIndex(infoPtr->hdpaItems, selectionMarkItem);
-    infoPtr->nFocusedItem   = DPA_GetPtrIndex(infoPtr->hdpaItems, focusedItem);
+    DPA_Destroy(infoPtr->hdpaItems);
+    infoPtr->hdpaItems = hdpaItems;
+    infoPtr->nSelectionMark = selectionMark;
+    infoPtr->nFocusedItem   = focusedItem;
 
     /* I believe nHotItem should be left alone, see LISTVIEW_ShiftIndices */
 
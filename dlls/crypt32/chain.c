@@ -487,14 +487,94 @@ static void CRYPT_CheckTrustedStatus(HCERTSTORE hRoot,
         CertFreeCertificateContext(trustedRoot);
 }
 
+/* Cache of successfully verified (subject, issuer) signature pairs.  The
+ * result only depends on the encoded certificates, so the same chains being
+ * validated repeatedly don't need their signatures checked again.
+ */
+#define VERIFIED_SIGNATURE_CACHE_SIZE 64
+
+struct verified_signature
+{
+    BYTE *subject;
+    DWORD subject_size;
+    BYTE *issuer;
+    DWORD issuer_size;
+};
+
+static struct verified_signature verified_signatures[VERIFIED_SIGNATURE_CACHE_SIZE];
+
+static CRITICAL_SECTION verified_signatures_cs;
+static CRITICAL_SECTION_DEBUG verified_signatures_cs_debug =
+{
+    0, 0, &verified_signatures_cs,
+    { &verified_signatures_cs_debug.ProcessLocksList,
+    &verified_signatures_cs_debug.ProcessLocksList },
+    0, 0, { (DWORD_PTR)(__FILE__ ": verified_signatures_cs") }
+};
+static CRITICAL_SECTION verified_signatures_cs = { &verified_signatures_cs_debug, -1, 0, 0, 0, 0 };
+
+static struct verified_signature *CRYPT_GetVerifiedSignatureSlot(
+ PCCERT_CONTEXT subject, PCCERT_CONTEXT issuer)
+{
+    DWORD i, hash = subject->cbCertEncoded ^ issuer->cbCertEncoded;
+
+    /* the end of the encoded subject is its signature, which is well mixed */
+    for (i = 1; i <= 4 && i <= subject->cbCertEncoded; i++)
+        hash = (hash << 8) ^ subject->pbCertEncoded[subject->cbCertEncoded - i];
+    return &verified_signatures[hash % VERIFIED_SIGNATURE_CACHE_SIZE];
+}
+
+static BOOL CRYPT_VerifyCertSignature(DWORD dwCertEncodingType,
+ PCCERT_CONTEXT subject, PCCERT_CONTEXT issuer)
+{
+    struct verified_signature *slot = CRYPT_GetVerifiedSignatureSlot(subject,
+     issuer);
+    BYTE *subject_copy, *issuer_copy;
+    BOOL found;
+
+    EnterCriticalSection(&verified_signatures_cs);
+    found = slot->subject_size == subject->cbCertEncoded &&
+     slot->issuer_size == issuer->cbCertEncoded &&
+     !memcmp(slot->subject, subject->pbCertEncoded, subject->cbCertEncoded) &&
+     !memcmp(slot->issuer, issuer->pbCertEncoded, issuer->cbCertEncoded);
+    LeaveCriticalSection(&verified_signatures_cs);
+    if (found)
+        return TRUE;
+
+    if (!CryptVerifyCertificateSignatureEx(0, dwCertEncodingType,
+     CRYPT_VERIFY_CERT_SIGN_SUBJECT_CERT, (void *)subject,
+     CRYPT_VERIFY_CERT_SIGN_ISSUER_CERT, (void *)issuer, 0, NULL))
+        return FALSE;
+
+    subject_copy = CryptMemAlloc(subject->cbCertEncoded);
+    issuer_copy = CryptMemAlloc(issuer->cbCertEncoded);
+    if (subject_copy && issuer_copy)
+    {
+        memcpy(subject_copy, subject->pbCertEncoded, subject->cbCertEncoded);
+        memcpy(issuer_copy, issuer->pbCertEncoded, issuer->cbCertEncoded);
+        EnterCriticalSection(&verified_signatures_cs);
+        CryptMemFree(slot->subject);
+        CryptMemFree(slot->issuer);
+        slot->subject = subject_copy;
+        slot->subject_size = subject->cbCertEncoded;
+        slot->issuer = issuer_copy;
+        slot->issuer_size = issuer->cbCertEncoded;
+        LeaveCriticalSection(&verified_signatures_cs);
+    }
+    else
+    {
+        CryptMemFree(subject_copy);
+        CryptMemFree(issuer_copy);
+    }
+    return TRUE;
+}
+
 static void CRYPT_CheckRootCert(HCERTSTORE hRoot,
  PCERT_CHAIN_ELEMENT rootElement)
 {
     PCCERT_CONTEXT root = rootElement->pCertContext;
 
-    if (!CryptVerifyCertificateSignatureEx(0, root->dwCertEncodingType,
-     CRYPT_VERIFY_CERT_SIGN_SUBJECT_CERT, (void *)root,
-     CRYPT_VERIFY_CERT_SIGN_ISSUER_CERT, (void *)root, 0, NULL))
+    if (!CRYPT_VerifyCertSignature(root->dwCertEncodingType, root, root))
     {
         TRACE_(chain)("Last certificate's signature is invalid\n");
         rootElement->TrustStatus.dwErrorStatus |=
@@ -1909,11 +1989,9 @@ static void CRYPT_CheckSimpleChain(CertificateChainEngine *engine,
         if (i != 0)
         {
             /* Check the signature of the cert this issued */
-            if (!CryptVerifyCertificateSignatureEx(0, X509_ASN_ENCODING,
-             CRYPT_VERIFY_CERT_SIGN_SUBJECT_CERT,
-             (void *)chain->rgpElement[i - 1]->pCertContext,
-             CRYPT_VERIFY_CERT_SIGN_ISSUER_CERT,
-             (void *)chain->rgpElement[i]->pCertContext, 0, NULL))
+            if (!CRYPT_VerifyCertSignature(X509_ASN_ENCODING,
+             chain->rgpElement[i - 1]->pCertContext,
+             chain->rgpElement[i]->pCertContext))
                 chain->rgpElement[i - 1]->TrustStatus.dwErrorStatus |=
                  CERT_TRUST_IS_NOT_SIGNATURE_VALID;
             /* Once a path length constraint has been violated, every remaining
@@ -691,11 +691,13 @@ HRESULT d2d_bitmap_create_from_wic_bitmap(struct d2d_device_context *context, IW
     const D2D1_PIXEL_FORMAT *d2d_format;
     D2D1_BITMAP_PROPERTIES1 bitmap_desc;
     WICPixelFormatGUID wic_format;
-    unsigned int bpp, data_size;
+    IWICBitmap *wic_bitmap;
+    IWICBitmapLock *lock;
+    unsigned int bpp;
     D2D1_SIZE_U size;
     unsigned int i;
+    UINT32 pitch, data_size;
     WICRect rect;
-    UINT32 pitch;
     HRESULT hr;
     void *data;
 
@@ -770,6 +772,34 @@ HRESULT d2d_bitmap_create_from_wic_bitmap(struct d2d_device_context *context, IW
             return D2DERR_UNSUPPORTED_PIXEL_FORMAT;
     }
 
+    rect.X = 0;
+    rect.Y = 0;
+    rect.Width = size.width;
+    rect.Height = size.height;
+
+    /* Upload directly from the bitmap memory when it's available, instead of
+     * making an intermediate copy. */
+    if (SUCCEEDED(IWICBitmapSource_QueryInterface(bitmap_source, &IID_IWICBitmap, (void **)&wic_bitmap)))
+    {
+        hr = IWICBitmap_Lock(wic_bitmap, &rect, WICBitmapLockRead, &lock);
+        IWICBitmap_Release(wic_bitmap);
+        if (SUCCEEDED(hr))
+        {
+            BYTE *lock_data;
+
+            if (SUCCEEDED(IWICBitmapLock_GetStride(lock, &pitch))
+                    && SUCCEEDED(IWICBitmapLock_GetDataPointer(lock, &data_size, &lock_data))
+                    && pitch / bpp >= size.width && (!size.height
+                    || data_size >= (UINT64)pitch * (size.height - 1) + bpp * size.width))
+            {
+                hr = d2d_bitmap_create(context, size, lock_data, pitch, &bitmap_desc, bitmap);
+                IWICBitmapLock_Release(lock);
+                return hr;
+            }
+            IWICBitmapLock_Release(lock);
+        }
+    }
+
     pitch = ((bpp * size.width) + 15) & ~15;
     if (pitch / bpp < size.width)
         return E_OUTOFMEMORY;
@@ -777,10 +807,6 @@ HRESULT d2d_bitmap_create_from_wic_bitmap(struct d2d_device_context *context, IW
         return E_OUTOFMEMORY;
     data_size = size.height * pitch;
 
-    rect.X = 0;
-    rect.Y = 0;
-    rect.Width = size.width;
-    rect.Height = size.height;
     if (FAILED(hr = IWICBitmapSource_CopyPixels(bitmap_source, &rect, pitch, data_size, data)))
     {
         WARN("Failed to copy bitmap pixels, hr %#lx.\n", hr);
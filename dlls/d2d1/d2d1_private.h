@@ -201,6 +201,10 @@ struct d2d_device_context
     ID3D11Buffer *vs_cb;
     ID3D11PixelShader *ps;
     ID3D11Buffer *ps_cb;
+    /* Last data written to vs_cb and ps_cb. */
+    struct d2d_vs_cb vs_cb_data;
+    struct d2d_ps_cb ps_cb_data;
+    BOOL vs_cb_valid, ps_cb_valid;
     ID3D11Buffer *ib;
     unsigned int vb_stride;
     ID3D11Buffer *vb;
@@ -221,6 +225,10 @@ struct d2d_device_context
     struct d2d_clip_stack clip_stack;
 
     struct d2d_indexed_objects vertex_buffers;
+
+    struct list glyph_run_bitmaps;
+    unsigned int glyph_run_bitmap_count;
+    size_t glyph_run_bitmaps_size;
 };
 
 HRESULT d2d_d3d_create_render_target(struct d2d_device *device, IDXGISurface *surface, IUnknown *outer_unknown,
@@ -519,6 +527,21 @@ struct d2d_geometry_ops
             ID2D1GeometrySink *sink);
 };
 
+enum d2d_geometry_buffer
+{
+    D2D_GEOMETRY_BUFFER_FILL_FACES,
+    D2D_GEOMETRY_BUFFER_FILL_VERTICES,
+    D2D_GEOMETRY_BUFFER_FILL_BEZIER_VERTICES,
+    D2D_GEOMETRY_BUFFER_FILL_ARC_VERTICES,
+    D2D_GEOMETRY_BUFFER_OUTLINE_FACES,
+    D2D_GEOMETRY_BUFFER_OUTLINE_VERTICES,
+    D2D_GEOMETRY_BUFFER_OUTLINE_BEZIER_FACES,
+    D2D_GEOMETRY_BUFFER_OUTLINE_BEZIERS,
+    D2D_GEOMETRY_BUFFER_OUTLINE_ARC_FACES,
+    D2D_GEOMETRY_BUFFER_OUTLINE_ARCS,
+    D2D_GEOMETRY_BUFFER_COUNT,
+};
+
 struct d2d_geometry
 {
     ID2D1Geometry ID2D1Geometry_iface;
@@ -575,6 +598,14 @@ struct d2d_geometry
         size_t arc_face_count;
     } outline;
 
+    /* Index and vertex buffers created from the arrays above. Only set on
+     * the geometry owning the arrays, see d2d_geometry_get_buffer_owner(). */
+    struct
+    {
+        ID3D11Device1 *device;
+        ID3D11Buffer *buffers[D2D_GEOMETRY_BUFFER_COUNT];
+    } d3d;
+
     union
     {
         struct
@@ -632,6 +663,7 @@ void d2d_transformed_geometry_init(struct d2d_geometry *geometry, ID2D1Factory *
 HRESULT d2d_geometry_group_init(struct d2d_geometry *geometry, ID2D1Factory *factory,
         D2D1_FILL_MODE fill_mode, ID2D1Geometry **src_geometries, unsigned int geometry_count);
 struct d2d_geometry *unsafe_impl_from_ID2D1Geometry(ID2D1Geometry *iface);
+struct d2d_geometry *d2d_geometry_get_buffer_owner(const struct d2d_geometry *geometry);
 
 struct d2d_geometry_realization
 {
@@ -259,6 +259,42 @@ static ULONG STDMETHODCALLTYPE d2d_device_context_inner_AddRef(IUnknown *iface)
     return refcount;
 }
 
+/* Rasterized glyph runs, kept so that text drawn at the same position every
+ * frame doesn't go through IDWriteGlyphRunAnalysis each time. */
+#define D2D_GLYPH_RUN_BITMAP_MAX_COUNT 128
+#define D2D_GLYPH_RUN_BITMAP_MAX_SIZE (4 * 1024 * 1024)
+
+struct d2d_glyph_run_bitmap
+{
+    struct list entry;
+
+    IDWriteFontFace *font_face;
+    float font_size;
+    UINT32 glyph_count;
+    DWRITE_GLYPH_OFFSET *offsets;
+    float *advances;
+    UINT16 *indices;
+    BOOL is_sideways;
+    UINT32 bidi_level;
+    D2D1_POINT_2F baseline_origin;
+    D2D1_MATRIX_3X2_F transform;
+    float dpi_x, dpi_y;
+    DWRITE_RENDERING_MODE rendering_mode;
+    DWRITE_MEASURING_MODE measuring_mode;
+    DWRITE_TEXT_ANTIALIAS_MODE antialias_mode;
+
+    ID2D1Bitmap *bitmap;
+    RECT bounds;
+    size_t size;
+};
+
+static void d2d_glyph_run_bitmap_destroy(struct d2d_glyph_run_bitmap *entry)
+{
+    ID2D1Bitmap_Release(entry->bitmap);
+    IDWriteFontFace_Release(entry->font_face);
+    free(entry);
+}
+
 static ULONG STDMETHODCALLTYPE d2d_device_context_inner_Release(IUnknown *iface)
 {
     struct d2d_device_context *context = impl_from_IUnknown(iface);
@@ -268,8 +304,14 @@ static ULONG STDMETHODCALLTYPE d2d_device_context_inner_Release(IUnknown *iface)
 
     if (!refcount)
     {
+        struct d2d_glyph_run_bitmap *glyph_run_bitmap, *next;
         unsigned int i, j, k;
 
+        LIST_FOR_EACH_ENTRY_SAFE(glyph_run_bitmap, next, &context->glyph_run_bitmaps,
+                struct d2d_glyph_run_bitmap, entry)
+        {
+            d2d_glyph_run_bitmap_destroy(glyph_run_bitmap);
+        }
         d2d_clip_stack_cleanup(&context->clip_stack);
         IDWriteRenderingParams_Release(context->default_text_rendering_params);
         if (context->text_rendering_params)
@@ -772,9 +814,20 @@ static HRESULT d2d_device_context_update_ps_cb(struct d2d_device_context *contex
 {
     D3D11_MAPPED_SUBRESOURCE map_desc;
     ID3D11DeviceContext *d3d_context;
-    struct d2d_ps_cb *cb_data;
+    struct d2d_ps_cb cb_data;
     HRESULT hr;
 
+    memset(&cb_data, 0, sizeof(cb_data));
+    cb_data.outline = outline;
+    cb_data.is_arc = is_arc;
+    if (!d2d_brush_fill_cb(brush, &cb_data.colour_brush))
+        WARN("Failed to initialize colour brush buffer.\n");
+    if (!d2d_brush_fill_cb(opacity_brush, &cb_data.opacity_brush))
+        WARN("Failed to initialize opacity brush buffer.\n");
+
+    if (context->ps_cb_valid && !memcmp(&cb_data, &context->ps_cb_data, sizeof(cb_data)))
+        return S_OK;
+
     ID3D11Device1_GetImmediateContext(context->d3d_device, &d3d_context);
 
     if (FAILED(hr = ID3D11DeviceContext_Map(d3d_context, (ID3D11Resource *)context->ps_cb,
@@ -785,19 +838,14 @@ static HRESULT d2d_device_context_update_ps_cb(struct d2d_device_context *contex
         return hr;
     }
 
-    cb_data = map_desc.pData;
-    cb_data->outline = outline;
-    cb_data->is_arc = is_arc;
-    cb_data->pad[0] = 0;
-    cb_data->pad[1] = 0;
-    if (!d2d_brush_fill_cb(brush, &cb_data->colour_brush))
-        WARN("Failed to initialize colour brush buffer.\n");
-    if (!d2d_brush_fill_cb(opacity_brush, &cb_data->opacity_brush))
-        WARN("Failed to initialize opacity brush buffer.\n");
+    memcpy(map_desc.pData, &cb_data, sizeof(cb_data));
 
     ID3D11DeviceContext_Unmap(d3d_context, (ID3D11Resource *)context->ps_cb, 0);
     ID3D11DeviceContext_Release(d3d_context);
 
+    context->ps_cb_data = cb_data;
+    context->ps_cb_valid = TRUE;
+
     return hr;
 }
 
@@ -807,10 +855,36 @@ static HRESULT d2d_device_context_update_vs_cb(struct d2d_device_context *contex
     D3D11_MAPPED_SUBRESOURCE map_desc;
     ID3D11DeviceContext *d3d_context;
     const D2D1_MATRIX_3X2_F *w;
-    struct d2d_vs_cb *cb_data;
+    struct d2d_vs_cb cb_data;
     float tmp_x, tmp_y;
     HRESULT hr;
 
+    cb_data.transform_geometry._11 = geometry_transform->_11;
+    cb_data.transform_geometry._21 = geometry_transform->_21;
+    cb_data.transform_geometry._31 = geometry_transform->_31;
+    cb_data.transform_geometry.pad0 = 0.0f;
+    cb_data.transform_geometry._12 = geometry_transform->_12;
+    cb_data.transform_geometry._22 = geometry_transform->_22;
+    cb_data.transform_geometry._32 = geometry_transform->_32;
+    cb_data.transform_geometry.stroke_width = stroke_width;
+
+    w = &context->drawing_state.transform;
+
+    tmp_x = context->desc.dpiX / 96.0f;
+    cb_data.transform_rtx.x = w->_11 * tmp_x;
+    cb_data.transform_rtx.y = w->_21 * tmp_x;
+    cb_data.transform_rtx.z = w->_31 * tmp_x;
+    cb_data.transform_rtx.w = 2.0f / context->pixel_size.width;
+
+    tmp_y = context->desc.dpiY / 96.0f;
+    cb_data.transform_rty.x = w->_12 * tmp_y;
+    cb_data.transform_rty.y = w->_22 * tmp_y;
+    cb_data.transform_rty.z = w->_32 * tmp_y;
+    cb_data.transform_rty.w = -2.0f / context->pixel_size.height;
+
+    if (context->vs_cb_valid && !memcmp(&cb_data, &context->vs_cb_data, sizeof(cb_data)))
+        return S_OK;
+
     ID3D11Device1_GetImmediateContext(context->d3d_device, &d3d_context);
 
     if (FAILED(hr = ID3D11DeviceContext_Map(d3d_context, (ID3D11Resource *)context->vs_cb,
@@ -821,36 +895,52 @@ static HRESULT d2d_device_context_update_vs_cb(struct d2d_device_context *contex
         return hr;
     }
 
-    cb_data = map_desc.pData;
-    cb_data->transform_geometry._11 = geometry_transform->_11;
-    cb_data->transform_geometry._21 = geometry_transform->_21;
-    cb_data->transform_geometry._31 = geometry_transform->_31;
-    cb_data->transform_geometry.pad0 = 0.0f;
-    cb_data->transform_geometry._12 = geometry_transform->_12;
-    cb_data->transform_geometry._22 = geometry_transform->_22;
-    cb_data->transform_geometry._32 = geometry_transform->_32;
-    cb_data->transform_geometry.stroke_width = stroke_width;
-
-    w = &context->drawing_state.transform;
-
-    tmp_x = context->desc.dpiX / 96.0f;
-    cb_data->transform_rtx.x = w->_11 * tmp_x;
-    cb_data->transform_rtx.y = w->_21 * tmp_x;
-    cb_data->transform_rtx.z = w->_31 * tmp_x;
-    cb_data->transform_rtx.w = 2.0f / context->pixel_size.width;
-
-    tmp_y = context->desc.dpiY / 96.0f;
-    cb_data->transform_rty.x = w->_12 * tmp_y;
-    cb_data->transform_rty.y = w->_22 * tmp_y;
-    cb_data->transform_rty.z = w->_32 * tmp_y;
-    cb_data->transform_rty.w = -2.0f / context->pixel_size.height;
+    memcpy(map_desc.pData, &cb_data, sizeof(cb_data));
 
     ID3D11DeviceContext_Unmap(d3d_context, (ID3D11Resource *)context->vs_cb, 0);
     ID3D11DeviceContext_Release(d3d_context);
 
+    context->vs_cb_data = cb_data;
+    context->vs_cb_valid = TRUE;
+
     return S_OK;
 }
 
+static HRESULT d2d_device_context_get_geometry_buffer(struct d2d_device_context *render_target,
+        const struct d2d_geometry *geometry, enum d2d_geometry_buffer idx, const D3D11_BUFFER_DESC *desc,
+        const D3D11_SUBRESOURCE_DATA *data, ID3D11Buffer **buffer)
+{
+    struct d2d_geometry *owner = d2d_geometry_get_buffer_owner(geometry);
+    unsigned int i;
+    HRESULT hr = S_OK;
+
+    if (render_target->cs)
+        EnterCriticalSection(render_target->cs);
+
+    if (owner->d3d.device != render_target->d3d_device)
+    {
+        for (i = 0; i < ARRAY_SIZE(owner->d3d.buffers); ++i)
+        {
+            if (owner->d3d.buffers[i])
+                ID3D11Buffer_Release(owner->d3d.buffers[i]);
+            owner->d3d.buffers[i] = NULL;
+        }
+        if (owner->d3d.device)
+            ID3D11Device1_Release(owner->d3d.device);
+        ID3D11Device1_AddRef(owner->d3d.device = render_target->d3d_device);
+    }
+
+    if (!owner->d3d.buffers[idx])
+        hr = ID3D11Device1_CreateBuffer(render_target->d3d_device, desc, data, &owner->d3d.buffers[idx]);
+    if (SUCCEEDED(hr))
+        ID3D11Buffer_AddRef(*buffer = owner->d3d.buffers[idx]);
+
+    if (render_target->cs)
+        LeaveCriticalSection(render_target->cs);
+
+    return hr;
+}
+
 static void d2d_device_context_draw_geometry(struct d2d_device_context *render_target,
         const struct d2d_geometry *geometry, struct d2d_brush *brush, float stroke_width)
 {
@@ -884,7 +974,8 @@ static void d2d_device_context_draw_geometry(struct d2d_device_context *render_t
         buffer_desc.BindFlags = D3D11_BIND_INDEX_BUFFER;
         buffer_data.pSysMem = geometry->outline.faces;
 
-        if (FAILED(hr = ID3D11Device1_CreateBuffer(render_target->d3d_device, &buffer_desc, &buffer_data, &ib)))
+        if (FAILED(hr = d2d_device_context_get_geometry_buffer(render_target, geometry,
+                D2D_GEOMETRY_BUFFER_OUTLINE_FACES, &buffer_desc, &buffer_data, &ib)))
         {
             WARN("Failed to create index buffer, hr %#lx.\n", hr);
             return;
@@ -894,7 +985,8 @@ static void d2d_device_context_draw_geometry(struct d2d_device_context *render_t
         buffer_desc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
         buffer_data.pSysMem = geometry->outline.vertices;
 
-        if (FAILED(hr = ID3D11Device1_CreateBuffer(render_target->d3d_device, &buffer_desc, &buffer_data, &vb)))
+        if (FAILED(hr = d2d_device_context_get_geometry_buffer(render_target, geometry,
+                D2D_GEOMETRY_BUFFER_OUTLINE_VERTICES, &buffer_desc, &buffer_data, &vb)))
         {
             ERR("Failed to create vertex buffer, hr %#lx.\n", hr);
             ID3D11Buffer_Release(ib);
@@ -914,7 +1006,8 @@ static void d2d_device_context_draw_geometry(struct d2d_device_context *render_t
         buffer_desc.BindFlags = D3D11_BIND_INDEX_BUFFER;
         buffer_data.pSysMem = geometry->outline.bezier_faces;
 
-        if (FAILED(hr = ID3D11Device1_CreateBuffer(render_target->d3d_device, &buffer_desc, &buffer_data, &ib)))
+        if (FAILED(hr = d2d_device_context_get_geometry_buffer(render_target, geometry,
+                D2D_GEOMETRY_BUFFER_OUTLINE_BEZIER_FACES, &buffer_desc, &buffer_data, &ib)))
         {
             WARN("Failed to create curves index buffer, hr %#lx.\n", hr);
             return;
@@ -924,7 +1017,8 @@ static void d2d_device_context_draw_geometry(struct d2d_device_context *render_t
         buffer_desc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
         buffer_data.pSysMem = geometry->outline.beziers;
 
-        if (FAILED(hr = ID3D11Device1_CreateBuffer(render_target->d3d_device, &buffer_desc, &buffer_data, &vb)))
+        if (FAILED(hr = d2d_device_context_get_geometry_buffer(render_target, geometry,
+                D2D_GEOMETRY_BUFFER_OUTLINE_BEZIERS, &buffer_desc, &buffer_data, &vb)))
         {
             ERR("Failed to create curves vertex buffer, hr %#lx.\n", hr);
             ID3D11Buffer_Release(ib);
@@ -945,7 +1039,8 @@ static void d2d_device_context_draw_geometry(struct d2d_device_context *render_t
         buffer_desc.BindFlags = D3D11_BIND_INDEX_BUFFER;
         buffer_data.pSysMem = geometry->outline.arc_faces;
 
-        if (FAILED(hr = ID3D11Device1_CreateBuffer(render_target->d3d_device, &buffer_desc, &buffer_data, &ib)))
+        if (FAILED(hr = d2d_device_context_get_geometry_buffer(render_target, geometry,
+                D2D_GEOMETRY_BUFFER_OUTLINE_ARC_FACES, &buffer_desc, &buffer_data, &ib)))
         {
             WARN("Failed to create arcs index buffer, hr %#lx.\n", hr);
             return;
@@ -955,7 +1050,8 @@ static void d2d_device_context_draw_geometry(struct d2d_device_context *render_t
         buffer_desc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
         buffer_data.pSysMem = geometry->outline.arcs;
 
-        if (FAILED(hr = ID3D11Device1_CreateBuffer(render_target->d3d_device, &buffer_desc, &buffer_data, &vb)))
+        if (FAILED(hr = d2d_device_context_get_geometry_buffer(render_target, geometry,
+                D2D_GEOMETRY_BUFFER_OUTLINE_ARCS, &buffer_desc, &buffer_data, &vb)))
         {
             ERR("Failed to create arcs vertex buffer, hr %#lx.\n", hr);
             ID3D11Buffer_Release(ib);
@@ -1044,7 +1140,8 @@ static void d2d_device_context_fill_geometry(struct d2d_device_context *render_t
         buffer_desc.BindFlags = D3D11_BIND_INDEX_BUFFER;
         buffer_data.pSysMem = geometry->fill.faces;
 
-        if (FAILED(hr = ID3D11Device1_CreateBuffer(render_target->d3d_device, &buffer_desc, &buffer_data, &ib)))
+        if (FAILED(hr = d2d_device_context_get_geometry_buffer(render_target, geometry,
+                D2D_GEOMETRY_BUFFER_FILL_FACES, &buffer_desc, &buffer_data, &ib)))
         {
             WARN("Failed to create index buffer, hr %#lx.\n", hr);
             return;
@@ -1054,7 +1151,8 @@ static void d2d_device_context_fill_geometry(struct d2d_device_context *render_t
         buffer_desc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
         buffer_data.pSysMem = geometry->fill.vertices;
 
-        if (FAILED(hr = ID3D11Device1_CreateBuffer(render_target->d3d_device, &buffer_desc, &buffer_data, &vb)))
+        if (FAILED(hr = d2d_device_context_get_geometry_buffer(render_target, geometry,
+                D2D_GEOMETRY_BUFFER_FILL_VERTICES, &buffer_desc, &buffer_data, &vb)))
         {
             ERR("Failed to create vertex buffer, hr %#lx.\n", hr);
             ID3D11Buffer_Release(ib);
@@ -1074,7 +1172,8 @@ static void d2d_device_context_fill_geometry(struct d2d_device_context *render_t
         buffer_desc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
         buffer_data.pSysMem = geometry->fill.bezier_vertices;
 
-        if (FAILED(hr = ID3D11Device1_CreateBuffer(render_target->d3d_device, &buffer_desc, &buffer_data, &vb)))
+        if (FAILED(hr = d2d_device_context_get_geometry_buffer(render_target, geometry,
+                D2D_GEOMETRY_BUFFER_FILL_BEZIER_VERTICES, &buffer_desc, &buffer_data, &vb)))
         {
             ERR("Failed to create curves vertex buffer, hr %#lx.\n", hr);
             return;
@@ -1092,7 +1191,8 @@ static void d2d_device_context_fill_geometry(struct d2d_device_context *render_t
         buffer_desc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
         buffer_data.pSysMem = geometry->fill.arc_vertices;
 
-        if (FAILED(hr = ID3D11Device1_CreateBuffer(render_target->d3d_device, &buffer_desc, &buffer_data, &vb)))
+        if (FAILED(hr = d2d_device_context_get_geometry_buffer(render_target, geometry,
+                D2D_GEOMETRY_BUFFER_FILL_ARC_VERTICES, &buffer_desc, &buffer_data, &vb)))
         {
             ERR("Failed to create arc vertex buffer, hr %#lx.\n", hr);
             return;
@@ -1472,16 +1572,124 @@ static HRESULT d2d_device_context_get_glyph_run_analysis(struct d2d_device_conte
     return S_OK;
 }
 
+static BOOL d2d_glyph_run_bitmap_matches(const struct d2d_glyph_run_bitmap *entry,
+        const struct d2d_device_context *context, D2D1_POINT_2F baseline_origin,
+        const DWRITE_GLYPH_RUN *glyph_run, DWRITE_RENDERING_MODE rendering_mode,
+        DWRITE_MEASURING_MODE measuring_mode, DWRITE_TEXT_ANTIALIAS_MODE antialias_mode)
+{
+    UINT32 count = glyph_run->glyphCount;
+
+    if (entry->font_face != glyph_run->fontFace || entry->font_size != glyph_run->fontEmSize
+            || entry->glyph_count != count || entry->is_sideways != glyph_run->isSideways
+            || entry->bidi_level != glyph_run->bidiLevel
+            || entry->rendering_mode != rendering_mode || entry->measuring_mode != measuring_mode
+            || entry->antialias_mode != antialias_mode
+            || entry->dpi_x != context->desc.dpiX || entry->dpi_y != context->desc.dpiY)
+        return FALSE;
+    if (memcmp(&entry->baseline_origin, &baseline_origin, sizeof(baseline_origin))
+            || memcmp(&entry->transform, &context->drawing_state.transform, sizeof(entry->transform)))
+        return FALSE;
+    if (!entry->advances != !glyph_run->glyphAdvances || !entry->offsets != !glyph_run->glyphOffsets)
+        return FALSE;
+    if (memcmp(entry->indices, glyph_run->glyphIndices, count * sizeof(*entry->indices)))
+        return FALSE;
+    if (entry->advances && memcmp(entry->advances, glyph_run->glyphAdvances, count * sizeof(*entry->advances)))
+        return FALSE;
+    if (entry->offsets && memcmp(entry->offsets, glyph_run->glyphOffsets, count * sizeof(*entry->offsets)))
+        return FALSE;
+    return TRUE;
+}
+
+static struct d2d_glyph_run_bitmap *d2d_device_context_find_glyph_run_bitmap(struct d2d_device_context *context,
+        D2D1_POINT_2F baseline_origin, const DWRITE_GLYPH_RUN *glyph_run, DWRITE_RENDERING_MODE rendering_mode,
+        DWRITE_MEASURING_MODE measuring_mode, DWRITE_TEXT_ANTIALIAS_MODE antialias_mode)
+{
+    struct d2d_glyph_run_bitmap *entry;
+
+    LIST_FOR_EACH_ENTRY(entry, &context->glyph_run_bitmaps, struct d2d_glyph_run_bitmap, entry)
+    {
+        if (!d2d_glyph_run_bitmap_matches(entry, context, baseline_origin, glyph_run,
+                rendering_mode, measuring_mode, antialias_mode))
+            continue;
+        list_remove(&entry->entry);
+        list_add_head(&context->glyph_run_bitmaps, &entry->entry);
+        return entry;
+    }
+
+    return NULL;
+}
+
+static void d2d_device_context_add_glyph_run_bitmap(struct d2d_device_context *context,
+        D2D1_POINT_2F baseline_origin, const DWRITE_GLYPH_RUN *glyph_run, DWRITE_RENDERING_MODE rendering_mode,
+        DWRITE_MEASURING_MODE measuring_mode, DWRITE_TEXT_ANTIALIAS_MODE antialias_mode,
+        ID2D1Bitmap *bitmap, const RECT *bounds, size_t size)
+{
+    UINT32 count = glyph_run->glyphCount;
+    struct d2d_glyph_run_bitmap *entry;
+    struct list *tail;
+
+    if (size > D2D_GLYPH_RUN_BITMAP_MAX_SIZE / 16)
+        return;
+
+    while (context->glyph_run_bitmap_count >= D2D_GLYPH_RUN_BITMAP_MAX_COUNT
+            || context->glyph_run_bitmaps_size + size > D2D_GLYPH_RUN_BITMAP_MAX_SIZE)
+    {
+        tail = list_tail(&context->glyph_run_bitmaps);
+        entry = LIST_ENTRY(tail, struct d2d_glyph_run_bitmap, entry);
+        list_remove(&entry->entry);
+        --context->glyph_run_bitmap_count;
+        context->glyph_run_bitmaps_size -= entry->size;
+        d2d_glyph_run_bitmap_destroy(entry);
+    }
+
+    if (!(entry = calloc(1, sizeof(*entry) + count * (sizeof(*entry->offsets)
+            + sizeof(*entry->advances) + sizeof(*entry->indices)))))
+        return;
+
+    IDWriteFontFace_AddRef(entry->font_face = glyph_run->fontFace);
+    entry->font_size = glyph_run->fontEmSize;
+    entry->glyph_count = count;
+    entry->offsets = (DWRITE_GLYPH_OFFSET *)(entry + 1);
+    entry->advances = (float *)(entry->offsets + count);
+    entry->indices = (UINT16 *)(entry->advances + count);
+    memcpy(entry->indices, glyph_run->glyphIndices, count * sizeof(*entry->indices));
+    if (glyph_run->glyphAdvances)
+        memcpy(entry->advances, glyph_run->glyphAdvances, count * sizeof(*entry->advances));
+    else
+        entry->advances = NULL;
+    if (glyph_run->glyphOffsets)
+        memcpy(entry->offsets, glyph_run->glyphOffsets, count * sizeof(*entry->offsets));
+    else
+        entry->offsets = NULL;
+    entry->is_sideways = glyph_run->isSideways;
+    entry->bidi_level = glyph_run->bidiLevel;
+    entry->baseline_origin = baseline_origin;
+    entry->transform = context->drawing_state.transform;
+    entry->dpi_x = context->desc.dpiX;
+    entry->dpi_y = context->desc.dpiY;
+    entry->rendering_mode = rendering_mode;
+    entry->measuring_mode = measuring_mode;
+    entry->antialias_mode = antialias_mode;
+    ID2D1Bitmap_AddRef(entry->bitmap = bitmap);
+    entry->bounds = *bounds;
+    entry->size = size;
+
+    list_add_head(&context->glyph_run_bitmaps, &entry->entry);
+    ++context->glyph_run_bitmap_count;
+    context->glyph_run_bitmaps_size += size;
+}
+
 static void d2d_device_context_draw_glyph_run_bitmap(struct d2d_device_context *context,
         D2D1_POINT_2F baseline_origin, const DWRITE_GLYPH_RUN *glyph_run, ID2D1Brush *brush,
         DWRITE_RENDERING_MODE rendering_mode, DWRITE_MEASURING_MODE measuring_mode,
         DWRITE_TEXT_ANTIALIAS_MODE antialias_mode)
 {
+    IDWriteGlyphRunAnalysis *analysis = NULL;
     ID2D1RectangleGeometry *geometry = NULL;
     ID2D1BitmapBrush *opacity_brush = NULL;
+    struct d2d_glyph_run_bitmap *cached;
     D2D1_BITMAP_PROPERTIES bitmap_desc;
     ID2D1Bitmap *opacity_bitmap = NULL;
-    IDWriteGlyphRunAnalysis *analysis;
     DWRITE_TEXTURE_TYPE texture_type;
     D2D1_BRUSH_PROPERTIES brush_desc;
     D2D1_MATRIX_3X2_F *transform, m;
@@ -1493,6 +1701,14 @@ static void d2d_device_context_draw_glyph_run_bitmap(struct d2d_device_context *
     RECT bounds;
     HRESULT hr;
 
+    if ((cached = d2d_device_context_find_glyph_run_bitmap(context, baseline_origin, glyph_run,
+            rendering_mode, measuring_mode, antialias_mode)))
+    {
+        ID2D1Bitmap_AddRef(opacity_bitmap = cached->bitmap);
+        bounds = cached->bounds;
+        goto draw;
+    }
+
     hr = d2d_device_context_get_glyph_run_analysis(context, baseline_origin, glyph_run,
             rendering_mode, measuring_mode, antialias_mode, &texture_type, &analysis);
     if (FAILED(hr))
@@ -1543,6 +1759,10 @@ static void d2d_device_context_draw_glyph_run_bitmap(struct d2d_device_context *
         goto done;
     }
 
+    d2d_device_context_add_glyph_run_bitmap(context, baseline_origin, glyph_run, rendering_mode,
+            measuring_mode, antialias_mode, opacity_bitmap, &bounds, opacity_values_size);
+
+draw:
     scale_x = context->desc.dpiX / 96.0f;
     scale_y = context->desc.dpiY / 96.0f;
     d2d_rect_set(&run_rect, bounds.left / scale_x, bounds.top / scale_y,
@@ -1583,7 +1803,8 @@ done:
     if (opacity_bitmap)
         ID2D1Bitmap_Release(opacity_bitmap);
     free(opacity_values);
-    IDWriteGlyphRunAnalysis_Release(analysis);
+    if (analysis)
+        IDWriteGlyphRunAnalysis_Release(analysis);
 }
 
 static HRESULT d2d_device_context_get_text_rendering_mode(struct d2d_device_context *context,
@@ -1991,6 +2212,9 @@ static void STDMETHODCALLTYPE d2d_device_context_Clear(ID2D1DeviceContext6 *ifac
         return;
     }
 
+    context->vs_cb_valid = FALSE;
+    context->ps_cb_valid = FALSE;
+
     ID3D11Device1_GetImmediateContext(context->d3d_device, &d3d_context);
 
     if (FAILED(hr = ID3D11DeviceContext_Map(d3d_context, (ID3D11Resource *)context->vs_cb,
@@ -4225,6 +4449,7 @@ static HRESULT d2d_device_context_init(struct d2d_device_context *render_target,
     render_target->IDWriteTextRenderer_iface.lpVtbl = &d2d_text_renderer_vtbl;
     render_target->IUnknown_iface.lpVtbl = &d2d_device_context_inner_unknown_vtbl;
     render_target->refcount = 1;
+    list_init(&render_target->glyph_run_bitmaps);
     ID2D1Device1_GetFactory((ID2D1Device1 *)&device->ID2D1Device6_iface, &render_target->factory);
     render_target->device = device;
     ID2D1Device6_AddRef(&render_target->device->ID2D1Device6_iface);
@@ -2718,82 +2718,118 @@ static BOOL d2d_geometry_apply_intersections(struct d2d_geometry *geometry,
     return TRUE;
 }
 
-/* Intersect the geometry's segments with themselves. This uses the
- * straightforward approach of testing everything against everything, but
- * there certainly exist more scalable algorithms for this. */
+struct d2d_segment_bounds
+{
+    struct d2d_segment_idx idx;
+    BOOL bezier;
+    D2D1_RECT_F bounds;
+};
+
+static int d2d_segment_bounds_compare(const void *a, const void *b)
+{
+    const struct d2d_segment_bounds *s0 = a, *s1 = b;
+
+    if (s0->bounds.left != s1->bounds.left)
+        return s0->bounds.left > s1->bounds.left ? 1 : -1;
+    return 0;
+}
+
+static BOOL d2d_segment_idx_is_before(const struct d2d_segment_idx *i0, const struct d2d_segment_idx *i1)
+{
+    if (i0->figure_idx != i1->figure_idx)
+        return i0->figure_idx < i1->figure_idx;
+    return i0->vertex_idx < i1->vertex_idx;
+}
+
+static BOOL d2d_geometry_intersect_segments(struct d2d_geometry *geometry,
+        struct d2d_geometry_intersections *intersections, const struct d2d_segment_bounds *p,
+        const struct d2d_segment_bounds *q)
+{
+    const struct d2d_segment_bounds *tmp;
+
+    /* Keep the argument order of the pairwise tests stable. */
+    if (d2d_segment_idx_is_before(&p->idx, &q->idx))
+    {
+        tmp = p;
+        p = q;
+        q = tmp;
+    }
+
+    if (q->bezier)
+    {
+        if (p->bezier)
+            return d2d_geometry_intersect_bezier_bezier(geometry, intersections,
+                    &p->idx, 0.0f, 1.0f, &q->idx, 0.0f, 1.0f);
+        return d2d_geometry_intersect_bezier_line(geometry, intersections, &q->idx, &p->idx);
+    }
+    if (p->bezier)
+        return d2d_geometry_intersect_bezier_line(geometry, intersections, &p->idx, &q->idx);
+    return d2d_geometry_intersect_line_line(geometry, intersections, &p->idx, &q->idx);
+}
+
+/* Intersect the geometry's segments with themselves. The segments are sorted
+ * by the left edge of their bounding boxes, and each segment is only tested
+ * against the segments whose bounding boxes overlap its own. */
 static BOOL d2d_geometry_intersect_self(struct d2d_geometry *geometry)
 {
     struct d2d_geometry_intersections intersections = {0};
-    const struct d2d_figure *figure_p, *figure_q;
-    struct d2d_segment_idx idx_p, idx_q;
-    enum d2d_vertex_type type_p, type_q;
+    struct d2d_segment_bounds *segments, *segment;
+    size_t segment_count, i, j, next;
+    const struct d2d_figure *figure;
+    struct d2d_segment_idx idx;
     BOOL ret = FALSE;
-    size_t max_q;
 
     if (!geometry->u.path.figure_count)
         return TRUE;
 
-    for (idx_p.figure_idx = 0; idx_p.figure_idx < geometry->u.path.figure_count; ++idx_p.figure_idx)
+    for (i = 0, segment_count = 0; i < geometry->u.path.figure_count; ++i)
+        segment_count += geometry->u.path.figures[i].vertex_count;
+    if (!segment_count)
+        return TRUE;
+    if (!(segments = malloc(segment_count * sizeof(*segments))))
     {
-        figure_p = &geometry->u.path.figures[idx_p.figure_idx];
-        idx_p.control_idx = 0;
-        for (idx_p.vertex_idx = 0; idx_p.vertex_idx < figure_p->vertex_count; ++idx_p.vertex_idx)
+        ERR("Failed to allocate segments array.\n");
+        return FALSE;
+    }
+
+    for (idx.figure_idx = 0, segment_count = 0; idx.figure_idx < geometry->u.path.figure_count; ++idx.figure_idx)
+    {
+        figure = &geometry->u.path.figures[idx.figure_idx];
+        idx.control_idx = 0;
+        for (idx.vertex_idx = 0; idx.vertex_idx < figure->vertex_count; ++idx.vertex_idx)
         {
-            if ((type_p = figure_p->vertex_types[idx_p.vertex_idx]) == D2D_VERTEX_TYPE_END)
+            if (figure->vertex_types[idx.vertex_idx] == D2D_VERTEX_TYPE_END)
                 continue;
 
-            for (idx_q.figure_idx = 0; idx_q.figure_idx <= idx_p.figure_idx; ++idx_q.figure_idx)
-            {
-                figure_q = &geometry->u.path.figures[idx_q.figure_idx];
-                if (idx_q.figure_idx != idx_p.figure_idx)
-                {
-                    if (!d2d_rect_check_overlap(&figure_p->bounds, &figure_q->bounds))
-                        continue;
-                    if ((max_q = figure_q->vertex_count)
-                            && figure_q->vertex_types[max_q - 1] == D2D_VERTEX_TYPE_END)
-                        --max_q;
-                }
-                else
-                {
-                    max_q = idx_p.vertex_idx;
-                }
+            segment = &segments[segment_count++];
+            segment->idx = idx;
+            segment->bezier = d2d_vertex_type_is_bezier(figure->vertex_types[idx.vertex_idx]);
+            next = idx.vertex_idx + 1;
+            if (next == figure->vertex_count)
+                next = 0;
+            segment->bounds.left = segment->bounds.right = figure->vertices[idx.vertex_idx].x;
+            segment->bounds.top = segment->bounds.bottom = figure->vertices[idx.vertex_idx].y;
+            d2d_rect_expand(&segment->bounds, &figure->vertices[next]);
+            if (segment->bezier)
+                d2d_rect_expand(&segment->bounds, &figure->bezier_controls[idx.control_idx++]);
+        }
+    }
 
-                idx_q.control_idx = 0;
-                for (idx_q.vertex_idx = 0; idx_q.vertex_idx < max_q; ++idx_q.vertex_idx)
-                {
-                    type_q = figure_q->vertex_types[idx_q.vertex_idx];
-                    if (d2d_vertex_type_is_bezier(type_q))
-                    {
-                        if (d2d_vertex_type_is_bezier(type_p))
-                        {
-                            if (!d2d_geometry_intersect_bezier_bezier(geometry, &intersections,
-                                    &idx_p, 0.0f, 1.0f, &idx_q, 0.0f, 1.0f))
-                                goto done;
-                        }
-                        else
-                        {
-                            if (!d2d_geometry_intersect_bezier_line(geometry, &intersections, &idx_q, &idx_p))
-                                goto done;
-                        }
-                        ++idx_q.control_idx;
-                    }
-                    else
-                    {
-                        if (d2d_vertex_type_is_bezier(type_p))
-                        {
-                            if (!d2d_geometry_intersect_bezier_line(geometry, &intersections, &idx_p, &idx_q))
-                                goto done;
-                        }
-                        else
-                        {
-                            if (!d2d_geometry_intersect_line_line(geometry, &intersections, &idx_p, &idx_q))
-                                goto done;
-                        }
-                    }
-                }
-            }
-            if (d2d_vertex_type_is_bezier(type_p))
-                ++idx_p.control_idx;
+    qsort(segments, segment_count, sizeof(*segments), d2d_segment_bounds_compare);
+
+    for (i = 0; i < segment_count; ++i)
+    {
+        for (j = i + 1; j < segment_count && segments[j].bounds.left <= segments[i].bounds.right; ++j)
+        {
+            if (segments[j].bounds.top > segments[i].bounds.bottom
+                    || segments[j].bounds.bottom < segments[i].bounds.top)
+                continue;
+            if (segments[j].idx.figure_idx != segments[i].idx.figure_idx
+                    && !d2d_rect_check_overlap(&geometry->u.path.figures[segments[j].idx.figure_idx].bounds,
+                    &geometry->u.path.figures[segments[i].idx.figure_idx].bounds))
+                continue;
+            if (!d2d_geometry_intersect_segments(geometry, &intersections, &segments[i], &segments[j]))
+                goto done;
         }
     }
 
@@ -2802,6 +2838,7 @@ static BOOL d2d_geometry_intersect_self(struct d2d_geometry *geometry)
     ret = d2d_geometry_apply_intersections(geometry, &intersections);
 
 done:
+    free(segments);
     free(intersections.intersections);
     return ret;
 }
@@ -3245,6 +3282,15 @@ static BOOL d2d_geometry_fill_add_arc_triangle(struct d2d_geometry *geometry,
 
 static void d2d_geometry_cleanup(struct d2d_geometry *geometry)
 {
+    unsigned int i;
+
+    for (i = 0; i < ARRAY_SIZE(geometry->d3d.buffers); ++i)
+    {
+        if (geometry->d3d.buffers[i])
+            ID3D11Buffer_Release(geometry->d3d.buffers[i]);
+    }
+    if (geometry->d3d.device)
+        ID3D11Device1_Release(geometry->d3d.device);
     free(geometry->outline.arc_faces);
     free(geometry->outline.arcs);
     free(geometry->outline.bezier_faces);
@@ -6673,6 +6719,21 @@ struct d2d_geometry *unsafe_impl_from_ID2D1Geometry(ID2D1Geometry *iface)
     return CONTAINING_RECORD(iface, struct d2d_geometry, ID2D1Geometry_iface);
 }
 
+/* Transformed geometries and geometry groups share the fill and outline
+ * arrays of their source geometry, and so should share its buffers too. */
+struct d2d_geometry *d2d_geometry_get_buffer_owner(const struct d2d_geometry *geometry)
+{
+    for (;;)
+    {
+        if (geometry->ID2D1Geometry_iface.lpVtbl == (const ID2D1GeometryVtbl *)&d2d_transformed_geometry_vtbl)
+            geometry = unsafe_impl_from_ID2D1Geometry(geometry->u.transformed.src_geometry);
+        else if (geometry->ID2D1Geometry_iface.lpVtbl == (const ID2D1GeometryVtbl *)&d2d_geometry_group_vtbl)
+            geometry = unsafe_impl_from_ID2D1Geometry((ID2D1Geometry *)geometry->u.group.path);
+        else
+            return (struct d2d_geometry *)geometry;
+    }
+}
+
 static inline struct d2d_geometry_realization *impl_from_ID2D1GeometryRealization(
         ID2D1GeometryRealization *iface)
 {
@@ -85,11 +85,18 @@ static HRESULT d2d_wic_render_target_present(IUnknown *outer_unknown)
 
     src = mapped_texture.pData;
 
-    for (i = 0; i < render_target->height; ++i)
+    if (render_target->height && mapped_texture.RowPitch == dst_pitch)
     {
-        memcpy(dst, src, render_target->bpp * render_target->width);
-        src += mapped_texture.RowPitch;
-        dst += dst_pitch;
+        memcpy(dst, src, (render_target->height - 1) * dst_pitch + render_target->bpp * render_target->width);
+    }
+    else
+    {
+        for (i = 0; i < render_target->height; ++i)
+        {
+            memcpy(dst, src, render_target->bpp * render_target->width);
+            src += mapped_texture.RowPitch;
+            dst += dst_pitch;
+        }
     }
 
     ID3D10Texture2D_Unmap(render_target->readback_texture, 0);
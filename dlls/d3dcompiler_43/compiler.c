@@ -20,6 +20,7 @@
 
 #define COBJMACROS
 #include <stdarg.h>
+#include <stdio.h>
 #include <time.h>
 #include "wine/debug.h"
 
@@ -303,6 +304,212 @@ HRESULT WINAPI vkd3d_D3DCompile2VKD3D(const void *data, SIZE_T data_size, const
         const void *secondary_data, SIZE_T secondary_data_size, ID3DBlob **shader,
         ID3DBlob **error_messages, unsigned int compiler_version);
 
+/* Optional on-disk cache of compiled shaders, enabled by pointing
+ * WINE_D3DCOMPILER_CACHE_PATH at a directory. Entries are keyed on the
+ * preprocessed source, which takes care of macros and include contents, along
+ * with everything else that can influence the generated code. The complete key
+ * is stored in each entry and compared on lookup, so a hash collision can only
+ * cause a miss. */
+
+#define D3DCOMPILER_CACHE_MAGIC 0x48435844 /* "DXCH" */
+#define D3DCOMPILER_CACHE_VERSION 1
+
+struct d3dcompiler_cache_header
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t key_size;
+    uint32_t blob_size;
+};
+
+struct d3dcompiler_cache_key
+{
+    char *data;
+    size_t size;
+    uint64_t hash;
+};
+
+static WCHAR d3dcompiler_cache_dir[MAX_PATH];
+
+static BOOL WINAPI d3dcompiler_cache_init(INIT_ONCE *once, void *param, void **context)
+{
+    DWORD len;
+
+    len = GetEnvironmentVariableW(L"WINE_D3DCOMPILER_CACHE_PATH", d3dcompiler_cache_dir,
+            ARRAY_SIZE(d3dcompiler_cache_dir));
+    if (!len || len >= ARRAY_SIZE(d3dcompiler_cache_dir) - 32)
+    {
+        d3dcompiler_cache_dir[0] = 0;
+        return TRUE;
+    }
+    if (!CreateDirectoryW(d3dcompiler_cache_dir, NULL) && GetLastError() != ERROR_ALREADY_EXISTS)
+    {
+        WARN("Failed to create shader cache directory %s, error %lu.\n",
+                debugstr_w(d3dcompiler_cache_dir), GetLastError());
+        d3dcompiler_cache_dir[0] = 0;
+        return TRUE;
+    }
+    TRACE("Using shader cache directory %s.\n", debugstr_w(d3dcompiler_cache_dir));
+    return TRUE;
+}
+
+static BOOL d3dcompiler_cache_enabled(void)
+{
+    static INIT_ONCE init_once = INIT_ONCE_STATIC_INIT;
+
+    InitOnceExecuteOnce(&init_once, d3dcompiler_cache_init, NULL, NULL);
+    return !!d3dcompiler_cache_dir[0];
+}
+
+static void cache_key_append(struct d3dcompiler_cache_key *key, size_t *offset, const void *data, size_t size)
+{
+    if (key->data)
+        memcpy(key->data + *offset, data, size);
+    *offset += size;
+}
+
+static void cache_key_append_string(struct d3dcompiler_cache_key *key, size_t *offset, const char *str)
+{
+    cache_key_append(key, offset, str ? str : "", (str ? strlen(str) : 0) + 1);
+}
+
+static size_t cache_key_write(struct d3dcompiler_cache_key *key, const char *filename,
+        const char *entry_point, const char *profile, UINT flags, UINT effect_flags, UINT secondary_flags,
+        const void *secondary_data, SIZE_T secondary_data_size, ID3DBlob *preprocessed)
+{
+    const uint32_t params[] = {D3D_COMPILER_VERSION, flags, effect_flags, secondary_flags, secondary_data_size};
+    size_t offset = 0;
+
+    cache_key_append(key, &offset, params, sizeof(params));
+    cache_key_append_string(key, &offset, filename);
+    cache_key_append_string(key, &offset, entry_point);
+    cache_key_append_string(key, &offset, profile);
+    if (secondary_data)
+        cache_key_append(key, &offset, secondary_data, secondary_data_size);
+    cache_key_append(key, &offset, ID3D10Blob_GetBufferPointer(preprocessed), ID3D10Blob_GetBufferSize(preprocessed));
+    return offset;
+}
+
+static BOOL d3dcompiler_cache_key_init(struct d3dcompiler_cache_key *key, const void *data, SIZE_T data_size,
+        const char *filename, const D3D_SHADER_MACRO *macros, ID3DInclude *include, const char *entry_point,
+        const char *profile, UINT flags, UINT effect_flags, UINT secondary_flags,
+        const void *secondary_data, SIZE_T secondary_data_size)
+{
+    ID3DBlob *preprocessed, *messages = NULL;
+    size_t i;
+
+    if (FAILED(vkd3d_D3DPreprocess(data, data_size, filename, macros, include, &preprocessed, &messages)))
+    {
+        if (messages)
+            ID3D10Blob_Release(messages);
+        return FALSE;
+    }
+    if (messages)
+        ID3D10Blob_Release(messages);
+
+    key->data = NULL;
+    key->size = cache_key_write(key, filename, entry_point, profile, flags, effect_flags,
+            secondary_flags, secondary_data, secondary_data_size, preprocessed);
+    if (!(key->data = malloc(key->size)))
+    {
+        ID3D10Blob_Release(preprocessed);
+        return FALSE;
+    }
+    cache_key_write(key, filename, entry_point, profile, flags, effect_flags,
+            secondary_flags, secondary_data, secondary_data_size, preprocessed);
+    ID3D10Blob_Release(preprocessed);
+
+    /* FNV-1a */
+    key->hash = 0xcbf29ce484222325ull;
+    for (i = 0; i < key->size; ++i)
+        key->hash = (key->hash ^ (unsigned char)key->data[i]) * 0x100000001b3ull;
+    return TRUE;
+}
+
+static void d3dcompiler_cache_get_path(const struct d3dcompiler_cache_key *key, WCHAR *path, size_t size)
+{
+    swprintf(path, size, L"%s\\%08x%08x.bin", d3dcompiler_cache_dir,
+            (unsigned int)(key->hash >> 32), (unsigned int)key->hash);
+}
+
+static BOOL d3dcompiler_cache_lookup(const struct d3dcompiler_cache_key *key, ID3DBlob **blob)
+{
+    struct d3dcompiler_cache_header header;
+    WCHAR path[MAX_PATH];
+    BOOL ret = FALSE;
+    char *stored_key;
+    HANDLE file;
+    DWORD read;
+
+    d3dcompiler_cache_get_path(key, path, ARRAY_SIZE(path));
+    file = CreateFileW(path, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, NULL, OPEN_EXISTING, 0, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+        return FALSE;
+
+    if (!ReadFile(file, &header, sizeof(header), &read, NULL) || read != sizeof(header)
+            || header.magic != D3DCOMPILER_CACHE_MAGIC || header.version != D3DCOMPILER_CACHE_VERSION
+            || header.key_size != key->size || !header.blob_size)
+        goto done;
+
+    if (!(stored_key = malloc(key->size)))
+        goto done;
+    if (!ReadFile(file, stored_key, key->size, &read, NULL) || read != key->size
+            || memcmp(stored_key, key->data, key->size))
+    {
+        free(stored_key);
+        goto done;
+    }
+    free(stored_key);
+
+    if (FAILED(D3DCreateBlob(header.blob_size, blob)))
+        goto done;
+    if (!ReadFile(file, ID3D10Blob_GetBufferPointer(*blob), header.blob_size, &read, NULL)
+            || read != header.blob_size)
+    {
+        ID3D10Blob_Release(*blob);
+        *blob = NULL;
+        goto done;
+    }
+    ret = TRUE;
+
+done:
+    CloseHandle(file);
+    return ret;
+}
+
+static void d3dcompiler_cache_store(const struct d3dcompiler_cache_key *key, ID3DBlob *blob)
+{
+    struct d3dcompiler_cache_header header;
+    WCHAR path[MAX_PATH], tmp_path[MAX_PATH];
+    HANDLE file;
+    DWORD written;
+    BOOL ret;
+
+    header.magic = D3DCOMPILER_CACHE_MAGIC;
+    header.version = D3DCOMPILER_CACHE_VERSION;
+    header.key_size = key->size;
+    header.blob_size = ID3D10Blob_GetBufferSize(blob);
+
+    d3dcompiler_cache_get_path(key, path, ARRAY_SIZE(path));
+    swprintf(tmp_path, ARRAY_SIZE(tmp_path), L"%s.%lx.tmp", path, GetCurrentThreadId());
+    file = CreateFileW(tmp_path, GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, 0, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+        return;
+
+    ret = WriteFile(file, &header, sizeof(header), &written, NULL)
+            && WriteFile(file, key->data, key->size, &written, NULL)
+            && WriteFile(file, ID3D10Blob_GetBufferPointer(blob), header.blob_size, &written, NULL);
+    CloseHandle(file);
+
+    /* Entries are written under a temporary name and renamed into place, so
+     * that concurrent readers never see a partially written file. */
+    if (!ret || !MoveFileExW(tmp_path, path, MOVEFILE_REPLACE_EXISTING))
+    {
+        WARN("Failed to store shader cache entry %s.\n", debugstr_w(path));
+        DeleteFileW(tmp_path);
+    }
+}
+
 HRESULT WINAPI D3DCompile2(const void *data, SIZE_T data_size, const char *filename,
         const D3D_SHADER_MACRO *macros, ID3DInclude *include, const char *entry_point,
         const char *profile, UINT flags, UINT effect_flags, UINT secondary_flags,
@@ -310,6 +517,8 @@ HRESULT WINAPI D3DCompile2(const void *data, SIZE_T data_size, const char *filen
         ID3DBlob **messages_blob)
 {
     struct d3dcompiler_include_from_file include_from_file;
+    struct d3dcompiler_cache_key cache_key;
+    BOOL use_cache = FALSE;
     ID3DBlob *dummy_blob;
     HRESULT hr;
 
@@ -332,8 +541,34 @@ HRESULT WINAPI D3DCompile2(const void *data, SIZE_T data_size, const char *filen
     else
         shader_blob = &dummy_blob;
 
+    if (shader_blob != &dummy_blob && d3dcompiler_cache_enabled() && d3dcompiler_cache_key_init(&cache_key,
+            data, data_size, filename, macros, include, entry_point, profile, flags, effect_flags,
+            secondary_flags, secondary_data, secondary_data_size))
+    {
+        if (d3dcompiler_cache_lookup(&cache_key, shader_blob))
+        {
+            TRACE("Found shader in cache.\n");
+            if (messages_blob)
+                *messages_blob = NULL;
+            free(cache_key.data);
+            return S_OK;
+        }
+        use_cache = TRUE;
+    }
+
     hr = vkd3d_D3DCompile2VKD3D(data, data_size, filename, macros, include, entry_point, profile, flags, effect_flags,
             secondary_flags, secondary_data, secondary_data_size, shader_blob, messages_blob, D3D_COMPILER_VERSION);
+
+    if (use_cache)
+    {
+        /* Only store shaders compiled without diagnostics, so that a cache
+         * hit, which never returns any messages, is indistinguishable from
+         * compiling the shader again. */
+        if (SUCCEEDED(hr) && (!messages_blob || !*messages_blob))
+            d3dcompiler_cache_store(&cache_key, *shader_blob);
+        free(cache_key.data);
+    }
+
     if (SUCCEEDED(hr) && shader_blob == &dummy_blob)
         ID3D10Blob_Release(dummy_blob);
     return hr;
@@ -2992,6 +2992,65 @@ static void d3dx_compress_block(enum d3dx_pixel_format_id fmt, uint8_t *block_bu
     }
 }
 
+struct d3dx_compress_context
+{
+    const struct d3dx_pixels *src_pixels;
+    const struct pixel_format_desc *src_desc;
+    struct d3dx_pixels *dst_pixels;
+    const struct pixel_format_desc *dst_desc;
+    unsigned int rows_per_slice;
+    unsigned int row_count;
+    LONG next_row;
+};
+
+static void d3dx_compress_block_row(const struct d3dx_compress_context *ctx, unsigned int row)
+{
+    const struct pixel_format_desc *dst_desc = ctx->dst_desc, *src_desc = ctx->src_desc;
+    const struct d3dx_pixels *src_pixels = ctx->src_pixels;
+    const unsigned int z = row / ctx->rows_per_slice;
+    const unsigned int y = (row % ctx->rows_per_slice) * dst_desc->block_height;
+    const unsigned int tmp_src_height = min(dst_desc->block_height, src_pixels->size.height - y);
+    const unsigned int block_buf_row_pitch = src_desc->bytes_per_pixel * dst_desc->block_width;
+    const uint8_t *src_ptr = &((const uint8_t *)src_pixels->data)[z * src_pixels->slice_pitch + y * src_pixels->row_pitch];
+    uint8_t *dst_ptr = &((uint8_t *)ctx->dst_pixels->data)[z * ctx->dst_pixels->slice_pitch
+            + (y / dst_desc->block_height) * ctx->dst_pixels->row_pitch];
+    uint8_t block_buf[64];
+    unsigned int x;
+
+    for (x = 0; x < src_pixels->size.width; x += dst_desc->block_width)
+    {
+        const unsigned int tmp_src_width = min(dst_desc->block_width, src_pixels->size.width - x);
+        struct volume block_buf_size = { tmp_src_width, tmp_src_height, 1 };
+
+        if (tmp_src_width != dst_desc->block_width || tmp_src_height != dst_desc->block_height)
+            memset(block_buf, 0, sizeof(block_buf));
+        copy_pixels(src_ptr, src_pixels->row_pitch, src_pixels->slice_pitch, block_buf, block_buf_row_pitch, 0,
+                &block_buf_size, src_desc);
+        d3dx_compress_block(dst_desc->format, block_buf, dst_ptr);
+        src_ptr += (src_desc->bytes_per_pixel * dst_desc->block_width);
+        dst_ptr += dst_desc->block_byte_count;
+    }
+}
+
+static void d3dx_compress_rows(struct d3dx_compress_context *ctx)
+{
+    unsigned int row;
+
+    while ((row = InterlockedIncrement(&ctx->next_row) - 1) < ctx->row_count)
+        d3dx_compress_block_row(ctx, row);
+}
+
+static void CALLBACK d3dx_compress_work_cb(TP_CALLBACK_INSTANCE *instance, void *context, TP_WORK *work)
+{
+    d3dx_compress_rows(context);
+}
+
+/* Block compression is by far the most expensive part of loading into a
+ * compressed format. Blocks are independent of each other, so spread rows
+ * of blocks over the thread pool when there is enough work to be worth it. */
+#define D3DX_COMPRESS_PARALLEL_MIN_BLOCKS 4096
+#define D3DX_COMPRESS_MAX_WORKERS 8
+
 /*
  * Source data passed into this function is potentially modified (currently
  * only in the case of DXT2/DXT3). As of now we only pass temporary buffers
@@ -3002,8 +3061,9 @@ static HRESULT d3dx_pixels_compress(struct d3dx_pixels *src_pixels,
         const struct pixel_format_desc *src_desc, struct d3dx_pixels *dst_pixels,
         const struct pixel_format_desc *dst_desc)
 {
-    unsigned int x, y, z, block_buf_row_pitch;
-    uint8_t block_buf[64];
+    unsigned int blocks_per_row, worker_count, i;
+    struct d3dx_compress_context ctx;
+    TP_WORK *work = NULL;
 
     switch (dst_desc->format)
     {
@@ -3037,34 +3097,36 @@ static HRESULT d3dx_pixels_compress(struct d3dx_pixels *src_pixels,
     }
 
     TRACE("Compressing pixels.\n");
-    block_buf_row_pitch = src_desc->bytes_per_pixel * dst_desc->block_width;
-    for (z = 0; z < src_pixels->size.depth; ++z)
-    {
-        const uint8_t *src_slice = &((const uint8_t *)src_pixels->data)[z * src_pixels->slice_pitch];
-        uint8_t *dst_slice = &((uint8_t *)dst_pixels->data)[z * dst_pixels->slice_pitch];
-
-        for (y = 0; y < src_pixels->size.height; y += dst_desc->block_height)
+    ctx.src_pixels = src_pixels;
+    ctx.src_desc = src_desc;
+    ctx.dst_pixels = dst_pixels;
+    ctx.dst_desc = dst_desc;
+    ctx.rows_per_slice = (src_pixels->size.height + dst_desc->block_height - 1) / dst_desc->block_height;
+    ctx.row_count = ctx.rows_per_slice * src_pixels->size.depth;
+    ctx.next_row = 0;
+
+    blocks_per_row = (src_pixels->size.width + dst_desc->block_width - 1) / dst_desc->block_width;
+    if (ctx.row_count > 1 && blocks_per_row * ctx.row_count >= D3DX_COMPRESS_PARALLEL_MIN_BLOCKS)
+    {
+        SYSTEM_INFO info;
+
+        GetSystemInfo(&info);
+        worker_count = min(min(info.dwNumberOfProcessors, D3DX_COMPRESS_MAX_WORKERS), ctx.row_count);
+        if (worker_count > 1 && (work = CreateThreadpoolWork(d3dx_compress_work_cb, &ctx, NULL)))
         {
-            const unsigned int tmp_src_height = min(dst_desc->block_height, src_pixels->size.height - y);
-            uint8_t *dst_ptr = &dst_slice[(y / dst_desc->block_height) * dst_pixels->row_pitch];
-            const uint8_t *src_ptr = &src_slice[y * src_pixels->row_pitch];
-
-            for (x = 0; x < src_pixels->size.width; x += dst_desc->block_width)
-            {
-                const unsigned int tmp_src_width = min(dst_desc->block_width, src_pixels->size.width - x);
-                struct volume block_buf_size = { tmp_src_width, tmp_src_height, 1 };
-
-                if (tmp_src_width != dst_desc->block_width || tmp_src_height != dst_desc->block_height)
-                    memset(block_buf, 0, sizeof(block_buf));
-                copy_pixels(src_ptr, src_pixels->row_pitch, src_pixels->slice_pitch, block_buf, block_buf_row_pitch, 0,
-                        &block_buf_size, src_desc);
-                d3dx_compress_block(dst_desc->format, block_buf, dst_ptr);
-                src_ptr += (src_desc->bytes_per_pixel * dst_desc->block_width);
-                dst_ptr += dst_desc->block_byte_count;
-            }
+            /* The calling thread takes a share of the rows as well. */
+            for (i = 1; i < worker_count; ++i)
+                SubmitThreadpoolWork(work);
         }
     }
 
+    d3dx_compress_rows(&ctx);
+    if (work)
+    {
+        WaitForThreadpoolWorkCallbacks(work, FALSE);
+        CloseThreadpoolWork(work);
+    }
+
     return S_OK;
 }
 
@@ -373,6 +373,53 @@ static void append(struct dump_context* dc, const void* data, unsigned size)
     dc->rva += size;
 }
 
+/******************************************************************
+ *		dump_memory_range
+ *
+ * Copies a range of the target's memory at the current file position, in
+ * large chunks. Unreadable pages are written as zeros, so that the data of
+ * the following ranges stays where the descriptors say it is.
+ */
+#define DUMP_CHUNK_SIZE 0x10000
+#define DUMP_PAGE_SIZE  0x1000
+
+static void dump_memory_range(struct dump_context* dc, ULONG64 base, ULONG64 size)
+{
+    static char zeros[DUMP_PAGE_SIZE];
+    char        small[DUMP_PAGE_SIZE];
+    char*       buffer;
+    unsigned    chunk, len, page_len, i;
+    DWORD       written;
+    ULONG64     pos;
+
+    if (!(buffer = HeapAlloc(GetProcessHeap(), 0, DUMP_CHUNK_SIZE)))
+    {
+        buffer = small;
+        chunk = sizeof(small);
+    }
+    else chunk = DUMP_CHUNK_SIZE;
+
+    for (pos = 0; pos < size; pos += len)
+    {
+        len = min(size - pos, chunk);
+        if (read_process_memory(dc->process, base + pos, buffer, len))
+        {
+            WriteFile(dc->hFile, buffer, len, &written, NULL);
+            continue;
+        }
+        /* retry page by page */
+        for (i = 0; i < len; i += page_len)
+        {
+            page_len = min(len - i, DUMP_PAGE_SIZE);
+            if (read_process_memory(dc->process, base + pos + i, buffer, page_len))
+                WriteFile(dc->hFile, buffer, page_len, &written, NULL);
+            else
+                WriteFile(dc->hFile, zeros, page_len, &written, NULL);
+        }
+    }
+    if (buffer != small) HeapFree(GetProcessHeap(), 0, buffer);
+}
+
 /******************************************************************
  *		dump_exception_info
  *
@@ -786,10 +833,8 @@ static unsigned         dump_memory_info(struct dump_context* dc)
 {
     MINIDUMP_MEMORY_LIST        mdMemList;
     MINIDUMP_MEMORY_DESCRIPTOR  mdMem;
-    DWORD                       written;
-    unsigned                    i, pos, len, sz;
+    unsigned                    i, sz;
     RVA                         rva_base;
-    char                        tmp[1024];
 
     mdMemList.NumberOfMemoryRanges = dc->num_mem;
     append(dc, &mdMemList.NumberOfMemoryRanges,
@@ -805,12 +850,7 @@ static unsigned         dump_memory_info(struct dump_context* dc)
         mdMem.Memory.Rva = dc->rva;
         mdMem.Memory.DataSize = dc->mem[i].size;
         SetFilePointer(dc->hFile, dc->rva, NULL, FILE_BEGIN);
-        for (pos = 0; pos < dc->mem[i].size; pos += sizeof(tmp))
-        {
-            len = min(dc->mem[i].size - pos, sizeof(tmp));
-            if (read_process_memory(dc->process, dc->mem[i].base + pos, tmp, len))
-                WriteFile(dc->hFile, tmp, len, &written, NULL);
-        }
+        dump_memory_range(dc, dc->mem[i].base, dc->mem[i].size);
         dc->rva += mdMem.Memory.DataSize;
         writeat(dc, rva_base + i * sizeof(mdMem), &mdMem, sizeof(mdMem));
         if (dc->mem[i].rva)
@@ -831,11 +871,8 @@ static unsigned         dump_memory64_info(struct dump_context* dc)
 {
     MINIDUMP_MEMORY64_LIST          mdMem64List;
     MINIDUMP_MEMORY_DESCRIPTOR64    mdMem64;
-    DWORD                           written;
-    unsigned                        i, len, sz;
+    unsigned                        i, sz;
     RVA                             rva_base;
-    char                            tmp[1024];
-    ULONG64                         pos;
     LARGE_INTEGER                   filepos;
 
     sz = sizeof(mdMem64List.NumberOfMemoryRanges) +
@@ -861,12 +898,7 @@ static unsigned         dump_memory64_info(struct dump_context* dc)
         mdMem64.StartOfMemoryRange = dc->mem64[i].base;
         mdMem64.DataSize = dc->mem64[i].size;
         SetFilePointerEx(dc->hFile, filepos, NULL, FILE_BEGIN);
-        for (pos = 0; pos < dc->mem64[i].size; pos += sizeof(tmp))
-        {
-            len = min(dc->mem64[i].size - pos, sizeof(tmp));
-            if (read_process_memory(dc->process, dc->mem64[i].base + pos, tmp, len))
-                WriteFile(dc->hFile, tmp, len, &written, NULL);
-        }
+        dump_memory_range(dc, dc->mem64[i].base, dc->mem64[i].size);
         filepos.QuadPart += mdMem64.DataSize;
         writeat(dc, rva_base + i * sizeof(mdMem64), &mdMem64, sizeof(mdMem64));
     }
@@ -193,6 +193,8 @@ struct pdb_reader
     pdb_reader_fetch_block_t fetch;
     struct {unsigned block_no; unsigned age;} cache[4*4];
     char *fetch_cache_blocks;
+    char *image; /* whole file mapping (if any) */
+    pdboff_t image_size;
 };
 
 enum pdb_result
@@ -256,6 +258,30 @@ static enum pdb_result pdb_reader_fetch_block_from_file(struct pdb_reader *pdb,
     return R_PDB_SUCCESS;
 }
 
+static enum pdb_result pdb_reader_fetch_block_from_map(struct pdb_reader *pdb, unsigned block_no, void **buffer)
+{
+    pdboff_t offset = (pdboff_t)block_no * pdb->block_size;
+
+    if (offset + pdb->block_size > pdb->image_size) return R_PDB_IOERROR;
+    *buffer = pdb->image + offset;
+    return R_PDB_SUCCESS;
+}
+
+/* map the whole file if possible, so that blocks are accessed without copying them */
+static void pdb_reader_map_file(struct pdb_reader *pdb)
+{
+    LARGE_INTEGER size;
+    HANDLE map;
+
+    if (!GetFileSizeEx(pdb->file, &size) || (sizeof(SIZE_T) < sizeof(size.QuadPart) && size.HighPart)) return;
+    if (!(map = CreateFileMappingW(pdb->file, NULL, PAGE_READONLY, 0, 0, NULL))) return;
+    pdb->image = MapViewOfFile(map, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(map);
+    if (!pdb->image) return;
+    pdb->image_size = size.QuadPart;
+    pdb->fetch = &pdb_reader_fetch_block_from_map;
+}
+
 static const char       PDB_JG_IDENT[] = "Microsoft C/C++ program database 2.00\r\n\032JG\0";
 static const char       PDB_DS_IDENT[] = "Microsoft C/C++ MSF 7.00\r\n\032DS\0";
 
@@ -550,6 +576,7 @@ static enum pdb_result pdb_reader_init(struct pdb_reader *pdb, struct module *mo
         pdb->cache[i].age = i;
     }
     pdb->fetch = &pdb_reader_fetch_block_from_file;
+    pdb_reader_map_file(pdb);
     toc_blocks_size = pdb_reader_num_blocks(pdb, hdr.toc_size) * sizeof(uint32_t);
     if ((result = pdb_reader_alloc(pdb, toc_blocks_size, (void**)&toc_blocks)) ||
         (result = pdb_reader_fetch_file_no_cache(pdb, toc_blocks, (pdboff_t)hdr.toc_block * hdr.block_size, toc_blocks_size)) ||
@@ -583,6 +610,8 @@ static enum pdb_result pdb_reader_init(struct pdb_reader *pdb, struct module *mo
 
 failure:
     WARN("Failed to load PDB header\n");
+    if (pdb->image) UnmapViewOfFile(pdb->image);
+    pdb->image = NULL;
     pdb_reader_free(pdb, toc);
     pdb_reader_free(pdb, toc_blocks);
     return result;
@@ -590,6 +619,7 @@ failure:
 
 static void pdb_reader_dispose(struct pdb_reader *pdb)
 {
+    if (pdb->image) UnmapViewOfFile(pdb->image);
     CloseHandle(pdb->file);
     /* note: pdb is allocated inside its pool, so this must be last line */
     pool_destroy(&pdb->pool);
@@ -315,6 +315,25 @@ static UINT cp_fields_noresample(IDirectSoundBufferImpl *dsb, UINT count)
     return count;
 }
 
+/* Independent partial sums break the dependency chain on a single
+ * accumulator, which lets the compiler vectorize this without -ffast-math. */
+static inline float fir_dot(const float *coeffs, const float *samples, int count)
+{
+    float sum0 = 0.0f, sum1 = 0.0f, sum2 = 0.0f, sum3 = 0.0f;
+    int j;
+
+    for (j = 0; j + 4 <= count; j += 4) {
+        sum0 += coeffs[j] * samples[j];
+        sum1 += coeffs[j + 1] * samples[j + 1];
+        sum2 += coeffs[j + 2] * samples[j + 2];
+        sum3 += coeffs[j + 3] * samples[j + 3];
+    }
+    for (; j < count; j++)
+        sum0 += coeffs[j] * samples[j];
+
+    return (sum0 + sum1) + (sum2 + sum3);
+}
+
 static UINT cp_fields_resample(IDirectSoundBufferImpl *dsb, UINT count, LONG64 *freqAccNum)
 {
     UINT i, channel;
@@ -379,22 +398,19 @@ static UINT cp_fields_resample(IDirectSoundBufferImpl *dsb, UINT count, LONG64 *
         UINT idx = (ipos + 1) * dsbfirstep - int_fir_steps - 1;
         float rem = int_fir_steps + 1.0 - total_fir_steps;
 
+        float rem_inv = 1.0f - rem;
         int fir_used = 0;
         while (idx < fir_len - 1) {
-            fir_copy[fir_used++] = fir[idx] * (1.0 - rem) + fir[idx + 1] * rem;
-            idx += dsb->firstep;
+            fir_copy[fir_used++] = fir[idx] * rem_inv + fir[idx + 1] * rem;
+            idx += dsbfirstep;
         }
 
         assert(fir_used <= fir_cachesize);
         assert(ipos + fir_used <= required_input);
 
-        for (channel = 0; channel < dsb->mix_channels; channel++) {
-            int j;
-            float sum = 0.0;
-            float* cache = &intermediate[channel * required_input + ipos];
-            for (j = 0; j < fir_used; j++)
-                sum += fir_copy[j] * cache[j];
-            dsb->put(dsb, i * ostride, channel, sum * dsb->firgain);
+        for (channel = 0; channel < channels; channel++) {
+            const float *cache = &intermediate[channel * required_input + ipos];
+            dsb->put(dsb, i * ostride, channel, fir_dot(fir_copy, cache, fir_used) * dsb->firgain);
         }
     }
 
@@ -720,7 +736,7 @@ static void DSOUND_PerformMix(DirectSoundDevice *device)
 		/* check for underrun. underrun occurs when the write position passes the mix position
 		 * also wipe out just-played sound data */
 		if (!pad_frames)
-			WARN("Probable buffer underrun\n");
+			WARN("Probable buffer underrun, %lu so far\n", ++device->underruns);
 
 		hr = IAudioRenderClient_GetBuffer(device->render, frames, (BYTE **)&buffer);
 		if(FAILED(hr)){
@@ -734,7 +750,8 @@ static void DSOUND_PerformMix(DirectSoundDevice *device)
 		if (!device->normfunction)
 			DSOUND_MixToPrimary(device, buffer, frames, &all_stopped);
 		else {
-			memset(device->buffer, nfiller, device->buflen);
+			/* only the part mixed into below is read back */
+			memset(device->buffer, nfiller, frames * device->pwfx->nChannels * sizeof(float));
 
 			/* do the mixing */
 			DSOUND_MixToPrimary(device, (float*)device->buffer, frames, &all_stopped);
@@ -677,6 +677,14 @@ static DWRITE_SCRIPT_ANALYSIS get_char_sa(UINT32 c)
 {
     DWRITE_SCRIPT_ANALYSIS sa;
 
+    /* Fast path for Basic Latin, skipping table lookup and range checks. */
+    if (c < 0x80)
+    {
+        sa.script = ((c | 0x20) >= 'a' && (c | 0x20) <= 'z') ? Script_Latin : Script_Common;
+        sa.shapes = (c <= 0x001f || c == 0x007f) ? DWRITE_SCRIPT_SHAPES_NO_VISUAL : DWRITE_SCRIPT_SHAPES_DEFAULT;
+        return sa;
+    }
+
     sa.script = get_char_script(c);
     sa.shapes = DWRITE_SCRIPT_SHAPES_DEFAULT;
     if ((c <= 0x001f)                          /* C0 controls */
@@ -1555,6 +1563,7 @@ static HRESULT WINAPI dwritetextanalyzer_GetGlyphs(IDWriteTextAnalyzer2 *iface,
     struct dwrite_fontface *font_obj;
     WCHAR digits[NATIVE_DIGITS_LEN];
     unsigned int glyph_count;
+    BOOL cacheable;
     HRESULT hr;
 
     TRACE("%s:%u, %p, %d, %d, %s, %s, %p, %p, %p, %u, %u, %p, %p, %p, %p, %p.\n", debugstr_wn(text, length),
@@ -1574,8 +1583,6 @@ static HRESULT WINAPI dwritetextanalyzer_GetGlyphs(IDWriteTextAnalyzer2 *iface,
     context.length = length;
     context.is_rtl = is_rtl;
     context.is_sideways = is_sideways;
-    context.u.subst.glyphs = calloc(glyph_count, sizeof(*glyphs));
-    context.u.subst.glyph_props = calloc(glyph_count, sizeof(*glyph_props));
     context.u.subst.text_props = text_props;
     context.u.subst.clustermap = clustermap;
     context.u.subst.max_glyph_count = max_glyph_count;
@@ -1585,11 +1592,22 @@ static HRESULT WINAPI dwritetextanalyzer_GetGlyphs(IDWriteTextAnalyzer2 *iface,
     context.user_features.features = features;
     context.user_features.range_lengths = feature_range_lengths;
     context.user_features.range_count = feature_ranges;
-    context.glyph_infos = calloc(glyph_count, sizeof(*context.glyph_infos));
     context.table = &context.cache->gsub;
 
     *actual_glyph_count = 0;
 
+    /* Identical runs are commonly shaped over and over by short lived layouts. */
+    cacheable = !feature_ranges && !*digits;
+    if (cacheable && shape_get_cached_glyphs(&context, glyphs, glyph_props))
+    {
+        *actual_glyph_count = context.glyph_count;
+        return S_OK;
+    }
+
+    context.u.subst.glyphs = calloc(glyph_count, sizeof(*glyphs));
+    context.u.subst.glyph_props = calloc(glyph_count, sizeof(*glyph_props));
+    context.glyph_infos = calloc(glyph_count, sizeof(*context.glyph_infos));
+
     if (!context.u.subst.glyphs || !context.u.subst.glyph_props || !context.glyph_infos)
     {
         hr = E_OUTOFMEMORY;
@@ -1603,6 +1621,8 @@ static HRESULT WINAPI dwritetextanalyzer_GetGlyphs(IDWriteTextAnalyzer2 *iface,
         *actual_glyph_count = context.glyph_count;
         memcpy(glyphs, context.u.subst.glyphs, context.glyph_count * sizeof(*glyphs));
         memcpy(glyph_props, context.u.subst.glyph_props, context.glyph_count * sizeof(*glyph_props));
+        if (cacheable)
+            shape_cache_glyphs(&context, glyphs, glyph_props);
     }
 
 failed:
@@ -653,6 +653,17 @@ struct scriptshaping_cache
         unsigned int markattachclassdef;
         unsigned int markglyphsetdef;
     } gdef;
+
+    /* Recently shaped runs, shared by all users of the font face. */
+    struct
+    {
+        CRITICAL_SECTION cs;
+        struct list mru;
+        unsigned int count;
+        size_t size;
+        unsigned int hits;
+        unsigned int misses;
+    } runs;
 };
 
 struct shaping_glyph_info
@@ -844,6 +855,10 @@ extern HRESULT opentype_get_vertical_glyph_variants(struct dwrite_fontface *font
         const UINT16 *nominal_glyphs, UINT16 *glyphs);
 
 extern HRESULT shape_get_glyphs(struct scriptshaping_context *context, const unsigned int *scripts);
+extern BOOL shape_get_cached_glyphs(struct scriptshaping_context *context, UINT16 *glyphs,
+        DWRITE_SHAPING_GLYPH_PROPERTIES *glyph_props);
+extern void shape_cache_glyphs(struct scriptshaping_context *context, const UINT16 *glyphs,
+        const DWRITE_SHAPING_GLYPH_PROPERTIES *glyph_props);
 extern HRESULT shape_get_positions(struct scriptshaping_context *context, const unsigned int *scripts);
 extern HRESULT shape_get_typographic_features(struct scriptshaping_context *context, const unsigned int *scripts,
         unsigned int max_tagcount, unsigned int *actual_tagcount, DWRITE_FONT_FEATURE_TAG *tags);
@@ -4737,16 +4737,12 @@ HRESULT create_font_collection(IDWriteFactory7 *factory, IDWriteFontFileEnumerat
     return hr;
 }
 
-static HRESULT collection_add_font_entry(struct dwrite_fontcollection *collection, const struct fontface_desc *desc)
+static HRESULT collection_add_font_data(struct dwrite_fontcollection *collection, struct dwrite_font_data *font_data)
 {
-    struct dwrite_font_data *font_data;
     WCHAR familyW[255];
     UINT32 index;
     HRESULT hr;
 
-    if (FAILED(hr = init_font_data(desc, collection->family_model, &font_data)))
-        return hr;
-
     fontstrings_get_en_string(font_data->family_names, familyW, ARRAY_SIZE(familyW));
 
     /* ignore dot named faces */
@@ -4784,11 +4780,291 @@ static HRESULT collection_add_font_entry(struct dwrite_fontcollection *collectio
     return hr;
 }
 
+/* Properties of system font faces are kept in a volatile registry key, shared by all processes
+   of the same prefix, so that font files are only parsed again when they are modified. */
+struct cached_font_data
+{
+    FILETIME writetime;
+    DWRITE_FONT_STYLE style;
+    DWRITE_FONT_STRETCH stretch;
+    DWRITE_FONT_WEIGHT weight;
+    DWRITE_PANOSE panose;
+    FONTSIGNATURE fontsig;
+    UINT32 flags;
+    DWRITE_FONT_METRICS1 metrics;
+    float axis[3];
+    LOGFONTW lf;
+    UINT32 family_names_count;
+    UINT32 names_count;
+    /* Locale and string pairs, family names followed by face names. */
+    WCHAR strings[1];
+};
+
+static HKEY open_font_data_cache_key(void)
+{
+    HKEY hkey;
+
+    if (RegCreateKeyExW(HKEY_CURRENT_USER, L"Software\\Wine\\Fonts\\DirectWrite", 0, NULL, REG_OPTION_VOLATILE,
+            KEY_ALL_ACCESS, NULL, &hkey, NULL))
+        return NULL;
+
+    return hkey;
+}
+
+static WCHAR *get_font_data_cache_name(IDWriteFontFile *file, unsigned int face_index,
+        DWRITE_FONT_FAMILY_MODEL family_model, FILETIME *writetime)
+{
+    IDWriteLocalFontFileLoader *local_loader = (IDWriteLocalFontFileLoader *)get_local_fontfile_loader();
+    IDWriteFontFileLoader *loader;
+    UINT32 key_size, length;
+    const void *key;
+    WCHAR *name;
+    int len;
+
+    if (FAILED(IDWriteFontFile_GetLoader(file, &loader)))
+        return NULL;
+    IDWriteFontFileLoader_Release(loader);
+    if (loader != (IDWriteFontFileLoader *)local_loader)
+        return NULL;
+
+    if (FAILED(IDWriteFontFile_GetReferenceKey(file, &key, &key_size)))
+        return NULL;
+    if (FAILED(IDWriteLocalFontFileLoader_GetFilePathLengthFromKey(local_loader, key, key_size, &length)))
+        return NULL;
+    if (FAILED(IDWriteLocalFontFileLoader_GetLastWriteTimeFromKey(local_loader, key, key_size, writetime)))
+        return NULL;
+
+    if (!(name = malloc((length + 24) * sizeof(*name))))
+        return NULL;
+    len = swprintf(name, length + 24, L"%u,%u,", face_index, family_model);
+    if (FAILED(IDWriteLocalFontFileLoader_GetFilePathFromKey(local_loader, key, key_size, name + len, length + 1)))
+    {
+        free(name);
+        return NULL;
+    }
+
+    return name;
+}
+
+static const WCHAR *cached_font_data_get_string(const WCHAR **ptr, const WCHAR *end)
+{
+    const WCHAR *str = *ptr;
+
+    while (*ptr < end && **ptr) (*ptr)++;
+    if (*ptr == end) return NULL;
+    (*ptr)++;
+    return str;
+}
+
+static HRESULT cached_font_data_get_strings(const WCHAR **ptr, const WCHAR *end, UINT32 count,
+        IDWriteLocalizedStrings **ret)
+{
+    const WCHAR *locale, *string;
+    HRESULT hr;
+
+    if (FAILED(hr = create_localizedstrings(ret)))
+        return hr;
+
+    while (count--)
+    {
+        if (!(locale = cached_font_data_get_string(ptr, end)) || !(string = cached_font_data_get_string(ptr, end)))
+            return E_FAIL;
+        if (FAILED(hr = add_localizedstring(*ret, locale, string)))
+            return hr;
+    }
+
+    return S_OK;
+}
+
+static HRESULT init_font_data_from_cache(HKEY hkey, const WCHAR *name, const FILETIME *writetime,
+        const struct fontface_desc *desc, struct dwrite_font_data **ret)
+{
+    struct cached_font_data *cached;
+    struct dwrite_font_data *data;
+    const WCHAR *ptr, *end;
+    DWORD type, size;
+    HRESULT hr;
+
+    *ret = NULL;
+
+    if (RegQueryValueExW(hkey, name, NULL, &type, NULL, &size) || type != REG_BINARY
+            || size < offsetof(struct cached_font_data, strings))
+        return E_FAIL;
+
+    if (!(cached = malloc(size)))
+        return E_OUTOFMEMORY;
+
+    if (RegQueryValueExW(hkey, name, NULL, &type, (BYTE *)cached, &size) || type != REG_BINARY
+            || size < offsetof(struct cached_font_data, strings)
+            || CompareFileTime(&cached->writetime, writetime))
+    {
+        free(cached);
+        return E_FAIL;
+    }
+
+    if (!(data = calloc(1, sizeof(*data))))
+    {
+        free(cached);
+        return E_OUTOFMEMORY;
+    }
+
+    data->refcount = 1;
+    data->file = desc->file;
+    data->face_index = desc->index;
+    data->face_type = desc->face_type;
+    IDWriteFontFile_AddRef(data->file);
+
+    data->style = cached->style;
+    data->stretch = cached->stretch;
+    data->weight = cached->weight;
+    data->panose = cached->panose;
+    data->fontsig = cached->fontsig;
+    data->flags = cached->flags;
+    data->metrics = cached->metrics;
+    data->lf = cached->lf;
+    data->lf.lfFaceName[LF_FACESIZE - 1] = 0;
+
+    ptr = cached->strings;
+    end = (const WCHAR *)((const BYTE *)cached + size);
+    if (FAILED(hr = cached_font_data_get_strings(&ptr, end, cached->family_names_count, &data->family_names))
+            || FAILED(hr = cached_font_data_get_strings(&ptr, end, cached->names_count, &data->names)))
+    {
+        free(cached);
+        release_font_data(data);
+        return hr;
+    }
+
+    init_font_prop_vec(data->weight, data->stretch, data->style, &data->propvec);
+
+    data->axis[0].axisTag = DWRITE_FONT_AXIS_TAG_WEIGHT;
+    data->axis[0].value = cached->axis[0];
+    data->axis[1].axisTag = DWRITE_FONT_AXIS_TAG_WIDTH;
+    data->axis[1].value = cached->axis[1];
+    data->axis[2].axisTag = DWRITE_FONT_AXIS_TAG_ITALIC;
+    data->axis[2].value = cached->axis[2];
+
+    free(cached);
+
+    *ret = data;
+    return S_OK;
+}
+
+static size_t cached_font_data_strings_size(IDWriteLocalizedStrings *strings)
+{
+    UINT32 i, count = IDWriteLocalizedStrings_GetCount(strings), length;
+    size_t size = 0;
+
+    for (i = 0; i < count; ++i)
+    {
+        if (FAILED(IDWriteLocalizedStrings_GetLocaleNameLength(strings, i, &length))) return 0;
+        size += length + 1;
+        if (FAILED(IDWriteLocalizedStrings_GetStringLength(strings, i, &length))) return 0;
+        size += length + 1;
+    }
+
+    return size;
+}
+
+static void cached_font_data_put_strings(WCHAR **ptr, IDWriteLocalizedStrings *strings)
+{
+    UINT32 i, count = IDWriteLocalizedStrings_GetCount(strings), length;
+
+    for (i = 0; i < count; ++i)
+    {
+        IDWriteLocalizedStrings_GetLocaleNameLength(strings, i, &length);
+        IDWriteLocalizedStrings_GetLocaleName(strings, i, *ptr, length + 1);
+        *ptr += length + 1;
+        IDWriteLocalizedStrings_GetStringLength(strings, i, &length);
+        IDWriteLocalizedStrings_GetString(strings, i, *ptr, length + 1);
+        *ptr += length + 1;
+    }
+}
+
+static void font_data_cache_store(HKEY hkey, const WCHAR *name, const FILETIME *writetime,
+        const struct dwrite_font_data *data)
+{
+    struct cached_font_data *cached;
+    size_t family_size, names_size, size;
+    WCHAR *ptr;
+
+    if (!data->names)
+        return;
+
+    family_size = cached_font_data_strings_size(data->family_names);
+    names_size = cached_font_data_strings_size(data->names);
+    if (!family_size || !names_size)
+        return;
+
+    size = offsetof(struct cached_font_data, strings[family_size + names_size]);
+    if (!(cached = calloc(1, size)))
+        return;
+
+    cached->writetime = *writetime;
+    cached->style = data->style;
+    cached->stretch = data->stretch;
+    cached->weight = data->weight;
+    cached->panose = data->panose;
+    cached->fontsig = data->fontsig;
+    cached->flags = data->flags;
+    cached->metrics = data->metrics;
+    cached->axis[0] = data->axis[0].value;
+    cached->axis[1] = data->axis[1].value;
+    cached->axis[2] = data->axis[2].value;
+    cached->lf = data->lf;
+    cached->family_names_count = IDWriteLocalizedStrings_GetCount(data->family_names);
+    cached->names_count = IDWriteLocalizedStrings_GetCount(data->names);
+
+    ptr = cached->strings;
+    cached_font_data_put_strings(&ptr, data->family_names);
+    cached_font_data_put_strings(&ptr, data->names);
+
+    RegSetValueExW(hkey, name, 0, REG_BINARY, (const BYTE *)cached, size);
+    free(cached);
+}
+
+static HRESULT collection_add_font_entry(struct dwrite_fontcollection *collection, struct fontface_desc *desc,
+        HKEY cache_key)
+{
+    struct dwrite_font_data *font_data;
+    FILETIME writetime;
+    WCHAR *name = NULL;
+    HRESULT hr;
+
+    if (cache_key && (name = get_font_data_cache_name(desc->file, desc->index, collection->family_model, &writetime)))
+    {
+        if (SUCCEEDED(init_font_data_from_cache(cache_key, name, &writetime, desc, &font_data)))
+        {
+            free(name);
+            return collection_add_font_data(collection, font_data);
+        }
+    }
+
+    if (FAILED(hr = get_filestream_from_file(desc->file, &desc->stream)))
+    {
+        WARN("Failed to get file stream.\n");
+        free(name);
+        return S_OK;
+    }
+
+    if (SUCCEEDED(hr = init_font_data(desc, collection->family_model, &font_data)))
+    {
+        if (name)
+            font_data_cache_store(cache_key, name, &writetime, font_data);
+        hr = collection_add_font_data(collection, font_data);
+    }
+
+    IDWriteFontFileStream_Release(desc->stream);
+    free(name);
+
+    return hr;
+}
+
 HRESULT create_font_collection_from_set(IDWriteFactory7 *factory, IDWriteFontSet *fontset,
         DWRITE_FONT_FAMILY_MODEL family_model, REFGUID riid, void **ret)
 {
     struct dwrite_fontset *set = unsafe_impl_from_IDWriteFontSet(fontset);
     struct dwrite_fontcollection *collection;
+    HKEY cache_key = NULL;
     HRESULT hr = S_OK;
     size_t i;
 
@@ -4805,35 +5081,32 @@ HRESULT create_font_collection_from_set(IDWriteFactory7 *factory, IDWriteFontSet
 
     init_font_collection(collection, factory, family_model);
 
+    if (set->is_system)
+        cache_key = open_font_data_cache_key();
+
     collection->set.count = set->count;
     for (i = 0; i < set->count; ++i)
     {
         const struct dwrite_fontset_entry *entry = set->entries[i];
-        IDWriteFontFileStream *stream;
         struct fontface_desc desc;
 
         collection->set.entries[i] = addref_fontset_entry(set->entries[i]);
 
-        if (FAILED(get_filestream_from_file(entry->file, &stream)))
-        {
-            WARN("Failed to get file stream.\n");
-            continue;
-        }
-
         desc.factory = factory;
         desc.face_type = entry->face_type;
         desc.file = entry->file;
-        desc.stream = stream;
+        desc.stream = NULL;
         desc.index = entry->face_index;
         desc.simulations = entry->simulations;
         desc.font_data = NULL;
 
-        if (FAILED(hr = collection_add_font_entry(collection, &desc)))
+        if (FAILED(hr = collection_add_font_entry(collection, &desc, cache_key)))
             WARN("Failed to add font collection element, hr %#lx.\n", hr);
-
-        IDWriteFontFileStream_Release(stream);
     }
 
+    if (cache_key)
+        RegCloseKey(cache_key);
+
     if (family_model == DWRITE_FONT_FAMILY_MODEL_WEIGHT_STRETCH_STYLE)
     {
         for (i = 0; i < collection->count; ++i)
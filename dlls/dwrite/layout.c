@@ -3083,6 +3083,21 @@ static inline HRESULT return_range(const struct layout_range_header *h, DWRITE_T
     return S_OK;
 }
 
+/* Underline, strikethrough and drawing effect ranges are only used to split effective runs
+   when lines are formed, so changing them does not require reshaping. */
+static USHORT get_layout_range_attr_recompute(enum layout_range_attr_kind attr)
+{
+    switch (attr)
+    {
+    case LAYOUT_RANGE_ATTR_UNDERLINE:
+    case LAYOUT_RANGE_ATTR_STRIKETHROUGH:
+    case LAYOUT_RANGE_ATTR_EFFECT:
+        return RECOMPUTE_LINES_AND_OVERHANGS;
+    default:
+        return RECOMPUTE_EVERYTHING;
+    }
+}
+
 /* Sets attribute value for given range, does all needed splitting/merging of existing ranges. */
 static HRESULT set_layout_range_attr(struct dwrite_textlayout *layout, enum layout_range_attr_kind attr, struct layout_range_attr_value *value)
 {
@@ -3190,7 +3205,7 @@ static HRESULT set_layout_range_attr(struct dwrite_textlayout *layout, enum layo
         list_add_after(&outer->entry, &cur->entry);
         list_add_after(&cur->entry, &right->entry);
 
-        layout->recompute = RECOMPUTE_EVERYTHING;
+        layout->recompute |= get_layout_range_attr_recompute(attr);
         return S_OK;
     }
 
@@ -3230,7 +3245,7 @@ done:
     if (changed) {
         struct list *next, *i;
 
-        layout->recompute = RECOMPUTE_EVERYTHING;
+        layout->recompute |= get_layout_range_attr_recompute(attr);
         i = list_head(ranges);
         while ((next = list_next(ranges, i))) {
             struct layout_range_header *next_range = LIST_ENTRY(next, struct layout_range_header, entry);
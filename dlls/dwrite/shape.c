@@ -49,6 +49,9 @@ struct scriptshaping_cache *create_scriptshaping_cache(void *context, const stru
 
     cache->font = font_ops;
     cache->context = context;
+    list_init(&cache->runs.mru);
+    InitializeCriticalSectionEx(&cache->runs.cs, 0, RTL_CRITICAL_SECTION_FLAG_FORCE_DEBUG_INFO);
+    cache->runs.cs.DebugInfo->Spare[0] = (DWORD_PTR)(__FILE__ ": shaping_cache.runs");
 
     opentype_layout_scriptshaping_cache_init(cache);
     cache->upem = cache->font->get_font_upem(cache->context);
@@ -56,11 +59,39 @@ struct scriptshaping_cache *create_scriptshaping_cache(void *context, const stru
     return cache;
 }
 
+struct shaped_run
+{
+    struct list entry;
+    size_t size;
+    unsigned int hash;
+    unsigned int script;
+    UINT32 language_tag;
+    BOOL is_rtl;
+    BOOL is_sideways;
+    unsigned int length;
+    unsigned int glyph_count;
+    WCHAR *text;
+    UINT16 *clustermap;
+    DWRITE_SHAPING_TEXT_PROPERTIES *text_props;
+    UINT16 *glyphs;
+    DWRITE_SHAPING_GLYPH_PROPERTIES *glyph_props;
+};
+
 void release_scriptshaping_cache(struct scriptshaping_cache *cache)
 {
+    struct shaped_run *run, *run2;
+
     if (!cache)
         return;
 
+    TRACE("%p: %u shaped run hits, %u misses, %u runs, %Iu bytes.\n", cache, cache->runs.hits,
+            cache->runs.misses, cache->runs.count, cache->runs.size);
+
+    LIST_FOR_EACH_ENTRY_SAFE(run, run2, &cache->runs.mru, struct shaped_run, entry)
+        free(run);
+    cache->runs.cs.DebugInfo->Spare[0] = 0;
+    DeleteCriticalSection(&cache->runs.cs);
+
     cache->font->release_font_table(cache->context, cache->gdef.table.context);
     cache->font->release_font_table(cache->context, cache->gsub.table.context);
     cache->font->release_font_table(cache->context, cache->gpos.table.context);
@@ -366,6 +397,124 @@ HRESULT shape_get_glyphs(struct scriptshaping_context *context, const unsigned i
     return (context->glyph_count <= context->u.subst.max_glyph_count) ? S_OK : E_NOT_SUFFICIENT_BUFFER;
 }
 
+/* Shaped runs cache. Results only depend on the font, the text and the parameters compared
+   below, callers are responsible for not caching runs shaped with user features or number
+   substitution. */
+#define SHAPED_RUNS_MAX_COUNT 256
+#define SHAPED_RUNS_MAX_SIZE 0x40000
+
+static unsigned int shape_get_run_hash(const struct scriptshaping_context *context)
+{
+    unsigned int i, hash = 2166136261u;
+
+    for (i = 0; i < context->length; ++i)
+        hash = (hash ^ context->text[i]) * 16777619u;
+    hash = (hash ^ context->script) * 16777619u;
+    hash = (hash ^ context->language_tag) * 16777619u;
+    return hash ^ (!!context->is_rtl << 1) ^ !!context->is_sideways;
+}
+
+static BOOL shape_run_matches(const struct shaped_run *run, const struct scriptshaping_context *context,
+        unsigned int hash)
+{
+    return run->hash == hash && run->length == context->length && run->script == context->script
+            && run->language_tag == context->language_tag && run->is_rtl == !!context->is_rtl
+            && run->is_sideways == !!context->is_sideways
+            && !memcmp(run->text, context->text, run->length * sizeof(*run->text));
+}
+
+BOOL shape_get_cached_glyphs(struct scriptshaping_context *context, UINT16 *glyphs,
+        DWRITE_SHAPING_GLYPH_PROPERTIES *glyph_props)
+{
+    struct scriptshaping_cache *cache = context->cache;
+    unsigned int hash = shape_get_run_hash(context);
+    struct shaped_run *run;
+    BOOL found = FALSE;
+
+    EnterCriticalSection(&cache->runs.cs);
+
+    LIST_FOR_EACH_ENTRY(run, &cache->runs.mru, struct shaped_run, entry)
+    {
+        if (!shape_run_matches(run, context, hash)) continue;
+
+        /* Let the shaper report insufficient buffer. */
+        if (run->glyph_count > context->u.subst.max_glyph_count) break;
+
+        memcpy(context->u.subst.clustermap, run->clustermap, run->length * sizeof(*run->clustermap));
+        memcpy(context->u.subst.text_props, run->text_props, run->length * sizeof(*run->text_props));
+        memcpy(glyphs, run->glyphs, run->glyph_count * sizeof(*run->glyphs));
+        memcpy(glyph_props, run->glyph_props, run->glyph_count * sizeof(*run->glyph_props));
+        context->glyph_count = run->glyph_count;
+
+        list_remove(&run->entry);
+        list_add_head(&cache->runs.mru, &run->entry);
+        found = TRUE;
+        break;
+    }
+
+    if (found)
+        cache->runs.hits++;
+    else
+        cache->runs.misses++;
+
+    LeaveCriticalSection(&cache->runs.cs);
+
+    return found;
+}
+
+void shape_cache_glyphs(struct scriptshaping_context *context, const UINT16 *glyphs,
+        const DWRITE_SHAPING_GLYPH_PROPERTIES *glyph_props)
+{
+    struct scriptshaping_cache *cache = context->cache;
+    struct shaped_run *run, *old;
+    size_t size;
+
+    size = sizeof(*run) + context->length * (sizeof(*run->text) + sizeof(*run->clustermap) + sizeof(*run->text_props))
+            + context->glyph_count * (sizeof(*run->glyphs) + sizeof(*run->glyph_props));
+    if (size > SHAPED_RUNS_MAX_SIZE / 16)
+        return;
+
+    if (!(run = malloc(size)))
+        return;
+
+    run->size = size;
+    run->hash = shape_get_run_hash(context);
+    run->script = context->script;
+    run->language_tag = context->language_tag;
+    run->is_rtl = !!context->is_rtl;
+    run->is_sideways = !!context->is_sideways;
+    run->length = context->length;
+    run->glyph_count = context->glyph_count;
+    run->text = (WCHAR *)(run + 1);
+    run->clustermap = (UINT16 *)(run->text + run->length);
+    run->text_props = (DWRITE_SHAPING_TEXT_PROPERTIES *)(run->clustermap + run->length);
+    run->glyphs = (UINT16 *)(run->text_props + run->length);
+    run->glyph_props = (DWRITE_SHAPING_GLYPH_PROPERTIES *)(run->glyphs + run->glyph_count);
+    memcpy(run->text, context->text, run->length * sizeof(*run->text));
+    memcpy(run->clustermap, context->u.subst.clustermap, run->length * sizeof(*run->clustermap));
+    memcpy(run->text_props, context->u.subst.text_props, run->length * sizeof(*run->text_props));
+    memcpy(run->glyphs, glyphs, run->glyph_count * sizeof(*run->glyphs));
+    memcpy(run->glyph_props, glyph_props, run->glyph_count * sizeof(*run->glyph_props));
+
+    EnterCriticalSection(&cache->runs.cs);
+
+    while (!list_empty(&cache->runs.mru) && (cache->runs.count >= SHAPED_RUNS_MAX_COUNT
+            || cache->runs.size + size > SHAPED_RUNS_MAX_SIZE))
+    {
+        old = LIST_ENTRY(list_tail(&cache->runs.mru), struct shaped_run, entry);
+        list_remove(&old->entry);
+        cache->runs.size -= old->size;
+        cache->runs.count--;
+        free(old);
+    }
+
+    list_add_head(&cache->runs.mru, &run->entry);
+    cache->runs.size += size;
+    cache->runs.count++;
+
+    LeaveCriticalSection(&cache->runs.cs);
+}
+
 static int __cdecl tag_array_sorting_compare(const void *a, const void *b)
 {
     unsigned int left = GET_BE_DWORD(*(unsigned int *)a), right = GET_BE_DWORD(*(unsigned int *)b);
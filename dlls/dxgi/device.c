@@ -462,7 +462,8 @@ static HRESULT STDMETHODCALLTYPE dxgi_swapchain_factory_create_swapchain(IWineDX
         return E_OUTOFMEMORY;
     }
 
-    if (FAILED(hr = d3d11_swapchain_init(object, device, &wined3d_desc)))
+    if (FAILED(hr = d3d11_swapchain_init(object, device, &wined3d_desc,
+            !!(desc->Flags & DXGI_SWAP_CHAIN_FLAG_FRAME_LATENCY_WAITABLE_OBJECT))))
     {
         WARN("Failed to initialise swapchain, hr %#lx.\n", hr);
         free(object);
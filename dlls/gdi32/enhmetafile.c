@@ -768,6 +768,98 @@ static BOOL emr_produces_output(int type)
     }
 }
 
+/******************************************************************
+ *       emr_can_be_culled
+ *
+ * Returns TRUE if the record only draws inside its rclBounds, which
+ * immediately follow the record header, and has no other side effect.
+ * Lines are not included since wide pens may draw outside of the bounds.
+ */
+static BOOL emr_can_be_culled(int type)
+{
+    switch(type) {
+    case EMR_FILLRGN:
+    case EMR_BITBLT:
+    case EMR_STRETCHBLT:
+    case EMR_STRETCHDIBITS:
+    case EMR_ALPHABLEND:
+        return TRUE;
+    default:
+        return FALSE;
+    }
+}
+
+/******************************************************************
+ *       emr_is_culled
+ *
+ * Returns TRUE if the record bounds, transformed to device space,
+ * are entirely outside of the clip box.
+ */
+static BOOL emr_is_culled(const ENHMETARECORD *emr, const ENHMETAHEADER *emh,
+                          const XFORM *xform, const RECT *clip)
+{
+    const RECTL *bounds = (const RECTL *)emr->dParm;
+    double x, y, left, top, right, bottom;
+    int i;
+
+    if (emr->nSize < sizeof(EMR) + sizeof(RECTL)) return FALSE;
+    /* don't trust bounds that are outside of the header bounds */
+    if (bounds->left > bounds->right || bounds->top > bounds->bottom) return FALSE;
+    if (bounds->left < emh->rclBounds.left || bounds->right > emh->rclBounds.right ||
+        bounds->top < emh->rclBounds.top || bounds->bottom > emh->rclBounds.bottom)
+        return FALSE;
+
+    left = top = 1e300;
+    right = bottom = -1e300;
+    for (i = 0; i < 4; i++)
+    {
+        double px = (i & 1) ? bounds->right + 1 : bounds->left;
+        double py = (i & 2) ? bounds->bottom + 1 : bounds->top;
+        x = px * xform->eM11 + py * xform->eM21 + xform->eDx;
+        y = px * xform->eM12 + py * xform->eM22 + xform->eDy;
+        left = min( left, x );
+        right = max( right, x );
+        top = min( top, y );
+        bottom = max( bottom, y );
+    }
+    /* leave a margin for rounding */
+    return (right + 2 < clip->left || left - 2 > clip->right ||
+            bottom + 2 < clip->top || top - 2 > clip->bottom);
+}
+
+/* get the clip box of the DC in device coordinates */
+static BOOL get_device_clip_box(HDC hdc, RECT *rect)
+{
+    POINT pts[4];
+    RECT box;
+    int i;
+
+    switch (GetClipBox( hdc, &box ))
+    {
+    case SIMPLEREGION:
+    case COMPLEXREGION:
+        break;
+    default:
+        return FALSE;
+    }
+    pts[0].x = pts[2].x = box.left;
+    pts[1].x = pts[3].x = box.right;
+    pts[0].y = pts[1].y = box.top;
+    pts[2].y = pts[3].y = box.bottom;
+    if (!LPtoDP( hdc, pts, 4 )) return FALSE;
+
+    rect->left = rect->right = pts[0].x;
+    rect->top = rect->bottom = pts[0].y;
+    for (i = 1; i < 4; i++)
+    {
+        rect->left = min( rect->left, pts[i].x );
+        rect->right = max( rect->right, pts[i].x );
+        rect->top = min( rect->top, pts[i].y );
+        rect->bottom = max( rect->bottom, pts[i].y );
+    }
+    return TRUE;
+}
+
 static HGDIOBJ get_object_handle(HANDLETABLE *handletable, UINT handles, DWORD i)
 {
     if (i & 0x80000000)
@@ -2349,6 +2441,10 @@ BOOL WINAPI PlayEnhMetaFileRecord(
 }
 
 
+static INT CALLBACK EMF_PlayEnhMetaFileCallback(HDC hdc, HANDLETABLE *ht,
+						const ENHMETARECORD *emr,
+						INT handles, LPARAM data);
+
 /*****************************************************************************
  *
  *        EnumEnhMetaFile  (GDI32.@)
@@ -2408,6 +2504,8 @@ BOOL WINAPI EnumEnhMetaFile(
     POINT vp_org, win_org;
     INT mapMode = MM_TEXT, old_align = 0, old_rop2 = 0, old_arcdir = 0, old_polyfill = 0, old_stretchblt = 0;
     COLORREF old_text_color = 0, old_bk_color = 0;
+    BOOL cull = FALSE, in_path = FALSE;
+    RECT clip_box = {0};
 
     if(!lpRect && hdc)
     {
@@ -2524,6 +2622,10 @@ BOOL WINAPI EnumEnhMetaFile(
             CombineTransform(&info->init_transform, &xform, &info->init_transform);
         }
 
+        /* when playing, records that are entirely clipped out can be skipped */
+        if (!IS_WIN9X() && callback == EMF_PlayEnhMetaFileCallback)
+            cull = get_device_clip_box( hdc, &clip_box );
+
         /* WinNT resets the current vp/win org/ext */
         if (!IS_WIN9X())
         {
@@ -2548,6 +2650,34 @@ BOOL WINAPI EnumEnhMetaFile(
             break;
         }
 
+        if (cull)
+        {
+            switch (emr->iType)
+            {
+            case EMR_BEGINPATH:
+                in_path = TRUE;
+                break;
+            case EMR_ENDPATH:
+            case EMR_ABORTPATH:
+                in_path = FALSE;
+                break;
+            case EMR_EXTSELECTCLIPRGN:
+            case EMR_SELECTCLIPPATH:
+                /* the clip region may get larger than the initial one */
+                cull = FALSE;
+                break;
+            default:
+                if (!in_path && emr_can_be_culled( emr->iType ) &&
+                    emr_is_culled( emr, emh, &info->init_transform, &clip_box ))
+                {
+                    TRACE("Skipping clipped record %s\n", get_emr_name(emr->iType));
+                    offset += emr->nSize;
+                    continue;
+                }
+                break;
+            }
+        }
+
         /* In Win9x mode we update the xform if the record will produce output */
         if (hdc && IS_WIN9X() && emr_produces_output(emr->iType))
             EMF_Update_MF_Xform(hdc, info);
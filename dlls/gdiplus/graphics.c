@@ -519,6 +519,40 @@ static GpStatus alpha_blend_bmp_pixels(GpGraphics *graphics, INT dst_x, INT dst_
     INT x, y;
     CompositingMode comp_mode = graphics->compmode;
 
+    if (dst_bitmap->format == PixelFormat32bppARGB)
+    {
+        /* Access the bits directly, GdipBitmapGetPixel() and GdipBitmapSetPixel()
+         * don't convert anything for this format. */
+        INT x0 = max(0, -dst_x), x1 = min(src_width, dst_bitmap->width - dst_x);
+        INT y0 = max(0, -dst_y), y1 = min(src_height, dst_bitmap->height - dst_y);
+
+        for (y=y0; y<y1; y++)
+        {
+            const ARGB *src_row = (const ARGB*)(src + src_stride * y);
+            ARGB *dst_row = (ARGB*)(dst_bitmap->bits + dst_bitmap->stride * (y + dst_y)) + dst_x;
+
+            if (comp_mode == CompositingModeSourceCopy)
+            {
+                for (x=x0; x<x1; x++)
+                    dst_row[x] = (src_row[x] & 0xff000000) ? src_row[x] : 0;
+            }
+            else if (fmt & PixelFormatPAlpha)
+            {
+                for (x=x0; x<x1; x++)
+                    if (src_row[x] & 0xff000000)
+                        dst_row[x] = color_over_fgpremult(dst_row[x], src_row[x]);
+            }
+            else
+            {
+                for (x=x0; x<x1; x++)
+                    if (src_row[x] & 0xff000000)
+                        dst_row[x] = color_over(dst_row[x], src_row[x]);
+            }
+        }
+
+        return Ok;
+    }
+
     for (y=0; y<src_height; y++)
     {
         for (x=0; x<src_width; x++)
@@ -1179,14 +1213,30 @@ static ARGB resample_bitmap_pixel(GDIPCONST GpRect *src_rect, LPBYTE bits, UINT
             return sample_bitmap_pixel(src_rect, bits, width, height,
                 leftx, topy, attributes);
 
-        topleft = sample_bitmap_pixel(src_rect, bits, width, height,
-            leftx, topy, attributes);
-        topright = sample_bitmap_pixel(src_rect, bits, width, height,
-            rightx, topy, attributes);
-        bottomleft = sample_bitmap_pixel(src_rect, bits, width, height,
-            leftx, bottomy, attributes);
-        bottomright = sample_bitmap_pixel(src_rect, bits, width, height,
-            rightx, bottomy, attributes);
+        if (leftx >= src_rect->X && topy >= src_rect->Y && leftx >= 0 && topy >= 0 &&
+            rightx < src_rect->X + src_rect->Width && bottomy < src_rect->Y + src_rect->Height &&
+            (UINT)rightx < width && (UINT)bottomy < height)
+        {
+            /* No wrapping needed, read the pixels directly. */
+            const ARGB *row = (const ARGB*)bits + (leftx - src_rect->X) + (topy - src_rect->Y) * src_rect->Width;
+
+            topleft = row[0];
+            topright = row[rightx - leftx];
+            row += (bottomy - topy) * src_rect->Width;
+            bottomleft = row[0];
+            bottomright = row[rightx - leftx];
+        }
+        else
+        {
+            topleft = sample_bitmap_pixel(src_rect, bits, width, height,
+                leftx, topy, attributes);
+            topright = sample_bitmap_pixel(src_rect, bits, width, height,
+                rightx, topy, attributes);
+            bottomleft = sample_bitmap_pixel(src_rect, bits, width, height,
+                leftx, bottomy, attributes);
+            bottomright = sample_bitmap_pixel(src_rect, bits, width, height,
+                rightx, bottomy, attributes);
+        }
 
         x_offset = point->X - leftxf;
         top = blend_colors(topleft, topright, x_offset);
@@ -1126,6 +1126,45 @@ static int cmp_edges(const void *a, const void *b)
     return (edge1->x > edge2->x) - (edge1->x < edge2->x);
 }
 
+/* Merge consecutive rows with identical spans, so that ExtCreateRegion() has
+ * fewer rectangles to add. The resulting region is the same. */
+static INT coalesce_scans(RECT *scans, INT count)
+{
+    INT i = 0, j, row_start, row_count, prev_start = -1, prev_count = 0, out = 0;
+
+    while (i < count)
+    {
+        row_start = i;
+        while (i < count && scans[i].top == scans[row_start].top)
+            i++;
+        row_count = i - row_start;
+
+        if (prev_start >= 0 && prev_count == row_count && scans[prev_start].bottom == scans[row_start].top)
+        {
+            for (j = 0; j < row_count; j++)
+            {
+                if (scans[prev_start + j].left != scans[row_start + j].left ||
+                    scans[prev_start + j].right != scans[row_start + j].right)
+                    break;
+            }
+
+            if (j == row_count)
+            {
+                for (j = 0; j < row_count; j++)
+                    scans[prev_start + j].bottom = scans[row_start + j].bottom;
+                continue;
+            }
+        }
+
+        memmove(&scans[out], &scans[row_start], row_count * sizeof(*scans));
+        prev_start = out;
+        prev_count = row_count;
+        out += row_count;
+    }
+
+    return out;
+}
+
 static GpStatus edge_list_to_rgndata(struct edge_list *edges, FillMode fill_mode, RGNDATA **rgndata)
 {
     int i, start_x = 0, winding_count = 0;
@@ -1177,6 +1216,8 @@ static GpStatus edge_list_to_rgndata(struct edge_list *edges, FillMode fill_mode
         }
     }
 
+    scan_count = coalesce_scans(scans, scan_count);
+
     (*rgndata)->rdh.dwSize = sizeof(RGNDATAHEADER);
     (*rgndata)->rdh.iType = RDH_RECTANGLES;
     (*rgndata)->rdh.nCount = scan_count;
@@ -449,7 +449,13 @@ static HRESULT compile_member_expression(compiler_ctx_t *ctx, member_expression_
     if(FAILED(hres))
         return hres;
 
-    return push_instr_bstr(ctx, OP_member, expr->identifier);
+    hres = push_instr_bstr(ctx, OP_member, expr->identifier);
+    if(FAILED(hres))
+        return hres;
+
+    /* DISPID hint, see interp_member */
+    instr_ptr(ctx, ctx->code_off - 1)->u.arg[1].uint = 0;
+    return S_OK;
 }
 
 #define LABEL_FLAG 0x80000000
@@ -2774,3 +2780,55 @@ HRESULT compile_script(script_ctx_t *ctx, const WCHAR *code, UINT64 source_conte
     *ret = compiler.code;
     return S_OK;
 }
+
+/*
+ * Code compiled for eval() and expression evaluation doesn't get linked into
+ * any script list, so it may be shared by repeated calls with the same
+ * source. Conditional compilation state may change the meaning of the source,
+ * so caching is disabled once it's enabled.
+ */
+HRESULT compile_eval_code(script_ctx_t *ctx, const WCHAR *code, UINT64 source_context, unsigned start_line,
+                          BOOL use_decode, named_item_t *named_item, bytecode_t **ret)
+{
+    bytecode_t *iter;
+    unsigned i;
+    HRESULT hres;
+
+    if(use_decode || ctx->cc)
+        return compile_script(ctx, code, source_context, start_line, NULL, NULL, TRUE, use_decode, named_item, ret);
+
+    if(!code)
+        code = L"";
+
+    for(i = 0; i < ARRAY_SIZE(ctx->eval_cache); i++) {
+        iter = ctx->eval_cache[i];
+        if(iter && iter->named_item == named_item && iter->source_context == source_context
+           && iter->start_line == start_line && !wcscmp(iter->source, code)) {
+            TRACE("using cached code %p\n", iter);
+            *ret = bytecode_addref(iter);
+            return S_OK;
+        }
+    }
+
+    hres = compile_script(ctx, code, source_context, start_line, NULL, NULL, TRUE, FALSE, named_item, ret);
+    if(FAILED(hres) || ctx->cc)
+        return hres;
+
+    i = ctx->eval_cache_next++ % ARRAY_SIZE(ctx->eval_cache);
+    if(ctx->eval_cache[i])
+        release_bytecode(ctx->eval_cache[i]);
+    ctx->eval_cache[i] = bytecode_addref(*ret);
+    return S_OK;
+}
+
+void release_eval_cache(script_ctx_t *ctx)
+{
+    unsigned i;
+
+    for(i = 0; i < ARRAY_SIZE(ctx->eval_cache); i++) {
+        if(ctx->eval_cache[i]) {
+            release_bytecode(ctx->eval_cache[i]);
+            ctx->eval_cache[i] = NULL;
+        }
+    }
+}
@@ -2593,6 +2593,24 @@ HRESULT jsdisp_get_id(jsdisp_t *jsdisp, const WCHAR *name, DWORD flags, DISPID *
     return DISP_E_UNKNOWNNAME;
 }
 
+/* Same as jsdisp_get_id without flags, but *id holds a DISPID returned for the same name
+ * earlier, possibly for another object.  Objects built the same way share property
+ * layouts, so this usually avoids hashing and looking up the name. */
+HRESULT jsdisp_get_id_hint(jsdisp_t *jsdisp, const WCHAR *name, DISPID *id)
+{
+    DWORD idx = *id - 1;
+
+    if(idx < jsdisp->prop_cnt) {
+        dispex_prop_t *prop = &jsdisp->props[idx];
+
+        if(prop->type != PROP_DELETED && prop->type != PROP_PROTREF && prop->type != PROP_EXTERN
+           && !wcscmp(prop->name, name))
+            return S_OK;
+    }
+
+    return jsdisp_get_id(jsdisp, name, 0, id);
+}
+
 HRESULT jsdisp_get_idx_id(jsdisp_t *jsdisp, DWORD idx, DISPID *id)
 {
     WCHAR name[11];
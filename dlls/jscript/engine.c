@@ -1444,6 +1444,8 @@ static HRESULT interp_array(script_ctx_t *ctx)
 static HRESULT interp_member(script_ctx_t *ctx)
 {
     const BSTR arg = get_op_bstr(ctx, 0);
+    instr_t *instr = &ctx->call_ctx->bytecode->instrs[ctx->call_ctx->ip];
+    jsdisp_t *jsdisp;
     IDispatch *obj;
     jsval_t v;
     DISPID id;
@@ -1455,7 +1457,15 @@ static HRESULT interp_member(script_ctx_t *ctx)
     if(FAILED(hres))
         return hres;
 
-    hres = disp_get_id(ctx, obj, arg, arg, 0, &id);
+    /* the second argument caches the DISPID found on the last execution */
+    if((jsdisp = to_jsdisp(obj))) {
+        id = instr->u.arg[1].uint;
+        hres = jsdisp_get_id_hint(jsdisp, arg, &id);
+        if(SUCCEEDED(hres))
+            instr->u.arg[1].uint = id;
+    }else {
+        hres = disp_get_id(ctx, obj, arg, arg, 0, &id);
+    }
     if(SUCCEEDED(hres)) {
         hres = disp_propget(ctx, obj, id, &v);
     }else if(hres == DISP_E_UNKNOWNNAME) {
@@ -212,6 +212,8 @@ struct _bytecode_t {
 };
 
 HRESULT compile_script(script_ctx_t*,const WCHAR*,UINT64,unsigned,const WCHAR*,const WCHAR*,BOOL,BOOL,named_item_t*,bytecode_t**);
+HRESULT compile_eval_code(script_ctx_t*,const WCHAR*,UINT64,unsigned,BOOL,named_item_t*,bytecode_t**);
+void release_eval_cache(script_ctx_t*);
 void release_bytecode(bytecode_t*);
 
 unsigned get_location_line(bytecode_t *code, unsigned loc, unsigned *char_pos);
@@ -78,6 +78,7 @@ void script_release(script_ctx_t *ctx)
         return;
 
     jsval_release(ctx->acc);
+    release_eval_cache(ctx);
     if(ctx->cc)
         release_cc(ctx->cc);
     heap_pool_free(&ctx->tmp_heap);
@@ -500,6 +501,7 @@ static void decrease_state(JScript *This, SCRIPTSTATE state)
                 This->ctx->site = NULL;
             }
 
+            release_eval_cache(This->ctx);
             script_globals_release(This->ctx);
             gc_run(This->ctx);
 
@@ -1111,8 +1113,11 @@ static HRESULT WINAPI JScriptParse_ParseScriptText(IActiveScriptParse *iface,
     }
 
     enter_script(This->ctx, &ei);
-    hres = compile_script(This->ctx, pstrCode, dwSourceContextCookie, ulStartingLine, NULL, pstrDelimiter,
-            (dwFlags & SCRIPTTEXT_ISEXPRESSION) != 0, This->is_encode, item, &code);
+    if((dwFlags & SCRIPTTEXT_ISEXPRESSION) && !pstrDelimiter)
+        hres = compile_eval_code(This->ctx, pstrCode, dwSourceContextCookie, ulStartingLine, This->is_encode, item, &code);
+    else
+        hres = compile_script(This->ctx, pstrCode, dwSourceContextCookie, ulStartingLine, NULL, pstrDelimiter,
+                (dwFlags & SCRIPTTEXT_ISEXPRESSION) != 0, This->is_encode, item, &code);
     if(FAILED(hres))
         return leave_script(This->ctx, hres);
 
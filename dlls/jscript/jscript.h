@@ -265,6 +265,7 @@ HRESULT jsdisp_propput_idx(jsdisp_t*,DWORD,jsval_t);
 HRESULT jsdisp_propget_name(jsdisp_t*,LPCWSTR,jsval_t*);
 HRESULT jsdisp_get_idx(jsdisp_t*,DWORD,jsval_t*);
 HRESULT jsdisp_get_id(jsdisp_t*,const WCHAR*,DWORD,DISPID*);
+HRESULT jsdisp_get_id_hint(jsdisp_t*,const WCHAR*,DISPID*);
 HRESULT jsdisp_get_idx_id(jsdisp_t*,DWORD,DISPID*);
 HRESULT disp_delete(IDispatch*,DISPID,BOOL*);
 HRESULT disp_delete_name(script_ctx_t*,IDispatch*,jsstr_t*,BOOL*);
@@ -383,6 +384,8 @@ struct weak_refs_entry {
     struct list list;
 };
 
+#define EVAL_CACHE_SIZE 16
+
 struct _script_ctx_t {
     LONG ref;
 
@@ -402,6 +405,9 @@ struct _script_ctx_t {
     JSCaller *jscaller;
     jsexcept_t *ei;
 
+    struct _bytecode_t *eval_cache[EVAL_CACHE_SIZE];
+    unsigned eval_cache_next;
+
     heap_pool_t tmp_heap;
 
     jsval_t *stack;
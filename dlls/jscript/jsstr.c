@@ -207,6 +207,66 @@ int jsstr_cmp(jsstr_t *str1, jsstr_t *str2)
     return ropes_cmp(jsstr_as_rope(str1), jsstr_as_rope(str2));
 }
 
+static inline unsigned jsstr_depth(jsstr_t *str)
+{
+    return jsstr_is_rope(str) ? jsstr_as_rope(str)->depth : 0;
+}
+
+static jsstr_t *jsstr_alloc_rope(jsstr_t *left, jsstr_t *right, unsigned depth)
+{
+    jsstr_rope_t *rope;
+
+    rope = malloc(sizeof(*rope));
+    if(!rope)
+        return NULL;
+
+    jsstr_init(&rope->str, jsstr_length(left)+jsstr_length(right), JSSTR_ROPE);
+    rope->left = jsstr_addref(left);
+    rope->right = jsstr_addref(right);
+    rope->depth = depth;
+    return &rope->str;
+}
+
+/*
+ * Repeated appending builds a rope whose left spine gets deeper with each
+ * concatenation. Instead of flattening the whole string when the depth limit
+ * is reached, merge the pieces at the top of the spine into a single flat
+ * string, descending as long as the next piece is not longer than what was
+ * collected so far. Pieces grow geometrically this way, so each character
+ * gets copied a logarithmic number of times and the spine stays shallow.
+ */
+static jsstr_t *jsstr_rope_merge_spine(jsstr_rope_t *str)
+{
+    jsstr_rope_t *spine[JSSTR_MAX_ROPE_DEPTH];
+    jsstr_t *base = &str->str, *tail, *ret;
+    unsigned n = 0, len = 0;
+    WCHAR *ptr;
+
+    while(jsstr_is_rope(base) && n < ARRAY_SIZE(spine)) {
+        jsstr_rope_t *rope = jsstr_as_rope(base);
+
+        if(n && jsstr_length(rope->right) > len)
+            break;
+        spine[n++] = rope;
+        len += jsstr_length(rope->right);
+        base = rope->left;
+    }
+
+    if(jsstr_depth(base) + 2 >= JSSTR_MAX_ROPE_DEPTH)
+        return NULL;
+
+    tail = jsstr_alloc_buf(len, &ptr);
+    if(!tail)
+        return NULL;
+
+    while(n--)
+        ptr += jsstr_flush(spine[n]->right, ptr);
+
+    ret = jsstr_alloc_rope(base, tail, jsstr_depth(base)+1);
+    jsstr_release(tail);
+    return ret;
+}
+
 jsstr_t *jsstr_concat(jsstr_t *str1, jsstr_t *str2)
 {
     unsigned len1, len2;
@@ -223,26 +283,29 @@ jsstr_t *jsstr_concat(jsstr_t *str1, jsstr_t *str2)
 
     if(len1 + len2 >= JSSTR_SHORT_STRING_LENGTH) {
         unsigned depth, depth2;
-        jsstr_rope_t *rope;
 
-        depth = jsstr_is_rope(str1) ? jsstr_as_rope(str1)->depth : 0;
-        depth2 = jsstr_is_rope(str2) ? jsstr_as_rope(str2)->depth : 0;
+        depth = jsstr_depth(str1);
+        depth2 = jsstr_depth(str2);
         if(depth2 > depth)
             depth = depth2;
 
-        if(depth++ < JSSTR_MAX_ROPE_DEPTH) {
-            if(len1+len2 > JSSTR_MAX_LENGTH)
-                return NULL;
+        if(len1+len2 > JSSTR_MAX_LENGTH)
+            return NULL;
+
+        if(depth++ < JSSTR_MAX_ROPE_DEPTH)
+            return jsstr_alloc_rope(str1, str2, depth);
 
-            rope = malloc(sizeof(*rope));
-            if(!rope)
-                return NULL;
+        if(jsstr_is_rope(str1) && depth2 + 2 < JSSTR_MAX_ROPE_DEPTH) {
+            jsstr_t *merged;
 
-            jsstr_init(&rope->str, len1+len2, JSSTR_ROPE);
-            rope->left = jsstr_addref(str1);
-            rope->right = jsstr_addref(str2);
-            rope->depth = depth;
-            return &rope->str;
+            if((merged = jsstr_rope_merge_spine(jsstr_as_rope(str1)))) {
+                depth = jsstr_depth(merged);
+                if(depth2 > depth)
+                    depth = depth2;
+                ret = jsstr_alloc_rope(merged, str2, depth+1);
+                jsstr_release(merged);
+                return ret;
+            }
         }
     }
 
@@ -511,8 +511,11 @@ static BOOL copy_file( const WCHAR *source, const WCHAR *dest, COPYFILE2_EXTENDE
     PCOPYFILE2_PROGRESS_ROUTINE progress = params ? params->pProgressRoutine : NULL;
 
     static const int buffer_size = 65536;
+    static const LONGLONG clone_chunk_size = 64 * 1024 * 1024;
     HANDLE h1, h2;
     FILE_BASIC_INFORMATION info;
+    FILE_STANDARD_INFORMATION std_info;
+    DUPLICATE_EXTENTS_DATA extents;
     IO_STATUS_BLOCK io;
     DWORD count;
     BOOL ret = FALSE;
@@ -587,6 +590,29 @@ static BOOL copy_file( const WCHAR *source, const WCHAR *dest, COPYFILE2_EXTENDE
         return FALSE;
     }
 
+    /* let the file system copy the data itself if it can, and fall back to reading
+     * and writing from where it stopped otherwise */
+    if (!NtQueryInformationFile( h1, &io, &std_info, sizeof(std_info), FileStandardInformation ))
+    {
+        extents.FileHandle = h1;
+        extents.SourceFileOffset.QuadPart = 0;
+        while (extents.SourceFileOffset.QuadPart < std_info.EndOfFile.QuadPart)
+        {
+            extents.TargetFileOffset = extents.SourceFileOffset;
+            extents.ByteCount.QuadPart = min( std_info.EndOfFile.QuadPart - extents.SourceFileOffset.QuadPart,
+                                              clone_chunk_size );
+            if (NtFsControlFile( h2, NULL, NULL, NULL, &io, FSCTL_DUPLICATE_EXTENTS_TO_FILE,
+                                 &extents, sizeof(extents), NULL, 0 ))
+                break;
+            extents.SourceFileOffset.QuadPart += extents.ByteCount.QuadPart;
+        }
+        if (extents.SourceFileOffset.QuadPart)
+        {
+            SetFilePointerEx( h1, extents.SourceFileOffset, NULL, FILE_BEGIN );
+            SetFilePointerEx( h2, extents.SourceFileOffset, NULL, FILE_BEGIN );
+        }
+    }
+
     while (ReadFile( h1, buffer, buffer_size, &count, NULL ) && count)
     {
         char *p = buffer;
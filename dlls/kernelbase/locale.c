@@ -3826,6 +3826,41 @@ static int get_sortkey( const struct sortguid *sortid, DWORD flags,
 }
 
 
+/* check whether characters are followed by a nonspace mark that would modify their weights */
+static BOOL next_is_nonspace_mark( const WCHAR *src, int srclen, int pos, UINT except )
+{
+    union char_weights weights;
+
+    for (; pos < srclen; pos++)
+    {
+        weights = get_char_weights( src[pos], except );
+        if (weights.script != SCRIPT_UNSORTABLE) return weights.script == SCRIPT_NONSPACE_MARK;
+    }
+    return FALSE;
+}
+
+/* length of the common prefix made of characters that always get the same two byte primary weight */
+static int get_common_prefix( const struct sortguid *sortid, DWORD flags, const WCHAR *src1, int srclen1,
+                              const WCHAR *src2, int srclen2, UINT except )
+{
+    union char_weights weights;
+    int len = 0, maxlen = min( srclen1, srclen2 );
+
+    if (sortid->flags & FLAG_REVERSEDIACRITICS) return 0;
+
+    while (len < maxlen && src1[len] == src2[len])
+    {
+        weights = get_char_weights( src1[len], except );
+        if (weights._case & CASE_COMPR_6) break;
+        if (weights.script != SCRIPT_LATIN &&
+            (weights.script != SCRIPT_DIGIT || (flags & SORT_DIGITSASNUMBERS))) break;
+        len++;
+    }
+    if (len && (next_is_nonspace_mark( src1, srclen1, len, except ) ||
+                next_is_nonspace_mark( src2, srclen2, len, except ))) len--;
+    return len;
+}
+
 /* implementation of CompareStringEx */
 static int compare_string( const struct sortguid *sortid, DWORD flags,
                            const WCHAR *src1, int srclen1, const WCHAR *src2, int srclen2 )
@@ -3849,6 +3884,10 @@ static int compare_string( const struct sortguid *sortid, DWORD flags,
     init_sortkey_state( &s1, flags, srclen1, primary1, sizeof(primary1) );
     init_sortkey_state( &s2, flags, srclen2, primary2, sizeof(primary2) );
 
+    /* a common prefix adds identical weights to both keys, so it doesn't affect the result */
+    pos1 = pos2 = get_common_prefix( sortid, flags, src1, srclen1, src2, srclen2, except );
+    s1.primary_pos = s2.primary_pos = 2 * pos1;
+
     while (pos1 < srclen1 || pos2 < srclen2)
     {
         while (pos1 < srclen1 && !s1.key_primary.len)
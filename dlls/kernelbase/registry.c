@@ -507,6 +507,236 @@ static BOOL is_perf_key( HKEY key )
 }
 
 
+/* Optional per-process cache of value queries, enabled with WINEREGCACHE=1.
+ *
+ * Each cached key holds a duplicate of the application handle with a change
+ * notification attached, the server signals the event as soon as a value of
+ * the key is set or deleted by anybody, and the cached values are discarded
+ * on the next lookup. Entries are keyed by the application handle and are
+ * dropped by RegCloseKey(), so handles closed directly with NtClose() must not
+ * be used with the cache enabled. Deleting a key doesn't signal its own
+ * notifications, so values of an open deleted key may still be returned. */
+
+#define REG_CACHE_KEYS       32
+#define REG_CACHE_VALUES     32
+#define REG_CACHE_DATA_SIZE  2048
+
+struct reg_cache_value
+{
+    struct list    entry;
+    UNICODE_STRING name;
+    NTSTATUS       status;  /* STATUS_SUCCESS or STATUS_OBJECT_NAME_NOT_FOUND */
+    DWORD          type;
+    DWORD          size;
+    BYTE           data[1];  /* name followed by the value data */
+};
+
+struct reg_cache_key
+{
+    struct list     entry;
+    HKEY            hkey;   /* handle used by the application */
+    HANDLE          watch;  /* duplicated handle the notification is attached to */
+    HANDLE          event;  /* signaled when a value of the key changes */
+    IO_STATUS_BLOCK io;
+    struct list     values; /* MRU */
+    unsigned int    count;
+};
+
+static CRITICAL_SECTION reg_cache_cs;
+static CRITICAL_SECTION_DEBUG reg_cache_cs_debug =
+{
+    0, 0, &reg_cache_cs,
+    { &reg_cache_cs_debug.ProcessLocksList,
+      &reg_cache_cs_debug.ProcessLocksList },
+    0, 0, { (DWORD_PTR)(__FILE__ ": reg_cache_cs") }
+};
+static CRITICAL_SECTION reg_cache_cs = { &reg_cache_cs_debug, -1, 0, 0, 0, 0 };
+static struct list reg_cache = LIST_INIT(reg_cache); /* MRU */
+static unsigned int reg_cache_count;
+
+static BOOL use_value_cache(void)
+{
+    static int enabled = -1;
+    WCHAR buffer[2];
+
+    if (enabled == -1)
+        enabled = GetEnvironmentVariableW( L"WINEREGCACHE", buffer, ARRAY_SIZE(buffer) ) &&
+                  IS_OPTION_TRUE( buffer[0] );
+    return enabled;
+}
+
+static void flush_cache_values( struct reg_cache_key *key )
+{
+    struct reg_cache_value *value, *next;
+
+    LIST_FOR_EACH_ENTRY_SAFE( value, next, &key->values, struct reg_cache_value, entry )
+    {
+        list_remove( &value->entry );
+        HeapFree( GetProcessHeap(), 0, value );
+    }
+    key->count = 0;
+}
+
+static void free_cache_key( struct reg_cache_key *key )
+{
+    flush_cache_values( key );
+    list_remove( &key->entry );
+    reg_cache_count--;
+    if (key->watch) NtClose( key->watch );
+    if (key->event) NtClose( key->event );
+    HeapFree( GetProcessHeap(), 0, key );
+}
+
+static BOOL watch_cache_key( struct reg_cache_key *key )
+{
+    NTSTATUS status = NtNotifyChangeKey( key->watch, key->event, NULL, NULL, &key->io,
+                                         REG_NOTIFY_CHANGE_LAST_SET, FALSE, NULL, 0, TRUE );
+    return status == STATUS_PENDING || !status;
+}
+
+/* keep a key in the cache without caching its values */
+static struct reg_cache_key *disable_cache_key( struct reg_cache_key *key )
+{
+    flush_cache_values( key );
+    if (key->watch) NtClose( key->watch );
+    if (key->event) NtClose( key->event );
+    key->watch = key->event = NULL;
+    return NULL;
+}
+
+/* drop the cached values of a key handle that is being closed */
+static void flush_value_cache( HKEY hkey )
+{
+    struct reg_cache_key *key;
+
+    if (!use_value_cache()) return;
+
+    EnterCriticalSection( &reg_cache_cs );
+    LIST_FOR_EACH_ENTRY( key, &reg_cache, struct reg_cache_key, entry )
+    {
+        if (key->hkey != hkey) continue;
+        free_cache_key( key );
+        break;
+    }
+    LeaveCriticalSection( &reg_cache_cs );
+}
+
+static struct reg_cache_key *get_cache_key( HKEY hkey )
+{
+    static const LARGE_INTEGER zero;
+    struct reg_cache_key *key;
+
+    LIST_FOR_EACH_ENTRY( key, &reg_cache, struct reg_cache_key, entry )
+    {
+        if (key->hkey != hkey) continue;
+        list_remove( &key->entry );
+        list_add_head( &reg_cache, &key->entry );
+
+        if (!key->watch) return NULL;
+        if (NtWaitForSingleObject( key->event, FALSE, &zero ) == STATUS_WAIT_0)
+        {
+            flush_cache_values( key );
+            if (!watch_cache_key( key )) return disable_cache_key( key );
+        }
+        return key;
+    }
+
+    if (!(key = HeapAlloc( GetProcessHeap(), 0, sizeof(*key) ))) return NULL;
+    key->hkey = hkey;
+    key->watch = key->event = NULL;
+    list_init( &key->values );
+    key->count = 0;
+    list_add_head( &reg_cache, &key->entry );
+    reg_cache_count++;
+
+    if (reg_cache_count > REG_CACHE_KEYS)
+        free_cache_key( LIST_ENTRY( list_tail( &reg_cache ), struct reg_cache_key, entry ) );
+
+    /* the entry is kept even if the key can't be watched, so that we don't retry every time */
+    if (NtDuplicateObject( GetCurrentProcess(), hkey, GetCurrentProcess(), &key->watch,
+                           0, 0, DUPLICATE_SAME_ACCESS ) ||
+        NtCreateEvent( &key->event, EVENT_ALL_ACCESS, NULL, NotificationEvent, FALSE ) ||
+        !watch_cache_key( key ))
+        return disable_cache_key( key );
+    return key;
+}
+
+static void cache_value( struct reg_cache_key *key, const UNICODE_STRING *name, NTSTATUS status,
+                         const KEY_VALUE_PARTIAL_INFORMATION *info )
+{
+    struct reg_cache_value *value;
+    DWORD size = status ? 0 : info->DataLength;
+
+    if (size > REG_CACHE_DATA_SIZE) return;
+    if (!(value = HeapAlloc( GetProcessHeap(), 0, offsetof( struct reg_cache_value, data[size] ) + name->Length )))
+        return;
+    value->name.Buffer = (WCHAR *)value->data;
+    value->name.Length = value->name.MaximumLength = name->Length;
+    memcpy( value->name.Buffer, name->Buffer, name->Length );
+    value->status = status;
+    value->type = status ? 0 : info->Type;
+    value->size = size;
+    memcpy( value->data + name->Length, info->Data, size );
+    list_add_head( &key->values, &value->entry );
+
+    if (++key->count > REG_CACHE_VALUES)
+    {
+        value = LIST_ENTRY( list_tail( &key->values ), struct reg_cache_value, entry );
+        list_remove( &value->entry );
+        HeapFree( GetProcessHeap(), 0, value );
+        key->count--;
+    }
+}
+
+/* same as NtQueryValueKey( KeyValuePartialInformation ), served from the cache when enabled */
+static NTSTATUS query_value_key( HKEY hkey, const UNICODE_STRING *name, void *buffer,
+                                 DWORD length, DWORD *result_len )
+{
+    static const DWORD info_size = offsetof( KEY_VALUE_PARTIAL_INFORMATION, Data );
+    KEY_VALUE_PARTIAL_INFORMATION *info = buffer, header;
+    struct reg_cache_value *value;
+    struct reg_cache_key *key;
+    NTSTATUS status;
+
+    if (!use_value_cache())
+        return NtQueryValueKey( hkey, name, KeyValuePartialInformation, buffer, length, result_len );
+
+    EnterCriticalSection( &reg_cache_cs );
+
+    if (!(key = get_cache_key( hkey )))
+    {
+        LeaveCriticalSection( &reg_cache_cs );
+        return NtQueryValueKey( hkey, name, KeyValuePartialInformation, buffer, length, result_len );
+    }
+
+    LIST_FOR_EACH_ENTRY( value, &key->values, struct reg_cache_value, entry )
+    {
+        if (!RtlEqualUnicodeString( &value->name, name, TRUE )) continue;
+        list_remove( &value->entry );
+        list_add_head( &key->values, &value->entry );
+
+        if ((status = value->status)) goto done;
+        header.TitleIndex = 0;
+        header.Type = value->type;
+        header.DataLength = value->size;
+        memcpy( info, &header, min( length, info_size ) );
+        if (length > info_size)
+            memcpy( info->Data, value->data + value->name.Length, min( length - info_size, value->size ) );
+        *result_len = info_size + value->size;
+        if (length < info_size) status = STATUS_BUFFER_TOO_SMALL;
+        else if (length < *result_len) status = STATUS_BUFFER_OVERFLOW;
+        goto done;
+    }
+
+    status = NtQueryValueKey( hkey, name, KeyValuePartialInformation, buffer, length, result_len );
+    if (!status || status == STATUS_OBJECT_NAME_NOT_FOUND) cache_value( key, name, status, info );
+
+done:
+    LeaveCriticalSection( &reg_cache_cs );
+    return status;
+}
+
+
 /******************************************************************************
  * RemapPredefinedHandleInternal   (kernelbase.@)
  */
@@ -531,7 +761,11 @@ NTSTATUS WINAPI RemapPredefinedHandleInternal( HKEY hkey, HKEY override )
     }
 
     old_key = InterlockedExchangePointer( (void **)&special_root_keys[idx], override );
-    if (old_key) NtClose( old_key );
+    if (old_key)
+    {
+        flush_value_cache( old_key );
+        NtClose( old_key );
+    }
     return STATUS_SUCCESS;
 }
 
@@ -554,7 +788,11 @@ NTSTATUS WINAPI DisablePredefinedHandleTableInternal( HKEY hkey )
     cache_disabled[idx] = TRUE;
 
     old_key = InterlockedExchangePointer( (void **)&special_root_keys[idx], NULL );
-    if (old_key) NtClose( old_key );
+    if (old_key)
+    {
+        flush_value_cache( old_key );
+        NtClose( old_key );
+    }
     return STATUS_SUCCESS;
 }
 
@@ -1131,6 +1369,7 @@ LSTATUS WINAPI DECLSPEC_HOTPATCH RegCloseKey( HKEY hkey )
 {
     if (!hkey) return ERROR_INVALID_HANDLE;
     if (hkey >= (HKEY)0x80000000) return ERROR_SUCCESS;
+    flush_value_cache( hkey );
     return RtlNtStatusToDosError( NtClose( hkey ) );
 }
 
@@ -1664,8 +1903,7 @@ LSTATUS WINAPI DECLSPEC_HOTPATCH RegQueryValueExW( HKEY hkey, LPCWSTR name, LPDW
         if (count) *count = 0;
     }
 
-    status = NtQueryValueKey( hkey, &name_str, KeyValuePartialInformation,
-                              buffer, total_size, &total_size );
+    status = query_value_key( hkey, &name_str, buffer, total_size, &total_size );
     if (status && status != STATUS_BUFFER_OVERFLOW) goto done;
 
     if (data)
@@ -1677,8 +1915,7 @@ LSTATUS WINAPI DECLSPEC_HOTPATCH RegQueryValueExW( HKEY hkey, LPCWSTR name, LPDW
             if (!(buf_ptr = HeapAlloc( GetProcessHeap(), 0, total_size )))
                 return ERROR_NOT_ENOUGH_MEMORY;
             info = (KEY_VALUE_PARTIAL_INFORMATION *)buf_ptr;
-            status = NtQueryValueKey( hkey, &name_str, KeyValuePartialInformation,
-                                      buf_ptr, total_size, &total_size );
+            status = query_value_key( hkey, &name_str, buf_ptr, total_size, &total_size );
         }
 
         if (!status)
@@ -1763,8 +2000,7 @@ LSTATUS WINAPI DECLSPEC_HOTPATCH RegQueryValueExA( HKEY hkey, LPCSTR name, LPDWO
         return ret;
     }
 
-    status = NtQueryValueKey( hkey, &nameW, KeyValuePartialInformation,
-                              buffer, sizeof(buffer), &total_size );
+    status = query_value_key( hkey, &nameW, buffer, sizeof(buffer), &total_size );
     if (status && status != STATUS_BUFFER_OVERFLOW) goto done;
 
     /* we need to fetch the contents for a string type even if not requested,
@@ -1781,8 +2017,7 @@ LSTATUS WINAPI DECLSPEC_HOTPATCH RegQueryValueExA( HKEY hkey, LPCSTR name, LPDWO
                 goto done;
             }
             info = (KEY_VALUE_PARTIAL_INFORMATION *)buf_ptr;
-            status = NtQueryValueKey( hkey, &nameW, KeyValuePartialInformation,
-                                      buf_ptr, total_size, &total_size );
+            status = query_value_key( hkey, &nameW, buf_ptr, total_size, &total_size );
         }
 
         if (status) goto done;
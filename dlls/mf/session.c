@@ -173,6 +173,10 @@ struct transform_stream
     unsigned int requests;
     unsigned int min_buffer_size;
     BOOL draining;
+    /* Output sample that the transform did not consume, kept for the next ProcessOutput() call. */
+    IMFSample *spare_sample;
+    unsigned int spare_size;
+    unsigned int spare_alignment;
 };
 
 enum topo_node_flags
@@ -793,7 +797,11 @@ static void release_topo_node(struct topo_node *node)
             for (i = 0; i < node->u.transform.input_count; ++i)
                 transform_stream_drop_events(&node->u.transform.inputs[i]);
             for (i = 0; i < node->u.transform.output_count; ++i)
+            {
                 transform_stream_drop_events(&node->u.transform.outputs[i]);
+                if (node->u.transform.outputs[i].spare_sample)
+                    IMFSample_Release(node->u.transform.outputs[i].spare_sample);
+            }
             free(node->u.transform.inputs);
             free(node->u.transform.outputs);
             free(node->u.transform.input_map);
@@ -3451,7 +3459,21 @@ static HRESULT transform_get_external_output_sample(const struct media_session *
     }
     else
     {
-        buffer_size = max(stream_info->cbSize, transform->u.transform.outputs[output].min_buffer_size);
+        struct transform_stream *stream = &transform->u.transform.outputs[output];
+
+        buffer_size = max(stream_info->cbSize, stream->min_buffer_size);
+
+        if (stream->spare_sample)
+        {
+            if (stream->spare_size >= buffer_size && stream->spare_alignment == stream_info->cbAlignment)
+            {
+                *sample = stream->spare_sample;
+                stream->spare_sample = NULL;
+                return S_OK;
+            }
+            IMFSample_Release(stream->spare_sample);
+            stream->spare_sample = NULL;
+        }
 
         hr = MFCreateAlignedMemoryBuffer(buffer_size, stream_info->cbAlignment, &buffer);
         if (SUCCEEDED(hr))
@@ -3462,6 +3484,12 @@ static HRESULT transform_get_external_output_sample(const struct media_session *
 
         if (buffer)
             IMFMediaBuffer_Release(buffer);
+
+        if (SUCCEEDED(hr))
+        {
+            stream->spare_size = buffer_size;
+            stream->spare_alignment = stream_info->cbAlignment;
+        }
     }
 
     return hr;
@@ -3628,6 +3656,29 @@ static void release_output_samples(struct topo_node *node, MFT_OUTPUT_DATA_BUFFE
     }
 }
 
+static void transform_node_keep_spare_samples(const struct media_session *session, struct topo_node *node,
+        MFT_OUTPUT_DATA_BUFFER *buffers)
+{
+    struct topo_node *topo_node;
+    DWORD input;
+    UINT i;
+
+    for (i = 0; i < node->u.transform.output_count; ++i)
+    {
+        struct transform_stream *stream = &node->u.transform.outputs[i];
+
+        if (!buffers[i].pSample || stream->spare_sample)
+            continue;
+        /* Samples from a sink allocator go back to its pool instead. */
+        if (!(topo_node = session_get_topo_node_output(session, node, i, &input))
+                || (topo_node->type == MF_TOPOLOGY_OUTPUT_NODE && topo_node->u.sink.allocator))
+            continue;
+
+        stream->spare_sample = buffers[i].pSample;
+        buffers[i].pSample = NULL;
+    }
+}
+
 static HRESULT transform_node_pull_samples(const struct media_session *session, struct topo_node *node)
 {
     MFT_OUTPUT_DATA_BUFFER *buffers;
@@ -3653,6 +3704,12 @@ static HRESULT transform_node_pull_samples(const struct media_session *session,
         hr = IMFTransform_ProcessOutput(node->object.transform, 0, node->u.transform.output_count, buffers, &status);
     }
 
+    /* Decoders usually need several inputs before producing an output. Keep
+     * the samples allocated for this attempt instead of allocating a whole new
+     * frame buffer on every pull. */
+    if (hr == MF_E_TRANSFORM_NEED_MORE_INPUT)
+        transform_node_keep_spare_samples(session, node, buffers);
+
     /* Collect returned samples for all streams. */
     for (i = 0; i < node->u.transform.output_count; ++i)
     {
@@ -360,8 +360,26 @@ static HRESULT WINAPI HTMLDocument_get_all(IHTMLDocument2 *iface, IHTMLElementCo
     HTMLDocumentNode *This = impl_from_IHTMLDocument2(iface);
 
     TRACE("(%p)->(%p)\n", This, p);
-    *p = create_all_collection(&This->node, FALSE);
 
+    /* Fragments don't get mutation notifications, so they can't cache the collection. */
+    if(!This->dom_document) {
+        *p = create_all_collection(&This->node, FALSE);
+        return S_OK;
+    }
+
+    /* Building the collection walks the whole tree, so reuse it until the DOM changes. */
+    if(!This->all_collection || This->all_collection_version != This->dom_version) {
+        IHTMLElementCollection *col = create_all_collection(&This->node, FALSE);
+        if(!col)
+            return E_OUTOFMEMORY;
+
+        unlink_ref(&This->all_collection);
+        This->all_collection = col;
+        This->all_collection_version = This->dom_version;
+    }
+
+    IHTMLElementCollection_AddRef(This->all_collection);
+    *p = This->all_collection;
     return S_OK;
 }
 
@@ -5271,6 +5289,7 @@ void detach_document_node(HTMLDocumentNode *doc)
 
     unlink_ref(&doc->dom_implementation);
     unlink_ref(&doc->namespaces);
+    unlink_ref(&doc->all_collection);
     detach_events(doc);
     detach_selection(doc);
     detach_ranges(doc);
@@ -5427,6 +5446,8 @@ static void HTMLDocumentNode_traverse(DispatchEx *dispex, nsCycleCollectionTrave
         note_cc_edge((nsISupports*)This->dom_implementation, "dom_implementation", cb);
     if(This->namespaces)
         note_cc_edge((nsISupports*)This->namespaces, "namespaces", cb);
+    if(This->all_collection)
+        note_cc_edge((nsISupports*)This->all_collection, "all_collection", cb);
 }
 
 static void HTMLDocumentNode_unlink(DispatchEx *dispex)
@@ -1177,6 +1177,11 @@ struct HTMLDocumentNode {
     IHTMLDOMImplementation *dom_implementation;
     IHTMLNamespaceCollection *namespaces;
 
+    /* document.all snapshot, valid as long as dom_version doesn't change */
+    IHTMLElementCollection *all_collection;
+    LONG all_collection_version;
+    LONG dom_version;
+
     ICatInformation *catmgr;
     nsDocumentEventListener *nsevent_listener;
     BOOL *event_vector;
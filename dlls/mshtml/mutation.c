@@ -821,17 +821,26 @@ static void NSAPI nsDocumentObserver_AttributeSetToCurrentValue(nsIDocumentObser
 static void NSAPI nsDocumentObserver_ContentAppended(nsIDocumentObserver *iface, nsIDocument *aDocument,
         nsIContent *aContainer, nsIContent *aFirstNewContent, LONG aNewIndexInContainer)
 {
+    HTMLDocumentNode *This = impl_from_nsIDocumentObserver(iface);
+
+    This->dom_version++;
 }
 
 static void NSAPI nsDocumentObserver_ContentInserted(nsIDocumentObserver *iface, nsIDocument *aDocument,
         nsIContent *aContainer, nsIContent *aChild, LONG aIndexInContainer)
 {
+    HTMLDocumentNode *This = impl_from_nsIDocumentObserver(iface);
+
+    This->dom_version++;
 }
 
 static void NSAPI nsDocumentObserver_ContentRemoved(nsIDocumentObserver *iface, nsIDocument *aDocument,
         nsIContent *aContainer, nsIContent *aChild, LONG aIndexInContainer,
         nsIContent *aProviousSibling)
 {
+    HTMLDocumentNode *This = impl_from_nsIDocumentObserver(iface);
+
+    This->dom_version++;
 }
 
 static void NSAPI nsDocumentObserver_NodeWillBeDestroyed(nsIDocumentObserver *iface, const nsINode *aNode)
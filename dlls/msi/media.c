@@ -150,11 +150,127 @@ static UINT CDECL cabinet_read(INT_PTR hf, void *pv, UINT cb)
     return 0;
 }
 
+/* Small files are buffered while they are extracted and written out by the
+ * thread pool, so that decompression doesn't wait for the file system calls.
+ * There's only one extraction at a time, like for package_disk below. */
+#define MAX_ASYNC_FILE_SIZE 0x10000
+#define MAX_ASYNC_WRITES    64
+
+struct async_write
+{
+    HANDLE   handle;
+    FILETIME time;
+    DWORD    size;
+    DWORD    capacity;
+    BYTE     data[1];
+};
+
+static struct
+{
+    TP_CALLBACK_ENVIRON env;
+    TP_CLEANUP_GROUP   *group;
+    HANDLE              slots;   /* limits the number of buffered files */
+    LONG                failed;
+    struct async_write *current; /* file being extracted */
+} writer;
+
+static void writer_init(void)
+{
+    InitializeThreadpoolEnvironment( &writer.env );
+    writer.failed = FALSE;
+    writer.current = NULL;
+    if (!(writer.slots = CreateSemaphoreW( NULL, MAX_ASYNC_WRITES, MAX_ASYNC_WRITES, NULL ))) return;
+    if ((writer.group = CreateThreadpoolCleanupGroup()))
+        SetThreadpoolCallbackCleanupGroup( &writer.env, writer.group, NULL );
+}
+
+static BOOL writer_finish(void)
+{
+    if (writer.group)
+    {
+        CloseThreadpoolCleanupGroupMembers( writer.group, FALSE, NULL );
+        CloseThreadpoolCleanupGroup( writer.group );
+        writer.group = NULL;
+    }
+    if (writer.slots) CloseHandle( writer.slots );
+    writer.slots = NULL;
+    DestroyThreadpoolEnvironment( &writer.env );
+
+    free( writer.current );
+    writer.current = NULL;
+    return !writer.failed;
+}
+
+static void CALLBACK async_write_proc( TP_CALLBACK_INSTANCE *instance, void *context )
+{
+    struct async_write *write = context;
+    DWORD written;
+    BOOL ret;
+
+    ret = WriteFile( write->handle, write->data, write->size, &written, NULL ) && written == write->size;
+    if (ret) ret = SetFileTime( write->handle, &write->time, 0, &write->time );
+    if (!ret)
+    {
+        ERR( "failed to write file (error %lu)\n", GetLastError() );
+        InterlockedExchange( &writer.failed, TRUE );
+    }
+    CloseHandle( write->handle );
+    free( write );
+    ReleaseSemaphore( writer.slots, 1, NULL );
+}
+
+static void writer_begin_file( HANDLE handle, DWORD size )
+{
+    if (!writer.group || size > MAX_ASYNC_FILE_SIZE) return;
+    if (!(writer.current = malloc( FIELD_OFFSET( struct async_write, data[size] ) ))) return;
+    writer.current->handle = handle;
+    writer.current->size = 0;
+    writer.current->capacity = size;
+}
+
+/* writes out what has been buffered, the rest of the file is written synchronously */
+static BOOL writer_flush_file(void)
+{
+    struct async_write *write = writer.current;
+    DWORD written;
+    BOOL ret;
+
+    writer.current = NULL;
+    ret = WriteFile( write->handle, write->data, write->size, &written, NULL ) && written == write->size;
+    free( write );
+    return ret;
+}
+
+static BOOL writer_end_file( HANDLE handle, const FILETIME *time )
+{
+    struct async_write *write = writer.current;
+
+    if (!write || write->handle != handle) return FALSE;
+
+    writer.current = NULL;
+    write->time = *time;
+    WaitForSingleObject( writer.slots, INFINITE );
+    if (!TrySubmitThreadpoolCallback( async_write_proc, write, &writer.env ))
+        async_write_proc( NULL, write );
+    return TRUE;
+}
+
 static UINT CDECL cabinet_write(INT_PTR hf, void *pv, UINT cb)
 {
     HANDLE handle = (HANDLE)hf;
     DWORD written;
 
+    if (writer.current && writer.current->handle == handle)
+    {
+        if (writer.current->size + cb <= writer.current->capacity)
+        {
+            memcpy( writer.current->data + writer.current->size, pv, cb );
+            writer.current->size += cb;
+            return cb;
+        }
+        if (!writer_flush_file()) return 0;
+    }
+
     if (WriteFile(handle, pv, cb, &written, NULL))
         return written;
 
@@ -164,6 +280,12 @@ static UINT CDECL cabinet_write(INT_PTR hf, void *pv, UINT cb)
 static int CDECL cabinet_close(INT_PTR hf)
 {
     HANDLE handle = (HANDLE)hf;
+
+    if (writer.current && writer.current->handle == handle)
+    {
+        free( writer.current );
+        writer.current = NULL;
+    }
     return CloseHandle(handle) ? 0 : -1;
 }
 
@@ -478,6 +600,7 @@ static INT_PTR cabinet_copy_file(FDINOTIFICATIONTYPE fdint,
     }
 
 done:
+    if (handle && handle != INVALID_HANDLE_VALUE) writer_begin_file( handle, pfdin->cb );
     free(path);
 
     return (INT_PTR)handle;
@@ -495,21 +618,23 @@ static INT_PTR cabinet_close_file_info(FDINOTIFICATIONTYPE fdint,
 
     if (!DosDateTimeToFileTime(pfdin->date, pfdin->time, &ft))
     {
-        CloseHandle(handle);
+        cabinet_close(pfdin->hf);
         return -1;
     }
     if (!LocalFileTimeToFileTime(&ft, &ftLocal))
     {
-        CloseHandle(handle);
+        cabinet_close(pfdin->hf);
         return -1;
     }
-    if (!SetFileTime(handle, &ftLocal, 0, &ftLocal))
+    if (!writer_end_file(handle, &ftLocal))
     {
+        if (!SetFileTime(handle, &ftLocal, 0, &ftLocal))
+        {
+            CloseHandle(handle);
+            return -1;
+        }
         CloseHandle(handle);
-        return -1;
     }
-
-    CloseHandle(handle);
     data->cb(data->package, data->curfile, MSICABEXTRACT_FILEEXTRACTED, NULL, NULL, data->user);
 
     free(data->curfile);
@@ -639,11 +764,22 @@ static BOOL extract_cabinet_stream( MSIPACKAGE *package, MSIMEDIAINFO *mi, LPVOI
  */
 BOOL msi_cabextract(MSIPACKAGE* package, MSIMEDIAINFO *mi, LPVOID data)
 {
+    BOOL ret;
+
+    writer_init();
     if (mi->cabinet[0] == '#')
     {
-        return extract_cabinet_stream( package, mi, data );
+        ret = extract_cabinet_stream( package, mi, data );
     }
-    return extract_cabinet( package, mi, data );
+    else ret = extract_cabinet( package, mi, data );
+
+    /* wait for the pending writes before the files are used */
+    if (!writer_finish())
+    {
+        ERR("failed to write extracted files\n");
+        ret = FALSE;
+    }
+    return ret;
 }
 
 void msi_free_media_info(MSIMEDIAINFO *mi)
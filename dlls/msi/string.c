@@ -46,6 +46,7 @@ struct msistring
     USHORT nonpersistent_refcount;
     WCHAR *data;
     int    len;
+    UINT   hash_next;      /* next string id in the same hash bucket */
 };
 
 struct string_table
@@ -53,11 +54,14 @@ struct string_table
     UINT maxcount;         /* the number of strings */
     UINT freeslot;
     UINT codepage;
-    UINT sortcount;
+    UINT hashcount;        /* the number of strings in the hash table */
+    UINT hashsize;         /* the number of buckets, a power of two */
     struct msistring *strings; /* an array of strings */
-    UINT *sorted;              /* index */
+    UINT *hash;                /* index, 0 terminates a chain */
 };
 
+#define MIN_HASH_SIZE 256
+
 static BOOL validate_codepage( UINT codepage )
 {
     if (codepage != CP_ACP && !IsValidCodePage( codepage ))
@@ -88,8 +92,10 @@ static string_table *init_stringtable( int entries, UINT codepage )
         return NULL;
     }
 
-    st->sorted = malloc( sizeof(UINT) * entries );
-    if( !st->sorted )
+    st->hashsize = MIN_HASH_SIZE;
+    while (st->hashsize < entries) st->hashsize *= 2;
+    st->hash = calloc( st->hashsize, sizeof(UINT) );
+    if( !st->hash )
     {
         free( st->strings );
         free( st );
@@ -99,7 +105,7 @@ static string_table *init_stringtable( int entries, UINT codepage )
     st->maxcount = entries;
     st->freeslot = 1;
     st->codepage = codepage;
-    st->sortcount = 0;
+    st->hashcount = 0;
 
     return st;
 }
@@ -115,25 +121,22 @@ VOID msi_destroy_stringtable( string_table *st )
             free( st->strings[i].data );
     }
     free( st->strings );
-    free( st->sorted );
+    free( st->hash );
     free( st );
 }
 
 static int st_find_free_entry( string_table *st )
 {
-    UINT i, sz, *s;
+    UINT i, sz, start = st->freeslot ? st->freeslot : 1;
     struct msistring *p;
 
     TRACE("%p\n", st);
 
-    if( st->freeslot )
-    {
-        for( i = st->freeslot; i < st->maxcount; i++ )
-            if( !st->strings[i].persistent_refcount &&
-                !st->strings[i].nonpersistent_refcount )
-                return i;
-    }
-    for( i = 1; i < st->maxcount; i++ )
+    for( i = start; i < st->maxcount; i++ )
+        if( !st->strings[i].persistent_refcount &&
+            !st->strings[i].nonpersistent_refcount )
+            return i;
+    for( i = 1; i < start; i++ )
         if( !st->strings[i].persistent_refcount &&
             !st->strings[i].nonpersistent_refcount )
             return i;
@@ -143,14 +146,7 @@ static int st_find_free_entry( string_table *st )
     if (!(p = realloc( st->strings, sz * sizeof(*p) ))) return -1;
     memset( p + st->maxcount, 0, (sz - st->maxcount) * sizeof(*p) );
 
-    if (!(s = realloc( st->sorted, sz * sizeof(*s) )))
-    {
-        free( p );
-        return -1;
-    }
-
     st->strings = p;
-    st->sorted = s;
 
     st->freeslot = st->maxcount;
     st->maxcount = sz;
@@ -173,36 +169,60 @@ static inline int cmp_string( const WCHAR *str1, int len1, const WCHAR *str2, in
     return 0;
 }
 
-static int find_insert_index( const string_table *st, UINT string_id )
+static inline UINT hash_string( const WCHAR *str, int len )
+{
+    UINT hash = 2166136261u;
+
+    while (len--) hash = (hash ^ *str++) * 16777619u;
+    return hash;
+}
+
+static UINT find_string( const string_table *st, const WCHAR *str, int len )
+{
+    UINT id = st->hash[hash_string( str, len ) & (st->hashsize - 1)];
+
+    while (id && cmp_string( str, len, st->strings[id].data, st->strings[id].len ))
+        id = st->strings[id].hash_next;
+    return id;
+}
+
+static void link_string( string_table *st, UINT string_id )
+{
+    const struct msistring *str = &st->strings[string_id];
+    UINT *bucket = &st->hash[hash_string( str->data, str->len ) & (st->hashsize - 1)];
+
+    st->strings[string_id].hash_next = *bucket;
+    *bucket = string_id;
+}
+
+static void grow_hash( string_table *st )
 {
-    int i, c, low = 0, high = st->sortcount - 1;
+    UINT i, *hash, size = st->hashsize * 2, count = st->hashcount;
 
-    while (low <= high)
+    if (!(hash = calloc( size, sizeof(UINT) ))) return;
+    free( st->hash );
+    st->hash = hash;
+    st->hashsize = size;
+
+    /* relink the strings, taking care to keep only the first of any duplicates */
+    st->hashcount = 0;
+    for (i = 1; i < st->maxcount && st->hashcount < count; i++)
     {
-        i = (low + high) / 2;
-        c = cmp_string( st->strings[string_id].data, st->strings[string_id].len,
-                        st->strings[st->sorted[i]].data, st->strings[st->sorted[i]].len );
-        if (c < 0)
-            high = i - 1;
-        else if (c > 0)
-            low = i + 1;
-        else
-            return -1; /* already exists */
+        if (!st->strings[i].persistent_refcount && !st->strings[i].nonpersistent_refcount) continue;
+        if (find_string( st, st->strings[i].data, st->strings[i].len )) continue;
+        link_string( st, i );
+        st->hashcount++;
     }
-    return high + 1;
 }
 
-static void insert_string_sorted( string_table *st, UINT string_id )
+static void insert_string_hash( string_table *st, UINT string_id )
 {
-    int i;
+    if (find_string( st, st->strings[string_id].data, st->strings[string_id].len ))
+        return; /* already exists */
 
-    i = find_insert_index( st, string_id );
-    if (i == -1)
-        return;
-
-    memmove( &st->sorted[i] + 1, &st->sorted[i], (st->sortcount - i) * sizeof(UINT) );
-    st->sorted[i] = string_id;
-    st->sortcount++;
+    if (st->hashcount >= st->hashsize) grow_hash( st );
+    link_string( st, string_id );
+    st->hashcount++;
 }
 
 static void set_st_entry( string_table *st, UINT n, WCHAR *str, int len, USHORT refcount,
@@ -222,7 +242,7 @@ static void set_st_entry( string_table *st, UINT n, WCHAR *str, int len, USHORT
     st->strings[n].data = str;
     st->strings[n].len  = len;
 
-    insert_string_sorted( st, n );
+    insert_string_hash( st, n );
 
     if( n < st->maxcount )
         st->freeslot = n + 1;
@@ -399,26 +419,15 @@ static UINT id2string( const string_table *st, UINT id, char *buffer, UINT *sz )
  */
 UINT msi_string2id( const string_table *st, const WCHAR *str, int len, UINT *id )
 {
-    int i, c, low = 0, high = st->sortcount - 1;
+    UINT n;
 
     if (len < 0) len = lstrlenW( str );
 
-    while (low <= high)
-    {
-        i = (low + high) / 2;
-        c = cmp_string( str, len, st->strings[st->sorted[i]].data, st->strings[st->sorted[i]].len );
+    if (!(n = find_string( st, str, len )))
+        return ERROR_INVALID_PARAMETER;
 
-        if (c < 0)
-            high = i - 1;
-        else if (c > 0)
-            low = i + 1;
-        else
-        {
-            *id = st->sorted[i];
-            return ERROR_SUCCESS;
-        }
-    }
-    return ERROR_INVALID_PARAMETER;
+    *id = n;
+    return ERROR_SUCCESS;
 }
 
 static void string_totalsize( const string_table *st, UINT *datasize, UINT *poolsize )
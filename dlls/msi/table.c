@@ -55,6 +55,7 @@ struct column_info
     UINT    type;
     UINT    offset;
     struct column_hash_entry **hash_table;
+    UINT    hash_size;
 };
 
 struct tagMSITABLE
@@ -1155,6 +1156,17 @@ static UINT TABLE_fetch_stream( struct tagMSIVIEW *view, UINT row, UINT col, ISt
     return r;
 }
 
+static void table_reset_hash_tables( struct table_view *tv )
+{
+    UINT i;
+
+    for (i = 0; i < tv->num_cols; i++)
+    {
+        free( tv->columns[i].hash_table );
+        tv->columns[i].hash_table = NULL;
+    }
+}
+
 /* Set a table value, i.e. preadjusted integer or string ID. */
 static UINT table_set_bytes( struct table_view *tv, UINT row, UINT col, UINT val )
 {
@@ -1742,6 +1754,9 @@ static UINT TABLE_insert_row( struct tagMSIVIEW *view, MSIRECORD *rec, UINT row,
     if( r != ERROR_SUCCESS )
         return r;
 
+    /* the row numbers stored in the hash tables are about to change */
+    table_reset_hash_tables( tv );
+
     /* shift the rows to make room for the new row */
     for (i = tv->table->row_count - 1; i > row; i--)
     {
@@ -1775,12 +1790,7 @@ static UINT TABLE_delete_row( struct tagMSIVIEW *view, UINT row )
     num_rows = tv->table->row_count;
     tv->table->row_count--;
 
-    /* reset the hash tables */
-    for (i = 0; i < tv->num_cols; i++)
-    {
-        free(tv->columns[i].hash_table);
-        tv->columns[i].hash_table = NULL;
-    }
+    table_reset_hash_tables( tv );
 
     for (i = row + 1; i < num_rows; i++)
     {
@@ -1964,6 +1974,7 @@ static UINT TABLE_remove_column(struct tagMSIVIEW *view, UINT number)
     if (tv->table->colinfo[number-1].type & MSITYPE_TEMPORARY)
     {
         UINT size = tv->table->colinfo[number-1].offset;
+        free( tv->table->colinfo[number-1].hash_table );
         tv->table->col_count--;
         tv->table->colinfo = realloc(tv->table->colinfo, sizeof(*tv->table->colinfo) * tv->table->col_count);
 
@@ -2182,6 +2193,69 @@ done:
     return r;
 }
 
+static UINT TABLE_find_matching_rows( struct tagMSIVIEW *view, UINT col, UINT val, UINT *row,
+                                      MSIITERHANDLE *handle )
+{
+    struct table_view *tv = (struct table_view *)view;
+    struct column_info *column;
+    const struct column_hash_entry *entry;
+
+    TRACE("%p, %u, %u, %p\n", view, col, val, *handle);
+
+    if( !tv->table )
+        return ERROR_INVALID_PARAMETER;
+
+    if( (col==0) || (col>tv->num_cols) )
+        return ERROR_INVALID_PARAMETER;
+
+    column = &tv->columns[col - 1];
+    if( !column->hash_table )
+    {
+        struct column_hash_entry **hash_table, *new_entry;
+        UINT i, size, num_rows = tv->table->row_count;
+
+        size = max( MSITABLE_HASH_TABLE_SIZE, num_rows | 1 );
+
+        /* allocate the buckets and the entries in one block, so that resetting
+         * the table is a single free */
+        hash_table = calloc( 1, size * sizeof(*hash_table) + num_rows * sizeof(*new_entry) );
+        if( !hash_table )
+            return ERROR_OUTOFMEMORY;
+        new_entry = (struct column_hash_entry *)(hash_table + size);
+
+        /* insert in reverse order so that each chain lists its rows in ascending order */
+        for( i = num_rows; i > 0; i-- )
+        {
+            UINT value;
+
+            if( TABLE_fetch_int( view, i - 1, col, &value ) != ERROR_SUCCESS )
+                continue;
+
+            new_entry->value = value;
+            new_entry->row = i - 1;
+            new_entry->next = hash_table[value % size];
+            hash_table[value % size] = new_entry++;
+        }
+        column->hash_table = hash_table;
+        column->hash_size = size;
+    }
+
+    if( !*handle )
+        entry = column->hash_table[val % column->hash_size];
+    else
+        entry = (*handle)->next;
+
+    while( entry && entry->value != val )
+        entry = entry->next;
+
+    *handle = entry;
+    if( !entry )
+        return ERROR_NO_MORE_ITEMS;
+
+    *row = entry->row;
+    return ERROR_SUCCESS;
+}
+
 static const MSIVIEWOPS table_ops =
 {
     TABLE_fetch_int,
@@ -2203,6 +2277,7 @@ static const MSIVIEWOPS table_ops =
     TABLE_add_column,
     NULL,
     TABLE_drop,
+    TABLE_find_matching_rows,
 };
 
 UINT TABLE_CreateView( MSIDATABASE *db, LPCWSTR name, MSIVIEW **view )
@@ -2788,7 +2863,7 @@ static UINT TransformView_Create( MSIDATABASE *db, string_table *st, LPCWSTR nam
     static const WCHAR query_sfx[] = L"' AND `Row` IS NULL AND `Current` IS NOT NULL AND `new` = 1";
 
     WCHAR buf[256], *query = buf;
-    UINT r, len, name_len, size, add_col;
+    UINT r, len, name_len, size, add_col, i;
     struct column_info *colinfo;
     struct table_view *tv;
     MSIRECORD *rec;
@@ -2894,6 +2969,7 @@ static UINT TransformView_Create( MSIDATABASE *db, string_table *st, LPCWSTR nam
     msiobj_release( &q->hdr );
 
     memcpy( colinfo, tv->columns, tv->num_cols * sizeof(*colinfo) );
+    for (i = 0; i < tv->num_cols; i++) colinfo[i].hash_table = NULL;
     tv->columns = colinfo;
     tv->num_cols += add_col;
     *view = (MSIVIEW *)tv;
@@ -3170,6 +3246,30 @@ static UINT table_find_row( struct table_view *tv, MSIRECORD *rec, UINT *row, UI
     data = record_to_row( tv, rec );
     if( !data )
         return r;
+
+    /* Use the index of the first key column if a query already built it.
+     * Inserting rows invalidates it, so don't build it here, bulk inserts
+     * would end up rebuilding it for every row. */
+    for( i = 0; i < tv->num_cols; i++ )
+        if( tv->columns[i].type & MSITYPE_KEY ) break;
+    if( i < tv->num_cols && tv->columns[i].hash_table )
+    {
+        MSIITERHANDLE handle = NULL;
+        UINT key = i + 1, candidate;
+
+        while( TABLE_find_matching_rows( &tv->view, key, data[key - 1], &candidate, &handle ) == ERROR_SUCCESS )
+        {
+            r = row_matches( tv, candidate, data, column );
+            if( r == ERROR_SUCCESS )
+            {
+                *row = candidate;
+                break;
+            }
+        }
+        free( data );
+        return r;
+    }
+
     for( i = 0; i < tv->table->row_count; i++ )
     {
         r = row_matches( tv, i, data, column );
@@ -647,38 +647,156 @@ static UINT WHERE_evaluate( MSIWHEREVIEW *wv, const UINT rows[],
     return ERROR_SUCCESS;
 }
 
+static BOOL is_table_column( const struct expr *expr, const struct join_table *table )
+{
+    switch (expr->type)
+    {
+    case EXPR_COL_NUMBER:
+    case EXPR_COL_NUMBER32:
+    case EXPR_COL_NUMBER_STRING:
+        return expr->u.column.parsed.table == table;
+    default:
+        return FALSE;
+    }
+}
+
+/* looks for a column of table that the condition requires to be equal to a
+ * known value, so the matching rows can be looked up instead of scanned */
+static BOOL find_index_condition( MSIWHEREVIEW *wv, const struct expr *cond, const struct join_table *table,
+                                  const UINT rows[], UINT *col, UINT *val )
+{
+    const struct expr *column, *value;
+    const struct join_table *other;
+
+    if (cond->type != EXPR_COMPLEX && cond->type != EXPR_STRCMP)
+        return FALSE;
+
+    if (cond->type == EXPR_COMPLEX && cond->u.expr.op == OP_AND)
+        return find_index_condition( wv, cond->u.expr.left, table, rows, col, val ) ||
+               find_index_condition( wv, cond->u.expr.right, table, rows, col, val );
+
+    if (cond->u.expr.op != OP_EQ)
+        return FALSE;
+
+    column = cond->u.expr.left;
+    value = cond->u.expr.right;
+    if (!is_table_column( column, table ))
+    {
+        column = cond->u.expr.right;
+        value = cond->u.expr.left;
+        if (!is_table_column( column, table ))
+            return FALSE;
+    }
+
+    switch (value->type)
+    {
+    case EXPR_COL_NUMBER:
+    case EXPR_COL_NUMBER32:
+    case EXPR_COL_NUMBER_STRING:
+        /* join to a table that already has a current row */
+        other = value->u.column.parsed.table;
+        if (value->type != column->type || other == table || rows[other->table_index] == INVALID_ROW_INDEX)
+            return FALSE;
+        if (other->view->ops->fetch_int( other->view, rows[other->table_index], value->u.column.parsed.column, val ))
+            return FALSE;
+        /* null strings compare equal to empty ones */
+        if (column->type == EXPR_COL_NUMBER_STRING && !*val)
+            return FALSE;
+        break;
+
+    case EXPR_UVAL:
+        if (column->type == EXPR_COL_NUMBER)
+            *val = value->u.uval + 0x8000;
+        else if (column->type == EXPR_COL_NUMBER32)
+            *val = value->u.uval + 0x80000000;
+        else
+            return FALSE;
+        break;
+
+    case EXPR_SVAL:
+        if (column->type != EXPR_COL_NUMBER_STRING || !value->u.sval[0] ||
+            msi_string2id( wv->db->strings, value->u.sval, -1, val ) != ERROR_SUCCESS)
+            return FALSE;
+        break;
+
+    default:
+        return FALSE;
+    }
+
+    *col = column->u.column.parsed.column;
+    return TRUE;
+}
+
+static UINT check_condition( MSIWHEREVIEW *wv, MSIRECORD *record, struct join_table **tables,
+                             UINT table_rows[] );
+
+static UINT check_row( MSIWHEREVIEW *wv, MSIRECORD *record, struct join_table **tables,
+                       UINT table_rows[], BOOL *done )
+{
+    UINT r;
+    INT val = 0;
+
+    *done = TRUE;
+    wv->rec_index = 0;
+    r = WHERE_evaluate( wv, table_rows, wv->cond, &val, record );
+    if (r != ERROR_SUCCESS && r != ERROR_CONTINUE)
+        return r;
+    if (val)
+    {
+        if (*(tables + 1))
+        {
+            r = check_condition(wv, record, tables + 1, table_rows);
+            if (r != ERROR_SUCCESS)
+                return r;
+        }
+        else
+        {
+            if (r != ERROR_SUCCESS)
+                return r;
+            add_row (wv, table_rows);
+        }
+    }
+    *done = FALSE;
+    return r;
+}
+
 static UINT check_condition( MSIWHEREVIEW *wv, MSIRECORD *record, struct join_table **tables,
                              UINT table_rows[] )
 {
-    UINT r = ERROR_FUNCTION_FAILED;
-    INT val;
+    struct join_table *table = *tables;
+    UINT *row = &table_rows[table->table_index];
+    UINT r = ERROR_FUNCTION_FAILED, col, val;
+    BOOL done = FALSE;
 
-    for (table_rows[(*tables)->table_index] = 0;
-         table_rows[(*tables)->table_index] < (*tables)->row_count;
-         table_rows[(*tables)->table_index]++)
+    if (wv->cond && table->view->ops->find_matching_rows &&
+        find_index_condition( wv, wv->cond, table, table_rows, &col, &val ))
     {
-        val = 0;
-        wv->rec_index = 0;
-        r = WHERE_evaluate( wv, table_rows, wv->cond, &val, record );
-        if (r != ERROR_SUCCESS && r != ERROR_CONTINUE)
-            break;
-        if (val)
+        MSIITERHANDLE handle = NULL;
+        UINT res;
+
+        r = ERROR_SUCCESS;
+        while (!done)
         {
-            if (*(tables + 1))
-            {
-                r = check_condition(wv, record, tables + 1, table_rows);
-                if (r != ERROR_SUCCESS)
-                    break;
-            }
-            else
+            res = table->view->ops->find_matching_rows( table->view, col, val, row, &handle );
+            if (res != ERROR_SUCCESS)
             {
-                if (r != ERROR_SUCCESS)
-                    break;
-                add_row (wv, table_rows);
+                if (res != ERROR_NO_MORE_ITEMS)
+                    r = res;
+                break;
             }
+            r = check_row( wv, record, tables, table_rows, &done );
+        }
+    }
+    else
+    {
+        for (*row = 0; *row < table->row_count; (*row)++)
+        {
+            r = check_row( wv, record, tables, table_rows, &done );
+            if (done)
+                break;
         }
     }
-    table_rows[(*tables)->table_index] = INVALID_ROW_INDEX;
+    *row = INVALID_ROW_INDEX;
     return r;
 }
 
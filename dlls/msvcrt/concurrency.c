@@ -155,6 +155,8 @@ typedef struct {
     HANDLE *shutdown_events;
     CRITICAL_SECTION cs;
     struct list scheduled_chores;
+    TP_POOL *pool;
+    TP_CALLBACK_ENVIRON env;
 } ThreadScheduler;
 extern const vtable_ptr ThreadScheduler_vtable;
 
@@ -1418,6 +1420,9 @@ static void ThreadScheduler_dtor(ThreadScheduler *this)
     LIST_FOR_EACH_ENTRY_SAFE(sc, next, &this->scheduled_chores,
             struct scheduled_chore, entry)
         operator_delete(sc);
+
+    if(this->pool)
+        CloseThreadpool(this->pool);
 }
 
 DEFINE_THISCALL_WRAPPER(ThreadScheduler_Id, 4)
@@ -1575,7 +1580,7 @@ void __thiscall ThreadScheduler_ScheduleTask_loc(ThreadScheduler *this,
     arg->scheduler = this;
     ThreadScheduler_Reference(this);
 
-    work = CreateThreadpoolWork(schedule_task_proc, arg, NULL);
+    work = CreateThreadpoolWork(schedule_task_proc, arg, &this->env);
     if(!work) {
         scheduler_resource_allocation_error e;
 
@@ -1628,6 +1633,7 @@ Scheduler* __thiscall ThreadScheduler_vector_dtor(ThreadScheduler *this, unsigne
 static ThreadScheduler* ThreadScheduler_ctor(ThreadScheduler *this,
         const SchedulerPolicy *policy)
 {
+    unsigned int min_concurrency;
     SYSTEM_INFO si;
 
     TRACE("(%p)->()\n", this);
@@ -1649,6 +1655,19 @@ static ThreadScheduler* ThreadScheduler_ctor(ThreadScheduler *this,
     this->cs.DebugInfo->Spare[0] = (DWORD_PTR)(__FILE__ ": ThreadScheduler");
 
     list_init(&this->scheduled_chores);
+
+    /* run the tasks in a pool of our own, keeping enough worker threads
+     * alive for MinConcurrency tasks to run without waiting for new ones */
+    memset(&this->env, 0, sizeof(this->env));
+    this->env.Version = 1;
+    this->pool = CreateThreadpool(NULL);
+    if(this->pool) {
+        min_concurrency = SchedulerPolicy_GetPolicyValue(&this->policy, MinConcurrency);
+        if(min_concurrency > this->virt_proc_no)
+            min_concurrency = this->virt_proc_no;
+        SetThreadpoolThreadMinimum(this->pool, min_concurrency);
+        this->env.Pool = this->pool;
+    }
     return this;
 }
 
@@ -91,6 +91,9 @@ static char utf16_bom[2] = { 0xff, 0xfe };
 
 #define MSVCRT_INTERNAL_BUFSIZ 4096
 
+/* same spin count as native uses for the stream locks */
+#define MSVCRT_FILE_CS_SPIN_COUNT 4000
+
 enum textmode
 {
     TEXTMODE_ANSI,
@@ -633,7 +636,7 @@ static FILE* msvcrt_alloc_fp(void)
           CRITICAL_SECTION *cs = file_get_cs(file);
           if (cs)
           {
-              InitializeCriticalSectionEx(cs, 0, RTL_CRITICAL_SECTION_FLAG_FORCE_DEBUG_INFO);
+              InitializeCriticalSectionEx(cs, MSVCRT_FILE_CS_SPIN_COUNT, RTL_CRITICAL_SECTION_FLAG_FORCE_DEBUG_INFO);
               cs->DebugInfo->Spare[0] = (DWORD_PTR)(__FILE__ ": file_crit.crit");
           }
           MSVCRT_stream_idx++;
@@ -824,7 +827,7 @@ void msvcrt_init_io(void)
 
     if (cs)
     {
-      InitializeCriticalSectionEx(cs, 0, RTL_CRITICAL_SECTION_FLAG_FORCE_DEBUG_INFO);
+      InitializeCriticalSectionEx(cs, MSVCRT_FILE_CS_SPIN_COUNT, RTL_CRITICAL_SECTION_FLAG_FORCE_DEBUG_INFO);
       cs->DebugInfo->Spare[0] = (DWORD_PTR)(__FILE__ ": file_crit.crit");
     }
   }
@@ -3912,19 +3915,38 @@ char * CDECL fgets(char *s, int size, FILE* file)
 
   _lock_file(file);
 
-  while ((size >1) && (cc = _fgetc_nolock(file)) != EOF && cc != '\n')
+  while (size > 1)
+  {
+    if (file->_cnt > 0)
+    {
+      /* copy straight from the buffer up to the end of the line */
+      int len = min(file->_cnt, size - 1);
+      char *nl = memchr(file->_ptr, '\n', len);
+
+      if (nl) len = nl - file->_ptr + 1;
+      memcpy(s, file->_ptr, len);
+      s += len;
+      size -= len;
+      file->_ptr += len;
+      file->_cnt -= len;
+      cc = (unsigned char)s[-1];
+    }
+    else
     {
+      if ((cc = _fgetc_nolock(file)) == EOF)
+        break;
       *s++ = (char)cc;
-      size --;
+      size--;
     }
+    if (cc == '\n')
+      break;
+  }
   if ((cc == EOF) && (s == buf_start)) /* If nothing read, return 0*/
   {
     TRACE(":nothing read\n");
     _unlock_file(file);
     return NULL;
   }
-  if ((cc != EOF) && (size > 1))
-    *s++ = cc;
   *s = '\0';
   TRACE(":got %s\n", debugstr_a(buf_start));
   _unlock_file(file);
@@ -830,7 +830,12 @@ int CDECL wmemcpy_s(wchar_t *dest, size_t numberOfElements,
 BOOL msvcrt_init_heap(void)
 {
 #if _MSVCR_VER <= 100
+    ULONG lfh = 2;
+
     heap = HeapCreate(0, 0, 0);
+    /* serve small blocks from the low fragmentation heap size classes right
+     * away instead of waiting for the heap to enable them on its own */
+    if (heap) HeapSetInformation(heap, HeapCompatibilityInformation, &lfh, sizeof(lfh));
 #else
     heap = GetProcessHeap();
 #endif
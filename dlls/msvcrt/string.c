@@ -353,6 +353,14 @@ void CDECL _swab(char* src, char* dst, int len)
   }
 }
 
+static const ULONGLONG p10s_64[] =
+{
+    1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000,
+    10000000000, 100000000000, 1000000000000, 10000000000000, 100000000000000,
+    1000000000000000, 10000000000000000, 100000000000000000, 1000000000000000000,
+    10000000000000000000ull
+};
+
 static struct fpnum fpnum(int sign, int exp, ULONGLONG m, enum fpmod mod)
 {
     struct fpnum ret;
@@ -754,6 +762,9 @@ static struct fpnum fpnum_parse_bnum(wchar_t (*get)(void *ctx), void (*unget)(vo
     enum fpmod round = FP_ROUND_ZERO;
     wchar_t nch;
     ULONGLONG m;
+    /* significant digits, as long as they fit in 64 bits */
+    ULONGLONG int_m = 0;
+    int int_digits = 0;
 
     nch = get(ctx);
     if(nch == '-') {
@@ -824,6 +835,7 @@ static struct fpnum fpnum_parse_bnum(wchar_t (*get)(void *ctx), void (*unget)(vo
 
         b->data[bnum_idx(b, b->b)] = b->data[bnum_idx(b, b->b)] * 10 + nch - '0';
         limb_digits++;
+        if(int_digits++ < 19) int_m = int_m * 10 + nch - '0';
         nch = get(ctx);
         dp++;
     }
@@ -831,6 +843,7 @@ static struct fpnum fpnum_parse_bnum(wchar_t (*get)(void *ctx), void (*unget)(vo
         if(nch != '0') b->data[bnum_idx(b, b->b)] |= 1;
         nch = get(ctx);
         dp++;
+        int_digits++;
     }
 
     if(nch == *locinfo->lconv->decimal_point) {
@@ -860,11 +873,13 @@ static struct fpnum fpnum_parse_bnum(wchar_t (*get)(void *ctx), void (*unget)(vo
 
         b->data[bnum_idx(b, b->b)] = b->data[bnum_idx(b, b->b)] * 10 + nch - '0';
         limb_digits++;
+        if(int_digits++ < 19) int_m = int_m * 10 + nch - '0';
         nch = get(ctx);
     }
     while(nch>='0' && nch<='9') {
         if(nch != '0') b->data[bnum_idx(b, b->b)] |= 1;
         nch = get(ctx);
+        int_digits++;
     }
 
     if(!found_digit) {
@@ -915,6 +930,11 @@ static struct fpnum fpnum_parse_bnum(wchar_t (*get)(void *ctx), void (*unget)(vo
     if(!b->data[bnum_idx(b, b->e-1)])
         return fpnum(sign, 0, 0, 0);
 
+    /* integer values that fit in 64 bits don't need the bnum conversion */
+    if(int_digits <= 19 && dp >= int_digits && dp - int_digits < ARRAY_SIZE(p10s_64) &&
+            int_m <= ~(ULONGLONG)0 / p10s_64[dp - int_digits])
+        return fpnum(sign, 0, int_m * p10s_64[dp - int_digits], FP_ROUND_ZERO);
+
     /* Fill last limb with 0 if needed */
     if(b->b+1 != b->e) {
         for(; limb_digits != LIMB_DIGITS; limb_digits++)
@@ -1559,13 +1579,26 @@ int CDECL _atoldbl(_LDOUBLE *value, char *str)
     return _atoldbl_l( value, str, NULL );
 }
 
+#define BYTE_ONES  ((size_t)-1 / 0xff)
+#define BYTE_HIGHS (BYTE_ONES << 7)
+
+static inline BOOL has_zero_byte(size_t x)
+{
+    return ((x - BYTE_ONES) & ~x & BYTE_HIGHS) != 0;
+}
+
 /*********************************************************************
  *              strlen (MSVCRT.@)
  */
 size_t __cdecl strlen(const char *str)
 {
     const char *s = str;
-    while (*s) s++;
+    const size_t *w;
+
+    /* aligned word reads never cross a page boundary */
+    for (; (size_t)s % sizeof(size_t); s++) if (!*s) return s - str;
+    for (w = (const size_t *)s; !has_zero_byte(*w); w++);
+    for (s = (const char *)w; *s; s++);
     return s - str;
 }
 
@@ -3272,8 +3305,13 @@ char* __cdecl strrchr(const char *str, int c)
 void* __cdecl memchr(const void *ptr, int c, size_t n)
 {
     const unsigned char *p = ptr;
+    size_t mask = BYTE_ONES * (unsigned char)c;
 
-    for (p = ptr; n; n--, p++) if (*p == (unsigned char)c) return (void *)(ULONG_PTR)p;
+    for (; n && (size_t)p % sizeof(size_t); n--, p++)
+        if (*p == (unsigned char)c) return (void *)(ULONG_PTR)p;
+    for (; n >= sizeof(size_t); n -= sizeof(size_t), p += sizeof(size_t))
+        if (has_zero_byte(*(const size_t *)p ^ mask)) break;
+    for (; n; n--, p++) if (*p == (unsigned char)c) return (void *)(ULONG_PTR)p;
     return NULL;
 }
 
@@ -3282,6 +3320,18 @@ void* __cdecl memchr(const void *ptr, int c, size_t n)
  */
 int __cdecl strcmp(const char *str1, const char *str2)
 {
+    if ((size_t)str1 % sizeof(size_t) == (size_t)str2 % sizeof(size_t))
+    {
+        while ((size_t)str1 % sizeof(size_t) && *str1 && *str1 == *str2) { str1++; str2++; }
+        if ((size_t)str1 % sizeof(size_t) == 0)
+        {
+            while (*(const size_t *)str1 == *(const size_t *)str2 && !has_zero_byte(*(const size_t *)str1))
+            {
+                str1 += sizeof(size_t);
+                str2 += sizeof(size_t);
+            }
+        }
+    }
     while (*str1 && *str1 == *str2) { str1++; str2++; }
     if ((unsigned char)*str1 > (unsigned char)*str2) return 1;
     if ((unsigned char)*str1 < (unsigned char)*str2) return -1;
@@ -2969,7 +2969,17 @@ wchar_t* CDECL wcsrchr(const wchar_t *str, wchar_t ch)
  */
 size_t CDECL wcslen(const wchar_t *str)
 {
+    static const size_t ones = (size_t)-1 / 0xffff;
     const wchar_t *s = str;
+    const size_t *w;
+
+    /* aligned word reads never cross a page boundary */
+    if ((size_t)s % sizeof(wchar_t) == 0)
+    {
+        for (; (size_t)s % sizeof(size_t); s++) if (!*s) return s - str;
+        for (w = (const size_t *)s; !((*w - ones) & ~*w & (ones << 15)); w++);
+        s = (const wchar_t *)w;
+    }
     while (*s) s++;
     return s - str;
 }
@@ -43,6 +43,7 @@ struct bsc_t {
 
     void *obj;
     HRESULT (*onDataAvailable)(void*,char*,DWORD);
+    BOOL chunked;
 
     IBinding *binding;
     IStream *memstream;
@@ -116,6 +117,10 @@ static HRESULT WINAPI bsc_OnStartBinding(
     This->binding = pib;
     IBinding_AddRef(pib);
 
+    /* Chunked consumers get the data as it arrives, nothing needs to be buffered. */
+    if(This->chunked)
+        return S_OK;
+
     hr = CreateStreamOnHGlobal(NULL, TRUE, &This->memstream);
     if(FAILED(hr))
         return hr;
@@ -162,7 +167,11 @@ static HRESULT WINAPI bsc_OnStopBinding(
         This->binding = NULL;
     }
 
-    if(This->obj && SUCCEEDED(hresult)) {
+    if(This->chunked) {
+        /* A NULL chunk signals the end of data. */
+        if(This->obj && SUCCEEDED(hresult) && SUCCEEDED(This->hres))
+            This->hres = This->onDataAvailable(This->obj, NULL, 0);
+    }else if(This->obj && SUCCEEDED(hresult)) {
         HGLOBAL hglobal;
         hr = GetHGlobalFromStream(This->memstream, &hglobal);
         if(SUCCEEDED(hr))
@@ -209,7 +218,12 @@ static HRESULT WINAPI bsc_OnDataAvailable(
         if(FAILED(hr))
             break;
 
-        hr = IStream_Write(bsc->memstream, buf, read, &written);
+        if(bsc->chunked) {
+            if(read && bsc->obj && SUCCEEDED(bsc->hres))
+                bsc->hres = bsc->onDataAvailable(bsc->obj, (char*)buf, read);
+            written = read;
+        }else
+            hr = IStream_Write(bsc->memstream, buf, read, &written);
     } while(SUCCEEDED(hr) && written != 0 && read != 0);
 
     return S_OK;
@@ -296,8 +310,8 @@ HRESULT create_moniker_from_url(LPCWSTR url, IMoniker **mon)
     return hr;
 }
 
-HRESULT bind_url(IMoniker *mon, HRESULT (*onDataAvailable)(void*,char*,DWORD),
-        void *obj, bsc_t **ret)
+static HRESULT bind_url_mode(IMoniker *mon, HRESULT (*onDataAvailable)(void*,char*,DWORD),
+        void *obj, BOOL chunked, bsc_t **ret)
 {
     bsc_t *bsc;
     IBindCtx *pbc;
@@ -315,6 +329,7 @@ HRESULT bind_url(IMoniker *mon, HRESULT (*onDataAvailable)(void*,char*,DWORD),
     bsc->ref = 1;
     bsc->obj = obj;
     bsc->onDataAvailable = onDataAvailable;
+    bsc->chunked = chunked;
     bsc->binding = NULL;
     bsc->memstream = NULL;
     bsc->hres = S_OK;
@@ -339,6 +354,19 @@ HRESULT bind_url(IMoniker *mon, HRESULT (*onDataAvailable)(void*,char*,DWORD),
     return hr;
 }
 
+HRESULT bind_url(IMoniker *mon, HRESULT (*onDataAvailable)(void*,char*,DWORD),
+        void *obj, bsc_t **ret)
+{
+    return bind_url_mode(mon, onDataAvailable, obj, FALSE, ret);
+}
+
+/* Same as bind_url(), but passes each chunk to the callback as soon as it's read. */
+HRESULT bind_url_chunked(IMoniker *mon, HRESULT (*onData)(void*,char*,DWORD),
+        void *obj, bsc_t **ret)
+{
+    return bind_url_mode(mon, onData, obj, TRUE, ret);
+}
+
 HRESULT detach_bsc(bsc_t *bsc)
 {
     HRESULT hres;
@@ -64,8 +64,31 @@ typedef struct {
     LONG selectNsStr_len;
     BOOL XPath;
     IUri *uri;
+    struct list xpath_cache;
+    unsigned int xpath_cache_size;
 } domdoc_properties;
 
+/* Compiled selection queries, most recently used first. */
+#define XPATH_CACHE_SIZE 16
+
+struct xpath_cache_entry
+{
+    struct list entry;
+    xmlChar *query;
+    xmlChar *ns;
+    BOOL xpath;
+    xmlXPathCompExprPtr comp;
+};
+
+static CRITICAL_SECTION xpath_cache_cs;
+static CRITICAL_SECTION_DEBUG xpath_cache_cs_dbg =
+{
+    0, 0, &xpath_cache_cs,
+    { &xpath_cache_cs_dbg.ProcessLocksList, &xpath_cache_cs_dbg.ProcessLocksList },
+      0, 0, { (DWORD_PTR)(__FILE__ ": xpath_cache") }
+};
+static CRITICAL_SECTION xpath_cache_cs = { &xpath_cache_cs_dbg, -1, 0, 0, 0, 0 };
+
 typedef struct ConnectionPoint ConnectionPoint;
 typedef struct domdoc domdoc;
 
@@ -236,6 +259,83 @@ int registerNamespaces(xmlXPathContextPtr ctxt)
     return n;
 }
 
+static void free_xpath_cache_entry(struct xpath_cache_entry *entry)
+{
+    xmlXPathFreeCompExpr(entry->comp);
+    xmlFree(entry->query);
+    xmlFree(entry->ns);
+    free(entry);
+}
+
+static void clear_xpath_cache(domdoc_properties *properties)
+{
+    struct xpath_cache_entry *entry, *entry2;
+
+    LIST_FOR_EACH_ENTRY_SAFE(entry, entry2, &properties->xpath_cache, struct xpath_cache_entry, entry)
+        free_xpath_cache_entry(entry);
+    list_init(&properties->xpath_cache);
+    properties->xpath_cache_size = 0;
+}
+
+/* Takes a compiled query out of the cache, callers return it with put_cached_xpath(). The key includes
+   selection language and namespaces, because both affect how the query is compiled. */
+xmlXPathCompExprPtr get_cached_xpath(xmlDocPtr doc, const xmlChar *query, BOOL xpath)
+{
+    domdoc_properties *properties = properties_from_xmlDocPtr(doc);
+    struct xpath_cache_entry *entry;
+    xmlXPathCompExprPtr comp = NULL;
+
+    EnterCriticalSection(&xpath_cache_cs);
+    LIST_FOR_EACH_ENTRY(entry, &properties->xpath_cache, struct xpath_cache_entry, entry)
+    {
+        if (entry->xpath == xpath && xmlStrEqual(entry->query, query) &&
+                xmlStrEqual(entry->ns, properties->selectNsStr))
+        {
+            list_remove(&entry->entry);
+            properties->xpath_cache_size--;
+            comp = entry->comp;
+            entry->comp = NULL;
+            break;
+        }
+    }
+    LeaveCriticalSection(&xpath_cache_cs);
+
+    if (comp)
+        free_xpath_cache_entry(entry);
+    return comp;
+}
+
+void put_cached_xpath(xmlDocPtr doc, const xmlChar *query, BOOL xpath, xmlXPathCompExprPtr comp)
+{
+    domdoc_properties *properties = properties_from_xmlDocPtr(doc);
+    struct xpath_cache_entry *entry, *evicted = NULL;
+
+    if (!(entry = malloc(sizeof(*entry))))
+    {
+        xmlXPathFreeCompExpr(comp);
+        return;
+    }
+
+    entry->query = xmlStrdup(query);
+    entry->xpath = xpath;
+    entry->comp = comp;
+
+    EnterCriticalSection(&xpath_cache_cs);
+    entry->ns = xmlStrdup(properties->selectNsStr);
+    if (properties->xpath_cache_size == XPATH_CACHE_SIZE)
+    {
+        evicted = LIST_ENTRY(list_tail(&properties->xpath_cache), struct xpath_cache_entry, entry);
+        list_remove(&evicted->entry);
+        properties->xpath_cache_size--;
+    }
+    list_add_head(&properties->xpath_cache, &entry->entry);
+    properties->xpath_cache_size++;
+    LeaveCriticalSection(&xpath_cache_cs);
+
+    if (evicted)
+        free_xpath_cache_entry(evicted);
+}
+
 static inline void clear_selectNsList(struct list* pNsList)
 {
     select_ns_entry *ns, *ns2;
@@ -280,6 +380,9 @@ static domdoc_properties *create_properties(MSXML_VERSION version)
     /* document uri */
     properties->uri = NULL;
 
+    list_init(&properties->xpath_cache);
+    properties->xpath_cache_size = 0;
+
     return properties;
 }
 
@@ -319,6 +422,9 @@ static domdoc_properties* copy_properties(domdoc_properties const* properties)
         pcopy->uri = properties->uri;
         if (pcopy->uri)
             IUri_AddRef(pcopy->uri);
+
+        list_init(&pcopy->xpath_cache);
+        pcopy->xpath_cache_size = 0;
     }
 
     return pcopy;
@@ -354,6 +460,7 @@ static void properties_release(domdoc_properties *properties)
             IXMLDOMSchemaCollection2_Release(properties->schemaCache);
         clear_selectNsList(&properties->selectNsList);
         free((xmlChar*)properties->selectNsStr);
+        clear_xpath_cache(properties);
         if (properties->uri)
             IUri_Release(properties->uri);
         free(properties);
@@ -211,6 +211,8 @@ extern void wineXmlCallbackError(char const* caller, const xmlError* err);
 extern BOOL is_preserving_whitespace(xmlNodePtr node);
 extern BOOL is_xpathmode(const xmlDocPtr doc);
 extern void set_xpathmode(xmlDocPtr doc, BOOL xpath);
+extern xmlXPathCompExprPtr get_cached_xpath(xmlDocPtr doc, const xmlChar *query, BOOL xpath);
+extern void put_cached_xpath(xmlDocPtr doc, const xmlChar *query, BOOL xpath, xmlXPathCompExprPtr comp);
 
 extern void init_xmlnode(xmlnode*,xmlNodePtr,IXMLDOMNode*,dispex_static_data_t*);
 extern void destroy_xmlnode(xmlnode*);
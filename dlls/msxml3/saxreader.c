@@ -2554,24 +2554,18 @@ static HRESULT internal_parseBuffer(saxreader *This, const char *buffer, int siz
     return hr;
 }
 
-static HRESULT internal_parseStream(saxreader *This, ISequentialStream *stream, BOOL vbInterface)
+static HRESULT push_parser_create(saxreader *This, const char *data, ULONG size, BOOL vbInterface,
+        saxlocator **ret)
 {
     saxlocator *locator;
     HRESULT hr;
-    ULONG dataRead;
-    char data[2048];
-    int ret;
-
-    dataRead = 0;
-    hr = ISequentialStream_Read(stream, data, sizeof(data), &dataRead);
-    if(FAILED(hr)) return hr;
 
     hr = SAXLocator_create(This, &locator, vbInterface);
     if(FAILED(hr)) return hr;
 
     locator->pParserCtxt = xmlCreatePushParserCtxt(
             &locator->saxreader->sax, locator,
-            data, dataRead, NULL);
+            data, size, NULL);
     if(!locator->pParserCtxt)
     {
         ISAXLocator_Release(&locator->ISAXLocator_iface);
@@ -2579,28 +2573,53 @@ static HRESULT internal_parseStream(saxreader *This, ISequentialStream *stream,
     }
 
     This->isParsing = TRUE;
+    *ret = locator;
+    return S_OK;
+}
+
+static HRESULT push_parser_chunk(saxlocator *locator, const char *data, ULONG size, BOOL terminate)
+{
+    int ret;
+
+    ret = xmlParseChunk(locator->pParserCtxt, data, size, terminate);
+    return ret!=XML_ERR_OK && locator->ret==S_OK ? E_FAIL : locator->ret;
+}
+
+static void push_parser_free(saxlocator *locator)
+{
+    locator->saxreader->isParsing = FALSE;
+
+    xmlFreeParserCtxt(locator->pParserCtxt);
+    locator->pParserCtxt = NULL;
+    ISAXLocator_Release(&locator->ISAXLocator_iface);
+}
+
+static HRESULT internal_parseStream(saxreader *This, ISequentialStream *stream, BOOL vbInterface)
+{
+    saxlocator *locator;
+    HRESULT hr;
+    ULONG dataRead;
+    char data[2048];
+
+    dataRead = 0;
+    hr = ISequentialStream_Read(stream, data, sizeof(data), &dataRead);
+    if(FAILED(hr)) return hr;
+
+    hr = push_parser_create(This, data, dataRead, vbInterface, &locator);
+    if(FAILED(hr)) return hr;
 
     do {
         dataRead = 0;
         hr = ISequentialStream_Read(stream, data, sizeof(data), &dataRead);
         if (FAILED(hr) || !dataRead) break;
 
-        ret = xmlParseChunk(locator->pParserCtxt, data, dataRead, 0);
-        hr = ret!=XML_ERR_OK && locator->ret==S_OK ? E_FAIL : locator->ret;
+        hr = push_parser_chunk(locator, data, dataRead, FALSE);
     }while(hr == S_OK);
 
     if(SUCCEEDED(hr))
-    {
-        ret = xmlParseChunk(locator->pParserCtxt, data, 0, 1);
-        hr = ret!=XML_ERR_OK && locator->ret==S_OK ? E_FAIL : locator->ret;
-    }
-
-
-    This->isParsing = FALSE;
+        hr = push_parser_chunk(locator, data, 0, TRUE);
 
-    xmlFreeParserCtxt(locator->pParserCtxt);
-    locator->pParserCtxt = NULL;
-    ISAXLocator_Release(&locator->ISAXLocator_iface);
+    push_parser_free(locator);
     return hr;
 }
 
@@ -2689,22 +2708,31 @@ static HRESULT internal_parse(
     return hr;
 }
 
-static HRESULT internal_vbonDataAvailable(void *obj, char *ptr, DWORD len)
+struct url_parser
 {
-    saxreader *This = obj;
-
-    return internal_parseBuffer(This, ptr, len, TRUE);
-}
+    saxreader *reader;
+    saxlocator *locator;
+    BOOL vbInterface;
+};
 
-static HRESULT internal_onDataAvailable(void *obj, char *ptr, DWORD len)
+/* Downloaded data is fed to the push parser as it arrives, a NULL chunk terminates the document. */
+static HRESULT internal_onURLData(void *obj, char *ptr, DWORD len)
 {
-    saxreader *This = obj;
+    struct url_parser *parser = obj;
+    HRESULT hr;
 
-    return internal_parseBuffer(This, ptr, len, FALSE);
+    if(!parser->locator)
+    {
+        hr = push_parser_create(parser->reader, ptr, len, parser->vbInterface, &parser->locator);
+        if(FAILED(hr) || ptr) return hr;
+    }
+
+    return push_parser_chunk(parser->locator, ptr, len, !ptr);
 }
 
 static HRESULT internal_parseURL(saxreader *reader, const WCHAR *url, BOOL vbInterface)
 {
+    struct url_parser parser = { reader, NULL, vbInterface };
     IMoniker *mon;
     bsc_t *bsc;
     HRESULT hr;
@@ -2718,14 +2746,15 @@ static HRESULT internal_parseURL(saxreader *reader, const WCHAR *url, BOOL vbInt
     if(FAILED(hr))
         return hr;
 
-    if(vbInterface) hr = bind_url(mon, internal_vbonDataAvailable, reader, &bsc);
-    else hr = bind_url(mon, internal_onDataAvailable, reader, &bsc);
+    hr = bind_url_chunked(mon, internal_onURLData, &parser, &bsc);
     IMoniker_Release(mon);
 
-    if(FAILED(hr))
-        return hr;
+    if(SUCCEEDED(hr))
+        hr = detach_bsc(bsc);
 
-    return detach_bsc(bsc);
+    if(parser.locator)
+        push_parser_free(parser.locator);
+    return hr;
 }
 
 static HRESULT saxreader_put_handler_from_variant(saxreader *This, enum saxhandler_type type, const VARIANT *v, BOOL vb)
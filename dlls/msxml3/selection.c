@@ -766,6 +766,8 @@ HRESULT create_selection(xmlNodePtr node, xmlChar* query, IXMLDOMNodeList **out)
 {
     domselection *This = malloc(sizeof(domselection));
     xmlXPathContextPtr ctxt = xmlXPathNewContext(node->doc);
+    xmlXPathCompExprPtr comp;
+    BOOL xpath;
     HRESULT hr;
 
     TRACE("(%p, %s, %p)\n", node, debugstr_a((char const*)query), out);
@@ -791,15 +793,13 @@ HRESULT create_selection(xmlNodePtr node, xmlChar* query, IXMLDOMNodeList **out)
     registerNamespaces(ctxt);
     xmlXPathContextSetCache(ctxt, 1, -1, 0);
 
-    if (is_xpathmode(This->node->doc))
+    xpath = is_xpathmode(This->node->doc);
+    if (xpath)
     {
         xmlXPathRegisterAllFunctions(ctxt);
-        This->result = xmlXPathEvalExpression(query, ctxt);
     }
     else
     {
-        xmlChar* pattern_query = XSLPattern_to_XPath(ctxt, query);
-
         xmlXPathRegisterFunc(ctxt, (xmlChar const*)"not", xmlXPathNotFunction);
         xmlXPathRegisterFunc(ctxt, (xmlChar const*)"boolean", xmlXPathBooleanFunction);
 
@@ -813,10 +813,27 @@ HRESULT create_selection(xmlNodePtr node, xmlChar* query, IXMLDOMNodeList **out)
         xmlXPathRegisterFunc(ctxt, (xmlChar const*)"OP_ILEq", XSLPattern_OP_ILEq);
         xmlXPathRegisterFunc(ctxt, (xmlChar const*)"OP_IGt", XSLPattern_OP_IGt);
         xmlXPathRegisterFunc(ctxt, (xmlChar const*)"OP_IGEq", XSLPattern_OP_IGEq);
+    }
+
+    if (!(comp = get_cached_xpath(This->node->doc, query, xpath)))
+    {
+        if (xpath)
+            comp = xmlXPathCtxtCompile(ctxt, query);
+        else
+        {
+            xmlChar* pattern_query = XSLPattern_to_XPath(ctxt, query);
+            comp = xmlXPathCtxtCompile(ctxt, pattern_query);
+            xmlFree(pattern_query);
+        }
+    }
 
-        This->result = xmlXPathEvalExpression(pattern_query, ctxt);
-        xmlFree(pattern_query);
+    if (comp)
+    {
+        This->result = xmlXPathCompiledEval(comp, ctxt);
+        put_cached_xpath(This->node->doc, query, xpath, comp);
     }
+    else
+        This->result = NULL;
 
     if (!This->result || This->result->type != XPATH_NODESET)
     {
@@ -24,6 +24,8 @@
 
 #include "config.h"
 #include <stdarg.h>
+#include <pthread.h>
+#include <time.h>
 #include <sys/types.h>
 #include <sys/socket.h>
 
@@ -159,12 +161,102 @@ struct ip6stat {
 #include "ipmib.h"
 #include "netiodef.h"
 #include "wine/nsi.h"
+#include "wine/list.h"
 #include "wine/debug.h"
 
 #include "unix_private.h"
 
 WINE_DEFAULT_DEBUG_CHANNEL(nsi);
 
+/* Tables are enumerated over and over by polling clients, so keep the last
+ * getifaddrs() result around for a short while.  It is also dropped as soon
+ * as an address or link change is reported by the notification code. */
+#define IFADDRS_CACHE_TIMEOUT 1000 /* ms */
+
+struct ifaddrs_snapshot
+{
+    struct list entry;
+    struct ifaddrs *addrs;
+    unsigned int refs;
+};
+
+static pthread_mutex_t ifaddrs_lock = PTHREAD_MUTEX_INITIALIZER;
+static struct list ifaddrs_snapshots = LIST_INIT( ifaddrs_snapshots );
+static struct ifaddrs_snapshot *ifaddrs_current;
+static ULONGLONG ifaddrs_current_time;
+
+static ULONGLONG monotonic_time_ms( void )
+{
+    struct timespec ts;
+
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+    return (ULONGLONG)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+static void release_ifaddrs_snapshot( struct ifaddrs_snapshot *snapshot )
+{
+    if (--snapshot->refs) return;
+    list_remove( &snapshot->entry );
+    freeifaddrs( snapshot->addrs );
+    free( snapshot );
+}
+
+void ip_addresses_changed( void )
+{
+    pthread_mutex_lock( &ifaddrs_lock );
+    if (ifaddrs_current) release_ifaddrs_snapshot( ifaddrs_current );
+    ifaddrs_current = NULL;
+    pthread_mutex_unlock( &ifaddrs_lock );
+}
+
+/* same as getifaddrs(), the result must be released with put_ifaddrs() */
+static int get_ifaddrs( struct ifaddrs **addrs )
+{
+    struct ifaddrs_snapshot *snapshot;
+    ULONGLONG now = monotonic_time_ms();
+    int ret = 0;
+
+    pthread_mutex_lock( &ifaddrs_lock );
+    if (ifaddrs_current && now - ifaddrs_current_time >= IFADDRS_CACHE_TIMEOUT)
+    {
+        release_ifaddrs_snapshot( ifaddrs_current );
+        ifaddrs_current = NULL;
+    }
+    if (!ifaddrs_current)
+    {
+        if (!(snapshot = malloc( sizeof(*snapshot) ))) ret = -1;
+        else if ((ret = getifaddrs( &snapshot->addrs ))) free( snapshot );
+        else
+        {
+            snapshot->refs = 1;
+            list_add_head( &ifaddrs_snapshots, &snapshot->entry );
+            ifaddrs_current = snapshot;
+            ifaddrs_current_time = now;
+        }
+    }
+    if (!ret)
+    {
+        ifaddrs_current->refs++;
+        *addrs = ifaddrs_current->addrs;
+    }
+    pthread_mutex_unlock( &ifaddrs_lock );
+    return ret;
+}
+
+static void put_ifaddrs( struct ifaddrs *addrs )
+{
+    struct ifaddrs_snapshot *snapshot;
+
+    pthread_mutex_lock( &ifaddrs_lock );
+    LIST_FOR_EACH_ENTRY( snapshot, &ifaddrs_snapshots, struct ifaddrs_snapshot, entry )
+    {
+        if (snapshot->addrs != addrs) continue;
+        release_ifaddrs_snapshot( snapshot );
+        break;
+    }
+    pthread_mutex_unlock( &ifaddrs_lock );
+}
+
 static inline UINT nsi_popcount( UINT m )
 {
 #ifdef HAVE___BUILTIN_POPCOUNT
@@ -832,7 +924,7 @@ static NTSTATUS ip_interface_fill( UINT fam, const char *unix_name, void *key_da
     UINT num = 0, scope_id = 0xffffffff;
     NET_LUID luid;
 
-    if (getifaddrs( &addrs )) return STATUS_NO_MORE_ENTRIES;
+    if (get_ifaddrs( &addrs )) return STATUS_NO_MORE_ENTRIES;
 
     if (fam == AF_INET6) addr_scopes = get_ipv6_addr_scope_table( &addr_scopes_size );
 
@@ -933,7 +1025,7 @@ static NTSTATUS ip_interface_fill( UINT fam, const char *unix_name, void *key_da
         }
         if (!count)
         {
-            freeifaddrs( addrs );
+            put_ifaddrs( addrs );
             free( addr_scopes );
             return STATUS_SUCCESS;
         }
@@ -943,7 +1035,7 @@ static NTSTATUS ip_interface_fill( UINT fam, const char *unix_name, void *key_da
         if (dyn) ++dyn;
         if (stat) ++stat;
     }
-    freeifaddrs( addrs );
+    put_ifaddrs( addrs );
     free( addr_scopes );
 
     if (!count) return STATUS_NOT_FOUND;
@@ -1063,7 +1155,7 @@ static NTSTATUS ip_unicast_enumerate_all( int family, void *key_data, UINT key_s
     TRACE( "%p %d %p %d %p %d %p %d %p\n", key_data, key_size, rw_data, rw_size,
            dynamic_data, dynamic_size, static_data, static_size, count );
 
-    if (getifaddrs( &addrs )) return STATUS_NO_MORE_ENTRIES;
+    if (get_ifaddrs( &addrs )) return STATUS_NO_MORE_ENTRIES;
 
     for (entry = addrs; entry; entry = entry->ifa_next)
     {
@@ -1080,7 +1172,7 @@ static NTSTATUS ip_unicast_enumerate_all( int family, void *key_data, UINT key_s
         num++;
     }
 
-    freeifaddrs( addrs );
+    put_ifaddrs( addrs );
 
     if (!want_data || num <= *count) *count = num;
     else status = STATUS_BUFFER_OVERFLOW;
@@ -1120,7 +1212,7 @@ static NTSTATUS ip_unicast_get_all_parameters( const void *key, UINT key_size, v
 
     if (!convert_luid_to_unix_name( &key6->luid, &unix_name )) return STATUS_NOT_FOUND;
 
-    if (getifaddrs( &addrs )) return STATUS_NO_MORE_ENTRIES;
+    if (get_ifaddrs( &addrs )) return STATUS_NO_MORE_ENTRIES;
 
     for (entry = addrs; entry; entry = entry->ifa_next)
     {
@@ -1137,7 +1229,7 @@ static NTSTATUS ip_unicast_get_all_parameters( const void *key, UINT key_size, v
         break;
     }
 
-    freeifaddrs( addrs );
+    put_ifaddrs( addrs );
     return status;
 }
 
@@ -1506,7 +1598,7 @@ static NTSTATUS ipv4_forward_enumerate_all( void *key_data, UINT key_size, void
         FILE *fp;
 
         /* Loopback routes are not present in /proc/net/routes, add those explicitly. */
-        if (getifaddrs( &addrs )) return STATUS_NO_MORE_ENTRIES;
+        if (get_ifaddrs( &addrs )) return STATUS_NO_MORE_ENTRIES;
         for (ifentry = addrs; ifentry; ifentry = ifentry->ifa_next)
         {
             if (!(ifentry->ifa_flags & IFF_LOOPBACK)) continue;
@@ -1541,7 +1633,7 @@ static NTSTATUS ipv4_forward_enumerate_all( void *key_data, UINT key_size, void
             num++;
             break;
         }
-        freeifaddrs( addrs );
+        put_ifaddrs( addrs );
 
         if (!(fp = fopen( "/proc/net/route", "r" ))) return STATUS_NOT_SUPPORTED;
 
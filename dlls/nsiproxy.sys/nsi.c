@@ -207,7 +207,7 @@ static NTSTATUS poll_events(void)
 
         memset( &addr, 0, sizeof(addr) );
         addr.nl_family = AF_NETLINK;
-        addr.nl_groups = RTMGRP_IPV4_IFADDR | RTMGRP_IPV6_IFADDR;
+        addr.nl_groups = RTMGRP_LINK | RTMGRP_IPV4_IFADDR | RTMGRP_IPV6_IFADDR;
         if (bind( netlink_fd, (struct sockaddr *)&addr, sizeof(addr) ) == -1)
         {
             close( netlink_fd );
@@ -229,6 +229,11 @@ static NTSTATUS poll_events(void)
         for (nlh = (struct nlmsghdr *)buffer; NLMSG_OK(nlh, len); nlh = NLMSG_NEXT(nlh, len))
         {
             if (nlh->nlmsg_type == NLMSG_DONE) break;
+            if (nlh->nlmsg_type == RTM_NEWLINK || nlh->nlmsg_type == RTM_DELLINK)
+            {
+                ip_addresses_changed();
+                continue;
+            }
             if (nlh->nlmsg_type == RTM_NEWADDR || nlh->nlmsg_type == RTM_DELADDR)
             {
                 struct ifaddrmsg *addrmsg = (struct ifaddrmsg *)(nlh + 1);
@@ -241,6 +246,7 @@ static NTSTATUS poll_events(void)
                     WARN( "Unknown addrmsg->ifa_family %d.\n", addrmsg->ifa_family );
                     continue;
                 }
+                ip_addresses_changed();
                 if ((status = add_notification( module, NSI_IP_UNICAST_TABLE))) return status;
             }
         }
@@ -298,6 +304,7 @@ static NTSTATUS poll_events(void)
                 case KEV_INET_NEW_ADDR:
                 case KEV_INET_CHANGED_ADDR:
                 case KEV_INET_ADDR_DELETED:
+                    ip_addresses_changed();
                     if ((status = add_notification( &NPI_MS_IPV4_MODULEID, NSI_IP_UNICAST_TABLE))) return status;
                     break;
             }
@@ -311,6 +318,7 @@ static NTSTATUS poll_events(void)
                 case KEV_INET6_ADDR_DELETED:
                 case KEV_INET6_NEW_LL_ADDR:
                 case KEV_INET6_NEW_RTADV_ADDR:
+                    ip_addresses_changed();
                     if ((status = add_notification( &NPI_MS_IPV6_MODULEID, NSI_IP_UNICAST_TABLE))) return status;
                     break;
             }
@@ -127,6 +127,7 @@ struct ipv6_addr_scope
     UINT scope;
 };
 
+void ip_addresses_changed( void );
 struct ipv6_addr_scope *get_ipv6_addr_scope_table( unsigned int *size );
 UINT find_ipv6_addr_scope( const IN6_ADDR *addr, const struct ipv6_addr_scope *table, unsigned int size );
 
@@ -37,6 +37,7 @@
 #include "wine/debug.h"
 
 WINE_DEFAULT_DEBUG_CHANNEL(heap);
+WINE_DECLARE_DEBUG_CHANNEL(heapprof);
 
 /* HeapCompatibilityInformation values */
 
@@ -169,6 +170,10 @@ C_ASSERT( HEAP_MAX_FREE_BLOCK_SIZE >= HEAP_MAX_BLOCK_REGION_SIZE );
 /* minimum size to start allocating large blocks */
 #define HEAP_MIN_LARGE_BLOCK_SIZE  (HEAP_MAX_USED_BLOCK_SIZE - 0x1000)
 
+/* number and maximum size of freed large block regions kept for reuse */
+#define HEAP_LARGE_CACHE_COUNT     4
+#define HEAP_LARGE_CACHE_MAX_SIZE  (16 * 1024 * 1024)
+
 #define FREE_LIST_LINEAR_BITS 2
 #define FREE_LIST_LINEAR_MASK ((1 << FREE_LIST_LINEAR_BITS) - 1)
 #define FREE_LIST_COUNT ((FIELD_BITS( struct block, block_size ) - FREE_LIST_LINEAR_BITS + 1) * (1 << FREE_LIST_LINEAR_BITS) + 1)
@@ -293,6 +298,7 @@ struct heap
     struct list      entry;         /* Entry in process heap list */
     struct list      subheap_list;  /* Sub-heap list */
     struct list      large_list;    /* Large blocks list */
+    ARENA_LARGE     *large_cache[HEAP_LARGE_CACHE_COUNT]; /* Freed large blocks kept for reuse */
     SIZE_T           grow_size;     /* Size of next subheap for growing heap */
     SIZE_T           min_size;      /* Minimum committed size */
     DWORD            magic;         /* Magic number */
@@ -1002,6 +1008,49 @@ static void *allocate_region( struct heap *heap, ULONG flags, SIZE_T *region_siz
 }
 
 
+static inline SIZE_T large_arena_region_size( const ARENA_LARGE *arena )
+{
+    return (char *)&arena->block - (char *)arena + arena->block_size;
+}
+
+/* take a cached large block region at least total_size big, heap must be locked */
+static ARENA_LARGE *heap_get_cached_large( struct heap *heap, SIZE_T total_size )
+{
+    ARENA_LARGE *arena;
+    SIZE_T region_size;
+    UINT i;
+
+    for (i = 0; i < HEAP_LARGE_CACHE_COUNT; i++)
+    {
+        if (!(arena = heap->large_cache[i])) continue;
+        region_size = large_arena_region_size( arena );
+        /* don't waste too much memory on a mostly unused region */
+        if (region_size < total_size || region_size - total_size > total_size / 4) continue;
+        heap->large_cache[i] = NULL;
+        return arena;
+    }
+
+    return NULL;
+}
+
+/* keep a freed large block region for reuse, heap must be locked */
+static BOOL heap_put_cached_large( struct heap *heap, ULONG flags, ARENA_LARGE *arena )
+{
+    UINT i;
+
+    if (flags & HEAP_CHECKING_ENABLED) return FALSE;
+    if (large_arena_region_size( arena ) > HEAP_LARGE_CACHE_MAX_SIZE) return FALSE;
+
+    for (i = 0; i < HEAP_LARGE_CACHE_COUNT; i++)
+    {
+        if (heap->large_cache[i]) continue;
+        heap->large_cache[i] = arena;
+        return TRUE;
+    }
+
+    return FALSE;
+}
+
 static NTSTATUS heap_allocate_large( struct heap *heap, ULONG flags, SIZE_T block_size,
                                      SIZE_T size, void **ret )
 {
@@ -1010,7 +1059,19 @@ static NTSTATUS heap_allocate_large( struct heap *heap, ULONG flags, SIZE_T bloc
     struct block *block;
 
     if (total_size < size) return STATUS_NO_MEMORY;  /* overflow */
-    if (!(arena = allocate_region( heap, flags, &total_size, &total_size ))) return STATUS_NO_MEMORY;
+
+    heap_lock( heap, flags );
+    arena = heap_get_cached_large( heap, total_size );
+    heap_unlock( heap, flags );
+
+    if (arena)
+    {
+        /* reused regions are already committed and faulted in, clear them as fresh pages would be */
+        total_size = large_arena_region_size( arena );
+        valgrind_make_writable( arena, total_size );
+        memset( arena, 0, total_size );
+    }
+    else if (!(arena = allocate_region( heap, flags, &total_size, &total_size ))) return STATUS_NO_MEMORY;
 
     block = &arena->block;
     arena->data_size = size;
@@ -1038,11 +1099,18 @@ static NTSTATUS heap_free_large( struct heap *heap, ULONG flags, struct block *b
     ARENA_LARGE *arena = CONTAINING_RECORD( block, ARENA_LARGE, block );
     LPVOID address = arena;
     SIZE_T size = 0;
+    BOOL cached;
 
     heap_lock( heap, flags );
     list_remove( &arena->entry );
+    cached = heap_put_cached_large( heap, flags, arena );
     heap_unlock( heap, flags );
 
+    if (cached)
+    {
+        valgrind_make_noaccess( arena, large_arena_region_size( arena ) );
+        return STATUS_SUCCESS;
+    }
     return NtFreeVirtualMemory( NtCurrentProcess(), &address, &size, MEM_RELEASE );
 }
 
@@ -1532,6 +1600,7 @@ HANDLE WINAPI RtlCreateHeap( ULONG flags, void *addr, SIZE_T total_size, SIZE_T
     heap->min_size      = commit_size;
     list_init( &heap->subheap_list );
     list_init( &heap->large_list );
+    memset( heap->large_cache, 0, sizeof(heap->large_cache) );
 
     list_init( &heap->free_lists[0].entry );
     for (i = 0, entry = heap->free_lists; i < FREE_LIST_COUNT; i++, entry++)
@@ -1619,7 +1688,7 @@ HANDLE WINAPI RtlDestroyHeap( HANDLE handle )
     ARENA_LARGE *arena, *arena_next;
     struct block **pending, **tmp;
     struct heap *heap;
-    ULONG heap_flags;
+    ULONG heap_flags, i;
     SIZE_T size;
     void *addr;
 
@@ -1662,6 +1731,12 @@ HANDLE WINAPI RtlDestroyHeap( HANDLE handle )
         addr = arena;
         NtFreeVirtualMemory( NtCurrentProcess(), &addr, &size, MEM_RELEASE );
     }
+    for (i = 0; i < HEAP_LARGE_CACHE_COUNT; i++)
+    {
+        if (!(addr = heap->large_cache[i])) continue;
+        size = 0;
+        NtFreeVirtualMemory( NtCurrentProcess(), &addr, &size, MEM_RELEASE );
+    }
     LIST_FOR_EACH_ENTRY_SAFE( subheap, next, &heap->subheap_list, SUBHEAP, entry )
     {
         if (subheap == &heap->subheap) continue;  /* do this one last */
@@ -1861,10 +1936,12 @@ static inline ULONG heap_current_thread_affinity(void)
 static struct group *heap_acquire_bin_group( struct heap *heap, ULONG flags, SIZE_T block_size, struct bin *bin )
 {
     ULONG affinity = NtCurrentTeb()->HeapVirtualAffinity;
+    struct group **slot = bin_get_affinity_group( bin, affinity );
     struct group *group;
     SLIST_ENTRY *entry;
 
-    if ((group = InterlockedExchangePointer( (void *)bin_get_affinity_group( bin, affinity ), NULL )))
+    /* the slot is empty after its group got fully used, don't lock the cache line for nothing */
+    if (ReadPointerNoFence( (void **)slot ) && (group = InterlockedExchangePointer( (void *)slot, NULL )))
         return group;
 
     if ((entry = RtlInterlockedPopEntrySList( &bin->groups )))
@@ -1876,12 +1953,12 @@ static struct group *heap_acquire_bin_group( struct heap *heap, ULONG flags, SIZ
 /* release a thread owned and fully freed group to the bin shared group, or free its memory */
 static NTSTATUS heap_release_bin_group( struct heap *heap, ULONG flags, struct bin *bin, struct group *group )
 {
-    ULONG affinity = group->affinity;
+    struct group **slot = bin_get_affinity_group( bin, group->affinity );
 
     /* using InterlockedExchangePointer here would possibly return a group that has used blocks,
      * we prefer keeping our fully freed group instead for reduced memory consumption.
      */
-    if (!InterlockedCompareExchangePointer( (void *)bin_get_affinity_group( bin, affinity ), group, NULL ))
+    if (!ReadPointerNoFence( (void **)slot ) && !InterlockedCompareExchangePointer( (void *)slot, group, NULL ))
         return STATUS_SUCCESS;
 
     /* try re-using the block group instead of releasing it */
@@ -2013,8 +2090,9 @@ static void heap_thread_detach_bin_groups( struct heap *heap )
     for (i = 0; i < BLOCK_SIZE_BIN_COUNT; ++i)
     {
         struct bin *bin = heap->bins + i;
-        struct group *group;
-        if (!(group = InterlockedExchangePointer( (void *)bin_get_affinity_group( bin, affinity ), NULL ))) continue;
+        struct group **slot = bin_get_affinity_group( bin, affinity ), *group;
+        if (!ReadPointerNoFence( (void **)slot )) continue;
+        if (!(group = InterlockedExchangePointer( (void *)slot, NULL ))) continue;
         RtlInterlockedPushEntrySList( &bin->groups, &group->entry );
     }
 }
@@ -2033,6 +2111,119 @@ void heap_thread_detach(void)
     RtlLeaveCriticalSection( &process_heap->cs );
 }
 
+/* Sampling allocation profiler, enabled with WINEDEBUG=+heapprof. A backtrace is recorded
+ * approximately every HEAP_PROFILE_INTERVAL allocated bytes, and the totals per call site are
+ * printed at process exit in the legacy pprof heap profile format. */
+
+#define HEAP_PROFILE_INTERVAL  (512 * 1024)
+#define HEAP_PROFILE_FRAMES    32
+#define HEAP_PROFILE_SITES     4096
+
+struct heap_profile_site
+{
+    ULONG     hash;
+    ULONG     frame_count;
+    ULONGLONG count;
+    ULONGLONG bytes;
+    void     *frames[HEAP_PROFILE_FRAMES];
+};
+
+static LONG heap_profile_countdown = HEAP_PROFILE_INTERVAL;
+static struct heap_profile_site *heap_profile_sites;
+static ULONG heap_profile_site_count;
+static RTL_SRWLOCK heap_profile_lock = RTL_SRWLOCK_INIT;
+
+static void heap_profile_sample( SIZE_T size )
+{
+    LONG step = min( size, HEAP_PROFILE_INTERVAL );
+    void *frames[HEAP_PROFILE_FRAMES];
+    struct heap_profile_site *site;
+    ULONG i, hash, frame_count;
+
+    if (InterlockedExchangeAdd( &heap_profile_countdown, -step ) > step) return;
+    InterlockedExchange( &heap_profile_countdown, HEAP_PROFILE_INTERVAL );
+
+    if (!(frame_count = RtlCaptureStackBackTrace( 2, ARRAY_SIZE(frames), frames, NULL ))) return;
+    for (i = 0, hash = frame_count; i < frame_count; i++)
+        hash = hash * 0x9e3779b1 + (ULONG)((ULONG_PTR)frames[i] >> 4);
+
+    RtlAcquireSRWLockExclusive( &heap_profile_lock );
+
+    if (!heap_profile_sites)
+    {
+        SIZE_T alloc_size = HEAP_PROFILE_SITES * sizeof(*heap_profile_sites);
+        void *addr = NULL;
+
+        if (!NtAllocateVirtualMemory( NtCurrentProcess(), &addr, 0, &alloc_size,
+                                      MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE ))
+            heap_profile_sites = addr;
+    }
+
+    for (i = hash % HEAP_PROFILE_SITES; heap_profile_sites; i = (i + 1) % HEAP_PROFILE_SITES)
+    {
+        site = heap_profile_sites + i;
+        if (!site->frame_count)
+        {
+            /* keep some room so that lookups don't degenerate */
+            if (heap_profile_site_count >= HEAP_PROFILE_SITES * 3 / 4) break;
+            heap_profile_site_count++;
+            site->hash = hash;
+            site->frame_count = frame_count;
+            memcpy( site->frames, frames, frame_count * sizeof(*frames) );
+        }
+        else if (site->hash != hash || site->frame_count != frame_count ||
+                 memcmp( site->frames, frames, frame_count * sizeof(*frames) )) continue;
+
+        site->count++;
+        site->bytes += size;
+        break;
+    }
+
+    RtlReleaseSRWLockExclusive( &heap_profile_lock );
+}
+
+/* print the profile, the loader lock must be held */
+void heap_profile_dump(void)
+{
+    ULONGLONG total_count = 0, total_bytes = 0;
+    LDR_DATA_TABLE_ENTRY *mod;
+    LIST_ENTRY *entry;
+    ULONG i, j;
+
+    if (!TRACE_ON(heapprof) || !heap_profile_sites) return;
+
+    RtlAcquireSRWLockExclusive( &heap_profile_lock );
+
+    for (i = 0; i < HEAP_PROFILE_SITES; i++)
+    {
+        total_count += heap_profile_sites[i].count;
+        total_bytes += heap_profile_sites[i].bytes;
+    }
+
+    /* live allocations aren't tracked, only report the cumulative totals */
+    MESSAGE( "heap profile: 0: 0 [%I64u: %I64u] @ heap_v2/%u\n", total_count, total_bytes, HEAP_PROFILE_INTERVAL );
+    for (i = 0; i < HEAP_PROFILE_SITES; i++)
+    {
+        const struct heap_profile_site *site = heap_profile_sites + i;
+        if (!site->frame_count) continue;
+        MESSAGE( "0: 0 [%I64u: %I64u] @", site->count, site->bytes );
+        for (j = 0; j < site->frame_count; j++) MESSAGE( " 0x%Ix", (ULONG_PTR)site->frames[j] );
+        MESSAGE( "\n" );
+    }
+
+    MESSAGE( "\nMAPPED_LIBRARIES:\n" );
+    for (entry = NtCurrentTeb()->Peb->LdrData->InLoadOrderModuleList.Flink;
+         entry != &NtCurrentTeb()->Peb->LdrData->InLoadOrderModuleList; entry = entry->Flink)
+    {
+        mod = CONTAINING_RECORD( entry, LDR_DATA_TABLE_ENTRY, InLoadOrderLinks );
+        MESSAGE( "%Ix-%Ix r-xp 00000000 00:00 0 %.*ls\n", (ULONG_PTR)mod->DllBase,
+                 (ULONG_PTR)mod->DllBase + mod->SizeOfImage,
+                 (int)(mod->FullDllName.Length / sizeof(WCHAR)), mod->FullDllName.Buffer );
+    }
+
+    RtlReleaseSRWLockExclusive( &heap_profile_lock );
+}
+
 /***********************************************************************
  *           RtlAllocateHeap   (NTDLL.@)
  */
@@ -2066,6 +2257,7 @@ void *WINAPI DECLSPEC_HOTPATCH RtlAllocateHeap( HANDLE handle, ULONG flags, SIZE
     }
 
     if (!status) valgrind_notify_alloc( ptr, size, flags & HEAP_ZERO_MEMORY );
+    if (!status && TRACE_ON(heapprof)) heap_profile_sample( size );
 
     TRACE( "handle %p, flags %#lx, size %#Ix, return %p, status %#lx.\n", handle, flags, size, ptr, status );
     heap_set_status( heap, flags, status );
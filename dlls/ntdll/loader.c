@@ -192,6 +192,7 @@ static LDR_DDAG_NODE *node_ntdll, *node_kernel32;
 
 static NTSTATUS load_dll( const WCHAR *load_path, const WCHAR *libname, DWORD flags, WINE_MODREF** pwm, BOOL system );
 static NTSTATUS process_attach( LDR_DDAG_NODE *node, LPVOID lpReserved );
+static NTSTATUS get_env_var( const WCHAR *name, SIZE_T extra, UNICODE_STRING *ret );
 static FARPROC find_ordinal_export( HMODULE module, const IMAGE_EXPORT_DIRECTORY *exports,
                                     DWORD exp_size, DWORD ordinal, LPCWSTR load_path,
                                     WINE_MODREF *importer, BOOL is_dynamic );
@@ -1674,6 +1675,126 @@ static void call_tls_callbacks( HMODULE module, UINT reason )
     }
 }
 
+/* startup timeline, written in Chrome trace event format when WINESTARTUPTRACE is set */
+#define STARTUP_TRACE_MAX_EVENTS 1024
+
+struct startup_trace_event
+{
+    const char   *phase;
+    WCHAR         name[32];
+    LARGE_INTEGER start;
+    LARGE_INTEGER end;
+};
+
+static struct startup_trace_event *startup_trace_events;
+static unsigned int startup_trace_count;
+
+static inline void startup_trace_start( LARGE_INTEGER *time )
+{
+    if (startup_trace_events) NtQuerySystemTime( time );
+    else time->QuadPart = 0;
+}
+
+/* record an event that started at 'start'; called with the loader lock held */
+static void startup_trace_add( const char *phase, const WCHAR *name, LARGE_INTEGER start )
+{
+    struct startup_trace_event *event;
+    size_t len;
+
+    if (!startup_trace_events || startup_trace_count >= STARTUP_TRACE_MAX_EVENTS) return;
+    event = &startup_trace_events[startup_trace_count++];
+    event->phase = phase;
+    len = min( wcslen( name ), ARRAY_SIZE(event->name) - 1 );
+    memcpy( event->name, name, len * sizeof(WCHAR) );
+    event->name[len] = 0;
+    event->start = start;
+    NtQuerySystemTime( &event->end );
+}
+
+static void startup_trace_init(void)
+{
+    UNICODE_STRING path;
+
+    if (get_env_var( L"WINESTARTUPTRACE", 0, &path )) return;
+    RtlFreeUnicodeString( &path );
+    startup_trace_events = RtlAllocateHeap( GetProcessHeap(), 0,
+                                            STARTUP_TRACE_MAX_EVENTS * sizeof(*startup_trace_events) );
+}
+
+static void startup_trace_write_event( HANDLE file, const char *phase, const WCHAR *name,
+                                       LONGLONG start, LONGLONG end, BOOL first )
+{
+    char buffer[256], name_str[ARRAY_SIZE(startup_trace_events->name)];
+    IO_STATUS_BLOCK io;
+    unsigned int i;
+    int len;
+
+    /* keep it to plain ASCII, there is no need to escape anything then */
+    for (i = 0; name[i]; i++)
+        name_str[i] = (name[i] >= ' ' && name[i] < 0x7f && name[i] != '"' && name[i] != '\\') ? name[i] : '?';
+    name_str[i] = 0;
+
+    len = _snprintf( buffer, sizeof(buffer),
+                     "%s{\"name\":\"%s%s%s\",\"cat\":\"startup\",\"ph\":\"X\",\"ts\":%I64d,\"dur\":%I64d,"
+                     "\"pid\":%lu,\"tid\":%lu}",
+                     first ? "" : ",\n", phase, name_str[0] ? " " : "", name_str, start / 10, (end - start) / 10,
+                     HandleToULong( NtCurrentTeb()->ClientId.UniqueProcess ),
+                     HandleToULong( NtCurrentTeb()->ClientId.UniqueThread ));
+    if (len > 0) NtWriteFile( file, 0, NULL, NULL, &io, buffer, len, NULL, NULL );
+}
+
+/* write the collected events to "<WINESTARTUPTRACE>.<pid>.json" */
+static void startup_trace_write(void)
+{
+    static const char header[] = "{\"traceEvents\":[\n", footer[] = "\n]}\n";
+    KERNEL_USER_TIMES times;
+    UNICODE_STRING path, nt_name;
+    OBJECT_ATTRIBUTES attr;
+    IO_STATUS_BLOCK io;
+    LARGE_INTEGER now;
+    HANDLE file;
+    unsigned int i;
+
+    if (!startup_trace_events) return;
+    NtQuerySystemTime( &now );
+
+    if (get_env_var( L"WINESTARTUPTRACE", 32, &path )) goto done;
+    swprintf( path.Buffer + path.Length / sizeof(WCHAR), 32, L".%lu.json",
+              HandleToULong( NtCurrentTeb()->ClientId.UniqueProcess ));
+    if (RtlDosPathNameToNtPathName_U_WithStatus( path.Buffer, &nt_name, NULL, NULL ))
+    {
+        RtlFreeUnicodeString( &path );
+        goto done;
+    }
+    RtlFreeUnicodeString( &path );
+
+    InitializeObjectAttributes( &attr, &nt_name, OBJ_CASE_INSENSITIVE, 0, NULL );
+    if (!NtCreateFile( &file, GENERIC_WRITE | SYNCHRONIZE, &attr, &io, NULL, 0, 0, FILE_OVERWRITE_IF,
+                       FILE_SYNCHRONOUS_IO_NONALERT | FILE_NON_DIRECTORY_FILE, NULL, 0 ))
+    {
+        NtWriteFile( file, 0, NULL, NULL, &io, header, sizeof(header) - 1, NULL, NULL );
+        /* the process creation time covers the process spawn and the server side setup */
+        if (!NtQueryInformationProcess( GetCurrentProcess(), ProcessTimes, &times, sizeof(times), NULL ))
+            startup_trace_write_event( file, "process startup", L"", times.CreateTime.QuadPart,
+                                       now.QuadPart, TRUE );
+        else
+            startup_trace_write_event( file, "loader init", L"", startup_trace_events[0].start.QuadPart,
+                                       now.QuadPart, TRUE );
+        for (i = 0; i < startup_trace_count; i++)
+            startup_trace_write_event( file, startup_trace_events[i].phase, startup_trace_events[i].name,
+                                       startup_trace_events[i].start.QuadPart,
+                                       startup_trace_events[i].end.QuadPart, FALSE );
+        NtWriteFile( file, 0, NULL, NULL, &io, footer, sizeof(footer) - 1, NULL, NULL );
+        NtClose( file );
+    }
+    RtlFreeUnicodeString( &nt_name );
+
+done:
+    RtlFreeHeap( GetProcessHeap(), 0, startup_trace_events );
+    startup_trace_events = NULL;
+}
+
+
 /*************************************************************************
  *              MODULE_InitDLL
  */
@@ -1683,6 +1804,7 @@ static NTSTATUS MODULE_InitDLL( WINE_MODREF *wm, UINT reason, LPVOID lpReserved
     NTSTATUS status = STATUS_SUCCESS;
     DLLENTRYPROC entry = wm->ldr.EntryPoint;
     void *module = wm->ldr.DllBase;
+    LARGE_INTEGER start;
     BOOL retv = FALSE;
 
     /* Skip calls for modules loaded with special load flags */
@@ -1691,17 +1813,21 @@ static NTSTATUS MODULE_InitDLL( WINE_MODREF *wm, UINT reason, LPVOID lpReserved
     if (wm->ldr.TlsIndex == -1) call_tls_callbacks( wm->ldr.DllBase, reason );
     if (!entry) return STATUS_SUCCESS;
 
-    if (TRACE_ON(relay))
+    if (TRACE_ON(relay) || startup_trace_events)
     {
         size_t len = min( wm->ldr.BaseDllName.Length, sizeof(mod_name)-sizeof(WCHAR) );
         memcpy( mod_name, wm->ldr.BaseDllName.Buffer, len );
         mod_name[len / sizeof(WCHAR)] = 0;
+    }
+
+    if (TRACE_ON(relay))
         TRACE_(relay)("\1Call PE DLL (proc=%p,module=%p %s,reason=%s,res=%p)\n",
                       entry, module, debugstr_w(mod_name), reason_names[reason], lpReserved );
-    }
     else TRACE("(%p %s,%s,%p) - CALL\n", module, debugstr_w(wm->ldr.BaseDllName.Buffer),
                reason_names[reason], lpReserved );
 
+    startup_trace_start( &start );
+
     __TRY
     {
         retv = call_dll_entry_point( entry, module, reason, lpReserved );
@@ -1719,6 +1845,7 @@ static NTSTATUS MODULE_InitDLL( WINE_MODREF *wm, UINT reason, LPVOID lpReserved
     /* The state of the module list may have changed due to the call
        to the dll. We cannot assume that this module has not been
        deleted.  */
+    startup_trace_add( reason_names[reason], mod_name, start );
     if (TRACE_ON(relay))
         TRACE_(relay)("\1Ret  PE DLL (proc=%p,module=%p %s,reason=%s,res=%p) retval=%x\n",
                       entry, module, debugstr_w(mod_name), reason_names[reason], lpReserved, retv );
@@ -3327,11 +3454,14 @@ static NTSTATUS load_dll( const WCHAR *load_path, const WCHAR *libname, DWORD fl
     HANDLE mapping = 0;
     SECTION_IMAGE_INFORMATION image_info;
     NTSTATUS nts = STATUS_DLL_NOT_FOUND;
+    LARGE_INTEGER start;
     BOOL redirected;
     void *prev;
 
     TRACE( "looking for %s in %s\n", debugstr_w(libname), debugstr_w(load_path) );
 
+    startup_trace_start( &start );
+
     if (system && system_dll_path.Buffer)
         nts = search_dll_file( system_dll_path.Buffer, libname, &nt_name, pwm, &mapping, &image_info, &id );
 
@@ -3374,7 +3504,10 @@ static NTSTATUS load_dll( const WCHAR *load_path, const WCHAR *libname, DWORD fl
 
 done:
     if (nts == STATUS_SUCCESS)
+    {
         TRACE("Loaded module %s at %p\n", debugstr_us(&nt_name), (*pwm)->ldr.DllBase);
+        startup_trace_add( "load", (*pwm)->ldr.BaseDllName.Buffer, start );
+    }
     else
         WARN("Failed to load module %s; status=%lx\n", debugstr_w(libname), nts);
 
@@ -3912,6 +4045,7 @@ void WINAPI LdrShutdownProcess(void)
         RtlProcessFlsData( NtCurrentTeb()->FlsSlots, 1 );
 
     process_detach();
+    heap_profile_dump();
 }
 
 
@@ -4426,6 +4560,7 @@ void loader_init( CONTEXT *context, void **entry )
     static int attach_done;
     NTSTATUS status;
     ULONG_PTR cookie, port = 0;
+    LARGE_INTEGER start;
     WINE_MODREF *wm;
 
     if (process_detaching) NtTerminateThread( GetCurrentThread(), 0 );
@@ -4462,6 +4597,8 @@ void loader_init( CONTEXT *context, void **entry )
             InitializeListHead( &hash_table[i] );
 
         init_user_process_params();
+        startup_trace_init();
+        startup_trace_start( &start );
         load_global_options();
         version_init();
         open_known_dll_ntdir();
@@ -4504,6 +4641,7 @@ void loader_init( CONTEXT *context, void **entry )
                  debugstr_w(NtCurrentTeb()->Peb->ProcessParameters->ImagePathName.Buffer), status );
             NtTerminateProcess( GetCurrentProcess(), status );
         }
+        startup_trace_add( "imports", L"", start );
         imports_fixup_done = TRUE;
     }
     else
@@ -4560,6 +4698,8 @@ void loader_init( CONTEXT *context, void **entry )
         if (wm->ldr.TlsIndex == -1) call_tls_callbacks( wm->ldr.DllBase, DLL_PROCESS_ATTACH );
         if (wm->ldr.ActivationContext) RtlDeactivateActivationContext( 0, cookie );
 
+        startup_trace_write();
+
         NtQueryInformationProcess( GetCurrentProcess(), ProcessDebugPort, &port, sizeof(port), NULL );
         if (port) process_breakpoint();
     }
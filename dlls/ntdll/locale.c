@@ -51,6 +51,13 @@ static WCHAR casemap( USHORT *table, WCHAR ch )
     return ch + table[table[table[ch >> 8] + ((ch >> 4) & 0x0f)] + (ch & 0x0f)];
 }
 
+/* the case table only maps a-z in the ASCII range, so skip the lookups there */
+static inline WCHAR upcase( WCHAR ch )
+{
+    if (ch < 0x80) return casemap_ascii( ch );
+    return casemap( nls_info.UpperCaseTable, ch );
+}
+
 
 static NTSTATUS load_norm_table( ULONG form, const struct norm_table **info )
 {
@@ -414,8 +421,11 @@ LONG WINAPI RtlCompareUnicodeStrings( const WCHAR *s1, SIZE_T len1, const WCHAR
     {
         if (nls_info.UpperCaseTable)
         {
-            while (!ret && len--) ret = casemap( nls_info.UpperCaseTable, *s1++ ) -
-                                        casemap( nls_info.UpperCaseTable, *s2++ );
+            for (; len; len--, s1++, s2++)
+            {
+                if (*s1 == *s2) continue;
+                if ((ret = upcase( *s1 ) - upcase( *s2 ))) break;
+            }
         }
         else  /* locale not setup yet */
         {
@@ -443,8 +453,8 @@ BOOLEAN WINAPI RtlPrefixUnicodeString( const UNICODE_STRING *s1, const UNICODE_S
     if (ignore_case)
     {
         for (i = 0; i < s1->Length / sizeof(WCHAR); i++)
-            if (casemap( nls_info.UpperCaseTable, s1->Buffer[i] ) !=
-                casemap( nls_info.UpperCaseTable, s2->Buffer[i] )) return FALSE;
+            if (s1->Buffer[i] != s2->Buffer[i] &&
+                upcase( s1->Buffer[i] ) != upcase( s2->Buffer[i] )) return FALSE;
     }
     else
     {
@@ -481,7 +491,7 @@ NTSTATUS WINAPI RtlHashUnicodeString( const UNICODE_STRING *string, BOOLEAN case
             *hash = *hash * 65599 + string->Buffer[i];
     else if (nls_info.UpperCaseTable)
         for (i = 0; i < string->Length / sizeof(WCHAR); i++)
-            *hash = *hash * 65599 + casemap( nls_info.UpperCaseTable, string->Buffer[i] );
+            *hash = *hash * 65599 + upcase( string->Buffer[i] );
     else  /* locale not setup yet */
         for (i = 0; i < string->Length / sizeof(WCHAR); i++)
             *hash = *hash * 65599 + casemap_ascii( string->Buffer[i] );
@@ -711,7 +721,7 @@ NTSTATUS WINAPI RtlUpcaseUnicodeString( UNICODE_STRING *dest, const UNICODE_STRI
     else if (len > dest->MaximumLength) return STATUS_BUFFER_OVERFLOW;
 
     for (i = 0; i < len / sizeof(WCHAR); i++)
-        dest->Buffer[i] = casemap( nls_info.UpperCaseTable, src->Buffer[i] );
+        dest->Buffer[i] = upcase( src->Buffer[i] );
     dest->Length = len;
     return STATUS_SUCCESS;
 }
@@ -1084,6 +1094,21 @@ NTSTATUS WINAPI RtlNormalizeString( ULONG form, const WCHAR *src, INT src_len, W
         return STATUS_SUCCESS;
     }
 
+    /* the standard forms leave ASCII unchanged, and that covers most strings */
+    if (form == NormalizationC || form == NormalizationD || form == NormalizationKC || form == NormalizationKD)
+    {
+        int i;
+
+        for (i = 0; i < src_len; i++) if (src[i] >= 0x80 || !src[i]) break;
+        if (i == src_len - 1 && !src[i]) i++;  /* allow final null */
+        if (i == src_len && *dst_len >= src_len)
+        {
+            memcpy( dst, src, src_len * sizeof(WCHAR) );
+            *dst_len = src_len;
+            return STATUS_SUCCESS;
+        }
+    }
+
     if (!info->comp_size) return decompose_string( info, src, src_len, dst, dst_len );
 
     buf_len = src_len * 4;
@@ -339,8 +339,10 @@ ULONG WINAPI EtwEventSetInformation( REGHANDLE handle, EVENT_INFO_CLASS class, v
  */
 ULONG WINAPI EtwEventWriteString( REGHANDLE handle, UCHAR level, ULONGLONG keyword, PCWSTR string )
 {
-    FIXME("%s, %u, %s, %s: stub\n", wine_dbgstr_longlong(handle), level,
-          wine_dbgstr_longlong(keyword), debugstr_w(string));
+    static int once;
+
+    if (!once++) FIXME("%s, %u, %s, %s: stub\n", wine_dbgstr_longlong(handle), level,
+                       wine_dbgstr_longlong(keyword), debugstr_w(string));
     return ERROR_SUCCESS;
 }
 
@@ -350,8 +352,10 @@ ULONG WINAPI EtwEventWriteString( REGHANDLE handle, UCHAR level, ULONGLONG keywo
 ULONG WINAPI EtwEventWriteTransfer( REGHANDLE handle, PCEVENT_DESCRIPTOR descriptor, LPCGUID activity,
                                     LPCGUID related, ULONG count, PEVENT_DATA_DESCRIPTOR data )
 {
-    FIXME("%s, %p, %s, %s, %lu, %p: stub\n", wine_dbgstr_longlong(handle), descriptor,
-          debugstr_guid(activity), debugstr_guid(related), count, data);
+    static int once;
+
+    if (!once++) FIXME("%s, %p, %s, %s, %lu, %p: stub\n", wine_dbgstr_longlong(handle), descriptor,
+                       debugstr_guid(activity), debugstr_guid(related), count, data);
     return ERROR_SUCCESS;
 }
 
@@ -438,7 +442,9 @@ BOOLEAN WINAPI EtwEventEnabled( REGHANDLE handle, const EVENT_DESCRIPTOR *descri
 ULONG WINAPI EtwEventWrite( REGHANDLE handle, const EVENT_DESCRIPTOR *descriptor, ULONG count,
     EVENT_DATA_DESCRIPTOR *data )
 {
-    FIXME("(%s, %p, %lu, %p): stub\n", wine_dbgstr_longlong(handle), descriptor, count, data);
+    static int once;
+
+    if (!once++) FIXME("(%s, %p, %lu, %p): stub\n", wine_dbgstr_longlong(handle), descriptor, count, data);
     return ERROR_SUCCESS;
 }
 
@@ -449,8 +455,10 @@ ULONG WINAPI EtwEventWriteEx( REGHANDLE handle, const EVENT_DESCRIPTOR *descript
                             ULONG flags, const GUID *activity_id, const GUID *related_activity_id,
                             ULONG data_count, EVENT_DATA_DESCRIPTOR *data )
 {
-    FIXME( "(%s, %p, %#I64x, %lu, %p, %p, %lu, %p): stub\n", wine_dbgstr_longlong(handle), descriptor, filter,
-           flags, activity_id, related_activity_id, data_count, data );
+    static int once;
+
+    if (!once++) FIXME( "(%s, %p, %#I64x, %lu, %p, %p, %lu, %p): stub\n", wine_dbgstr_longlong(handle), descriptor, filter,
+                        flags, activity_id, related_activity_id, data_count, data );
     return ERROR_SUCCESS;
 }
 
@@ -1065,23 +1065,26 @@ PVOID WINAPI RtlDecodePointer( PVOID ptr )
     return (void *)(ptrval ^ cookie);
 }
 
+/* hash chains used by the LZNT1 compressor, kept in the caller-supplied workspace */
+struct lznt1_workspace
+{
+    WORD head[0x1000];  /* most recent position + 1 for each hash value */
+    WORD prev[0x1000];  /* previous position + 1 with the same hash as each position */
+};
+
 /******************************************************************************
  *  RtlGetCompressionWorkSpaceSize		[NTDLL.@]
  */
 NTSTATUS WINAPI RtlGetCompressionWorkSpaceSize(USHORT format, PULONG compress_workspace,
                                                PULONG decompress_workspace)
 {
-    FIXME("0x%04x, %p, %p: semi-stub\n", format, compress_workspace, decompress_workspace);
+    TRACE("0x%04x, %p, %p\n", format, compress_workspace, decompress_workspace);
 
     switch (format & COMPRESSION_FORMAT_MASK)
     {
         case COMPRESSION_FORMAT_LZNT1:
             if (compress_workspace)
-            {
-                /* FIXME: The current implementation of RtlCompressBuffer does not use a
-                 * workspace buffer, but Windows applications might expect a nonzero value. */
-                *compress_workspace = 16;
-            }
+                *compress_workspace = sizeof(struct lznt1_workspace);
             if (decompress_workspace)
                 *decompress_workspace = 0x1000;
             return STATUS_SUCCESS;
@@ -1096,28 +1099,134 @@ NTSTATUS WINAPI RtlGetCompressionWorkSpaceSize(USHORT format, PULONG compress_wo
     }
 }
 
-/* compress data using LZNT1, currently only a stub */
+/* number of displacement bits in an LZNT1 back-reference at position pos of a chunk */
+static inline ULONG lznt1_displacement_bits(ULONG pos)
+{
+    ULONG bits;
+
+    for (bits = 12; bits > 4; bits--)
+        if ((1 << (bits - 1)) < pos) break;
+    return bits;
+}
+
+static inline ULONG lznt1_hash(const UCHAR *ptr)
+{
+    return ((ptr[0] << 8) ^ (ptr[1] << 4) ^ ptr[2]) & 0xfff;
+}
+
+/* compress a single LZNT1 chunk, returns NULL if the result doesn't fit before dst_end */
+static UCHAR *lznt1_compress_chunk(const UCHAR *src, ULONG src_size, UCHAR *dst, UCHAR *dst_end,
+                                   struct lznt1_workspace *workspace, ULONG max_chain)
+{
+    ULONG pos = 0, flag_bit = 8, bits, hash, chain, candidate, max_length, length, best_length, best_displacement;
+    const UCHAR *match;
+    UCHAR *flags = NULL;
+
+    memset(workspace->head, 0, sizeof(workspace->head));
+
+    while (pos < src_size)
+    {
+        if (flag_bit == 8)
+        {
+            if (dst >= dst_end) return NULL;
+            flags = dst++;
+            *flags = 0;
+            flag_bit = 0;
+        }
+
+        /* find the longest match in the hash chain, the chain is ordered from
+         * the closest to the furthest position */
+        best_length = 0;
+        best_displacement = 0;
+        bits = lznt1_displacement_bits(pos);
+        if (pos + 3 <= src_size)
+        {
+            max_length = min((1 << (16 - bits)) + 2, src_size - pos);
+            hash = lznt1_hash(src + pos);
+            for (candidate = workspace->head[hash], chain = max_chain; candidate && chain;
+                 candidate = workspace->prev[candidate - 1], chain--)
+            {
+                match = src + candidate - 1;
+                if (pos - (candidate - 1) > (1 << bits)) break;
+                if (match[best_length] != src[pos + best_length]) continue;
+                length = 0;
+                while (length < max_length && match[length] == src[pos + length]) length++;
+                if (length <= best_length) continue;
+                best_length = length;
+                best_displacement = pos - (candidate - 1);
+                if (length == max_length) break;
+            }
+        }
+
+        if (best_length >= 3)
+        {
+            if (dst + sizeof(WORD) > dst_end) return NULL;
+            *(WORD *)dst = ((best_displacement - 1) << (16 - bits)) | (best_length - 3);
+            dst += sizeof(WORD);
+            *flags |= 1 << flag_bit;
+        }
+        else
+        {
+            if (dst >= dst_end) return NULL;
+            *dst++ = src[pos];
+            best_length = 1;
+        }
+        flag_bit++;
+
+        for (; best_length; best_length--, pos++)
+        {
+            if (pos + 3 > src_size) continue;
+            hash = lznt1_hash(src + pos);
+            workspace->prev[pos] = workspace->head[hash];
+            workspace->head[hash] = pos + 1;
+        }
+    }
+
+    return dst;
+}
+
+/* compress data using LZNT1 */
 static NTSTATUS lznt1_compress(UCHAR *src, ULONG src_size, UCHAR *dst, ULONG dst_size,
-                               ULONG chunk_size, ULONG *final_size, UCHAR *workspace)
+                               ULONG chunk_size, ULONG *final_size, UCHAR *workspace, ULONG max_chain)
 {
     UCHAR *src_cur = src, *src_end = src + src_size;
     UCHAR *dst_cur = dst, *dst_end = dst + dst_size;
     ULONG block_size;
+    UCHAR *limit, *ptr;
+
+    if (!workspace) return STATUS_INVALID_PARAMETER;
 
     while (src_cur < src_end)
     {
         /* determine size of current chunk */
         block_size = min(0x1000, src_end - src_cur);
-        if (dst_cur + sizeof(WORD) + block_size > dst_end)
+        if (dst_cur + sizeof(WORD) > dst_end)
             return STATUS_BUFFER_TOO_SMALL;
 
-        /* write (uncompressed) chunk header */
-        *(WORD *)dst_cur = 0x3000 | (block_size - 1);
-        dst_cur += sizeof(WORD);
+        /* only keep the compressed chunk when it is smaller than the data */
+        if (dst_end - dst_cur > sizeof(WORD) + block_size - 1)
+            limit = dst_cur + sizeof(WORD) + block_size - 1;
+        else
+            limit = dst_end;
 
-        /* write chunk content */
-        memcpy(dst_cur, src_cur, block_size);
-        dst_cur += block_size;
+        if ((ptr = lznt1_compress_chunk(src_cur, block_size, dst_cur + sizeof(WORD), limit,
+                                        (struct lznt1_workspace *)workspace, max_chain)))
+        {
+            /* write compressed chunk header */
+            *(WORD *)dst_cur = 0xb000 | (ptr - dst_cur - sizeof(WORD) - 1);
+            dst_cur = ptr;
+        }
+        else
+        {
+            if (dst_cur + sizeof(WORD) + block_size > dst_end)
+                return STATUS_BUFFER_TOO_SMALL;
+
+            /* write uncompressed chunk header and content */
+            *(WORD *)dst_cur = 0x3000 | (block_size - 1);
+            dst_cur += sizeof(WORD);
+            memcpy(dst_cur, src_cur, block_size);
+            dst_cur += block_size;
+        }
         src_cur += block_size;
     }
 
@@ -1134,14 +1243,15 @@ NTSTATUS WINAPI RtlCompressBuffer(USHORT format, PUCHAR uncompressed, ULONG unco
                                   PUCHAR compressed, ULONG compressed_size, ULONG chunk_size,
                                   PULONG final_size, PVOID workspace)
 {
-    FIXME("0x%04x, %p, %lu, %p, %lu, %lu, %p, %p: semi-stub\n", format, uncompressed,
+    TRACE("0x%04x, %p, %lu, %p, %lu, %lu, %p, %p\n", format, uncompressed,
           uncompressed_size, compressed, compressed_size, chunk_size, final_size, workspace);
 
     switch (format & COMPRESSION_FORMAT_MASK)
     {
         case COMPRESSION_FORMAT_LZNT1:
-            return lznt1_compress(uncompressed, uncompressed_size, compressed,
-                                  compressed_size, chunk_size, final_size, workspace);
+            return lznt1_compress(uncompressed, uncompressed_size, compressed, compressed_size,
+                                  chunk_size, final_size, workspace,
+                                  (format & COMPRESSION_ENGINE_MAXIMUM) ? 256 : 16);
 
         case COMPRESSION_FORMAT_NONE:
         case COMPRESSION_FORMAT_DEFAULT:
@@ -1153,6 +1263,22 @@ NTSTATUS WINAPI RtlCompressBuffer(USHORT format, PUCHAR uncompressed, ULONG unco
     }
 }
 
+/* copy a back-reference, the source and destination can overlap when the
+ * same bytes are repeated over and over again */
+static inline void copy_backref(UCHAR *dst, ULONG displacement, ULONG length)
+{
+    if (displacement >= length)
+        memcpy(dst, dst - displacement, length);
+    else
+    {
+        while (length--)
+        {
+            *dst = *(dst - displacement);
+            dst++;
+        }
+    }
+}
+
 /* decompress a single LZNT1 chunk */
 static UCHAR *lznt1_decompress_chunk(UCHAR *dst, ULONG dst_size, UCHAR *src, ULONG src_size)
 {
@@ -1177,8 +1303,7 @@ static UCHAR *lznt1_decompress_chunk(UCHAR *dst, ULONG dst_size, UCHAR *src, ULO
                 src_cur += sizeof(WORD);
 
                 /* find length / displacement bits */
-                for (displacement_bits = 12; displacement_bits > 4; displacement_bits--)
-                    if ((1 << (displacement_bits - 1)) < dst_cur - dst) break;
+                displacement_bits = lznt1_displacement_bits(dst_cur - dst);
 
                 length_bits       = 16 - displacement_bits;
                 code_length       = (code & ((1 << length_bits) - 1)) + 3;
@@ -1187,14 +1312,13 @@ static UCHAR *lznt1_decompress_chunk(UCHAR *dst, ULONG dst_size, UCHAR *src, ULO
                 if (dst_cur < dst + code_displacement)
                     return NULL;
 
-                /* copy bytes of chunk - we can't use memcpy() since source and dest can
-                 * be overlapping, and the same bytes can be repeated over and over again */
-                while (code_length--)
+                if (code_length > dst_end - dst_cur)
                 {
-                    if (dst_cur >= dst_end) return dst_cur;
-                    *dst_cur = *(dst_cur - code_displacement);
-                    dst_cur++;
+                    copy_backref(dst_cur, code_displacement, dst_end - dst_cur);
+                    return dst_end;
                 }
+                copy_backref(dst_cur, code_displacement, code_length);
+                dst_cur += code_length;
             }
             else
             {
@@ -1357,6 +1481,95 @@ NTSTATUS WINAPI RtlDecompressFragment(USHORT format, PUCHAR uncompressed, ULONG
 }
 
 
+/* decompress data encoded with plain LZ77 Xpress */
+static NTSTATUS xpress_decompress(UCHAR *dst, ULONG dst_size, UCHAR *src, ULONG src_size,
+                                  ULONG *final_size)
+{
+    UCHAR *src_cur = src, *src_end = src + src_size;
+    UCHAR *dst_cur = dst, *dst_end = dst + dst_size;
+    ULONG flags = 0, flag_count = 0, length, displacement;
+    UCHAR *half_byte = NULL;
+    WORD code;
+
+    for (;;)
+    {
+        if (!flag_count)
+        {
+            if (src_cur + sizeof(DWORD) > src_end) break;
+            flags = *(DWORD *)src_cur;
+            src_cur += sizeof(DWORD);
+            flag_count = 32;
+        }
+        flag_count--;
+
+        if (!(flags & (1u << flag_count)))
+        {
+            /* literal byte */
+            if (src_cur >= src_end) break;
+            if (dst_cur >= dst_end) return STATUS_BAD_COMPRESSION_BUFFER;
+            *dst_cur++ = *src_cur++;
+            continue;
+        }
+
+        /* backwards reference, the end of the input is marked by a match flag */
+        if (src_cur == src_end) break;
+        if (src_cur + sizeof(WORD) > src_end) return STATUS_BAD_COMPRESSION_BUFFER;
+        code = *(WORD *)src_cur;
+        src_cur += sizeof(WORD);
+        length = code & 7;
+        displacement = (code >> 3) + 1;
+
+        if (length == 7)
+        {
+            /* extended lengths share a byte between two matches, one nibble each */
+            if (!half_byte)
+            {
+                if (src_cur >= src_end) return STATUS_BAD_COMPRESSION_BUFFER;
+                half_byte = src_cur++;
+                length = *half_byte & 0xf;
+            }
+            else
+            {
+                length = *half_byte >> 4;
+                half_byte = NULL;
+            }
+
+            if (length == 15)
+            {
+                if (src_cur >= src_end) return STATUS_BAD_COMPRESSION_BUFFER;
+                length = *src_cur++;
+                if (length == 255)
+                {
+                    if (src_cur + sizeof(WORD) > src_end) return STATUS_BAD_COMPRESSION_BUFFER;
+                    length = *(WORD *)src_cur;
+                    src_cur += sizeof(WORD);
+                    if (!length)
+                    {
+                        if (src_cur + sizeof(DWORD) > src_end) return STATUS_BAD_COMPRESSION_BUFFER;
+                        length = *(DWORD *)src_cur;
+                        src_cur += sizeof(DWORD);
+                    }
+                    if (length < 15 + 7) return STATUS_BAD_COMPRESSION_BUFFER;
+                    length -= 15 + 7;
+                }
+                length += 15;
+            }
+            length += 7;
+        }
+        length += 3;
+
+        if (displacement > dst_cur - dst || length > dst_end - dst_cur)
+            return STATUS_BAD_COMPRESSION_BUFFER;
+        copy_backref(dst_cur, displacement, length);
+        dst_cur += length;
+    }
+
+    if (final_size)
+        *final_size = dst_cur - dst;
+
+    return STATUS_SUCCESS;
+}
+
 /******************************************************************************
  *  RtlDecompressBuffer		[NTDLL.@]
  */
@@ -1366,6 +1579,10 @@ NTSTATUS WINAPI RtlDecompressBuffer(USHORT format, PUCHAR uncompressed, ULONG un
     TRACE("0x%04x, %p, %lu, %p, %lu, %p\n", format, uncompressed,
         uncompressed_size, compressed, compressed_size, final_size);
 
+    /* Xpress data can't be decompressed in fragments */
+    if ((format & COMPRESSION_FORMAT_MASK) == COMPRESSION_FORMAT_XPRESS)
+        return xpress_decompress(uncompressed, uncompressed_size, compressed, compressed_size, final_size);
+
     return RtlDecompressFragment(format, uncompressed, uncompressed_size,
                                  compressed, compressed_size, 0, final_size, NULL);
 }
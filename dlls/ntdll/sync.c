@@ -278,6 +278,10 @@ NTSTATUS WINAPI RtlDeleteCriticalSection( RTL_CRITICAL_SECTION *crit )
     crit->OwningThread   = 0;
     if (crit_section_has_debuginfo( crit ))
     {
+        if (crit->DebugInfo->EntryCount)
+            TRACE( "section %p %s: %lu contended entries, %lu waits\n", crit,
+                   debugstr_a(crit_section_get_name( crit )), crit->DebugInfo->EntryCount,
+                   crit->DebugInfo->ContentionCount );
         /* only free the ones we made in here */
         if (!crit->DebugInfo->Spare[0])
         {
@@ -320,7 +324,11 @@ NTSTATUS WINAPI RtlpWaitForCriticalSection( RTL_CRITICAL_SECTION *crit )
         ERR( "section %p %s wait timed out in thread %04lx, blocked by %04lx, retrying (%u sec)\n",
              crit, debugstr_a(crit_section_get_name(crit)), GetCurrentThreadId(), HandleToULong(crit->OwningThread), timeout );
     }
-    if (crit_section_has_debuginfo( crit )) crit->DebugInfo->ContentionCount++;
+    if (crit_section_has_debuginfo( crit ))
+    {
+        crit->DebugInfo->EntryCount++;
+        crit->DebugInfo->ContentionCount++;
+    }
     return STATUS_SUCCESS;
 }
 
@@ -353,17 +361,24 @@ NTSTATUS WINAPI RtlEnterCriticalSection( RTL_CRITICAL_SECTION *crit )
 {
     if (crit->SpinCount)
     {
-        ULONG count;
+        ULONG count, i, backoff = 1;
 
         if (RtlTryEnterCriticalSection( crit )) return STATUS_SUCCESS;
-        for (count = crit->SpinCount; count > 0; count--)
+        for (count = crit->SpinCount; count > 0; count -= min( count, backoff ))
         {
             if (crit->LockCount > 0) break;  /* more than one waiter, don't bother spinning */
             if (crit->LockCount == -1)       /* try again */
             {
-                if (InterlockedCompareExchange( &crit->LockCount, 0, -1 ) == -1) goto done;
+                if (InterlockedCompareExchange( &crit->LockCount, 0, -1 ) == -1)
+                {
+                    if (crit_section_has_debuginfo( crit )) crit->DebugInfo->EntryCount++;
+                    goto done;
+                }
             }
-            YieldProcessor();
+            /* back off exponentially so that spinning waiters don't keep
+             * hammering the cache line while the owner is trying to release it */
+            for (i = 0; i < backoff; i++) YieldProcessor();
+            if (backoff < 64) backoff *= 2;
         }
     }
 
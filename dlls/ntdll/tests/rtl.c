@@ -2438,7 +2438,6 @@ static void test_RtlCompressBuffer(void)
                                buf1, sizeof(buf1), 4096, &final_size, workspace);
     ok(status == STATUS_SUCCESS, "got wrong status 0x%08lx\n", status);
     ok((*(WORD *)buf1 & 0x7000) == 0x3000, "no chunk signature found %04x\n", *(WORD *)buf1);
-    todo_wine
     ok(final_size < sizeof(test_buffer), "got wrong final_size %lu\n", final_size);
 
     /* test decompression */
@@ -2930,6 +2929,35 @@ static void test_RtlDecompressBuffer(void)
 #undef DECOMPRESS_BROKEN_FRAGMENT
 #undef DECOMPRESS_BROKEN_TRUNCATED
 
+static void test_RtlDecompressBuffer_xpress(void)
+{
+    static const UCHAR literals[] =
+    {
+        0x3f, 0x00, 0x00, 0x00, 'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h', 'i', 'j', 'k', 'l', 'm',
+        'n', 'o', 'p', 'q', 'r', 's', 't', 'u', 'v', 'w', 'x', 'y', 'z',
+    };
+    static const UCHAR repeated[] = {0xff, 0xff, 0xff, 0x1f, 'a', 'b', 'c', 0x17, 0x00, 0x0f, 0xff, 0x26, 0x01};
+    static UCHAR buf[0x1000];
+    ULONG final_size, i;
+    NTSTATUS status;
+
+    final_size = 0xdeadbeef;
+    status = RtlDecompressBuffer(COMPRESSION_FORMAT_XPRESS, buf, sizeof(buf), (UCHAR *)literals,
+                                 sizeof(literals), &final_size);
+    ok(status == STATUS_SUCCESS, "got wrong status 0x%08lx\n", status);
+    ok(final_size == 26, "got wrong final_size %lu\n", final_size);
+    ok(!memcmp(buf, "abcdefghijklmnopqrstuvwxyz", 26), "got wrong decoded data\n");
+
+    final_size = 0xdeadbeef;
+    status = RtlDecompressBuffer(COMPRESSION_FORMAT_XPRESS, buf, sizeof(buf), (UCHAR *)repeated,
+                                 sizeof(repeated), &final_size);
+    ok(status == STATUS_SUCCESS, "got wrong status 0x%08lx\n", status);
+    ok(final_size == 300, "got wrong final_size %lu\n", final_size);
+    for (i = 0; i < final_size; i++)
+        if (buf[i] != "abc"[i % 3]) break;
+    ok(i == 300, "got wrong decoded data at %lu\n", i);
+}
+
 struct critsect_locked_info
 {
     CRITICAL_SECTION crit;
@@ -5574,6 +5602,7 @@ START_TEST(rtl)
     test_RtlCompressBuffer();
     test_RtlGetCompressionWorkSpaceSize();
     test_RtlDecompressBuffer();
+    test_RtlDecompressBuffer_xpress();
     test_RtlIsCriticalSectionLocked();
     test_RtlInitializeCriticalSectionEx();
     test_RtlLeaveCriticalSection();
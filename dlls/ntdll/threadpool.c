@@ -114,6 +114,7 @@ struct threadpool
     int                     min_workers;
     int                     num_workers;
     int                     num_busy_workers;
+    int                     num_idle_workers;
     HANDLE                  compl_port;
     TP_POOL_STACK_INFORMATION stack_info;
 };
@@ -611,18 +612,21 @@ static void queue_add_timer(struct queue_timer *t, ULONGLONG time,
 {
     /* We MUST hold the queue cs while calling this function.  */
     struct timer_queue *q = t->q;
-    struct list *ptr = &q->timers;
+    struct list *ptr;
 
     assert(!q->quit || (t->destroy && time == EXPIRE_NEVER));
 
+    /* New timers usually expire after the already queued ones, so
+       search for the insertion point from the end of the list.  */
     if (time != EXPIRE_NEVER)
-        LIST_FOR_EACH(ptr, &q->timers)
+        LIST_FOR_EACH_REV(ptr, &q->timers)
         {
             struct queue_timer *cur = LIST_ENTRY(ptr, struct queue_timer, entry);
-            if (time < cur->expire)
+            if (cur->expire <= time)
                 break;
         }
-    list_add_before(ptr, &t->entry);
+    else ptr = q->timers.prev;
+    list_add_after(ptr, &t->entry);
 
     t->expire = time;
 
@@ -1051,6 +1055,31 @@ NTSTATUS WINAPI RtlDeleteTimer(HANDLE TimerQueue, HANDLE Timer,
     return status;
 }
 
+/***********************************************************************
+ *           timerqueue_insert    (internal)
+ *
+ * Inserts a timer into the sorted list of pending timers, timerqueue.cs
+ * has to be held. Returns TRUE if the timer is now the first one to expire.
+ */
+static BOOL timerqueue_insert( struct threadpool_object *timer )
+{
+    struct threadpool_object *other_timer;
+
+    /* Timers are usually set relative to the current time, so search from
+     * the end of the list, where new timeouts most likely belong. */
+    LIST_FOR_EACH_ENTRY_REV( other_timer, &timerqueue.pending_timers,
+                             struct threadpool_object, u.timer.timer_entry )
+    {
+        assert( other_timer->type == TP_OBJECT_TYPE_TIMER );
+        if (other_timer->u.timer.timeout <= timer->u.timer.timeout)
+            break;
+    }
+    list_add_after( &other_timer->u.timer.timer_entry, &timer->u.timer.timer_entry );
+    timer->u.timer.timer_pending = TRUE;
+
+    return list_head( &timerqueue.pending_timers ) == &timer->u.timer.timer_entry;
+}
+
 /***********************************************************************
  *           timerqueue_thread_proc    (internal)
  */
@@ -1090,15 +1119,7 @@ static void CALLBACK timerqueue_thread_proc( void *param )
                 if (timer->u.timer.timeout <= now.QuadPart)
                     timer->u.timer.timeout = now.QuadPart + 1;
 
-                LIST_FOR_EACH_ENTRY( other_timer, &timerqueue.pending_timers,
-                                     struct threadpool_object, u.timer.timer_entry )
-                {
-                    assert( other_timer->type == TP_OBJECT_TYPE_TIMER );
-                    if (timer->u.timer.timeout < other_timer->u.timer.timeout)
-                        break;
-                }
-                list_add_before( &other_timer->u.timer.timer_entry, &timer->u.timer.timer_entry );
-                timer->u.timer.timer_pending = TRUE;
+                timerqueue_insert( timer );
             }
         }
 
@@ -1528,12 +1549,14 @@ static void tp_waitqueue_unlock( struct threadpool_object *wait )
 
 static void CALLBACK ioqueue_thread_proc( void *param )
 {
+    FILE_IO_COMPLETION_INFORMATION entries[16];
     struct io_completion *completion;
     struct threadpool_object *io;
     IO_STATUS_BLOCK iosb;
-    ULONG_PTR key, value;
+    ULONG_PTR value;
     BOOL destroy, skip;
     NTSTATUS status;
+    ULONG i, count;
 
     TRACE( "starting I/O completion thread\n" );
     set_thread_name(L"wine_threadpool_ioqueue");
@@ -1543,63 +1566,71 @@ static void CALLBACK ioqueue_thread_proc( void *param )
     for (;;)
     {
         RtlLeaveCriticalSection( &ioqueue.cs );
-        if ((status = NtRemoveIoCompletion( ioqueue.port, &key, &value, &iosb, NULL )))
-            ERR("NtRemoveIoCompletion failed, status %#lx.\n", status);
+        if ((status = NtRemoveIoCompletionEx( ioqueue.port, entries, ARRAY_SIZE(entries), &count, NULL, FALSE )))
+        {
+            ERR("NtRemoveIoCompletionEx failed, status %#lx.\n", status);
+            count = 0;
+        }
         RtlEnterCriticalSection( &ioqueue.cs );
 
-        destroy = skip = FALSE;
-        io = (struct threadpool_object *)key;
+        for (i = 0; i < count; i++)
+        {
+            destroy = skip = FALSE;
+            io = (struct threadpool_object *)entries[i].CompletionKey;
+            value = entries[i].CompletionValue;
+            iosb = entries[i].IoStatusBlock;
 
-        TRACE( "io %p, iosb.Status %#lx.\n", io, iosb.Status );
+            TRACE( "io %p, iosb.Status %#lx.\n", io, iosb.Status );
 
-        if (io && (io->shutdown || io->u.io.shutting_down))
-        {
-            RtlEnterCriticalSection( &io->pool->cs );
-            if (!io->u.io.pending_count)
+            if (io && (io->shutdown || io->u.io.shutting_down))
             {
-                if (io->u.io.skipped_count)
-                    --io->u.io.skipped_count;
+                RtlEnterCriticalSection( &io->pool->cs );
+                if (!io->u.io.pending_count)
+                {
+                    if (io->u.io.skipped_count)
+                        --io->u.io.skipped_count;
 
-                if (io->u.io.skipped_count)
-                    skip = TRUE;
-                else
-                    destroy = TRUE;
+                    if (io->u.io.skipped_count)
+                        skip = TRUE;
+                    else
+                        destroy = TRUE;
+                }
+                RtlLeaveCriticalSection( &io->pool->cs );
+                if (skip) continue;
             }
-            RtlLeaveCriticalSection( &io->pool->cs );
-            if (skip) continue;
-        }
 
-        if (destroy)
-        {
-            --ioqueue.objcount;
-            TRACE( "Releasing io %p.\n", io );
-            io->shutdown = TRUE;
-            tp_object_release( io );
-        }
-        else if (io)
-        {
-            RtlEnterCriticalSection( &io->pool->cs );
+            if (destroy)
+            {
+                --ioqueue.objcount;
+                TRACE( "Releasing io %p.\n", io );
+                io->shutdown = TRUE;
+                tp_object_release( io );
+            }
+            else if (io)
+            {
+                RtlEnterCriticalSection( &io->pool->cs );
 
-            TRACE( "pending_count %u.\n", io->u.io.pending_count );
+                TRACE( "pending_count %u.\n", io->u.io.pending_count );
 
-            if (io->u.io.pending_count)
-            {
-                --io->u.io.pending_count;
-                if (!array_reserve((void **)&io->u.io.completions, &io->u.io.completion_max,
-                        io->u.io.completion_count + 1, sizeof(*io->u.io.completions)))
+                if (io->u.io.pending_count)
                 {
-                    ERR( "Failed to allocate memory.\n" );
-                    RtlLeaveCriticalSection( &io->pool->cs );
-                    continue;
-                }
+                    --io->u.io.pending_count;
+                    if (!array_reserve((void **)&io->u.io.completions, &io->u.io.completion_max,
+                            io->u.io.completion_count + 1, sizeof(*io->u.io.completions)))
+                    {
+                        ERR( "Failed to allocate memory.\n" );
+                        RtlLeaveCriticalSection( &io->pool->cs );
+                        continue;
+                    }
 
-                completion = &io->u.io.completions[io->u.io.completion_count++];
-                completion->iosb = iosb;
-                completion->cvalue = value;
+                    completion = &io->u.io.completions[io->u.io.completion_count++];
+                    completion->iosb = iosb;
+                    completion->cvalue = value;
 
-                tp_object_submit( io, FALSE );
+                    tp_object_submit( io, FALSE );
+                }
+                RtlLeaveCriticalSection( &io->pool->cs );
             }
-            RtlLeaveCriticalSection( &io->pool->cs );
         }
 
         if (!ioqueue.objcount)
@@ -1700,6 +1731,7 @@ static NTSTATUS tp_threadpool_alloc( struct threadpool **out )
     pool->min_workers             = 0;
     pool->num_workers             = 0;
     pool->num_busy_workers        = 0;
+    pool->num_idle_workers        = 0;
     pool->stack_info.StackReserve = nt->OptionalHeader.SizeOfStackReserve;
     pool->stack_info.StackCommit  = nt->OptionalHeader.SizeOfStackCommit;
 
@@ -2018,11 +2050,13 @@ static void tp_object_submit( struct threadpool_object *object, BOOL signaled )
     if (object->type == TP_OBJECT_TYPE_WAIT && signaled)
         object->u.wait.signaled++;
 
-    /* No new thread started - wake up one existing thread. */
+    /* No new thread started - wake up one existing thread. If no worker is
+     * waiting for work, the busy ones will pick up the item before going to
+     * sleep, so there's no need to signal the condition variable. */
     if (status != STATUS_SUCCESS)
     {
         assert( pool->num_workers > 0 );
-        RtlWakeConditionVariable( &pool->update_event );
+        if (pool->num_idle_workers) RtlWakeConditionVariable( &pool->update_event );
     }
 
     RtlLeaveCriticalSection( &pool->cs );
@@ -2359,6 +2393,7 @@ static void CALLBACK threadpool_worker_proc( void *param )
 {
     struct threadpool *pool = param;
     LARGE_INTEGER timeout;
+    NTSTATUS status;
     struct list *ptr;
 
     TRACE( "starting worker thread for pool %p\n", pool );
@@ -2396,7 +2431,10 @@ static void CALLBACK threadpool_worker_proc( void *param )
          * min_workers == 0, then objcount is used to detect if the last thread
          * can be terminated. */
         timeout.QuadPart = (ULONGLONG)THREADPOOL_WORKER_TIMEOUT * -10000;
-        if (RtlSleepConditionVariableCS( &pool->update_event, &pool->cs, &timeout ) == STATUS_TIMEOUT &&
+        pool->num_idle_workers++;
+        status = RtlSleepConditionVariableCS( &pool->update_event, &pool->cs, &timeout );
+        pool->num_idle_workers--;
+        if (status == STATUS_TIMEOUT &&
             !threadpool_get_next_item( pool ) && (pool->num_workers > max( pool->min_workers, 1 ) ||
             (!pool->min_workers && !pool->objcount)))
         {
@@ -2996,7 +3034,6 @@ BOOL WINAPI TpSetPoolMinThreads( TP_POOL *pool, DWORD minimum )
 VOID WINAPI TpSetTimer( TP_TIMER *timer, LARGE_INTEGER *timeout, LONG period, LONG window_length )
 {
     struct threadpool_object *this = impl_from_TP_TIMER( timer );
-    struct threadpool_object *other_timer;
     BOOL submit_timer = FALSE;
     ULONGLONG timestamp;
 
@@ -3046,20 +3083,9 @@ VOID WINAPI TpSetTimer( TP_TIMER *timer, LARGE_INTEGER *timeout, LONG period, LO
         this->u.timer.period        = period;
         this->u.timer.window_length = window_length;
 
-        LIST_FOR_EACH_ENTRY( other_timer, &timerqueue.pending_timers,
-                             struct threadpool_object, u.timer.timer_entry )
-        {
-            assert( other_timer->type == TP_OBJECT_TYPE_TIMER );
-            if (this->u.timer.timeout < other_timer->u.timer.timeout)
-                break;
-        }
-        list_add_before( &other_timer->u.timer.timer_entry, &this->u.timer.timer_entry );
-
         /* Wake up the timer thread when the timeout has to be updated. */
-        if (list_head( &timerqueue.pending_timers ) == &this->u.timer.timer_entry )
+        if (timerqueue_insert( this ))
             RtlWakeAllConditionVariable( &timerqueue.update_event );
-
-        this->u.timer.timer_pending = TRUE;
     }
 
     RtlLeaveCriticalSection( &timerqueue.cs );
@@ -51,6 +51,7 @@
 #endif
 #include <sys/socket.h>
 #include <sys/time.h>
+#include <sys/uio.h>
 #include <sys/ioctl.h>
 #ifdef HAVE_SYS_ATTR_H
 #include <sys/attr.h>
@@ -1675,11 +1676,92 @@ static unsigned int server_get_unix_name( HANDLE handle, char **unix_name );
 
 
 /* get the stat info and file attributes for a file (by file descriptor) */
+/* cache of the attributes stored in extended attributes, which are slow to read
+ * on network file systems */
+#define XATTR_CACHE_SIZE 256
+
+struct xattr_info
+{
+    ULONG attr;          /* attributes from the DOS attributes and reparse xattrs */
+    ULONG reparse_tag;   /* reparse tag, if the reparse xattr is present */
+    BOOL  dos_attrib;    /* whether the DOS attributes xattr is present */
+};
+
+struct xattr_cache_entry
+{
+    dev_t             dev;
+    ino_t             ino;
+    time_t            ctime;
+    long              ctime_nsec;
+    unsigned int      generation;
+    struct xattr_info info;
+};
+
+static struct xattr_cache_entry xattr_cache[XATTR_CACHE_SIZE];
+static unsigned int xattr_cache_generation = 1;  /* entries with generation 0 are unused */
+static pthread_mutex_t xattr_cache_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static inline long get_ctime_nsec( const struct stat *st )
+{
+#ifdef HAVE_STRUCT_STAT_ST_CTIM
+    return st->st_ctim.tv_nsec;
+#elif defined(HAVE_STRUCT_STAT_ST_CTIMESPEC)
+    return st->st_ctimespec.tv_nsec;
+#else
+    return 0;
+#endif
+}
+
+static struct xattr_cache_entry *get_xattr_cache_entry( const struct stat *st )
+{
+    return &xattr_cache[((ULONG_PTR)st->st_ino ^ ((ULONG_PTR)st->st_dev * 0x9e3779b9)) % XATTR_CACHE_SIZE];
+}
+
+static BOOL xattr_cache_get( const struct stat *st, struct xattr_info *info )
+{
+    struct xattr_cache_entry *entry = get_xattr_cache_entry( st );
+    BOOL ret;
+
+    mutex_lock( &xattr_cache_mutex );
+    ret = (entry->generation == xattr_cache_generation && entry->dev == st->st_dev &&
+           entry->ino == st->st_ino && entry->ctime == st->st_ctime &&
+           entry->ctime_nsec == get_ctime_nsec( st ));
+    if (ret) *info = entry->info;
+    mutex_unlock( &xattr_cache_mutex );
+    return ret;
+}
+
+static void xattr_cache_put( const struct stat *st, const struct xattr_info *info )
+{
+    struct xattr_cache_entry *entry = get_xattr_cache_entry( st );
+
+    /* the change time may not be precise enough to notice a change made right now */
+    if (st->st_ctime >= time( NULL ) - 1) return;
+
+    mutex_lock( &xattr_cache_mutex );
+    entry->dev = st->st_dev;
+    entry->ino = st->st_ino;
+    entry->ctime = st->st_ctime;
+    entry->ctime_nsec = get_ctime_nsec( st );
+    entry->generation = xattr_cache_generation;
+    entry->info = *info;
+    mutex_unlock( &xattr_cache_mutex );
+}
+
+static void xattr_cache_invalidate(void)
+{
+    mutex_lock( &xattr_cache_mutex );
+    if (!++xattr_cache_generation) xattr_cache_generation = 1;
+    mutex_unlock( &xattr_cache_mutex );
+}
+
+
 static int fd_get_file_info( HANDLE handle, int fd, unsigned int options,
                              struct stat *st, ULONG *attr, ULONG *reparse_tag )
 {
     char buffer[MAXIMUM_REPARSE_DATA_BUFFER_SIZE];
     char attr_data[65];
+    struct xattr_info info;
     int attr_len, ret;
 
     *attr = 0;
@@ -1697,34 +1779,48 @@ static int fd_get_file_info( HANDLE handle, int fd, unsigned int options,
         }
     }
 
-    attr_len = xattr_fget( fd, XATTR_REPARSE, buffer, sizeof(buffer) );
-    if (attr_len >= 0 && attr_len >= sizeof(ULONG))
+    if (!xattr_cache_get( st, &info ))
     {
-        *attr |= FILE_ATTRIBUTE_REPARSE_POINT;
-        if (reparse_tag) memcpy( reparse_tag, buffer, sizeof(ULONG) );
-    }
+        memset( &info, 0, sizeof(info) );
+        attr_len = xattr_fget( fd, XATTR_REPARSE, buffer, sizeof(buffer) );
+        if (attr_len >= 0 && attr_len >= sizeof(ULONG))
+        {
+            info.attr |= FILE_ATTRIBUTE_REPARSE_POINT;
+            memcpy( &info.reparse_tag, buffer, sizeof(ULONG) );
+        }
 
-    attr_len = xattr_fget( fd, SAMBA_XATTR_DOS_ATTRIB, attr_data, sizeof(attr_data)-1 );
-    if (attr_len != -1)
-        *attr |= parse_samba_dos_attrib_data( attr_data, attr_len );
-    else
-    {
-        if (errno == ENOTSUP) return ret;
+        attr_len = xattr_fget( fd, SAMBA_XATTR_DOS_ATTRIB, attr_data, sizeof(attr_data)-1 );
+        if (attr_len != -1)
+        {
+            info.attr |= parse_samba_dos_attrib_data( attr_data, attr_len );
+            info.dos_attrib = TRUE;
+            xattr_cache_put( st, &info );
+        }
+        else if (errno == ENOTSUP
 #ifdef ENODATA
-        if (errno == ENODATA) return ret;
+                 || errno == ENODATA
 #endif
 #ifdef ENOATTR
-        if (errno == ENOATTR) return ret;
+                 || errno == ENOATTR
 #endif
-        WARN( "Failed to get extended attribute " SAMBA_XATTR_DOS_ATTRIB ". errno %d (%s)\n",
-              errno, strerror( errno ) );
+                )
+            xattr_cache_put( st, &info );
+        else
+            WARN( "Failed to get extended attribute " SAMBA_XATTR_DOS_ATTRIB ". errno %d (%s)\n",
+                  errno, strerror( errno ) );
     }
+
+    *attr |= info.attr;
+    if (reparse_tag && (info.attr & FILE_ATTRIBUTE_REPARSE_POINT))
+        *reparse_tag = info.reparse_tag;
     return ret;
 }
 
 
 static int fd_set_dos_attrib( int fd, UINT attr, BOOL force_set )
 {
+    xattr_cache_invalidate();
+
     /* we only store the HIDDEN and SYSTEM attributes */
     attr &= XATTR_ATTRIBS_MASK;
     if (force_set || attr != 0)
@@ -1772,6 +1868,10 @@ static NTSTATUS fd_set_file_info( int fd, UINT attr, BOOL force_set_xattr )
 }
 
 
+/* last device on which extended attributes were found to be unsupported */
+static dev_t xattr_unsupported_dev;
+static BOOL xattr_unsupported_dev_valid;
+
 /* get the stat info and file attributes for a file (by name) */
 static int get_file_info( const char *path, struct stat *st, ULONG *attr, ULONG *reparse_tag )
 {
@@ -1779,6 +1879,7 @@ static int get_file_info( const char *path, struct stat *st, ULONG *attr, ULONG
     size_t len = strlen( path );
     char *parent_path;
     char attr_data[65];
+    struct xattr_info info;
     int attr_len, ret;
 
     *attr = 0;
@@ -1814,34 +1915,89 @@ static int get_file_info( const char *path, struct stat *st, ULONG *attr, ULONG
     }
     *attr |= get_file_attributes( st );
 
-    attr_len = xattr_get( path, XATTR_REPARSE, buffer, sizeof(buffer) );
-    if (attr_len >= 0 && attr_len >= sizeof(ULONG))
+    /* don't bother asking for extended attributes on a file system that doesn't support them */
+    if (xattr_unsupported_dev_valid && st->st_dev == xattr_unsupported_dev)
     {
-        *attr |= FILE_ATTRIBUTE_REPARSE_POINT;
-        if (reparse_tag) memcpy( reparse_tag, buffer, sizeof(ULONG) );
+        if (is_hidden_file( path )) *attr |= FILE_ATTRIBUTE_HIDDEN;
+        return ret;
     }
 
-    attr_len = xattr_get( path, SAMBA_XATTR_DOS_ATTRIB, attr_data, sizeof(attr_data)-1 );
-    if (attr_len != -1)
-        *attr |= parse_samba_dos_attrib_data( attr_data, attr_len );
-    else
+    if (!xattr_cache_get( st, &info ))
     {
-        if (is_hidden_file( path ))
-            *attr |= FILE_ATTRIBUTE_HIDDEN;
-        if (errno == ENOTSUP) return ret;
+        memset( &info, 0, sizeof(info) );
+        attr_len = xattr_get( path, XATTR_REPARSE, buffer, sizeof(buffer) );
+        if (attr_len >= 0 && attr_len >= sizeof(ULONG))
+        {
+            info.attr |= FILE_ATTRIBUTE_REPARSE_POINT;
+            memcpy( &info.reparse_tag, buffer, sizeof(ULONG) );
+        }
+        else if (attr_len == -1 && errno == ENOTSUP)
+        {
+            xattr_unsupported_dev = st->st_dev;
+            xattr_unsupported_dev_valid = TRUE;
+            if (is_hidden_file( path )) *attr |= FILE_ATTRIBUTE_HIDDEN;
+            return ret;
+        }
+
+        attr_len = xattr_get( path, SAMBA_XATTR_DOS_ATTRIB, attr_data, sizeof(attr_data)-1 );
+        if (attr_len != -1)
+        {
+            info.attr |= parse_samba_dos_attrib_data( attr_data, attr_len );
+            info.dos_attrib = TRUE;
+            xattr_cache_put( st, &info );
+        }
+        else if (errno == ENOTSUP
 #ifdef ENODATA
-        if (errno == ENODATA) return ret;
+                 || errno == ENODATA
 #endif
 #ifdef ENOATTR
-        if (errno == ENOATTR) return ret;
+                 || errno == ENOATTR
 #endif
-        WARN( "Failed to get extended attribute " SAMBA_XATTR_DOS_ATTRIB " from %s. errno %d (%s)\n",
-              debugstr_a(path), errno, strerror( errno ) );
+                )
+            xattr_cache_put( st, &info );
+        else
+            WARN( "Failed to get extended attribute " SAMBA_XATTR_DOS_ATTRIB " from %s. errno %d (%s)\n",
+                  debugstr_a(path), errno, strerror( errno ) );
     }
+
+    *attr |= info.attr;
+    if (reparse_tag && (info.attr & FILE_ATTRIBUTE_REPARSE_POINT)) *reparse_tag = info.reparse_tag;
+    if (!info.dos_attrib && is_hidden_file( path )) *attr |= FILE_ATTRIBUTE_HIDDEN;
     return ret;
 }
 
 
+#ifndef HAVE_PREADV
+static ssize_t preadv( int fd, const struct iovec *iov, int count, off_t offset )
+{
+    return pread( fd, iov[0].iov_base, iov[0].iov_len, offset );
+}
+#endif
+
+#ifndef HAVE_PWRITEV
+static ssize_t pwritev( int fd, const struct iovec *iov, int count, off_t offset )
+{
+    return pwrite( fd, iov[0].iov_base, iov[0].iov_len, offset );
+}
+#endif
+
+/* build an iovec array for the next part of a scatter/gather transfer */
+static int get_segment_iovecs( struct iovec *iov, int max_count, const FILE_SEGMENT_ELEMENT *segments,
+                               UINT pos, UINT length )
+{
+    int count;
+
+    for (count = 0; count < max_count && length; count++)
+    {
+        iov[count].iov_base = (char *)segments[count].Buffer + pos;
+        iov[count].iov_len = min( length, page_size - pos );
+        length -= iov[count].iov_len;
+        pos = 0;
+    }
+    return count;
+}
+
+
 #if defined(__ANDROID__) && !defined(HAVE_FUTIMENS)
 static int futimens( int fd, const struct timespec spec[2] )
 {
@@ -2461,9 +2617,14 @@ static NTSTATUS get_dir_data_entry( struct dir_data *dir_data, void *info_ptr, I
     const struct dir_data_names *names = &dir_data->names[dir_data->pos];
     union file_directory_info *info;
     struct stat st;
-    ULONG name_len, start, dir_size, attributes, reparse_tag;
+    ULONG name_len, start, dir_size, attributes = 0, reparse_tag = 0;
+    int ret;
 
-    if (get_file_info( names->unix_name, &st, &attributes, &reparse_tag ) == -1)
+    /* FileNamesInformation only needs to know whether the file should be ignored */
+    if (class == FileNamesInformation) ret = stat( names->unix_name, &st );
+    else ret = get_file_info( names->unix_name, &st, &attributes, &reparse_tag );
+
+    if (ret == -1)
     {
         TRACE( "file no longer exists %s\n", debugstr_a(names->unix_name) );
         return STATUS_SUCCESS;
@@ -2983,6 +3144,167 @@ NTSTATUS WINAPI NtQueryDirectoryFile( HANDLE handle, HANDLE event, PIO_APC_ROUTI
 }
 
 
+/* cache of directory contents, used for case-insensitive lookups */
+
+#define DIR_NAME_CACHE_SIZE      8
+#define DIR_NAME_CACHE_MAX_DATA  (1024 * 1024)
+
+struct dir_name_cache
+{
+    dev_t          dev;         /* identity of the cached directory */
+    ino_t          ino;
+    time_t         mtime;       /* modification time when the contents were read */
+    long           mtime_nsec;
+    unsigned int   last_use;
+    unsigned int   count;       /* number of cached names */
+    unsigned int   max_count;   /* allocated size of the offsets array */
+    unsigned int  *offsets;     /* offset of each entry in data */
+    unsigned int   data_size;   /* allocated size of data */
+    char          *data;        /* entries: WCHAR name length, WCHAR name and null-terminated unix name */
+};
+
+static pthread_mutex_t dir_name_cache_mutex = PTHREAD_MUTEX_INITIALIZER;
+static struct dir_name_cache dir_name_cache[DIR_NAME_CACHE_SIZE];
+static unsigned int dir_name_cache_use;
+
+static inline long get_mtime_nsec( const struct stat *st )
+{
+#ifdef HAVE_STRUCT_STAT_ST_MTIM
+    return st->st_mtim.tv_nsec;
+#elif defined(HAVE_STRUCT_STAT_ST_MTIMESPEC)
+    return st->st_mtimespec.tv_nsec;
+#else
+    return 0;
+#endif
+}
+
+/***********************************************************************
+ *           fill_dir_name_cache
+ *
+ * Read the contents of a directory into a cache entry. dir_name_cache_mutex must be held.
+ */
+static BOOL fill_dir_name_cache( struct dir_name_cache *cache, int root_fd, const char *dir )
+{
+    WCHAR buffer[MAX_DIR_ENTRY_LEN];
+    unsigned int pos = 0, needed, *offsets;
+    struct dirent *de;
+    char *data, *p;
+    int fd, len, wlen;
+    DIR *dirp;
+
+    cache->count = 0;
+    if ((fd = openat( root_fd, dir, O_RDONLY | O_DIRECTORY )) == -1) return FALSE;
+    if (!(dirp = fdopendir( fd )))
+    {
+        close( fd );
+        return FALSE;
+    }
+
+    while ((de = readdir( dirp )))
+    {
+        len = strlen( de->d_name );
+        wlen = ntdll_umbstowcs( de->d_name, len, buffer, MAX_DIR_ENTRY_LEN );
+        needed = (pos + (wlen + 1) * sizeof(WCHAR) + len + 2) & ~1;
+        if (needed > DIR_NAME_CACHE_MAX_DATA) goto failed;
+        if (needed > cache->data_size)
+        {
+            unsigned int size = max( needed, max( cache->data_size * 2, 4096 ));
+            if (!(data = realloc( cache->data, size ))) goto failed;
+            cache->data = data;
+            cache->data_size = size;
+        }
+        if (cache->count == cache->max_count)
+        {
+            unsigned int count = max( cache->max_count * 2, 64 );
+            if (!(offsets = realloc( cache->offsets, count * sizeof(*offsets) ))) goto failed;
+            cache->offsets = offsets;
+            cache->max_count = count;
+        }
+        cache->offsets[cache->count++] = pos;
+        p = cache->data + pos;
+        *(WCHAR *)p = wlen;
+        memcpy( p + sizeof(WCHAR), buffer, wlen * sizeof(WCHAR) );
+        memcpy( p + (wlen + 1) * sizeof(WCHAR), de->d_name, len + 1 );
+        pos = needed;
+    }
+    closedir( dirp );
+    return TRUE;
+
+failed:
+    cache->count = 0;
+    closedir( dirp );
+    return FALSE;
+}
+
+
+/***********************************************************************
+ *           find_file_in_dir_cache
+ *
+ * Case-insensitive search of a name in the cached contents of a directory.
+ * The matching unix name is copied to ret.
+ * Returns 1 if found, 0 if not found, and -1 if the directory can't be cached.
+ */
+static int find_file_in_dir_cache( int root_fd, const char *dir, const WCHAR *name, int length,
+                                   BOOLEAN is_name_8_dot_3, char *ret )
+{
+    struct dir_name_cache *cache = NULL, *lru = dir_name_cache;
+    struct stat st;
+    unsigned int i;
+    int found = 0;
+
+    if (fstatat( root_fd, dir, &st, 0 ) == -1) return -1;
+    /* the directory may still be changing within the granularity of its timestamp */
+    if (st.st_mtime >= time( NULL ) - 1) return -1;
+
+    mutex_lock( &dir_name_cache_mutex );
+
+    for (i = 0; i < DIR_NAME_CACHE_SIZE; i++)
+    {
+        if (dir_name_cache[i].dev == st.st_dev && dir_name_cache[i].ino == st.st_ino)
+        {
+            cache = dir_name_cache + i;
+            break;
+        }
+        if (dir_name_cache[i].last_use < lru->last_use) lru = dir_name_cache + i;
+    }
+
+    if (!cache || cache->mtime != st.st_mtime || cache->mtime_nsec != get_mtime_nsec( &st ))
+    {
+        if (!cache) cache = lru;
+        cache->dev = st.st_dev;
+        cache->ino = st.st_ino;
+        cache->mtime = st.st_mtime;
+        cache->mtime_nsec = get_mtime_nsec( &st );
+        if (!fill_dir_name_cache( cache, root_fd, dir ))
+        {
+            cache->dev = 0;
+            cache->ino = 0;
+            mutex_unlock( &dir_name_cache_mutex );
+            return -1;
+        }
+    }
+    cache->last_use = ++dir_name_cache_use;
+
+    for (i = 0; i < cache->count && !found; i++)
+    {
+        const WCHAR *entry = (const WCHAR *)(cache->data + cache->offsets[i]);
+        int len = entry[0];
+
+        if (len == length && !wcsnicmp( entry + 1, name, len )) found = 1;
+        else if (is_name_8_dot_3 && !is_legal_8dot3_name( entry + 1, len ))
+        {
+            WCHAR short_nameW[12];
+            len = hash_short_file_name( entry + 1, len, short_nameW );
+            if (len == length && !wcsnicmp( short_nameW, name, length )) found = 1;
+        }
+        if (found) strcpy( ret, (const char *)(entry + entry[0] + 1) );
+    }
+
+    mutex_unlock( &dir_name_cache_mutex );
+    return found;
+}
+
+
 /***********************************************************************
  *           find_file_in_dir
  *
@@ -3073,6 +3395,15 @@ static NTSTATUS find_file_in_dir( int root_fd, char *unix_name, int pos, const W
     }
 #endif /* VFAT_IOCTL_READDIR_BOTH */
 
+    switch (find_file_in_dir_cache( root_fd, unix_name, name, length, is_name_8_dot_3, unix_name + pos ))
+    {
+    case 1:
+        unix_name[pos - 1] = '/';
+        return STATUS_SUCCESS;
+    case 0:
+        goto not_found;
+    }
+
     if ((fd = openat( root_fd, unix_name, O_RDONLY )) == -1) return errno_to_status( errno );
     if (!(dir = fdopendir( fd )))
     {
@@ -3824,6 +4155,86 @@ static NTSTATUS nt_to_unix_file_name_no_root( OBJECT_ATTRIBUTES *attr, UNICODE_S
 }
 
 
+/* cache of recent NT to Unix name translations, to avoid repeating case-insensitive
+ * lookups when the same files are opened over and over */
+#define NAME_CACHE_SIZE 1024
+
+struct name_cache_entry
+{
+    WCHAR       *nt_name;
+    USHORT       nt_len;        /* in bytes */
+    BOOL         open_reparse;
+    unsigned int generation;
+    char        *unix_name;
+};
+
+static struct name_cache_entry name_cache[NAME_CACHE_SIZE];
+static unsigned int name_cache_generation = 1;  /* entries with generation 0 are unused */
+static pthread_mutex_t name_cache_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static struct name_cache_entry *get_name_cache_entry( const UNICODE_STRING *name, BOOL open_reparse )
+{
+    unsigned int i, hash = open_reparse ? 0x811c9dc5 : 0x01000193;
+
+    for (i = 0; i < name->Length / sizeof(WCHAR); i++) hash = (hash ^ name->Buffer[i]) * 0x01000193;
+    return &name_cache[hash % NAME_CACHE_SIZE];
+}
+
+/* invalidate the cache after changing the file name space */
+static void invalidate_name_cache(void)
+{
+    mutex_lock( &name_cache_mutex );
+    if (!++name_cache_generation) name_cache_generation = 1;
+    mutex_unlock( &name_cache_mutex );
+}
+
+static char *lookup_name_cache( const UNICODE_STRING *name, BOOL open_reparse )
+{
+    struct name_cache_entry *entry = get_name_cache_entry( name, open_reparse );
+    char *unix_name = NULL;
+    struct stat st;
+
+    mutex_lock( &name_cache_mutex );
+    if (entry->generation == name_cache_generation && entry->open_reparse == open_reparse &&
+        entry->nt_len == name->Length && !memcmp( entry->nt_name, name->Buffer, name->Length ))
+        unix_name = strdup( entry->unix_name );
+    mutex_unlock( &name_cache_mutex );
+
+    /* make sure the file is still there */
+    if (unix_name && stat( unix_name, &st ) == -1)
+    {
+        free( unix_name );
+        unix_name = NULL;
+    }
+    return unix_name;
+}
+
+static void add_name_cache( const UNICODE_STRING *name, BOOL open_reparse, const char *unix_name )
+{
+    struct name_cache_entry *entry = get_name_cache_entry( name, open_reparse );
+    WCHAR *nt_copy;
+    char *unix_copy;
+
+    if (!(nt_copy = malloc( name->Length ))) return;
+    if (!(unix_copy = strdup( unix_name )))
+    {
+        free( nt_copy );
+        return;
+    }
+    memcpy( nt_copy, name->Buffer, name->Length );
+
+    mutex_lock( &name_cache_mutex );
+    free( entry->nt_name );
+    free( entry->unix_name );
+    entry->nt_name = nt_copy;
+    entry->nt_len = name->Length;
+    entry->open_reparse = open_reparse;
+    entry->generation = name_cache_generation;
+    entry->unix_name = unix_copy;
+    mutex_unlock( &name_cache_mutex );
+}
+
+
 /******************************************************************************
  *           nt_to_unix_file_name
  *
@@ -3844,7 +4255,23 @@ static NTSTATUS nt_to_unix_file_name( OBJECT_ATTRIBUTES *attr, UNICODE_STRING *n
     NTSTATUS status;
 
     if (!attr->RootDirectory)  /* without root dir fall back to normal lookup */
-        return nt_to_unix_file_name_no_root( attr, nt_name, name_ret, disposition, open_reparse, 0 );
+    {
+        UNICODE_STRING *orig = attr->ObjectName;
+        WCHAR *orig_buffer = orig->Buffer;
+
+        if ((*name_ret = lookup_name_cache( orig, open_reparse )))
+        {
+            if (disposition != FILE_CREATE) return STATUS_SUCCESS;
+            free( *name_ret );
+            *name_ret = NULL;
+            return STATUS_OBJECT_NAME_COLLISION;
+        }
+        status = nt_to_unix_file_name_no_root( attr, nt_name, name_ret, disposition, open_reparse, 0 );
+        /* don't cache names that went through a reparse point */
+        if (!status && attr->ObjectName == orig && orig->Buffer == orig_buffer)
+            add_name_cache( orig, open_reparse, *name_ret );
+        return status;
+    }
 
     name     = attr->ObjectName->Buffer;
     name_len = attr->ObjectName->Length / sizeof(WCHAR);
@@ -5366,6 +5793,7 @@ NTSTATUS WINAPI NtSetInformationFile( HANDLE handle, IO_STATUS_BLOCK *io,
         {
             FILE_DISPOSITION_INFORMATION *info = ptr;
 
+            invalidate_name_cache();
             SERVER_START_REQ( set_fd_disp_info )
             {
                 req->handle   = wine_server_obj_handle( handle );
@@ -5385,6 +5813,7 @@ NTSTATUS WINAPI NtSetInformationFile( HANDLE handle, IO_STATUS_BLOCK *io,
             if (info->Flags & FILE_DISPOSITION_FORCE_IMAGE_SECTION_CHECK)
                 FIXME( "FILE_DISPOSITION_FORCE_IMAGE_SECTION_CHECK not supported\n" );
 
+            invalidate_name_cache();
             SERVER_START_REQ( set_fd_disp_info )
             {
                 req->handle   = wine_server_obj_handle( handle );
@@ -5421,6 +5850,7 @@ NTSTATUS WINAPI NtSetInformationFile( HANDLE handle, IO_STATUS_BLOCK *io,
             status = get_nt_and_unix_names( &attr, &nt_name, &unix_name, FILE_OPEN_IF, TRUE );
             if (status == STATUS_SUCCESS || status == STATUS_NO_SUCH_FILE)
             {
+                invalidate_name_cache();
                 SERVER_START_REQ( set_fd_name_info )
                 {
                     req->handle   = wine_server_obj_handle( handle );
@@ -5466,6 +5896,7 @@ NTSTATUS WINAPI NtSetInformationFile( HANDLE handle, IO_STATUS_BLOCK *io,
             status = get_nt_and_unix_names( &attr, &nt_name, &unix_name, FILE_OPEN_IF, TRUE );
             if (status == STATUS_SUCCESS || status == STATUS_NO_SUCH_FILE)
             {
+                invalidate_name_cache();
                 SERVER_START_REQ( set_fd_name_info )
                 {
                     req->handle   = wine_server_obj_handle( handle );
@@ -6252,11 +6683,13 @@ NTSTATUS WINAPI NtReadFileScatter( HANDLE file, HANDLE event, PIO_APC_ROUTINE ap
 
     while (length)
     {
+        struct iovec iov[64];
+        int count = get_segment_iovecs( iov, ARRAY_SIZE(iov), segments, pos, length );
+
         if (offset && offset->QuadPart != FILE_USE_FILE_POINTER_POSITION)
-            result = pread( unix_handle, (char *)segments->Buffer + pos,
-                            min( length - pos, page_size - pos ), offset->QuadPart + total );
+            result = preadv( unix_handle, iov, count, offset->QuadPart + total );
         else
-            result = read( unix_handle, (char *)segments->Buffer + pos, min( length - pos, page_size - pos ) );
+            result = readv( unix_handle, iov, count );
 
         if (result == -1)
         {
@@ -6267,11 +6700,9 @@ NTSTATUS WINAPI NtReadFileScatter( HANDLE file, HANDLE event, PIO_APC_ROUTINE ap
         if (!result) break;
         total += result;
         length -= result;
-        if ((pos += result) == page_size)
-        {
-            pos = 0;
-            segments++;
-        }
+        pos += result;
+        segments += pos / page_size;
+        pos %= page_size;
     }
 
     if (total == 0) status = STATUS_END_OF_FILE;
@@ -6552,11 +6983,13 @@ NTSTATUS WINAPI NtWriteFileGather( HANDLE file, HANDLE event, PIO_APC_ROUTINE ap
 
     while (length)
     {
+        struct iovec iov[64];
+        int count = get_segment_iovecs( iov, ARRAY_SIZE(iov), segments, pos, length );
+
         if (offset && offset->QuadPart != FILE_USE_FILE_POINTER_POSITION)
-            result = pwrite( unix_handle, (char *)segments->Buffer + pos,
-                             page_size - pos, offset->QuadPart + total );
+            result = pwritev( unix_handle, iov, count, offset->QuadPart + total );
         else
-            result = write( unix_handle, (char *)segments->Buffer + pos, page_size - pos );
+            result = writev( unix_handle, iov, count );
 
         if (result == -1)
         {
@@ -6576,11 +7009,9 @@ NTSTATUS WINAPI NtWriteFileGather( HANDLE file, HANDLE event, PIO_APC_ROUTINE ap
         }
         total += result;
         length -= result;
-        if ((pos += result) == page_size)
-        {
-            pos = 0;
-            segments++;
-        }
+        pos += result;
+        segments += pos / page_size;
+        pos %= page_size;
     }
 
  done:
@@ -6685,6 +7116,53 @@ static void ignore_server_ioctl_struct_holes( ULONG code, const void *in_buffer,
 }
 
 
+/* copy a file range on the host side, letting the file system share extents when it can */
+static NTSTATUS duplicate_extents( HANDLE handle, const DUPLICATE_EXTENTS_DATA *data )
+{
+#ifdef __NR_copy_file_range
+    /* handles are only 32-bit significant, and this may come from a 32-bit structure */
+    HANDLE src_handle = LongToHandle( HandleToLong( data->FileHandle ));
+    loff_t src_offset = data->SourceFileOffset.QuadPart, dst_offset = data->TargetFileOffset.QuadPart;
+    ULONGLONG count = data->ByteCount.QuadPart;
+    int src_fd, dst_fd, src_needs_close, dst_needs_close;
+    enum server_fd_type src_type, dst_type;
+    NTSTATUS status;
+    ssize_t ret;
+
+    if (src_offset < 0 || dst_offset < 0) return STATUS_INVALID_PARAMETER;
+
+    if ((status = server_get_unix_fd( handle, FILE_WRITE_DATA, &dst_fd, &dst_needs_close, &dst_type, NULL )))
+        return status;
+    if ((status = server_get_unix_fd( src_handle, FILE_READ_DATA, &src_fd, &src_needs_close, &src_type, NULL )))
+    {
+        if (dst_needs_close) close( dst_fd );
+        return status;
+    }
+
+    if (src_type != FD_TYPE_FILE || dst_type != FD_TYPE_FILE) status = STATUS_INVALID_DEVICE_REQUEST;
+
+    while (!status && count)
+    {
+        ret = syscall( __NR_copy_file_range, src_fd, &src_offset, dst_fd, &dst_offset,
+                       (size_t)min( count, 0x40000000 ), 0 );
+        if (ret > 0) count -= ret;
+        else if (!ret) break;  /* end of source file */
+        else if (errno == EINTR) continue;
+        else if (errno == ENOSYS || errno == EXDEV || errno == EINVAL || errno == EOPNOTSUPP)
+            status = STATUS_INVALID_DEVICE_REQUEST;
+        else
+            status = errno_to_status( errno );
+    }
+
+    if (src_needs_close) close( src_fd );
+    if (dst_needs_close) close( dst_fd );
+    return status;
+#else
+    return STATUS_INVALID_DEVICE_REQUEST;
+#endif
+}
+
+
 /******************************************************************************
  *              NtFsControlFile   (NTDLL.@)
  */
@@ -6774,6 +7252,11 @@ NTSTATUS WINAPI NtFsControlFile( HANDLE handle, HANDLE event, PIO_APC_ROUTINE ap
         break;
     }
 
+    case FSCTL_DUPLICATE_EXTENTS_TO_FILE:
+        if (in_size < sizeof(DUPLICATE_EXTENTS_DATA)) status = STATUS_INVALID_PARAMETER;
+        else status = duplicate_extents( handle, in_buffer );
+        break;
+
     case FSCTL_SET_SPARSE:
         TRACE("FSCTL_SET_SPARSE: Ignoring request\n");
         status = STATUS_SUCCESS;
@@ -275,9 +275,37 @@ static void read_reply_data( void *buffer, size_t size )
  */
 static inline unsigned int wait_reply( struct __server_request_info *req )
 {
-    read_reply_data( &req->u.reply, sizeof(req->u.reply) );
-    if (req->u.reply.reply_header.reply_size)
-        read_reply_data( req->reply_data, req->u.reply.reply_header.reply_size );
+    struct iovec vec[2];
+    data_size_t size = 0;
+    ssize_t ret;
+
+    /* the server writes the reply data right after the header, so try to get both at once */
+    vec[0].iov_base = &req->u.reply;
+    vec[0].iov_len  = sizeof(req->u.reply);
+    vec[1].iov_base = req->reply_data;
+    vec[1].iov_len  = req->u.req.request_header.reply_size;
+
+    for (;;)
+    {
+        if ((ret = readv( ntdll_get_thread_data()->reply_fd, vec, vec[1].iov_len ? 2 : 1 )) > 0)
+        {
+            if ((size_t)ret >= vec[0].iov_len)
+            {
+                size = ret - vec[0].iov_len;
+                break;
+            }
+            vec[0].iov_base = (char *)vec[0].iov_base + ret;
+            vec[0].iov_len -= ret;
+            continue;
+        }
+        if (!ret) abort_thread(0);
+        if (errno == EINTR) continue;
+        if (errno == EPIPE) abort_thread(0);
+        server_protocol_perror("readv");
+    }
+
+    if (req->u.reply.reply_header.reply_size > size)
+        read_reply_data( (char *)req->reply_data + size, req->u.reply.reply_header.reply_size - size );
     return req->u.reply.reply_header.error;
 }
 
@@ -29,6 +29,9 @@
 #include <sys/socket.h>
 #include <sys/ioctl.h>
 #include <unistd.h>
+#ifdef HAVE_SYS_SENDFILE_H
+# include <sys/sendfile.h>
+#endif
 #ifdef HAVE_IFADDRS_H
 # include <ifaddrs.h>
 #endif
@@ -152,6 +155,7 @@ struct async_transmit_ioctl
     unsigned int head_len;
     unsigned int tail_len;
     LARGE_INTEGER offset;
+    BOOL no_sendfile;           /* sendfile() is not usable for this file */
 };
 
 static NTSTATUS sock_errno_to_status( int err )
@@ -1387,6 +1391,43 @@ static NTSTATUS try_transmit( int sock_fd, int file_fd, struct async_transmit_io
         async->file_cursor += ret;
     }
 
+#ifdef HAVE_SYS_SENDFILE_H
+    /* let the kernel copy the file data directly to the socket */
+    while (async->file && !async->no_sendfile && async->buffer_cursor == async->read_len)
+    {
+        size_t count = 0x7ffff000;
+        off_t offset = async->offset.QuadPart;
+
+        if (async->file_len)
+            count = min( count, async->file_len - async->file_cursor );
+
+        TRACE( "sending up to %zu bytes of file data with sendfile\n", count );
+        if (async->offset.QuadPart == FILE_USE_FILE_POINTER_POSITION)
+            ret = sendfile( sock_fd, file_fd, NULL, count );
+        else
+            ret = sendfile( sock_fd, file_fd, &offset, count );
+        if (ret < 0)
+        {
+            if (errno == EINTR) continue;
+            if ((errno == EINVAL || errno == ENOSYS) && !async->file_cursor)
+            {
+                TRACE( "sendfile not supported, falling back to read/send\n" );
+                async->no_sendfile = TRUE;
+                break;
+            }
+            if (errno != EWOULDBLOCK) WARN( "sendfile: %s\n", strerror( errno ) );
+            return sock_errno_to_status( errno );
+        }
+        TRACE( "sendfile returned %zd\n", ret );
+
+        async->file_cursor += ret;
+        if (async->offset.QuadPart != FILE_USE_FILE_POINTER_POSITION)
+            async->offset.QuadPart += ret;
+        if (!ret || (async->file_len && async->file_cursor == async->file_len))
+            async->file = NULL;
+    }
+#endif
+
     if (async->file && async->buffer_cursor == async->read_len)
     {
         unsigned int read_size = async->buffer_size;
@@ -1511,6 +1552,7 @@ static NTSTATUS sock_transmit( HANDLE handle, HANDLE event, PIO_APC_ROUTINE apc,
     async->tail = u64_to_user_ptr(params->tail_ptr);
     async->tail_len = params->tail_len;
     async->offset = params->offset;
+    async->no_sendfile = FALSE;
 
     SERVER_START_REQ( send_socket )
     {
@@ -2873,9 +2873,10 @@ NTSTATUS WINAPI NtRemoveIoCompletion( HANDLE handle, ULONG_PTR *key, ULONG_PTR *
 NTSTATUS WINAPI NtRemoveIoCompletionEx( HANDLE handle, FILE_IO_COMPLETION_INFORMATION *info, ULONG count,
                                         ULONG *written, LARGE_INTEGER *timeout, BOOLEAN alertable )
 {
+    struct completion_msg msgs[32];
     HANDLE wait_handle = NULL;
     unsigned int status;
-    ULONG i = 0;
+    ULONG i = 0, j, extra, fetched;
 
     TRACE( "%p %p %u %p %p %u\n", handle, info, count, written, timeout, alertable );
 
@@ -2883,22 +2884,36 @@ NTSTATUS WINAPI NtRemoveIoCompletionEx( HANDLE handle, FILE_IO_COMPLETION_INFORM
 
     while (i < count)
     {
+        /* let the server return further queued completions along with the first one */
+        extra = min( count - i - 1, ARRAY_SIZE(msgs) );
+        fetched = 0;
         SERVER_START_REQ( remove_completion )
         {
             req->handle = wine_server_obj_handle( handle );
             req->alertable = alertable;
+            if (extra) wine_server_set_reply( req, msgs, extra * sizeof(msgs[0]) );
             if (!(status = wine_server_call( req )))
             {
                 info[i].CompletionKey             = reply->ckey;
                 info[i].CompletionValue           = reply->cvalue;
                 info[i].IoStatusBlock.Information = reply->information;
                 info[i].IoStatusBlock.Status      = reply->status;
+                fetched = wine_server_reply_size( reply ) / sizeof(msgs[0]);
             }
             else wait_handle = wine_server_ptr_handle( reply->wait_handle );
         }
         SERVER_END_REQ;
         if (status != STATUS_SUCCESS) break;
         ++i;
+        for (j = 0; j < fetched; j++, i++)
+        {
+            info[i].CompletionKey             = msgs[j].ckey;
+            info[i].CompletionValue           = msgs[j].cvalue;
+            info[i].IoStatusBlock.Information = msgs[j].information;
+            info[i].IoStatusBlock.Status      = msgs[j].status;
+        }
+        /* the queue has been drained, don't bother asking again */
+        if (fetched < extra) break;
     }
     if (i || (status != STATUS_PENDING && status != STATUS_USER_APC))
     {
@@ -167,9 +167,11 @@ static const BYTE VIRTUAL_Win32Flags[16] =
 };
 
 static struct wine_rb_tree views_tree;
+static struct file_view *last_found_view;  /* cache for find_view, locked via virtual_mutex */
 static pthread_mutex_t virtual_mutex;
 
 static const UINT page_shift = 12;
+static const size_t large_page_size = 2 * 1024 * 1024;  /* matches GetLargePageMinimum() */
 static const UINT_PTR page_mask = 0xfff;
 static const UINT_PTR granularity_mask = 0xffff;
 
@@ -1450,17 +1452,25 @@ static void VIRTUAL_Dump(void)
 static struct file_view *find_view( const void *addr, size_t size )
 {
     struct wine_rb_entry *ptr = views_tree.root;
+    struct file_view *view = last_found_view;
 
     if ((const char *)addr + size < (const char *)addr) return NULL; /* overflow */
 
+    /* consecutive lookups very often hit the same view */
+    if (view && view->base <= addr && (const char *)view->base + view->size > (const char *)addr)
+    {
+        if ((const char *)view->base + view->size < (const char *)addr + size) return NULL;  /* size too large */
+        return view;
+    }
+
     while (ptr)
     {
-        struct file_view *view = WINE_RB_ENTRY_VALUE( ptr, struct file_view, entry );
+        view = WINE_RB_ENTRY_VALUE( ptr, struct file_view, entry );
 
         if (view->base > addr) ptr = ptr->left;
         else if ((const char *)view->base + view->size <= (const char *)addr) ptr = ptr->right;
         else if ((const char *)view->base + view->size < (const char *)addr + size) break;  /* size too large */
-        else return view;
+        else return last_found_view = view;
     }
     return NULL;
 }
@@ -1786,6 +1796,7 @@ static void free_view( struct file_view *view )
  */
 static void unregister_view( struct file_view *view )
 {
+    if (view == last_found_view) last_found_view = NULL;
     if (mmap_is_in_reserved_area( view->base, view->size ))
         free_ranges_remove_view( view );
     wine_rb_remove( &views_tree, &view->entry );
@@ -3021,6 +3032,154 @@ static IMAGE_BASE_RELOCATION *process_relocation_block( char *page, IMAGE_BASE_R
 }
 
 
+struct perf_map_symbol
+{
+    DWORD       rva;
+    const char *name;
+    DWORD       ordinal;
+};
+
+static int compare_perf_map_symbols( const void *a, const void *b )
+{
+    const struct perf_map_symbol *sym1 = a, *sym2 = b;
+
+    if (sym1->rva != sym2->rva) return sym1->rva < sym2->rva ? -1 : 1;
+    return (int)sym1->ordinal - (int)sym2->ordinal;
+}
+
+static BOOL is_image_range_readable( const char *base, SIZE_T size )
+{
+    const char *addr = ROUND_ADDR( base, page_mask );
+
+    for ( ; addr < base + size; addr += page_size)
+        if (!(get_page_vprot( addr ) & VPROT_READ)) return FALSE;
+    return TRUE;
+}
+
+/***********************************************************************
+ *           perf_map_image
+ *
+ * Append the exported functions of a newly mapped image to /tmp/perf-<pid>.map,
+ * so that Linux perf can symbolize PE code. Enabled by setting WINEPERFMAP.
+ * Must be called with the virtual mutex held, which also serializes the writes.
+ */
+static void perf_map_image( char *ptr, SIZE_T total_size, IMAGE_NT_HEADERS *nt,
+                            const UNICODE_STRING *nt_name )
+{
+    static int perf_map_fd = -2;
+    IMAGE_SECTION_HEADER *sec = IMAGE_FIRST_SECTION( nt );
+    const IMAGE_EXPORT_DIRECTORY *exports;
+    const IMAGE_DATA_DIRECTORY *dir;
+    const DWORD *functions, *names;
+    const WORD *ordinals;
+    struct perf_map_symbol *symbols;
+    const WCHAR *name = NULL;
+    char module[256], *buffer;
+    DWORD i, j, count = 0, dir_end, end;
+    size_t pos = 0, size;
+    int len;
+
+    if (perf_map_fd == -2)
+    {
+        const char *env = getenv( "WINEPERFMAP" );
+
+        perf_map_fd = -1;
+        if (env && atoi( env ))
+        {
+            char path[32];
+
+            snprintf( path, sizeof(path), "/tmp/perf-%d.map", getpid() );
+            if ((perf_map_fd = open( path, O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644 )) == -1)
+                WARN( "cannot create %s: %s\n", path, strerror( errno ));
+        }
+    }
+    if (perf_map_fd == -1) return;
+
+    if (!(dir = get_data_dir( nt, total_size, IMAGE_DIRECTORY_ENTRY_EXPORT ))) return;
+    if (dir->Size < sizeof(*exports) || !is_image_range_readable( ptr + dir->VirtualAddress, dir->Size )) return;
+    exports = (const IMAGE_EXPORT_DIRECTORY *)(ptr + dir->VirtualAddress);
+    dir_end = dir->VirtualAddress + dir->Size;
+
+    /* all the export tables are expected to live in the export directory */
+    if (exports->AddressOfFunctions < dir->VirtualAddress ||
+        exports->NumberOfFunctions > (dir_end - exports->AddressOfFunctions) / sizeof(DWORD)) return;
+    if (exports->NumberOfNames &&
+        (exports->AddressOfNames < dir->VirtualAddress ||
+         exports->AddressOfNameOrdinals < dir->VirtualAddress ||
+         exports->NumberOfNames > (dir_end - exports->AddressOfNames) / sizeof(DWORD) ||
+         exports->NumberOfNames > (dir_end - exports->AddressOfNameOrdinals) / sizeof(WORD))) return;
+    functions = (const DWORD *)(ptr + exports->AddressOfFunctions);
+    names = (const DWORD *)(ptr + exports->AddressOfNames);
+    ordinals = (const WORD *)(ptr + exports->AddressOfNameOrdinals);
+
+    if (!(symbols = calloc( exports->NumberOfFunctions, sizeof(*symbols) ))) return;
+    for (i = 0; i < exports->NumberOfFunctions; i++)
+    {
+        /* skip forwarders and data exports */
+        if (!functions[i] || (functions[i] >= dir->VirtualAddress && functions[i] < dir_end)) continue;
+        for (j = 0; j < nt->FileHeader.NumberOfSections; j++)
+            if ((sec[j].Characteristics & IMAGE_SCN_MEM_EXECUTE) &&
+                functions[i] >= sec[j].VirtualAddress &&
+                functions[i] - sec[j].VirtualAddress < max( sec[j].Misc.VirtualSize, sec[j].SizeOfRawData ))
+                break;
+        if (j == nt->FileHeader.NumberOfSections) continue;
+        symbols[i].rva = functions[i];
+    }
+    for (i = 0; i < exports->NumberOfNames; i++)
+    {
+        if (ordinals[i] >= exports->NumberOfFunctions || !symbols[ordinals[i]].rva) continue;
+        if (names[i] < dir->VirtualAddress || names[i] >= dir_end) continue;
+        if (!memchr( ptr + names[i], 0, dir_end - names[i] )) continue;
+        if (!symbols[ordinals[i]].name) symbols[ordinals[i]].name = ptr + names[i];
+    }
+    for (i = 0; i < exports->NumberOfFunctions; i++)
+    {
+        if (!symbols[i].rva) continue;
+        symbols[count] = symbols[i];
+        symbols[count++].ordinal = exports->Base + i;
+    }
+    qsort( symbols, count, sizeof(*symbols), compare_perf_map_symbols );
+
+    len = nt_name ? nt_name->Length / sizeof(WCHAR) : 0;
+    if (len)
+    {
+        name = nt_name->Buffer + len;
+        while (name > nt_name->Buffer && name[-1] != '\\') name--;
+        len = nt_name->Buffer + len - name;
+    }
+    len = name ? ntdll_wcstoumbs( name, len, module, sizeof(module) - 1, FALSE ) : 0;
+    module[max( len, 0 )] = 0;
+
+    size = count * (sizeof(module) + 128 + 32) + 1;
+    if ((buffer = malloc( size )))
+    {
+        for (i = 0; i < count; i++)
+        {
+            /* aliases share the first entry */
+            if (i && symbols[i].rva == symbols[i - 1].rva) continue;
+            for (j = 0; j < nt->FileHeader.NumberOfSections; j++)
+                if (symbols[i].rva >= sec[j].VirtualAddress &&
+                    symbols[i].rva - sec[j].VirtualAddress < max( sec[j].Misc.VirtualSize, sec[j].SizeOfRawData ))
+                    break;
+            end = sec[j].VirtualAddress + max( sec[j].Misc.VirtualSize, sec[j].SizeOfRawData );
+            for (j = i + 1; j < count; j++)
+                if (symbols[j].rva != symbols[i].rva) break;
+            if (j < count && symbols[j].rva < end) end = symbols[j].rva;
+
+            if (symbols[i].name)
+                pos += snprintf( buffer + pos, size - pos, "%lx %x %s!%.127s\n",
+                                 (ULONG_PTR)ptr + symbols[i].rva, end - symbols[i].rva, module, symbols[i].name );
+            else
+                pos += snprintf( buffer + pos, size - pos, "%lx %x %s!#%u\n",
+                                 (ULONG_PTR)ptr + symbols[i].rva, end - symbols[i].rva, module, symbols[i].ordinal );
+        }
+        if (pos && write( perf_map_fd, buffer, pos ) != pos) WARN( "failed to write perf map entries\n" );
+        free( buffer );
+    }
+    free( symbols );
+}
+
+
 /***********************************************************************
  *           map_image_into_view
  *
@@ -3260,6 +3419,7 @@ static NTSTATUS map_image_into_view( struct file_view *view, const UNICODE_STRIN
 #ifdef VALGRIND_LOAD_PDB_DEBUGINFO
     VALGRIND_LOAD_PDB_DEBUGINFO(fd, ptr, total_size, ptr - (char *)wine_server_get_ptr( image_info->base ));
 #endif
+    perf_map_image( ptr, total_size, nt, nt_name );
     status = STATUS_SUCCESS;
 
 done:
@@ -5121,6 +5281,16 @@ static NTSTATUS allocate_virtual_memory( void **ret, SIZE_T *size_ptr, ULONG typ
     if (type & MEM_RESERVE_PLACEHOLDER && (protect != PAGE_NOACCESS)) return STATUS_INVALID_PARAMETER;
     if (!arm64ec_view && (attributes & MEM_EXTENDED_PARAMETER_EC_CODE)) return STATUS_INVALID_PARAMETER;
 
+    if (type & MEM_LARGE_PAGES)
+    {
+        /* large pages must be reserved and committed at once, in multiples of the large page size */
+        if ((type & (MEM_RESERVE | MEM_COMMIT)) != (MEM_RESERVE | MEM_COMMIT)) return STATUS_INVALID_PARAMETER;
+        if (type & (MEM_WRITE_WATCH | MEM_RESERVE_PLACEHOLDER)) return STATUS_INVALID_PARAMETER;
+        if (size & (large_page_size - 1) || (UINT_PTR)base & (large_page_size - 1))
+            return STATUS_INVALID_PARAMETER;
+        if (!align) align = large_page_size;
+    }
+
     /* Reserve the memory */
 
     server_enter_uninterrupted_section( &virtual_mutex, &sigset );
@@ -5143,6 +5313,10 @@ static NTSTATUS allocate_virtual_memory( void **ret, SIZE_T *size_ptr, ULONG typ
             {
                 base = view->base;
                 if (vprot & VPROT_EXEC || force_exec_prot) mprotect_range( base, size, 0, 0 );
+#ifdef MADV_HUGEPAGE
+                /* let the kernel back the range with transparent huge pages */
+                if (type & MEM_LARGE_PAGES) madvise( base, size, MADV_HUGEPAGE );
+#endif
             }
         }
     }
@@ -5198,7 +5372,8 @@ static NTSTATUS allocate_virtual_memory( void **ret, SIZE_T *size_ptr, ULONG typ
 NTSTATUS WINAPI NtAllocateVirtualMemory( HANDLE process, PVOID *ret, ULONG_PTR zero_bits,
                                          SIZE_T *size_ptr, ULONG type, ULONG protect )
 {
-    static const ULONG type_mask = MEM_COMMIT | MEM_RESERVE | MEM_TOP_DOWN | MEM_WRITE_WATCH | MEM_RESET;
+    static const ULONG type_mask = MEM_COMMIT | MEM_RESERVE | MEM_TOP_DOWN | MEM_WRITE_WATCH | MEM_RESET |
+                                   MEM_LARGE_PAGES;
     ULONG_PTR limit;
 
     TRACE("%p %p %08lx %x %08x\n", process, *ret, *size_ptr, type, protect );
@@ -5338,7 +5513,8 @@ NTSTATUS WINAPI NtAllocateVirtualMemoryEx( HANDLE process, PVOID *ret, SIZE_T *s
                                            ULONG count )
 {
     static const ULONG type_mask = MEM_COMMIT | MEM_RESERVE | MEM_TOP_DOWN | MEM_WRITE_WATCH
-                                   | MEM_RESET | MEM_RESERVE_PLACEHOLDER | MEM_REPLACE_PLACEHOLDER;
+                                   | MEM_RESET | MEM_RESERVE_PLACEHOLDER | MEM_REPLACE_PLACEHOLDER
+                                   | MEM_LARGE_PAGES;
     ULONG_PTR limit_low = 0;
     ULONG_PTR limit_high = 0;
     ULONG_PTR align = 0;
@@ -1277,6 +1277,9 @@ typedef struct tagTLBContext
 	void *mapping;        /* memory mapping */
 	MSFT_SegDir * pTblDir;
 	ITypeLibImpl* pLibInfo;
+	TLBString **names;    /* name table entries, indexed by offset / 4 */
+	TLBString **strings;  /* string table entries, indexed by offset / 4 */
+	TLBGuid **guids;      /* guid table entries, indexed by entry */
 } TLBContext;
 
 
@@ -2074,6 +2077,8 @@ static HRESULT MSFT_ReadAllGuids(TLBContext *pcx)
     MSFT_GuidEntry entry;
     int offs = 0;
 
+    pcx->guids = calloc(pcx->pTblDir->pGuidTab.length / sizeof(MSFT_GuidEntry) + 1, sizeof(*pcx->guids));
+
     MSFT_Seek(pcx, pcx->pTblDir->pGuidTab.offset);
     while (1) {
         if (offs >= pcx->pTblDir->pGuidTab.length)
@@ -2088,6 +2093,7 @@ static HRESULT MSFT_ReadAllGuids(TLBContext *pcx)
         guid->hreftype = entry.hreftype;
 
         list_add_tail(&pcx->pLibInfo->guid_list, &guid->entry);
+        if (pcx->guids) pcx->guids[offs / sizeof(MSFT_GuidEntry)] = guid;
 
         offs += sizeof(MSFT_GuidEntry);
     }
@@ -2097,6 +2103,15 @@ static TLBGuid *MSFT_ReadGuid( int offset, TLBContext *pcx)
 {
     TLBGuid *ret;
 
+    if (pcx->guids)
+    {
+        if (offset < 0 || offset >= pcx->pTblDir->pGuidTab.length || offset % sizeof(MSFT_GuidEntry))
+            return NULL;
+        ret = pcx->guids[offset / sizeof(MSFT_GuidEntry)];
+        if (ret) TRACE_(typelib)("%s\n", debugstr_guid(&ret->guid));
+        return ret;
+    }
+
     LIST_FOR_EACH_ENTRY(ret, &pcx->pLibInfo->guid_list, TLBGuid, entry){
         if(ret->offset == offset){
             TRACE_(typelib)("%s\n", debugstr_guid(&ret->guid));
@@ -2130,6 +2145,8 @@ static HRESULT MSFT_ReadAllNames(TLBContext *pcx)
     INT16 len_piece;
     int offs = 0, lengthInChars;
 
+    pcx->names = calloc(pcx->pTblDir->pNametab.length / 4 + 1, sizeof(*pcx->names));
+
     MSFT_Seek(pcx, pcx->pTblDir->pNametab.offset);
     while (1) {
         TLBString *tlbstr;
@@ -2165,6 +2182,7 @@ static HRESULT MSFT_ReadAllNames(TLBContext *pcx)
         free(string);
 
         list_add_tail(&pcx->pLibInfo->name_list, &tlbstr->entry);
+        if (pcx->names) pcx->names[offs / 4] = tlbstr;
 
         offs += len_piece;
     }
@@ -2174,6 +2192,15 @@ static TLBString *MSFT_ReadName( TLBContext *pcx, int offset)
 {
     TLBString *tlbstr;
 
+    if (pcx->names)
+    {
+        if (offset < 0 || offset >= pcx->pTblDir->pNametab.length || offset % 4)
+            return NULL;
+        tlbstr = pcx->names[offset / 4];
+        if (tlbstr) TRACE_(typelib)("%s\n", debugstr_w(tlbstr->str));
+        return tlbstr;
+    }
+
     LIST_FOR_EACH_ENTRY(tlbstr, &pcx->pLibInfo->name_list, TLBString, entry) {
         if (tlbstr->offset == offset) {
             TRACE_(typelib)("%s\n", debugstr_w(tlbstr->str));
@@ -2188,6 +2215,15 @@ static TLBString *MSFT_ReadString( TLBContext *pcx, int offset)
 {
     TLBString *tlbstr;
 
+    if (pcx->strings)
+    {
+        if (offset < 0 || offset >= pcx->pTblDir->pStringtab.length || offset % 4)
+            return NULL;
+        tlbstr = pcx->strings[offset / 4];
+        if (tlbstr) TRACE_(typelib)("%s\n", debugstr_w(tlbstr->str));
+        return tlbstr;
+    }
+
     LIST_FOR_EACH_ENTRY(tlbstr, &pcx->pLibInfo->string_list, TLBString, entry) {
         if (tlbstr->offset == offset) {
             TRACE_(typelib)("%s\n", debugstr_w(tlbstr->str));
@@ -2762,6 +2798,8 @@ static HRESULT MSFT_ReadAllStrings(TLBContext *pcx)
     INT16 len_str, len_piece;
     int offs = 0, lengthInChars;
 
+    pcx->strings = calloc(pcx->pTblDir->pStringtab.length / 4 + 1, sizeof(*pcx->strings));
+
     MSFT_Seek(pcx, pcx->pTblDir->pStringtab.offset);
     while (1) {
         TLBString *tlbstr;
@@ -2796,6 +2834,7 @@ static HRESULT MSFT_ReadAllStrings(TLBContext *pcx)
         free(string);
 
         list_add_tail(&pcx->pLibInfo->string_list, &tlbstr->entry);
+        if (pcx->strings) pcx->strings[offs / 4] = tlbstr;
 
         offs += len_piece;
     }
@@ -3381,8 +3420,20 @@ static HRESULT TLB_ReadTypeLib(LPCWSTR pszFileName, LPWSTR pszPath, UINT cchPath
 	/* We should really canonicalise the path here. */
         impl->index = index;
 
-        /* FIXME: check if it has added already in the meantime */
+        /* another thread may have loaded the same typelib in the meantime */
         EnterCriticalSection(&cache_section);
+        LIST_FOR_EACH_ENTRY(entry, &tlb_cache, ITypeLibImpl, entry)
+        {
+            if (!wcsicmp(entry->path, pszPath) && entry->index == index)
+            {
+                TRACE("already cached\n");
+                ITypeLib2_AddRef(&entry->ITypeLib2_iface);
+                LeaveCriticalSection(&cache_section);
+                ITypeLib2_Release(*ppTypeLib);
+                *ppTypeLib = &entry->ITypeLib2_iface;
+                return S_OK;
+            }
+        }
         list_add_head(&tlb_cache, &impl->entry);
         LeaveCriticalSection(&cache_section);
         ret = S_OK;
@@ -3449,6 +3500,9 @@ static ITypeLib2* ITypeLib2_Constructor_MSFT(LPVOID pLib, DWORD dwTLBLength)
     cx.mapping = pLib;
     cx.pLibInfo = pTypeLibImpl;
     cx.length = dwTLBLength;
+    cx.names = NULL;
+    cx.strings = NULL;
+    cx.guids = NULL;
 
     /* read header */
     MSFT_ReadLEDWords(&tlbHeader, sizeof(tlbHeader), &cx, 0);
@@ -3640,6 +3694,10 @@ static ITypeLib2* ITypeLib2_Constructor_MSFT(LPVOID pLib, DWORD dwTLBLength)
             TLB_fix_typeinfo_ptr_size(pTypeLibImpl->typeinfos[i]);
     }
 
+    free(cx.names);
+    free(cx.strings);
+    free(cx.guids);
+
     TRACE("(%p)\n", pTypeLibImpl);
     return &pTypeLibImpl->ITypeLib2_iface;
 }
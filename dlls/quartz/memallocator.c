@@ -55,7 +55,7 @@ typedef struct BaseMemAllocator
     HRESULT (* fnBufferPrepare)(IMemAllocator *, StdMediaSample2 *, DWORD flags);
     HRESULT (* fnBufferReleased)(IMemAllocator *, StdMediaSample2 *);
     void (* fnDestroyed)(IMemAllocator *);
-    HANDLE hSemWaiting;
+    CONDITION_VARIABLE free_cv;
     BOOL bDecommitQueued;
     BOOL bCommitted;
     LONG lWaiting;
@@ -100,7 +100,7 @@ static HRESULT BaseMemAllocator_Init(HRESULT (* fnAlloc)(IMemAllocator *),
     pMemAlloc->fnDestroyed = fnDestroyed;
     pMemAlloc->bDecommitQueued = FALSE;
     pMemAlloc->bCommitted = FALSE;
-    pMemAlloc->hSemWaiting = NULL;
+    InitializeConditionVariable(&pMemAlloc->free_cv);
     pMemAlloc->lWaiting = 0;
     pMemAlloc->pCritSect = pCritSect;
 
@@ -149,7 +149,6 @@ static ULONG WINAPI BaseMemAllocator_Release(IMemAllocator * iface)
 
     if (!ref)
     {
-        CloseHandle(This->hSemWaiting);
         if (This->bCommitted)
             This->fnFree(iface);
 
@@ -234,19 +233,11 @@ static HRESULT WINAPI BaseMemAllocator_Commit(IMemAllocator * iface)
             hr = S_OK;
         else
         {
-            if (!(This->hSemWaiting = CreateSemaphoreW(NULL, This->props.cBuffers, This->props.cBuffers, NULL)))
-            {
-                ERR("Failed to create semaphore, error %lu.\n", GetLastError());
-                hr = HRESULT_FROM_WIN32(GetLastError());
-            }
+            hr = This->fnAlloc(iface);
+            if (SUCCEEDED(hr))
+                This->bCommitted = TRUE;
             else
-            {
-                hr = This->fnAlloc(iface);
-                if (SUCCEEDED(hr))
-                    This->bCommitted = TRUE;
-                else
-                    ERR("Failed to allocate, hr %#lx.\n", hr);
-            }
+                ERR("Failed to allocate, hr %#lx.\n", hr);
         }
     }
     LeaveCriticalSection(This->pCritSect);
@@ -271,8 +262,8 @@ static HRESULT WINAPI BaseMemAllocator_Decommit(IMemAllocator * iface)
             {
                 This->bDecommitQueued = TRUE;
                 /* notify ALL waiting threads that they cannot be allocated a buffer any more */
-                ReleaseSemaphore(This->hSemWaiting, This->lWaiting, NULL);
-                
+                WakeAllConditionVariable(&This->free_cv);
+
                 hr = S_OK;
             }
             else
@@ -281,8 +272,6 @@ static HRESULT WINAPI BaseMemAllocator_Decommit(IMemAllocator * iface)
                     ERR("Waiting: %ld\n", This->lWaiting);
 
                 This->bCommitted = FALSE;
-                CloseHandle(This->hSemWaiting);
-                This->hSemWaiting = NULL;
 
                 hr = This->fnFree(iface);
             }
@@ -309,43 +298,42 @@ static HRESULT WINAPI BaseMemAllocator_GetBuffer(IMemAllocator * iface, IMediaSa
     EnterCriticalSection(This->pCritSect);
     if (!This->bCommitted || This->bDecommitQueued)
     {
+        LeaveCriticalSection(This->pCritSect);
         WARN("Not committed\n");
-        hr = VFW_E_NOT_COMMITTED;
+        return VFW_E_NOT_COMMITTED;
     }
-    else
-        ++This->lWaiting;
-    LeaveCriticalSection(This->pCritSect);
-    if (FAILED(hr))
-        return hr;
 
-    if (WaitForSingleObject(This->hSemWaiting, (dwFlags & AM_GBF_NOWAIT) ? 0 : INFINITE) != WAIT_OBJECT_0)
+    /* Waiting on the allocator's own lock keeps the common case, where a
+     * buffer is free, entirely in user space. */
+    ++This->lWaiting;
+    while (list_empty(&This->free_list) && This->bCommitted && !This->bDecommitQueued)
     {
-        EnterCriticalSection(This->pCritSect);
-        --This->lWaiting;
-        LeaveCriticalSection(This->pCritSect);
-        WARN("Timed out\n");
-        return VFW_E_TIMEOUT;
+        if ((dwFlags & AM_GBF_NOWAIT) || !SleepConditionVariableCS(&This->free_cv, This->pCritSect, INFINITE))
+        {
+            --This->lWaiting;
+            LeaveCriticalSection(This->pCritSect);
+            WARN("Timed out\n");
+            return VFW_E_TIMEOUT;
+        }
     }
 
-    EnterCriticalSection(This->pCritSect);
+    --This->lWaiting;
+
+    if (!This->bCommitted)
+        hr = VFW_E_NOT_COMMITTED;
+    else if (This->bDecommitQueued)
+        hr = VFW_E_TIMEOUT;
+    else
     {
-        --This->lWaiting;
-        if (!This->bCommitted)
-            hr = VFW_E_NOT_COMMITTED;
-        else if (This->bDecommitQueued)
-            hr = VFW_E_TIMEOUT;
-        else
-        {
-            StdMediaSample2 *ms;
-            struct list * free = list_head(&This->free_list);
-            list_remove(free);
-            list_add_head(&This->used_list, free);
-
-            ms = LIST_ENTRY(free, StdMediaSample2, listentry);
-            assert(ms->ref == 0);
-            *pSample = (IMediaSample *)&ms->IMediaSample2_iface;
-            IMediaSample_AddRef(*pSample);
-        }
+        StdMediaSample2 *ms;
+        struct list * free = list_head(&This->free_list);
+        list_remove(free);
+        list_add_head(&This->used_list, free);
+
+        ms = LIST_ENTRY(free, StdMediaSample2, listentry);
+        assert(ms->ref == 0);
+        *pSample = (IMediaSample *)&ms->IMediaSample2_iface;
+        IMediaSample_AddRef(*pSample);
     }
     LeaveCriticalSection(This->pCritSect);
 
@@ -384,20 +372,13 @@ static HRESULT WINAPI BaseMemAllocator_ReleaseBuffer(IMemAllocator * iface, IMed
             This->bCommitted = FALSE;
             This->bDecommitQueued = FALSE;
 
-            CloseHandle(This->hSemWaiting);
-            This->hSemWaiting = NULL;
-            
             This->fnFree(iface);
         }
     }
     LeaveCriticalSection(This->pCritSect);
 
     /* notify a waiting thread that there is now a free buffer */
-    if (This->hSemWaiting && !ReleaseSemaphore(This->hSemWaiting, 1, NULL))
-    {
-        ERR("Failed to release semaphore, error %lu.\n", GetLastError());
-        hr = HRESULT_FROM_WIN32(GetLastError());
-    }
+    WakeConditionVariable(&This->free_cv);
 
     return hr;
 }
@@ -832,6 +813,7 @@ static HRESULT StdMemAllocator_Alloc(IMemAllocator * iface)
 {
     StdMemAllocator *This = StdMemAllocator_from_IMemAllocator(iface);
     StdMediaSample2 * pSample = NULL;
+    SIZE_T align, prefix, stride;
     SYSTEM_INFO si;
     LONG i;
 
@@ -844,19 +826,22 @@ static HRESULT StdMemAllocator_Alloc(IMemAllocator * iface)
     if ((si.dwPageSize % This->base.props.cbAlign) != 0)
         return VFW_E_BADALIGN;
 
-    /* FIXME: each sample has to have its buffer start on the right alignment.
-     * We don't do this at the moment */
+    /* Each buffer starts on the requested alignment, with its prefix right
+     * before it. VirtualAlloc() gives us a page aligned base, so it is enough
+     * to round the prefix and the per-sample stride up to the alignment. */
+    align = This->base.props.cbAlign;
+    prefix = (This->base.props.cbPrefix + align - 1) & ~(align - 1);
+    stride = (prefix + This->base.props.cbBuffer + align - 1) & ~(align - 1);
 
     /* allocate memory */
-    This->pMemory = VirtualAlloc(NULL, (This->base.props.cbBuffer + This->base.props.cbPrefix) * This->base.props.cBuffers, MEM_COMMIT, PAGE_READWRITE);
+    This->pMemory = VirtualAlloc(NULL, stride * This->base.props.cBuffers, MEM_COMMIT, PAGE_READWRITE);
 
     if (!This->pMemory)
         return E_OUTOFMEMORY;
 
     for (i = This->base.props.cBuffers - 1; i >= 0; i--)
     {
-        /* pbBuffer does not start at the base address, it starts at base + cbPrefix */
-        BYTE * pbBuffer = (BYTE *)This->pMemory + i * (This->base.props.cbBuffer + This->base.props.cbPrefix) + This->base.props.cbPrefix;
+        BYTE * pbBuffer = (BYTE *)This->pMemory + i * stride + prefix;
         
         StdMediaSample2_Construct(pbBuffer, This->base.props.cbBuffer, iface, &pSample);
 
@@ -81,6 +81,10 @@ void editor_draw( ME_TextEditor *editor, HDC hDC, const RECT *update )
     /* Draw the paragraph if any of the paragraph is in the update region. */
     if (ys < update->bottom && ye > update->top)
       draw_paragraph( &c, para );
+    /* Paragraphs outside of tables are laid out in increasing y order,
+     * so nothing past this one can be visible. */
+    else if (!cell && ys >= update->bottom)
+      break;
     para = para_next( para );
   }
   if (editor_opaque( editor ))
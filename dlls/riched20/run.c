@@ -249,11 +249,22 @@ void cursor_from_char_ofs( ME_TextEditor *editor, int char_ofs, ME_Cursor *curso
 
     char_ofs = min( max( char_ofs, 0 ), ME_GetTextLength( editor ) );
 
-    /* Find the paragraph at the offset. */
-    for (para = editor_first_para( editor );
-         para_next( para )->nCharOfs <= char_ofs;
-         para = para_next( para ))
-        ;
+    /* Find the paragraph at the offset, searching from whichever end of the
+     * document is closer so that appending to large documents stays cheap. */
+    if (char_ofs > ME_GetTextLength( editor ) / 2)
+    {
+        for (para = para_prev( editor_end_para( editor ) );
+             para->nCharOfs > char_ofs;
+             para = para_prev( para ))
+            ;
+    }
+    else
+    {
+        for (para = editor_first_para( editor );
+             para_next( para )->nCharOfs <= char_ofs;
+             para = para_next( para ))
+            ;
+    }
 
     char_ofs -= para->nCharOfs;
 
@@ -538,6 +538,22 @@ void client_do_args( PMIDL_STUB_MESSAGE pStubMsg, PFORMAT_STRING pFormat, enum s
     }
 }
 
+/* the null reference checks done by the CALCSIZE phase, for when sizing can be skipped */
+static void client_check_ref_args( PMIDL_STUB_MESSAGE pStubMsg, PFORMAT_STRING pFormat,
+                                   unsigned short number_of_params )
+{
+    const NDR_PARAM_OIF *params = (const NDR_PARAM_OIF *)pFormat;
+    unsigned int i;
+
+    for (i = 0; i < number_of_params; i++)
+    {
+        unsigned char *pArg = pStubMsg->StackTop + params[i].stack_offset;
+
+        if (params[i].attr.IsSimpleRef && !*(unsigned char **)pArg)
+            RpcRaiseException(RPC_X_NULL_REF_POINTER);
+    }
+}
+
 static unsigned int type_stack_size(unsigned char fc)
 {
     switch (fc)
@@ -702,7 +718,8 @@ static void CALLBACK ndr_client_call_finally(BOOL normal, void *arg)
 static LONG_PTR ndr_client_call( const MIDL_STUB_DESC *stub_desc, const PFORMAT_STRING format,
         const PFORMAT_STRING handle_format, void **stack_top, BOOLEAN fpu_args, MIDL_STUB_MESSAGE *stub_msg,
         unsigned short procedure_number, unsigned short stack_size, unsigned int number_of_params,
-        INTERPRETER_OPT_FLAGS Oif_flags, INTERPRETER_OPT_FLAGS2 ext_flags, const NDR_PROC_HEADER *proc_header )
+        INTERPRETER_OPT_FLAGS Oif_flags, INTERPRETER_OPT_FLAGS2 ext_flags, const NDR_PROC_HEADER *proc_header,
+        const NDR_PROC_PARTIAL_OIF_HEADER *oif_header )
 {
     struct ndr_client_call_ctx finally_ctx;
     RPC_MESSAGE rpc_msg;
@@ -789,8 +806,15 @@ static LONG_PTR ndr_client_call( const MIDL_STUB_DESC *stub_desc, const PFORMAT_
 
         /* 2. CALCSIZE */
         TRACE( "CALCSIZE\n" );
-        client_do_args(stub_msg, format, STUBLESS_CALCSIZE, fpu_args,
-                       number_of_params, (unsigned char *)&retval);
+        if (oif_header && !Oif_flags.ClientMustSize && !(proc_header->Oi_flags & Oi_FULL_PTR_USED))
+        {
+            /* the compiler has already computed the buffer size, there's no need to walk the types */
+            client_check_ref_args(stub_msg, format, number_of_params);
+            stub_msg->BufferLength = oif_header->constant_client_buffer_size;
+        }
+        else
+            client_do_args(stub_msg, format, STUBLESS_CALCSIZE, fpu_args,
+                           number_of_params, (unsigned char *)&retval);
 
         /* 3. GETBUFFER */
         TRACE( "GETBUFFER\n" );
@@ -864,6 +888,7 @@ LONG_PTR WINAPI NdrpClientCall2( PMIDL_STUB_DESC pStubDesc, PFORMAT_STRING pForm
     LONG_PTR RetVal = 0;
     PFORMAT_STRING pHandleFormat;
     NDR_PARAM_OIF old_args[256];
+    const NDR_PROC_PARTIAL_OIF_HEADER *pOIFHeader = NULL;
 
     TRACE("pStubDesc %p, pFormat %p, ...\n", pStubDesc, pFormat);
 
@@ -895,8 +920,7 @@ LONG_PTR WINAPI NdrpClientCall2( PMIDL_STUB_DESC pStubDesc, PFORMAT_STRING pForm
 
     if (is_oicf_stubdesc(pStubDesc))  /* -Oicf format */
     {
-        const NDR_PROC_PARTIAL_OIF_HEADER *pOIFHeader =
-            (const NDR_PROC_PARTIAL_OIF_HEADER *)pFormat;
+        pOIFHeader = (const NDR_PROC_PARTIAL_OIF_HEADER *)pFormat;
 
         Oif_flags = pOIFHeader->Oi2Flags;
         number_of_params = pOIFHeader->number_of_params;
@@ -925,7 +949,7 @@ LONG_PTR WINAPI NdrpClientCall2( PMIDL_STUB_DESC pStubDesc, PFORMAT_STRING pForm
         {
             RetVal = ndr_client_call(pStubDesc, pFormat, pHandleFormat,
                                      stack_top, fpu_args, &stubMsg, procedure_number, stack_size,
-                                     number_of_params, Oif_flags, ext_flags, pProcHeader);
+                                     number_of_params, Oif_flags, ext_flags, pProcHeader, pOIFHeader);
         }
         __EXCEPT_ALL
         {
@@ -944,7 +968,7 @@ LONG_PTR WINAPI NdrpClientCall2( PMIDL_STUB_DESC pStubDesc, PFORMAT_STRING pForm
         {
             RetVal = ndr_client_call(pStubDesc, pFormat, pHandleFormat,
                                      stack_top, fpu_args, &stubMsg, procedure_number, stack_size,
-                                     number_of_params, Oif_flags, ext_flags, pProcHeader);
+                                     number_of_params, Oif_flags, ext_flags, pProcHeader, pOIFHeader);
         }
         __EXCEPT_ALL
         {
@@ -977,7 +1001,7 @@ LONG_PTR WINAPI NdrpClientCall2( PMIDL_STUB_DESC pStubDesc, PFORMAT_STRING pForm
     {
         RetVal = ndr_client_call(pStubDesc, pFormat, pHandleFormat,
                                  stack_top, fpu_args, &stubMsg, procedure_number, stack_size,
-                                 number_of_params, Oif_flags, ext_flags, pProcHeader);
+                                 number_of_params, Oif_flags, ext_flags, pProcHeader, pOIFHeader);
     }
 
     TRACE("RetVal = 0x%Ix\n", RetVal);
@@ -1439,9 +1463,16 @@ LONG WINAPI NdrStubCall2(
                 stubMsg.Buffer = pRpcMsg->Buffer;
             }
             break;
+        case STUBLESS_CALCSIZE:
+            /* the compiler has already computed the buffer size, there's no need to walk the types */
+            if (pOIFHeader && !Oif_flags.ServerMustSize && !(pProcHeader->Oi_flags & Oi_FULL_PTR_USED))
+            {
+                stubMsg.BufferLength = pOIFHeader->constant_server_buffer_size;
+                break;
+            }
+            /* fall through */
         case STUBLESS_UNMARSHAL:
         case STUBLESS_INITOUT:
-        case STUBLESS_CALCSIZE:
         case STUBLESS_MARSHAL:
         case STUBLESS_MUSTFREE:
         case STUBLESS_FREE:
@@ -613,6 +613,7 @@ static SECURITY_STATUS acquire_credentials_handle(ULONG fCredentialUse,
     if (!(creds = malloc(sizeof(*creds)))) return SEC_E_INSUFFICIENT_MEMORY;
     creds->credential_use = fCredentialUse;
     creds->enabled_protocols = enabled_protocols;
+    creds->has_certificate = cert != NULL;
 
     if (cert && !(key_blob = get_key_blob(cert, &key_size))) goto fail;
     params.c = creds;
@@ -29,7 +29,10 @@
 #include <stdarg.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <errno.h>
+#include <time.h>
+#include <pthread.h>
 #include <sys/types.h>
 #include <dlfcn.h>
 #ifdef SONAME_LIBGNUTLS
@@ -112,6 +115,8 @@ MAKE_FUNCPTR(gnutls_record_recv);
 MAKE_FUNCPTR(gnutls_record_send);
 MAKE_FUNCPTR(gnutls_server_name_set);
 MAKE_FUNCPTR(gnutls_session_channel_binding);
+MAKE_FUNCPTR(gnutls_session_get_data);
+MAKE_FUNCPTR(gnutls_session_set_data);
 MAKE_FUNCPTR(gnutls_set_default_priority);
 MAKE_FUNCPTR(gnutls_transport_get_ptr);
 MAKE_FUNCPTR(gnutls_transport_set_errno);
@@ -169,6 +174,12 @@ struct schan_transport
     gnutls_session_t session;
     struct schan_buffers in;
     struct schan_buffers out;
+    /* client session resumption */
+    UINT64 credentials;
+    DWORD enabled_protocols;
+    char *target;
+    BOOL resumable;
+    BOOL handshake_done;
 };
 
 static int compat_cipher_get_block_size(gnutls_cipher_algorithm_t cipher)
@@ -491,6 +502,123 @@ static NTSTATUS set_priority(schan_credentials *cred, gnutls_session_t session)
     return STATUS_SUCCESS;
 }
 
+/* Client session cache, so that connecting again to the same server with the
+ * same credentials can resume the previous session instead of going through
+ * a full handshake. */
+#define SESSION_CACHE_SIZE      32
+#define SESSION_CACHE_LIFETIME  600 /* seconds */
+
+struct session_cache_entry
+{
+    char *target;
+    UINT64 credentials;
+    DWORD enabled_protocols;
+    time_t expires;
+    void *data;
+    size_t size;
+};
+
+static struct session_cache_entry session_cache[SESSION_CACHE_SIZE];
+static pthread_mutex_t session_cache_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static void free_session_cache_entry(struct session_cache_entry *entry)
+{
+    free(entry->target);
+    free(entry->data);
+    memset(entry, 0, sizeof(*entry));
+}
+
+/* caller must hold session_cache_mutex */
+static struct session_cache_entry *find_session_cache_entry(const struct schan_transport *t, time_t now)
+{
+    unsigned int i;
+
+    for (i = 0; i < SESSION_CACHE_SIZE; i++)
+    {
+        struct session_cache_entry *entry = &session_cache[i];
+
+        if (!entry->target) continue;
+        if (entry->expires <= now)
+        {
+            free_session_cache_entry(entry);
+            continue;
+        }
+        if (entry->credentials == t->credentials && entry->enabled_protocols == t->enabled_protocols &&
+            !strcmp(entry->target, t->target))
+            return entry;
+    }
+    return NULL;
+}
+
+static void restore_cached_session(struct schan_transport *t)
+{
+    struct session_cache_entry *entry;
+    int err;
+
+    pthread_mutex_lock(&session_cache_mutex);
+    if ((entry = find_session_cache_entry(t, time(NULL))))
+    {
+        if ((err = pgnutls_session_set_data(t->session, entry->data, entry->size)) != GNUTLS_E_SUCCESS)
+            pgnutls_perror(err);
+        else
+            TRACE("Resuming session for %s\n", debugstr_a(t->target));
+    }
+    pthread_mutex_unlock(&session_cache_mutex);
+}
+
+static void cache_session(struct schan_transport *t)
+{
+    struct session_cache_entry *entry;
+    size_t size = 0;
+    time_t now;
+    void *data;
+    unsigned int i;
+
+    if (pgnutls_session_get_data(t->session, NULL, &size) != GNUTLS_E_SUCCESS || !size) return;
+    if (!(data = malloc(size))) return;
+    if (pgnutls_session_get_data(t->session, data, &size) != GNUTLS_E_SUCCESS)
+    {
+        free(data);
+        return;
+    }
+
+    pthread_mutex_lock(&session_cache_mutex);
+    now = time(NULL);
+    if (!(entry = find_session_cache_entry(t, now)))
+    {
+        /* use a free slot, or replace the entry closest to expiry */
+        entry = &session_cache[0];
+        for (i = 0; i < SESSION_CACHE_SIZE && entry->target; i++)
+            if (!session_cache[i].target || session_cache[i].expires < entry->expires) entry = &session_cache[i];
+        free_session_cache_entry(entry);
+
+        if (!(entry->target = strdup(t->target)))
+        {
+            pthread_mutex_unlock(&session_cache_mutex);
+            free(data);
+            return;
+        }
+        entry->credentials = t->credentials;
+        entry->enabled_protocols = t->enabled_protocols;
+    }
+    free(entry->data);
+    entry->data = data;
+    entry->size = size;
+    entry->expires = now + SESSION_CACHE_LIFETIME;
+    pthread_mutex_unlock(&session_cache_mutex);
+}
+
+static void flush_cached_sessions(UINT64 credentials)
+{
+    unsigned int i;
+
+    pthread_mutex_lock(&session_cache_mutex);
+    for (i = 0; i < SESSION_CACHE_SIZE; i++)
+        if (session_cache[i].target && session_cache[i].credentials == credentials)
+            free_session_cache_entry(&session_cache[i]);
+    pthread_mutex_unlock(&session_cache_mutex);
+}
+
 static NTSTATUS schan_create_session( void *args )
 {
     const struct create_session_params *params = args;
@@ -521,6 +649,13 @@ static NTSTATUS schan_create_session( void *args )
         return STATUS_INTERNAL_ERROR;
     }
     transport->session = s;
+    if (!(flags & GNUTLS_SERVER))
+    {
+        /* sessions established without a client certificate can be shared by all credentials */
+        transport->credentials = cred->has_certificate ? cred->credentials : 0;
+        transport->enabled_protocols = cred->enabled_protocols;
+        transport->resumable = TRUE;
+    }
 
     if ((status = set_priority(cred, s)))
     {
@@ -552,8 +687,10 @@ static NTSTATUS schan_dispose_session( void *args )
     const struct session_params *params = args;
     gnutls_session_t s = session_from_handle(params->session);
     struct schan_transport *t = (struct schan_transport *)pgnutls_transport_get_ptr(s);
+    if (t->target && t->handshake_done) cache_session(t);
     pgnutls_transport_set_ptr(s, NULL);
     pgnutls_deinit(s);
+    free(t->target);
     free(t);
     return STATUS_SUCCESS;
 }
@@ -562,7 +699,12 @@ static NTSTATUS schan_set_session_target( void *args )
 {
     const struct set_session_target_params *params = args;
     gnutls_session_t s = session_from_handle(params->session);
+    struct schan_transport *t = (struct schan_transport *)pgnutls_transport_get_ptr(s);
+
     pgnutls_server_name_set( s, GNUTLS_NAME_DNS, params->target, strlen(params->target) );
+
+    if (t->resumable && !t->target && (t->target = strdup(params->target)))
+        restore_cached_session(t);
     return STATUS_SUCCESS;
 }
 
@@ -658,6 +800,7 @@ static NTSTATUS schan_handshake( void *args )
         if (err == GNUTLS_E_SUCCESS)
         {
             TRACE("Handshake completed\n");
+            t->handshake_done = TRUE;
             status = SEC_E_OK;
         }
         else if (err == GNUTLS_E_AGAIN)
@@ -1453,6 +1596,7 @@ static NTSTATUS schan_allocate_certificate_credentials( void *args )
 static NTSTATUS schan_free_certificate_credentials( void *args )
 {
     const struct free_certificate_credentials_params *params = args;
+    if (params->c->has_certificate) flush_cached_sessions(params->c->credentials);
     pgnutls_certificate_free_credentials(certificate_creds_from_handle(params->c->credentials));
     return STATUS_SUCCESS;
 }
@@ -1520,6 +1664,8 @@ static NTSTATUS process_attach( void *args )
     LOAD_FUNCPTR(gnutls_record_send);
     LOAD_FUNCPTR(gnutls_server_name_set)
     LOAD_FUNCPTR(gnutls_session_channel_binding)
+    LOAD_FUNCPTR(gnutls_session_get_data)
+    LOAD_FUNCPTR(gnutls_session_set_data)
     LOAD_FUNCPTR(gnutls_set_default_priority)
     LOAD_FUNCPTR(gnutls_transport_get_ptr)
     LOAD_FUNCPTR(gnutls_transport_set_errno)
@@ -380,6 +380,36 @@ static BOOL is_fake_dll( HANDLE h )
             !memcmp( dos + 1, fakedll_signature, sizeof(fakedll_signature) ));
 }
 
+/* check if an existing file already has the given contents */
+static BOOL is_same_file( const WCHAR *name, const void *data, SIZE_T size )
+{
+    static const DWORD chunk_size = 65536;
+    const BYTE *ptr = data;
+    LARGE_INTEGER file_size;
+    BOOL ret = FALSE;
+    DWORD count;
+    HANDLE h;
+    BYTE *buffer;
+
+    h = CreateFileW( name, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, 0, NULL );
+    if (h == INVALID_HANDLE_VALUE) return FALSE;
+    if (!GetFileSizeEx( h, &file_size ) || file_size.QuadPart != size) goto done;
+    if (!(buffer = malloc( chunk_size ))) goto done;
+
+    while (size)
+    {
+        if (!ReadFile( h, buffer, min( size, chunk_size ), &count, NULL ) || !count) break;
+        if (memcmp( buffer, ptr, count )) break;
+        ptr += count;
+        size -= count;
+    }
+    ret = !size;
+    free( buffer );
+done:
+    CloseHandle( h );
+    return ret;
+}
+
 /* create directories leading to a given file */
 static void create_directories( const WCHAR *name )
 {
@@ -957,7 +987,13 @@ static int install_fake_dll( WCHAR *dest, WCHAR *file, BOOL delete, struct list
     destname[len] = 0;
     if (!add_handled_dll( destname )) ret = -1;
 
-    if (ret != -1)
+    if (ret != -1 && !delete && is_same_file( dest, data, size ))
+    {
+        /* don't rewrite the file on prefix updates, but keep it registered */
+        TRACE( "%s is up to date\n", debugstr_w(dest) );
+        register_fake_dll( dest, data, size, delay_copy );
+    }
+    else if (ret != -1)
     {
         HANDLE h = create_dest_file( dest, delete );
 
@@ -30,6 +30,7 @@
 #include "winuser.h"
 #include "winreg.h"
 #include "wine/debug.h"
+#include "wine/list.h"
 
 #include "shellapi.h"
 #include "objbase.h"
@@ -45,6 +46,7 @@ WINE_DEFAULT_DEBUG_CHANNEL(shell);
 
 typedef struct
 {
+	struct list hash_entry;	/* entry in the sic_hash bucket */
 	LPWSTR sSourceFile;	/* file (not path!) containing the icon */
 	DWORD dwSourceIndex;	/* index within the file, if it is a resource ID it will be negated */
 	DWORD dwListIndex;	/* index within the iconlist */
@@ -53,6 +55,7 @@ typedef struct
 } SIC_ENTRY, * LPSIC_ENTRY;
 
 static HDPA sic_hdpa;
+static struct list sic_hash[251];  /* entries hashed by file and index */
 static INIT_ONCE sic_init_once = INIT_ONCE_STATIC_INIT;
 static HIMAGELIST shell_imagelists[SHIL_LAST+1];
 
@@ -98,6 +101,25 @@ static INT CALLBACK SIC_CompareEntries( LPVOID p1, LPVOID p2, LPARAM lparam)
 	return 0;
 }
 
+static unsigned int SIC_HashEntry( const SIC_ENTRY *entry )
+{
+    unsigned int hash = entry->dwSourceIndex;
+    const WCHAR *p;
+
+    for (p = entry->sSourceFile; *p; p++) hash = hash * 31 + towlower( *p );
+    return hash % ARRAY_SIZE(sic_hash);
+}
+
+/* must be called with the SHELL32_SicCS held */
+static SIC_ENTRY *SIC_FindEntry( SIC_ENTRY *seek )
+{
+    SIC_ENTRY *entry;
+
+    LIST_FOR_EACH_ENTRY( entry, &sic_hash[SIC_HashEntry( seek )], SIC_ENTRY, hash_entry )
+        if (!SIC_CompareEntries( seek, entry, 0 )) return entry;
+    return NULL;
+}
+
 /**************************************************************************************
  *                      SIC_get_location
  *
@@ -114,7 +136,11 @@ HRESULT SIC_get_location( int list_idx, WCHAR *file, DWORD *size, int *res_idx )
 
     EnterCriticalSection( &SHELL32_SicCS );
 
-    dpa_idx = DPA_Search( sic_hdpa, &seek, 0, SIC_CompareEntries, SIC_COMPARE_LISTINDEX, 0 );
+    /* entries are appended in image list order, so try the matching position first */
+    if ((found = DPA_GetPtr( sic_hdpa, list_idx )) && found->dwListIndex == list_idx)
+        dpa_idx = list_idx;
+    else
+        dpa_idx = DPA_Search( sic_hdpa, &seek, 0, SIC_CompareEntries, SIC_COMPARE_LISTINDEX, 0 );
     if (dpa_idx != -1)
     {
         found = DPA_GetPtr( sic_hdpa, dpa_idx );
@@ -176,7 +202,12 @@ static HICON SIC_OverlayShortcutImage(HICON SourceIcon, int type)
                               so we can't use icon indices */
 
     if (s_imgListIdx != -1)
+    {
+        /* the image lists may be grown concurrently by SIC_IconAppend() */
+        EnterCriticalSection(&SHELL32_SicCS);
         ShortcutIcon = ImageList_GetIcon(shell_imagelists[type], s_imgListIdx, ILD_TRANSPARENT);
+        LeaveCriticalSection(&SHELL32_SicCS);
+    }
     else
         ShortcutIcon = NULL;
 
@@ -292,7 +323,7 @@ static INT SIC_IconAppend (const WCHAR *sourcefile, INT src_index, HICON *hicons
 {
     INT ret, index, index1;
     WCHAR path[MAX_PATH];
-    SIC_ENTRY *entry;
+    SIC_ENTRY *entry, *found;
     unsigned int i;
 
     TRACE("%s %i %p %#lx\n", debugstr_w(sourcefile), src_index, hicons, flags);
@@ -307,8 +338,14 @@ static INT SIC_IconAppend (const WCHAR *sourcefile, INT src_index, HICON *hicons
 
     EnterCriticalSection(&SHELL32_SicCS);
 
-    index = DPA_InsertPtr(sic_hdpa, 0x7fff, entry);
-    if ( INVALID_INDEX == index )
+    /* the icons are extracted without holding the lock, another thread may have added them already */
+    if ((found = SIC_FindEntry(entry)))
+    {
+        free(entry->sSourceFile);
+        SHFree(entry);
+        ret = found->dwListIndex;
+    }
+    else if ( INVALID_INDEX == (index = DPA_InsertPtr(sic_hdpa, 0x7fff, entry)) )
     {
         free(entry->sSourceFile);
         SHFree(entry);
@@ -326,6 +363,7 @@ static INT SIC_IconAppend (const WCHAR *sourcefile, INT src_index, HICON *hicons
         }
 
         entry->dwListIndex = index;
+        list_add_tail(&sic_hash[SIC_HashEntry(entry)], &entry->hash_entry);
         ret = entry->dwListIndex;
     }
 
@@ -453,6 +491,7 @@ static BOOL WINAPI SIC_Initialize( INIT_ONCE *once, void *param, void **context
 
     TRACE("large %ldx%ld small %ldx%ld\n", sizes[SHIL_LARGE].cx, sizes[SHIL_LARGE].cy, sizes[SHIL_SMALL].cx, sizes[SHIL_SMALL].cy);
 
+    for (i = 0; i < ARRAY_SIZE(sic_hash); i++) list_init(&sic_hash[i]);
     sic_hdpa = DPA_Create(16);
     if (!sic_hdpa)
         return(FALSE);
@@ -529,8 +568,8 @@ void SIC_Destroy(void)
  */
 INT SIC_GetIconIndex (LPCWSTR sSourceFile, INT dwSourceIndex, DWORD dwFlags )
 {
-	SIC_ENTRY sice;
-	INT ret, index = INVALID_INDEX;
+	SIC_ENTRY sice, *entry;
+	INT ret = INVALID_INDEX;
 	WCHAR path[MAX_PATH];
 
 	TRACE("%s %i\n", debugstr_w(sSourceFile), dwSourceIndex);
@@ -544,23 +583,16 @@ INT SIC_GetIconIndex (LPCWSTR sSourceFile, INT dwSourceIndex, DWORD dwFlags )
 
 	EnterCriticalSection(&SHELL32_SicCS);
 
-	if (NULL != DPA_GetPtr (sic_hdpa, 0))
-	{
-	  /* search linear from position 0*/
-	  index = DPA_Search (sic_hdpa, &sice, 0, SIC_CompareEntries, 0, 0);
-	}
-
-	if ( INVALID_INDEX == index )
-	{
-          ret = SIC_LoadIcon (sSourceFile, dwSourceIndex, dwFlags);
-	}
-	else
+	if ((entry = SIC_FindEntry(&sice)))
 	{
 	  TRACE("-- found\n");
-	  ret = ((LPSIC_ENTRY)DPA_GetPtr(sic_hdpa, index))->dwListIndex;
+	  ret = entry->dwListIndex;
 	}
 
 	LeaveCriticalSection(&SHELL32_SicCS);
+
+	/* don't block the other threads while extracting the icon */
+	if (!entry) ret = SIC_LoadIcon (sSourceFile, dwSourceIndex, dwFlags);
 	return ret;
 }
 
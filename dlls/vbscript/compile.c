@@ -2064,6 +2064,9 @@ HRESULT compile_script(script_ctx_t *script, const WCHAR *src, const WCHAR *item
 
     code->is_persistent = (flags & SCRIPTTEXT_ISPERSISTENT) != 0;
 
+    /* Lookup hints are an optimization only, so allocation failure is not fatal. */
+    code->lookup_hints = compiler_alloc_zero(code, ctx.instr_cnt * sizeof(*code->lookup_hints));
+
     if(TRACE_ON(vbscript_disas))
         dump_code(&ctx);
 
@@ -79,6 +79,13 @@ typedef struct {
     BOOL owned;
 } variant_val_t;
 
+#define LOOKUP_HINT_LOCAL_VAR   0x10000000
+#define LOOKUP_HINT_ARG         0x20000000
+#define LOOKUP_HINT_GLOBAL_VAR  0x30000000
+#define LOOKUP_HINT_GLOBAL_FUNC 0x40000000
+#define LOOKUP_HINT_TYPE_MASK   0xf0000000
+#define LOOKUP_HINT_INDEX_MASK  0x0fffffff
+
 static BOOL lookup_dynamic_vars(dynamic_var_t *var, const WCHAR *name, ref_t *ref)
 {
     while(var) {
@@ -94,7 +101,7 @@ static BOOL lookup_dynamic_vars(dynamic_var_t *var, const WCHAR *name, ref_t *re
     return FALSE;
 }
 
-static BOOL lookup_global_vars(ScriptDisp *script, const WCHAR *name, ref_t *ref)
+static BOOL lookup_global_vars(ScriptDisp *script, const WCHAR *name, ref_t *ref, unsigned *hint)
 {
     dynamic_var_t **vars = script->global_vars;
     size_t i, cnt = script->global_vars_cnt;
@@ -103,6 +110,8 @@ static BOOL lookup_global_vars(ScriptDisp *script, const WCHAR *name, ref_t *ref
         if(!wcsicmp(vars[i]->name, name)) {
             ref->type = vars[i]->is_const ? REF_CONST : REF_VAR;
             ref->u.v = &vars[i]->v;
+            if(hint && i <= LOOKUP_HINT_INDEX_MASK)
+                *hint = LOOKUP_HINT_GLOBAL_VAR | i;
             return TRUE;
         }
     }
@@ -110,7 +119,7 @@ static BOOL lookup_global_vars(ScriptDisp *script, const WCHAR *name, ref_t *ref
     return FALSE;
 }
 
-static BOOL lookup_global_funcs(ScriptDisp *script, const WCHAR *name, ref_t *ref)
+static BOOL lookup_global_funcs(ScriptDisp *script, const WCHAR *name, ref_t *ref, unsigned *hint)
 {
     function_t **funcs = script->global_funcs;
     size_t i, cnt = script->global_funcs_cnt;
@@ -119,6 +128,8 @@ static BOOL lookup_global_funcs(ScriptDisp *script, const WCHAR *name, ref_t *re
         if(!wcsicmp(funcs[i]->name, name)) {
             ref->type = REF_FUNC;
             ref->u.f = funcs[i];
+            if(hint && i <= LOOKUP_HINT_INDEX_MASK)
+                *hint = LOOKUP_HINT_GLOBAL_FUNC | i;
             return TRUE;
         }
     }
@@ -126,9 +137,71 @@ static BOOL lookup_global_funcs(ScriptDisp *script, const WCHAR *name, ref_t *re
     return FALSE;
 }
 
+/*
+ * Identifiers resolved to local variables, arguments or script globals keep
+ * resolving to the same slot, because those tables are never reordered or
+ * shrunk. Remember the slot for each instruction, so that subsequent executions
+ * only need to verify the name instead of scanning all the tables.
+ */
+static unsigned *get_lookup_hint(exec_ctx_t *ctx)
+{
+    return ctx->code->lookup_hints ? ctx->code->lookup_hints + (ctx->instr - ctx->code->instrs) : NULL;
+}
+
+static BOOL can_hint_global(exec_ctx_t *ctx)
+{
+    /* Named item scripts and class methods may resolve names by other means first. */
+    return !ctx->code->named_item && !ctx->func->code_ctx->named_item && !ctx->vbthis;
+}
+
+static BOOL lookup_hinted_identifier(exec_ctx_t *ctx, const WCHAR *name, unsigned hint, ref_t *ref)
+{
+    ScriptDisp *script_obj = ctx->script->script_obj;
+    unsigned i = hint & LOOKUP_HINT_INDEX_MASK;
+
+    switch(hint & LOOKUP_HINT_TYPE_MASK) {
+    case LOOKUP_HINT_LOCAL_VAR:
+        if(ctx->func->type == FUNC_GLOBAL || i >= ctx->func->var_cnt || wcsicmp(ctx->func->vars[i].name, name))
+            return FALSE;
+        ref->type = REF_VAR;
+        ref->u.v = ctx->vars+i;
+        return TRUE;
+    case LOOKUP_HINT_ARG:
+        if(ctx->func->type == FUNC_GLOBAL || i >= ctx->func->arg_cnt || wcsicmp(ctx->func->args[i].name, name))
+            return FALSE;
+        ref->type = REF_VAR;
+        ref->u.v = ctx->args+i;
+        return TRUE;
+    case LOOKUP_HINT_GLOBAL_VAR:
+        if(!can_hint_global(ctx) || i >= script_obj->global_vars_cnt || wcsicmp(script_obj->global_vars[i]->name, name))
+            return FALSE;
+        break;
+    case LOOKUP_HINT_GLOBAL_FUNC:
+        if(!can_hint_global(ctx) || i >= script_obj->global_funcs_cnt || wcsicmp(script_obj->global_funcs[i]->name, name))
+            return FALSE;
+        break;
+    default:
+        return FALSE;
+    }
+
+    /* Dynamic variables of the function take precedence over globals. */
+    if(ctx->func->type != FUNC_GLOBAL && lookup_dynamic_vars(ctx->dynamic_vars, name, ref))
+        return TRUE;
+
+    if((hint & LOOKUP_HINT_TYPE_MASK) == LOOKUP_HINT_GLOBAL_VAR) {
+        ref->type = script_obj->global_vars[i]->is_const ? REF_CONST : REF_VAR;
+        ref->u.v = &script_obj->global_vars[i]->v;
+    }else {
+        ref->type = REF_FUNC;
+        ref->u.f = script_obj->global_funcs[i];
+    }
+    return TRUE;
+}
+
 static HRESULT lookup_identifier(exec_ctx_t *ctx, BSTR name, vbdisp_invoke_type_t invoke_type, ref_t *ref)
 {
     ScriptDisp *script_obj = ctx->script->script_obj;
+    unsigned *hint = get_lookup_hint(ctx);
     named_item_t *item;
     unsigned i;
     DISPID id;
@@ -142,11 +215,16 @@ static HRESULT lookup_identifier(exec_ctx_t *ctx, BSTR name, vbdisp_invoke_type_
         return S_OK;
     }
 
+    if(hint && *hint && lookup_hinted_identifier(ctx, name, *hint, ref))
+        return S_OK;
+
     if(ctx->func->type != FUNC_GLOBAL) {
         for(i=0; i < ctx->func->var_cnt; i++) {
             if(!wcsicmp(ctx->func->vars[i].name, name)) {
                 ref->type = REF_VAR;
                 ref->u.v = ctx->vars+i;
+                if(hint && i <= LOOKUP_HINT_INDEX_MASK)
+                    *hint = LOOKUP_HINT_LOCAL_VAR | i;
                 return S_OK;
             }
         }
@@ -155,6 +233,8 @@ static HRESULT lookup_identifier(exec_ctx_t *ctx, BSTR name, vbdisp_invoke_type_
             if(!wcsicmp(ctx->func->args[i].name, name)) {
                 ref->type = REF_VAR;
                 ref->u.v = ctx->args+i;
+                if(hint && i <= LOOKUP_HINT_INDEX_MASK)
+                    *hint = LOOKUP_HINT_ARG | i;
                 return S_OK;
             }
         }
@@ -183,9 +263,9 @@ static HRESULT lookup_identifier(exec_ctx_t *ctx, BSTR name, vbdisp_invoke_type_
     }
 
     if(ctx->code->named_item) {
-        if(lookup_global_vars(ctx->code->named_item->script_obj, name, ref))
+        if(lookup_global_vars(ctx->code->named_item->script_obj, name, ref, NULL))
             return S_OK;
-        if(lookup_global_funcs(ctx->code->named_item->script_obj, name, ref))
+        if(lookup_global_funcs(ctx->code->named_item->script_obj, name, ref, NULL))
             return S_OK;
     }
 
@@ -201,9 +281,11 @@ static HRESULT lookup_identifier(exec_ctx_t *ctx, BSTR name, vbdisp_invoke_type_
         }
     }
 
-    if(lookup_global_vars(script_obj, name, ref))
+    if(hint && !can_hint_global(ctx))
+        hint = NULL;
+    if(lookup_global_vars(script_obj, name, ref, hint))
         return S_OK;
-    if(lookup_global_funcs(script_obj, name, ref))
+    if(lookup_global_funcs(script_obj, name, ref, hint))
         return S_OK;
 
     hres = get_builtin_id(ctx->script->global_obj, name, &id);
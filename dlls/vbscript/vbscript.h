@@ -378,6 +378,8 @@ struct _vbscode_t {
     class_desc_t *classes;
     class_desc_t *last_class;
 
+    unsigned *lookup_hints;
+
     struct list entry;
 };
 
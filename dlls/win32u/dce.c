@@ -608,36 +608,141 @@ void window_surface_unlock( struct window_surface *surface )
     pthread_mutex_unlock( &surface->mutex );
 }
 
+static inline LONGLONG get_rect_area( const RECT *rect )
+{
+    return (LONGLONG)(rect->right - rect->left) * (rect->bottom - rect->top);
+}
+
+/* surface lock must be held */
+static BOOL dirty_rects_match_bounds( const struct window_surface *surface )
+{
+    RECT rect;
+    UINT i;
+
+    reset_bounds( &rect );
+    for (i = 0; i < surface->dirty_count; i++) add_bounds_rect( &rect, &surface->dirty_rects[i] );
+    return EqualRect( &rect, &surface->bounds );
+}
+
+/* add a rectangle to the surface dirty area, keeping track of a few disjoint parts of it;
+ * surface lock must be held */
+void window_surface_add_bounds( struct window_surface *surface, const RECT *rect )
+{
+    RECT *rects = surface->dirty_rects, tmp, merged = *rect;
+    UINT i, best, count = surface->dirty_count;
+    LONGLONG growth, best_growth;
+
+    if (surface == &dummy_surface || IsRectEmpty( rect )) return;
+
+    /* the bounds may have been changed directly, start again from them */
+    if (IsRectEmpty( &surface->bounds )) count = 0;
+    else if (!dirty_rects_match_bounds( surface ))
+    {
+        rects[0] = surface->bounds;
+        count = 1;
+    }
+    add_bounds_rect( &surface->bounds, rect );
+
+    for (;;)
+    {
+        for (i = 0; i < count; i++) if (intersect_rect( &tmp, &merged, &rects[i] )) break;
+        if (i == count)
+        {
+            if (count < ARRAY_SIZE(surface->dirty_rects)) break;
+
+            /* no room left, merge with the rectangle that grows the least */
+            best_growth = -1;
+            for (i = best = 0; i < count; i++)
+            {
+                union_rect( &tmp, &merged, &rects[i] );
+                growth = get_rect_area( &tmp ) - get_rect_area( &rects[i] );
+                if (best_growth == -1 || growth < best_growth)
+                {
+                    best_growth = growth;
+                    best = i;
+                }
+            }
+            i = best;
+        }
+        union_rect( &merged, &merged, &rects[i] );
+        rects[i] = rects[--count];
+    }
+    rects[count++] = merged;
+    surface->dirty_count = count;
+}
+
+/* align bounds / dirty rect to help with 1bpp shape bitmap updates */
+static BOOL get_flush_rect( const struct window_surface *surface, const RECT *bounds, RECT *dirty )
+{
+    RECT rect;
+
+    rect.left = bounds->left & ~7;
+    rect.top = bounds->top;
+    rect.right = (bounds->right + 7) & ~7;
+    rect.bottom = bounds->bottom;
+
+    *dirty = surface->rect;
+    OffsetRect( dirty, -dirty->left, -dirty->top );
+    return intersect_rect( dirty, dirty, &rect );
+}
+
+/* check if flushing the dirty rects separately is worth it; surface lock must be held */
+static BOOL use_dirty_rects( const struct window_surface *surface, const RECT *dirty )
+{
+    LONGLONG area = 0;
+    RECT rect;
+    UINT i;
+
+    if (surface->dirty_count <= 1) return FALSE;
+    if (surface->shape_region || surface->alpha_mask || surface->color_key != CLR_INVALID) return FALSE;
+    if (!dirty_rects_match_bounds( surface )) return FALSE;
+
+    for (i = 0; i < surface->dirty_count; i++)
+        if (get_flush_rect( surface, &surface->dirty_rects[i], &rect )) area += get_rect_area( &rect );
+    return area * 4 < get_rect_area( dirty ) * 3;
+}
+
 void window_surface_flush( struct window_surface *surface )
 {
     char color_buf[FIELD_OFFSET( BITMAPINFO, bmiColors[256] )];
     char shape_buf[FIELD_OFFSET( BITMAPINFO, bmiColors[256] )];
     BITMAPINFO *color_info = (BITMAPINFO *)color_buf;
     BITMAPINFO *shape_info = (BITMAPINFO *)shape_buf;
-    RECT dirty = surface->rect, bounds;
+    RECT dirty, rect;
     void *color_bits;
+    UINT i;
 
     window_surface_lock( surface );
 
-    /* align bounds / dirty rect to help with 1bpp shape bitmap updates */
-    bounds.left = surface->bounds.left & ~7;
-    bounds.top = surface->bounds.top;
-    bounds.right = (surface->bounds.right + 7) & ~7;
-    bounds.bottom = surface->bounds.bottom;
-
-    OffsetRect( &dirty, -dirty.left, -dirty.top );
-
-    if (intersect_rect( &dirty, &dirty, &bounds ) && (color_bits = window_surface_get_color( surface, color_info )))
+    if (get_flush_rect( surface, &surface->bounds, &dirty ) &&
+        (color_bits = window_surface_get_color( surface, color_info )))
     {
         BOOL shape_changed = update_surface_shape( surface, &surface->rect, &dirty, color_info, color_bits );
         void *shape_bits = window_surface_get_shape( surface, shape_info );
+        BOOL ret = TRUE;
 
         TRACE( "Flushing hwnd %p, surface %p %s, bounds %s, dirty %s\n", surface->hwnd, surface,
                wine_dbgstr_rect( &surface->rect ), wine_dbgstr_rect( &surface->bounds ), wine_dbgstr_rect( &dirty ) );
 
-        if (surface->funcs->flush( surface, &surface->rect, &dirty, color_info, color_bits,
-                                   shape_changed, shape_info, shape_bits ))
+        if (use_dirty_rects( surface, &dirty ))
+        {
+            for (i = 0; i < surface->dirty_count; i++)
+            {
+                if (!get_flush_rect( surface, &surface->dirty_rects[i], &rect )) continue;
+                TRACE( "flushing dirty rect %s\n", wine_dbgstr_rect( &rect ) );
+                ret = surface->funcs->flush( surface, &surface->rect, &rect, color_info, color_bits,
+                                             shape_changed, shape_info, shape_bits ) && ret;
+                shape_changed = FALSE;
+            }
+        }
+        else ret = surface->funcs->flush( surface, &surface->rect, &dirty, color_info, color_bits,
+                                          shape_changed, shape_info, shape_bits );
+
+        if (ret)
+        {
             reset_bounds( &surface->bounds );
+            surface->dirty_count = 0;
+        }
     }
 
     window_surface_unlock( surface );
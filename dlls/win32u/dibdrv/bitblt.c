@@ -23,6 +23,10 @@
 #endif
 
 #include <assert.h>
+#include <limits.h>
+#include <pthread.h>
+#include <signal.h>
+#include <unistd.h>
 
 #include "ntgdi_private.h"
 #include "dibdrv.h"
@@ -585,17 +589,165 @@ static void mask_rect( dib_info *dst, const RECT *dst_rect, const dib_info *src,
     }
 }
 
+/* large operations are split in horizontal bands that are processed in parallel */
+
+#define MAX_BANDS        8
+#define BAND_MIN_PIXELS  (512 * 1024)
+
+static pthread_once_t band_once = PTHREAD_ONCE_INIT;
+static pthread_mutex_t band_job_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t band_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t band_start_cond = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t band_done_cond = PTHREAD_COND_INITIALIZER;
+static void (*band_func)( void *ctx, int band );
+static void *band_ctx;
+static int band_next, band_count, band_pending;
+static int band_threads;
+
+static void *band_thread( void *arg )
+{
+    void (*func)( void *ctx, int band );
+    void *ctx;
+    int band;
+
+    pthread_mutex_lock( &band_mutex );
+    for (;;)
+    {
+        while (band_next >= band_count) pthread_cond_wait( &band_start_cond, &band_mutex );
+        band = band_next++;
+        func = band_func;
+        ctx = band_ctx;
+        pthread_mutex_unlock( &band_mutex );
+
+        func( ctx, band );
+
+        pthread_mutex_lock( &band_mutex );
+        if (!--band_pending) pthread_cond_signal( &band_done_cond );
+    }
+    return NULL;
+}
+
+static void init_band_threads(void)
+{
+    long cpus = sysconf( _SC_NPROCESSORS_ONLN );
+    sigset_t set, old_set;
+    pthread_attr_t attr;
+    pthread_t thread;
+    int i;
+
+    if (cpus <= 1) return;
+
+    /* the threads never run any Windows code, keep signals away from them */
+    sigfillset( &set );
+    pthread_sigmask( SIG_SETMASK, &set, &old_set );
+    pthread_attr_init( &attr );
+    pthread_attr_setdetachstate( &attr, PTHREAD_CREATE_DETACHED );
+    for (i = 0; i < min( cpus, MAX_BANDS ) - 1; i++)
+    {
+        if (pthread_create( &thread, &attr, band_thread, NULL )) break;
+        band_threads++;
+    }
+    pthread_attr_destroy( &attr );
+    pthread_sigmask( SIG_SETMASK, &old_set, NULL );
+    TRACE( "started %u band threads\n", band_threads );
+}
+
+/* number of bands worth using for an operation touching the given number of pixels */
+static int get_band_count( LONGLONG pixels )
+{
+    if (pixels < BAND_MIN_PIXELS) return 1;
+    pthread_once( &band_once, init_band_threads );
+    return band_threads + 1;
+}
+
+static void run_bands( void (*func)( void *ctx, int band ), void *ctx, int count )
+{
+    int band;
+
+    /* only one parallel operation at a time, others run on their own thread */
+    if (count <= 1 || pthread_mutex_trylock( &band_job_mutex ))
+    {
+        for (band = 0; band < count; band++) func( ctx, band );
+        return;
+    }
+
+    pthread_mutex_lock( &band_mutex );
+    band_func = func;
+    band_ctx = ctx;
+    band_next = 0;
+    band_count = band_pending = count;
+    pthread_cond_broadcast( &band_start_cond );
+    while (band_next < band_count)
+    {
+        band = band_next++;
+        pthread_mutex_unlock( &band_mutex );
+        func( ctx, band );
+        pthread_mutex_lock( &band_mutex );
+        band_pending--;
+    }
+    while (band_pending) pthread_cond_wait( &band_done_cond, &band_mutex );
+    band_count = 0;
+    pthread_mutex_unlock( &band_mutex );
+    pthread_mutex_unlock( &band_job_mutex );
+}
+
+struct blend_bands
+{
+    dib_info            *dst;
+    const dib_info      *src;
+    const RECT          *rects;
+    int                  count;
+    POINT                offset;
+    BLENDFUNCTION        blend;
+    int                  top[MAX_BANDS + 1];
+};
+
+static void blend_band( void *ctx, int band )
+{
+    const struct blend_bands *params = ctx;
+    RECT rect, band_rect;
+    int i;
+
+    band_rect.left = INT_MIN;
+    band_rect.right = INT_MAX;
+    band_rect.top = params->top[band];
+    band_rect.bottom = params->top[band + 1];
+
+    for (i = 0; i < params->count; i++)
+        if (intersect_rect( &rect, &params->rects[i], &band_rect ))
+            params->dst->funcs->blend_rects( params->dst, 1, &rect, params->src, &params->offset, params->blend );
+}
+
 static DWORD blend_rect( dib_info *dst, const RECT *dst_rect, const dib_info *src, const RECT *src_rect,
                          HRGN clip, BLENDFUNCTION blend )
 {
     POINT offset;
     struct clipped_rects clipped_rects;
+    int i, bands, height;
 
     if (!get_clipped_rects( dst, dst_rect, clip, &clipped_rects )) return ERROR_SUCCESS;
 
     offset.x = src_rect->left - dst_rect->left;
     offset.y = src_rect->top  - dst_rect->top;
-    dst->funcs->blend_rects( dst, clipped_rects.count, clipped_rects.rects, src, &offset, blend );
+
+    height = dst_rect->bottom - dst_rect->top;
+    bands = get_band_count( (LONGLONG)(dst_rect->right - dst_rect->left) * height );
+    if (bands > height) bands = height;
+
+    if (bands > 1)
+    {
+        struct blend_bands params;
+
+        params.dst = dst;
+        params.src = src;
+        params.rects = clipped_rects.rects;
+        params.count = clipped_rects.count;
+        params.offset = offset;
+        params.blend = blend;
+        for (i = 0; i <= bands; i++) params.top[i] = dst_rect->top + height * i / bands;
+        run_bands( blend_band, &params, bands );
+    }
+    else dst->funcs->blend_rects( dst, clipped_rects.count, clipped_rects.rects, src, &offset, blend );
 
     free_clipped_rects( &clipped_rects );
     return ERROR_SUCCESS;
@@ -1198,6 +1350,131 @@ static DWORD calc_1d_stretch_params( INT dst_start, INT dst_length, INT dst_vis_
 }
 
 
+struct stretch_bands
+{
+    dib_info                *dst_dib;
+    const dib_info          *src_dib;
+    struct stretch_params    h_params;
+    struct stretch_params    v_params;
+    BOOL                     vstretch;
+    int                      mode;
+    int                      width;
+    int                      count;
+    POINT                    dst_start[MAX_BANDS + 1];
+    POINT                    src_start[MAX_BANDS + 1];
+    int                      err[MAX_BANDS + 1];
+    int                      row[MAX_BANDS + 1];
+    void (* row_fn)(const dib_info *dst_dib, const POINT *dst_start,
+                    const dib_info *src_dib, const POINT *src_start,
+                    const struct stretch_params *params, int mode, BOOL keep_dst);
+};
+
+static void stretch_rows( const struct stretch_bands *params, POINT dst_start, POINT src_start,
+                          int err, int rows )
+{
+    const struct stretch_params *v_params = &params->v_params;
+
+    if (params->vstretch)
+    {
+        BOOL need_row = TRUE;
+        RECT last_row, this_row;
+        last_row.left = 0;
+        last_row.right = params->width;
+
+        while (rows--)
+        {
+            if (need_row)
+            {
+                params->row_fn( params->dst_dib, &dst_start, params->src_dib, &src_start,
+                                &params->h_params, params->mode, FALSE );
+                need_row = FALSE;
+            }
+            else
+            {
+                last_row.top = dst_start.y - v_params->dst_inc;
+                last_row.bottom = last_row.top + 1;
+                this_row = last_row;
+                OffsetRect( &this_row, 0, v_params->dst_inc );
+                copy_rect( params->dst_dib, &this_row, params->dst_dib, &last_row, NULL, R2_COPYPEN );
+            }
+
+            if (err > 0)
+            {
+                src_start.y += v_params->src_inc;
+                need_row = TRUE;
+                err += v_params->err_add_1;
+            }
+            else err += v_params->err_add_2;
+            dst_start.y += v_params->dst_inc;
+        }
+    }
+    else
+    {
+        int merged_rows = 0;
+
+        while (rows--)
+        {
+            if (params->mode != STRETCH_DELETESCANS || !merged_rows)
+                params->row_fn( params->dst_dib, &dst_start, params->src_dib, &src_start,
+                                &params->h_params, params->mode, merged_rows != 0 );
+            merged_rows++;
+
+            if (err > 0)
+            {
+                dst_start.y += v_params->dst_inc;
+                merged_rows = 0;
+                err += v_params->err_add_1;
+            }
+            else err += v_params->err_add_2;
+            src_start.y += v_params->src_inc;
+        }
+    }
+}
+
+static void stretch_band( void *ctx, int band )
+{
+    const struct stretch_bands *params = ctx;
+
+    stretch_rows( params, params->dst_start[band], params->src_start[band], params->err[band],
+                  params->row[band + 1] - params->row[band] );
+}
+
+/* find the starting state of each band; bands must start on a new destination row */
+static void init_stretch_bands( struct stretch_bands *params, POINT dst_start, POINT src_start, int bands )
+{
+    const struct stretch_params *v_params = &params->v_params;
+    int row, err = v_params->err_start;
+    BOOL new_row = FALSE;
+
+    params->count = 0;
+    for (row = 0; row < v_params->length; row++)
+    {
+        if (row == 0 || (params->count < bands && (params->vstretch || new_row) &&
+                         row >= v_params->length * params->count / bands))
+        {
+            params->dst_start[params->count] = dst_start;
+            params->src_start[params->count] = src_start;
+            params->err[params->count] = err;
+            params->row[params->count] = row;
+            params->count++;
+        }
+
+        new_row = err > 0;
+        if (params->vstretch)
+        {
+            if (err > 0) src_start.y += v_params->src_inc;
+            dst_start.y += v_params->dst_inc;
+        }
+        else
+        {
+            if (err > 0) dst_start.y += v_params->dst_inc;
+            src_start.y += v_params->src_inc;
+        }
+        err += err > 0 ? v_params->err_add_1 : v_params->err_add_2;
+    }
+    params->row[params->count] = v_params->length;
+}
+
 DWORD stretch_bitmapinfo( const BITMAPINFO *src_info, void *src_bits, struct bitblt_coords *src,
                           const BITMAPINFO *dst_info, void *dst_bits, struct bitblt_coords *dst,
                           INT mode )
@@ -1207,11 +1484,9 @@ DWORD stretch_bitmapinfo( const BITMAPINFO *src_info, void *src_bits, struct bit
     RECT rect;
     BOOL hstretch, vstretch;
     struct stretch_params v_params, h_params;
-    int err;
+    struct stretch_bands params;
+    int bands;
     DWORD ret;
-    void (* row_fn)(const dib_info *dst_dib, const POINT *dst_start,
-                    const dib_info *src_dib, const POINT *src_start,
-                    const struct stretch_params *params, int mode, BOOL keep_dst);
 
     TRACE("dst %d, %d - %d x %d visrect %s src %d, %d - %d x %d visrect %s\n",
           dst->x, dst->y, dst->width, dst->height, wine_dbgstr_rect(&dst->visrect),
@@ -1251,64 +1526,22 @@ DWORD stretch_bitmapinfo( const BITMAPINFO *src_info, void *src_bits, struct bit
     dst_start.x -= dst->visrect.left;
     dst_start.y -= dst->visrect.top;
 
-    err = v_params.err_start;
-
-    row_fn = hstretch ? dst_dib.funcs->stretch_row : dst_dib.funcs->shrink_row;
-
-    if (vstretch)
-    {
-        BOOL need_row = TRUE;
-        RECT last_row, this_row;
-        if (hstretch) mode = STRETCH_DELETESCANS;
-        last_row.left = 0;
-        last_row.right = dst->visrect.right - dst->visrect.left;
-
-        while (v_params.length--)
-        {
-            if (need_row)
-            {
-                row_fn( &dst_dib, &dst_start, &src_dib, &src_start, &h_params, mode, FALSE );
-                need_row = FALSE;
-            }
-            else
-            {
-                last_row.top = dst_start.y - v_params.dst_inc;
-                last_row.bottom = last_row.top + 1;
-                this_row = last_row;
-                OffsetRect( &this_row, 0, v_params.dst_inc );
-                copy_rect( &dst_dib, &this_row, &dst_dib, &last_row, NULL, R2_COPYPEN );
-            }
-
-            if (err > 0)
-            {
-                src_start.y += v_params.src_inc;
-                need_row = TRUE;
-                err += v_params.err_add_1;
-            }
-            else err += v_params.err_add_2;
-            dst_start.y += v_params.dst_inc;
-        }
-    }
-    else
+    params.dst_dib = &dst_dib;
+    params.src_dib = &src_dib;
+    params.h_params = h_params;
+    params.v_params = v_params;
+    params.vstretch = vstretch;
+    params.mode = (vstretch && hstretch) ? STRETCH_DELETESCANS : mode;
+    params.width = dst->visrect.right - dst->visrect.left;
+    params.row_fn = hstretch ? dst_dib.funcs->stretch_row : dst_dib.funcs->shrink_row;
+
+    bands = get_band_count( (LONGLONG)h_params.length * v_params.length );
+    if (bands > 1)
     {
-        int merged_rows = 0;
-
-        while (v_params.length--)
-        {
-            if (mode != STRETCH_DELETESCANS || !merged_rows)
-                row_fn( &dst_dib, &dst_start, &src_dib, &src_start, &h_params, mode, merged_rows != 0 );
-            merged_rows++;
-
-            if (err > 0)
-            {
-                dst_start.y += v_params.dst_inc;
-                merged_rows = 0;
-                err += v_params.err_add_1;
-            }
-            else err += v_params.err_add_2;
-            src_start.y += v_params.src_inc;
-        }
+        init_stretch_bands( &params, dst_start, src_start, bands );
+        run_bands( stretch_band, &params, params.count );
     }
+    else stretch_rows( &params, dst_start, src_start, v_params.err_start, v_params.length );
 
 done:
     /* update coordinates, the destination rectangle is always stored at 0,0 */
@@ -504,6 +504,7 @@ struct windrv_physdev
     struct dibdrv_physdev *dibdrv;
     struct window_surface *surface;
     UINT lock_count;
+    RECT bounds;
 };
 
 static const struct gdi_dc_funcs window_driver;
@@ -521,7 +522,7 @@ static inline void lock_surface( struct windrv_physdev *dev )
     if (!dev->lock_count++)
     {
         window_surface_lock( surface );
-        if (IsRectEmpty( dev->dibdrv->bounds ) || !surface->draw_start_ticks)
+        if (IsRectEmpty( &surface->bounds ) || !surface->draw_start_ticks)
             surface->draw_start_ticks = NtGetTickCount();
     }
 }
@@ -533,6 +534,11 @@ static inline void unlock_surface( struct windrv_physdev *dev )
     if (!--dev->lock_count)
     {
         DWORD ticks = NtGetTickCount() - surface->draw_start_ticks;
+        if (!IsRectEmpty( &dev->bounds ))
+        {
+            window_surface_add_bounds( surface, &dev->bounds );
+            reset_bounds( &dev->bounds );
+        }
         window_surface_unlock( surface );
         if (ticks > FLUSH_PERIOD) window_surface_flush( dev->surface );
     }
@@ -599,7 +605,8 @@ void dibdrv_set_window_surface( DC *dc, struct window_surface *surface )
         }
         dibdrv->dib.rect = dc->attr->vis_rect;
         OffsetRect( &dibdrv->dib.rect, -dc->device_rect.left, -dc->device_rect.top );
-        dibdrv->bounds = &surface->bounds;
+        reset_bounds( &physdev->bounds );
+        dibdrv->bounds = &physdev->bounds;
         DC_InitDC( dc );
     }
     else if (windev)
@@ -23,6 +23,9 @@
 #endif
 
 #include <assert.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 #include "ntgdi_private.h"
 #include "dibdrv.h"
@@ -4652,6 +4655,54 @@ static inline DWORD blend_argb( DWORD dst, DWORD src )
             (alpha + ((BYTE)(dst >> 24) * (255 - alpha) + 127) / 255) << 24);
 }
 
+static void blend_argb_row( DWORD *dst, const DWORD *src, int len )
+{
+    int x = 0;
+
+#ifdef __SSE2__
+    /* process four pixels at a time; (v + 128 + ((v + 128) >> 8)) >> 8 gives
+     * the same result as (v + 127) / 255 for all v = dst * (255 - alpha). */
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i round = _mm_set1_epi16( 128 );
+    const __m128i max = _mm_set1_epi16( 255 );
+
+    for (; x + 4 <= len; x += 4)
+    {
+        __m128i s = _mm_loadu_si128( (const __m128i *)(src + x) );
+        __m128i a, d, lo, hi;
+
+        a = _mm_srli_epi32( s, 24 );
+        a = _mm_or_si128( a, _mm_slli_epi32( a, 8 ));
+        a = _mm_or_si128( a, _mm_slli_epi32( a, 16 ));
+
+        if (_mm_movemask_epi8( _mm_cmpeq_epi8( s, zero )) == 0xffff) continue;
+        if (_mm_movemask_epi8( _mm_cmpeq_epi8( a, _mm_cmpeq_epi8( a, a ))) == 0xffff)
+        {
+            _mm_storeu_si128( (__m128i *)(dst + x), s );
+            continue;
+        }
+        /* components larger than alpha may overflow, leave those to the C version */
+        if (_mm_movemask_epi8( _mm_cmpeq_epi8( _mm_max_epu8( s, a ), a )) != 0xffff)
+        {
+            int i;
+            for (i = x; i < x + 4; i++) dst[i] = blend_argb( dst[i], src[i] );
+            continue;
+        }
+
+        d = _mm_loadu_si128( (const __m128i *)(dst + x) );
+        lo = _mm_mullo_epi16( _mm_unpacklo_epi8( d, zero ), _mm_sub_epi16( max, _mm_unpacklo_epi8( a, zero )));
+        hi = _mm_mullo_epi16( _mm_unpackhi_epi8( d, zero ), _mm_sub_epi16( max, _mm_unpackhi_epi8( a, zero )));
+        lo = _mm_add_epi16( lo, round );
+        hi = _mm_add_epi16( hi, round );
+        lo = _mm_srli_epi16( _mm_add_epi16( lo, _mm_srli_epi16( lo, 8 )), 8 );
+        hi = _mm_srli_epi16( _mm_add_epi16( hi, _mm_srli_epi16( hi, 8 )), 8 );
+        d = _mm_add_epi8( s, _mm_packus_epi16( lo, hi ));
+        _mm_storeu_si128( (__m128i *)(dst + x), d );
+    }
+#endif
+    for (; x < len; x++) dst[x] = blend_argb( dst[x], src[x] );
+}
+
 static inline DWORD blend_argb_alpha( DWORD dst, DWORD src, DWORD alpha )
 {
     BYTE b = ((BYTE)src         * alpha + 127) / 255;
@@ -4696,8 +4747,7 @@ static void blend_rects_8888(const dib_info *dst, int num, const RECT *rc,
         {
             if (blend.SourceConstantAlpha == 255)
                 for (y = rc->top; y < rc->bottom; y++, dst_ptr += dst->stride / 4, src_ptr += src->stride / 4)
-                    for (x = 0; x < rc->right - rc->left; x++)
-                        dst_ptr[x] = blend_argb( dst_ptr[x], src_ptr[x] );
+                    blend_argb_row( dst_ptr, src_ptr, rc->right - rc->left );
             else
                 for (y = rc->top; y < rc->bottom; y++, dst_ptr += dst->stride / 4, src_ptr += src->stride / 4)
                     for (x = 0; x < rc->right - rc->left; x++)
@@ -6365,6 +6415,50 @@ static inline DWORD blend_subpixel( BYTE r, BYTE g, BYTE b, DWORD text, DWORD al
            blend_color( b, text,       (BYTE) alpha );
 }
 
+/* same as blend_subpixel() without gamma correction, applied to a whole row */
+static void blend_subpixel_row( DWORD *dst, const DWORD *glyph, int len, DWORD text )
+{
+    int x = 0;
+
+#ifdef __SSE2__
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i round = _mm_set1_epi16( 128 );
+    const __m128i max = _mm_set1_epi16( 255 );
+    const __m128i rgb = _mm_set1_epi32( 0x00ffffff );
+    const __m128i src = _mm_unpacklo_epi8( _mm_set1_epi32( text ), zero );
+
+    for (; x + 4 <= len; x += 4)
+    {
+        __m128i g = _mm_loadu_si128( (const __m128i *)(glyph + x) );
+        __m128i d, skip, lo, hi, a;
+
+        skip = _mm_cmpeq_epi32( g, zero );
+        if (_mm_movemask_epi8( skip ) == 0xffff) continue;
+
+        d = _mm_loadu_si128( (const __m128i *)(dst + x) );
+        a = _mm_unpacklo_epi8( g, zero );
+        lo = _mm_add_epi16( _mm_mullo_epi16( src, a ),
+                            _mm_mullo_epi16( _mm_unpacklo_epi8( d, zero ), _mm_sub_epi16( max, a )));
+        a = _mm_unpackhi_epi8( g, zero );
+        hi = _mm_add_epi16( _mm_mullo_epi16( src, a ),
+                            _mm_mullo_epi16( _mm_unpackhi_epi8( d, zero ), _mm_sub_epi16( max, a )));
+        /* (v + 128 + ((v + 128) >> 8)) >> 8 == (v + 127) / 255 for v <= 255 * 255 */
+        lo = _mm_add_epi16( lo, round );
+        hi = _mm_add_epi16( hi, round );
+        lo = _mm_srli_epi16( _mm_add_epi16( lo, _mm_srli_epi16( lo, 8 )), 8 );
+        hi = _mm_srli_epi16( _mm_add_epi16( hi, _mm_srli_epi16( hi, 8 )), 8 );
+        lo = _mm_and_si128( _mm_packus_epi16( lo, hi ), rgb );
+        d = _mm_or_si128( _mm_and_si128( skip, d ), _mm_andnot_si128( skip, lo ));
+        _mm_storeu_si128( (__m128i *)(dst + x), d );
+    }
+#endif
+    for (; x < len; x++)
+    {
+        if (glyph[x] == 0) continue;
+        dst[x] = blend_subpixel( dst[x] >> 16, dst[x] >> 8, dst[x], text, glyph[x], NULL );
+    }
+}
+
 static void draw_subpixel_glyph_8888( const dib_info *dib, const RECT *rect, const dib_info *glyph,
                                       const POINT *origin, DWORD text_pixel,
                                       const struct font_gamma_ramp *gamma_ramp )
@@ -6373,6 +6467,17 @@ static void draw_subpixel_glyph_8888( const dib_info *dib, const RECT *rect, con
     const DWORD *glyph_ptr = get_pixel_ptr_32( glyph, origin->x, origin->y );
     int x, y;
 
+    if (gamma_ramp == NULL || gamma_ramp->gamma == 1000)
+    {
+        for (y = rect->top; y < rect->bottom; y++)
+        {
+            blend_subpixel_row( dst_ptr, glyph_ptr, rect->right - rect->left, text_pixel );
+            dst_ptr += dib->stride / 4;
+            glyph_ptr += glyph->stride / 4;
+        }
+        return;
+    }
+
     for (y = rect->top; y < rect->bottom; y++)
     {
         for (x = 0; x < rect->right - rect->left; x++)
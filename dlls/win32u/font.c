@@ -49,6 +49,7 @@ WINE_DEFAULT_DEBUG_CHANNEL(font);
 
 static HKEY wine_fonts_key;
 static HKEY wine_fonts_cache_key;
+static HANDLE wine_fonts_cache_mutex;
 HKEY hkcu_key;
 
 struct font_physdev
@@ -1280,13 +1281,96 @@ struct cached_face
     /* WCHAR                file_name[]; */
 };
 
+/* the whole cache is also stored as a single value, so that it can be loaded in one request */
+
+static const WCHAR face_listW[] = {'F','a','c','e','L','i','s','t',0};
+
+enum face_list_type
+{
+    FACE_LIST_FAMILY,
+    FACE_LIST_SCALABLE,
+    FACE_LIST_BITMAP
+};
+
+struct face_list_record
+{
+    DWORD size;         /* total size of the record, DWORD aligned */
+    DWORD type;         /* enum face_list_type */
+    DWORD data_offset;  /* offset of the second name or of the struct cached_face */
+    WCHAR name[1];      /* family or style name */
+};
+
+struct face_list
+{
+    char  *data;
+    SIZE_T size;
+    SIZE_T max;
+};
+
+static void add_face_list_record( struct face_list *list, enum face_list_type type, const WCHAR *name,
+                                  const void *data, DWORD data_size )
+{
+    DWORD name_size = (lstrlenW( name ) + 1) * sizeof(WCHAR);
+    DWORD offset = (offsetof( struct face_list_record, name ) + name_size + 3) & ~3;
+    DWORD size = (offset + data_size + sizeof(WCHAR) + 3) & ~3;
+    struct face_list_record *record;
+
+    if (!list || !list->data) return;
+    if (list->size + size > list->max)
+    {
+        SIZE_T new_max = max( list->max * 2, list->size + size );
+        char *new_data;
+
+        if (!(new_data = realloc( list->data, new_max )))
+        {
+            free( list->data );
+            list->data = NULL;
+            return;
+        }
+        list->data = new_data;
+        list->max = new_max;
+    }
+    record = (struct face_list_record *)(list->data + list->size);
+    memset( record, 0, size );
+    record->size = size;
+    record->type = type;
+    record->data_offset = offset;
+    memcpy( record->name, name, name_size );
+    memcpy( (char *)record + offset, data, data_size );
+    list->size += size;
+}
+
+static void create_face_from_cache( struct gdi_font_family *family, const WCHAR *style,
+                                    const struct cached_face *cached, BOOL scalable )
+{
+    struct gdi_font_face *face;
+
+    if ((face = create_face( family, style, cached->full_name,
+                             cached->full_name + lstrlenW(cached->full_name) + 1,
+                             NULL, 0, cached->index, cached->fs, cached->ntmflags, cached->weight,
+                             cached->version, cached->flags, scalable ? NULL : &cached->size )))
+    {
+        if (!scalable)
+            TRACE("Adding bitmap size h %d w %d size %d x_ppem %d y_ppem %d\n",
+                  face->size.height, face->size.width, face->size.size >> 6,
+                  face->size.x_ppem >> 6, face->size.y_ppem >> 6);
+
+        TRACE("fsCsb = %08x %08x/%08x %08x %08x %08x\n",
+              face->fs.fsCsb[0], face->fs.fsCsb[1],
+              face->fs.fsUsb[0], face->fs.fsUsb[1],
+              face->fs.fsUsb[2], face->fs.fsUsb[3]);
+
+        release_face( face );
+    }
+}
+
 static void load_face_from_cache( HKEY hkey_family, struct gdi_font_family *family,
-                                  void *buffer, DWORD buffer_size, BOOL scalable )
+                                  void *buffer, DWORD buffer_size, BOOL scalable,
+                                  struct face_list *list )
 {
     KEY_VALUE_FULL_INFORMATION *info = (KEY_VALUE_FULL_INFORMATION *)buffer;
     KEY_NODE_INFORMATION *node_info = (KEY_NODE_INFORMATION *)buffer;
     DWORD index = 0, total_size;
-    struct gdi_font_face *face;
     HKEY hkey_strike;
     WCHAR name[256];
     struct cached_face *cached;
@@ -1298,23 +1382,9 @@ static void load_face_from_cache( HKEY hkey_family, struct gdi_font_family *fami
         if (info->Type == REG_BINARY && info->DataLength > sizeof(*cached))
         {
             ((DWORD *)cached)[info->DataLength / sizeof(DWORD)] = 0;
-            if ((face = create_face( family, name, cached->full_name,
-                                     cached->full_name + lstrlenW(cached->full_name) + 1,
-                                     NULL, 0, cached->index, cached->fs, cached->ntmflags, cached->weight,
-                                     cached->version, cached->flags, scalable ? NULL : &cached->size )))
-            {
-                if (!scalable)
-                    TRACE("Adding bitmap size h %d w %d size %d x_ppem %d y_ppem %d\n",
-                          face->size.height, face->size.width, face->size.size >> 6,
-                          face->size.x_ppem >> 6, face->size.y_ppem >> 6);
-
-                TRACE("fsCsb = %08x %08x/%08x %08x %08x %08x\n",
-                      face->fs.fsCsb[0], face->fs.fsCsb[1],
-                      face->fs.fsUsb[0], face->fs.fsUsb[1],
-                      face->fs.fsUsb[2], face->fs.fsUsb[3]);
-
-                release_face( face );
-            }
+            add_face_list_record( list, scalable ? FACE_LIST_SCALABLE : FACE_LIST_BITMAP,
+                                  name, cached, info->DataLength );
+            create_face_from_cache( family, name, cached, scalable );
         }
     }
 
@@ -1326,12 +1396,61 @@ static void load_face_from_cache( HKEY hkey_family, struct gdi_font_family *fami
     {
         if ((hkey_strike = reg_open_key( hkey_family, node_info->Name, node_info->NameLength )))
         {
-            load_face_from_cache( hkey_strike, family, buffer, buffer_size, FALSE );
+            load_face_from_cache( hkey_strike, family, buffer, buffer_size, FALSE, list );
             NtClose( hkey_strike );
         }
     }
 }
 
+static BOOL load_font_list_from_face_list(void)
+{
+    UNICODE_STRING nameW = { sizeof(face_listW) - sizeof(WCHAR), sizeof(face_listW), (WCHAR *)face_listW };
+    KEY_VALUE_PARTIAL_INFORMATION *info;
+    struct gdi_font_family *family = NULL;
+    const struct face_list_record *record;
+    ULONG size, pos;
+
+    if (NtQueryValueKey( wine_fonts_cache_key, &nameW, KeyValuePartialInformation,
+                         NULL, 0, &size ) != STATUS_BUFFER_TOO_SMALL)
+        return FALSE;
+    if (!(info = malloc( size ))) return FALSE;
+    if (NtQueryValueKey( wine_fonts_cache_key, &nameW, KeyValuePartialInformation,
+                         info, size, &size ) || info->Type != REG_BINARY)
+    {
+        free( info );
+        return FALSE;
+    }
+
+    for (pos = 0; pos + offsetof( struct face_list_record, name ) < info->DataLength; pos += record->size)
+    {
+        record = (const struct face_list_record *)(info->Data + pos);
+        if (record->size < sizeof(*record) || record->size > info->DataLength - pos ||
+            record->data_offset >= record->size) break;
+
+        if (record->type == FACE_LIST_FAMILY)
+        {
+            if (family) release_family( family );
+            TRACE( "loading family %s\n", debugstr_w(record->name) );
+            family = create_family( record->name, (const WCHAR *)((const char *)record + record->data_offset) );
+        }
+        else if (family)
+            create_face_from_cache( family, record->name,
+                                    (const struct cached_face *)((const char *)record + record->data_offset),
+                                    record->type == FACE_LIST_SCALABLE );
+    }
+    if (family) release_family( family );
+    free( info );
+    return TRUE;
+}
+
+static void invalidate_face_list(void)
+{
+    if (!wine_fonts_cache_mutex) return;
+    NtWaitForSingleObject( wine_fonts_cache_mutex, FALSE, NULL );
+    reg_delete_value( wine_fonts_cache_key, face_listW );
+    NtReleaseMutant( wine_fonts_cache_mutex, NULL );
+}
+
 static void load_font_list_from_cache(void)
 {
     WCHAR buffer[4096];
@@ -1339,9 +1458,22 @@ static void load_font_list_from_cache(void)
     KEY_NODE_INFORMATION *enum_info = (KEY_NODE_INFORMATION *)buffer;
     DWORD family_index = 0, total_size;
     struct gdi_font_family *family;
+    struct face_list list;
     HKEY hkey_family;
     WCHAR *second_name = (WCHAR *)info->Data;
 
+    NtWaitForSingleObject( wine_fonts_cache_mutex, FALSE, NULL );
+
+    if (load_font_list_from_face_list())
+    {
+        NtReleaseMutant( wine_fonts_cache_mutex, NULL );
+        return;
+    }
+
+    list.size = 0;
+    list.max = 0x10000;
+    list.data = malloc( list.max );
+
     while (!NtEnumerateKey( wine_fonts_cache_key, family_index++, KeyNodeInformation, enum_info,
                             sizeof(buffer), &total_size ))
     {
@@ -1353,12 +1485,18 @@ static void load_font_list_from_cache(void)
             second_name[0] = 0;
 
         family = create_family( buffer, second_name );
+        add_face_list_record( &list, FACE_LIST_FAMILY, buffer, second_name,
+                              (lstrlenW( second_name ) + 1) * sizeof(WCHAR) );
 
-        load_face_from_cache( hkey_family, family, buffer, sizeof(buffer), TRUE );
+        load_face_from_cache( hkey_family, family, buffer, sizeof(buffer), TRUE, &list );
 
         NtClose( hkey_family );
         release_family( family );
     }
+
+    if (list.data) set_reg_value( wine_fonts_cache_key, face_listW, REG_BINARY, list.data, list.size );
+    free( list.data );
+    NtReleaseMutant( wine_fonts_cache_mutex, NULL );
 }
 
 static void add_face_to_cache( struct gdi_font_face *face )
@@ -1406,6 +1544,7 @@ static void add_face_to_cache( struct gdi_font_face *face )
 
     if (hkey_face != hkey_family) NtClose( hkey_face );
     NtClose( hkey_family );
+    invalidate_face_list();
 }
 
 static void remove_face_from_cache( struct gdi_font_face *face )
@@ -1431,6 +1570,7 @@ static void remove_face_from_cache( struct gdi_font_face *face )
     else reg_delete_value( hkey_family, face->style_name );
 
     NtClose( hkey_family );
+    invalidate_face_list();
 }
 
 /* font links */
@@ -2441,11 +2581,14 @@ static void free_gdi_font( struct gdi_font *font )
         free_gdi_font( child );
     }
     for (i = 0; i < font->gm_size; i++) free( font->gm[i] );
+    for (i = 0; i < font->char_abc_size; i++) free( font->char_abc[i] );
+    TRACE( "%p char widths cache: %u hits, %u misses\n", font, font->char_abc_hits, font->char_abc_misses );
     free( font->otm.otmpFamilyName );
     free( font->otm.otmpStyleName );
     free( font->otm.otmpFaceName );
     free( font->otm.otmpFullName );
     free( font->gm );
+    free( font->char_abc );
     free( font->kern_pairs );
     free( font->gsub_table );
     free( font );
@@ -3803,6 +3946,51 @@ done:
     return ret;
 }
 
+/* widths of characters, cached by character code to avoid the glyph index lookup */
+struct char_abc
+{
+    ABC  abc;
+    BOOL init;
+};
+
+#define CHAR_ABC_BLOCK_SIZE 128
+
+static DWORD get_char_abc( struct gdi_font *font, UINT ch, ABC *abc )
+{
+    UINT block = ch / CHAR_ABC_BLOCK_SIZE;
+    UINT entry = ch % CHAR_ABC_BLOCK_SIZE;
+    DWORD ret;
+
+    if (block < font->char_abc_size && font->char_abc[block] && font->char_abc[block][entry].init)
+    {
+        font->char_abc_hits++;
+        *abc = font->char_abc[block][entry].abc;
+        return 1;
+    }
+
+    font->char_abc_misses++;
+    ret = get_glyph_outline( font, ch, GGO_METRICS, NULL, abc, 0, NULL, NULL );
+    if (ret == GDI_ERROR || ch > 0xffff) return ret;
+
+    if (block >= font->char_abc_size)
+    {
+        struct char_abc **ptr;
+
+        if (!(ptr = realloc( font->char_abc, (block + 1) * sizeof(*ptr) ))) return ret;
+        memset( ptr + font->char_abc_size, 0, (block + 1 - font->char_abc_size) * sizeof(*ptr) );
+        font->char_abc_size = block + 1;
+        font->char_abc = ptr;
+    }
+    if (!font->char_abc[block])
+    {
+        font->char_abc[block] = calloc( sizeof(**font->char_abc), CHAR_ABC_BLOCK_SIZE );
+        if (!font->char_abc[block]) return ret;
+    }
+    font->char_abc[block][entry].abc  = *abc;
+    font->char_abc[block][entry].init = TRUE;
+    return ret;
+}
+
 
 /*************************************************************
  * font_FontIsLinked
@@ -3840,7 +4028,7 @@ static BOOL font_GetCharABCWidths( PHYSDEV dev, UINT first, UINT count, WCHAR *c
     for (i = 0; i < count; i++)
     {
         c = chars ? chars[i] : first + i;
-        get_glyph_outline( physdev->font, c, GGO_METRICS, NULL, &buffer[i], 0, NULL, NULL );
+        get_char_abc( physdev->font, c, &buffer[i] );
     }
     pthread_mutex_unlock( &font_lock );
     return TRUE;
@@ -3893,7 +4081,7 @@ static BOOL font_GetCharWidth( PHYSDEV dev, UINT first, UINT count, const WCHAR
     for (i = 0; i < count; i++)
     {
         c = chars ? chars[i] : i + first;
-        if (get_glyph_outline( physdev->font, c, GGO_METRICS, NULL, &abc, 0, NULL, NULL ) == GDI_ERROR)
+        if (get_char_abc( physdev->font, c, &abc ) == GDI_ERROR)
             buffer[i] = 0;
         else
             buffer[i] = abc.abcA + abc.abcB + abc.abcC;
@@ -4252,7 +4440,7 @@ static BOOL font_GetTextExtentExPoint( PHYSDEV dev, const WCHAR *str, INT count,
     pthread_mutex_lock( &font_lock );
     for (i = pos = 0; i < count; i++)
     {
-        get_glyph_outline( physdev->font, str[i], GGO_METRICS, NULL, &abc, 0, NULL, NULL );
+        get_char_abc( physdev->font, str[i], &abc );
         pos += abc.abcA + abc.abcB + abc.abcC;
         dxs[i] = pos;
     }
@@ -6763,6 +6951,7 @@ UINT font_init(void)
         update_external_font_keys();
     }
 
+    wine_fonts_cache_mutex = mutex;
     NtReleaseMutant( mutex, NULL );
 
     if (disposition != REG_CREATED_NEW_KEY)
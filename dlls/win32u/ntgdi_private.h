@@ -260,6 +260,10 @@ struct gdi_font
     DWORD                  refcount;
     DWORD                  gm_size;
     struct glyph_metrics **gm;
+    DWORD                  char_abc_size;
+    struct char_abc      **char_abc;
+    DWORD                  char_abc_hits;
+    DWORD                  char_abc_misses;
     OUTLINETEXTMETRICW     otm;
     KERNINGPAIR           *kern_pairs;
     int                    kern_count;
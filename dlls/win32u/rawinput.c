@@ -449,6 +449,21 @@ UINT WINAPI NtUserGetRawInputDeviceInfo( HANDLE handle, UINT command, void *data
     return *data_size;
 }
 
+/* check the shared queue bits for pending raw input; returns FALSE if a server request is needed */
+static BOOL rawinput_queue_is_empty(void)
+{
+    struct object_lock lock = OBJECT_LOCK_INIT;
+    const queue_shm_t *queue_shm;
+    BOOL empty = FALSE;
+    UINT status;
+
+    while ((status = get_shared_queue( &lock, &queue_shm )) == STATUS_PENDING)
+        empty = !(queue_shm->wake_bits & QS_RAWINPUT);
+
+    if (status) return FALSE;
+    return empty;
+}
+
 /**********************************************************************
  *         NtUserGetRawInputBuffer   (win32u.@)
  */
@@ -474,6 +489,13 @@ UINT WINAPI NtUserGetRawInputBuffer( RAWINPUT *data, UINT *data_size, UINT heade
     /* with old WOW64 mode we didn't go through the WOW64 thunks, patch the header size here */
     if (NtCurrentTeb()->WowTebOffset) header_size = sizeof(RAWINPUTHEADER64);
 
+    /* applications often poll for raw input, avoid a server round trip when there is none */
+    if (rawinput_queue_is_empty())
+    {
+        *data_size = 0;
+        return 0;
+    }
+
     thread_info = get_user_thread_info();
     SERVER_START_REQ( get_rawinput_buffer )
     {
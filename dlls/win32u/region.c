@@ -1848,6 +1848,63 @@ static BOOL REGION_IntersectO(WINEREGION *pReg,  RECT *r1, RECT *r1End,
     return TRUE;
 }
 
+/***********************************************************************
+ *	     REGION_IntersectRectRegion
+ *
+ * Intersect a region with a single rectangle. This is the common case for
+ * clipping, and can be done in a single pass over the bands, coalescing
+ * the bands that become identical, with the same result as REGION_RegionOp.
+ * The destination may be the source region.
+ */
+static BOOL REGION_IntersectRectRegion( WINEREGION *dst, const RECT *rect, WINEREGION *src )
+{
+    RECT clip = *rect, *out;
+    INT i, j, k, n = 0, prev_start = -1, cur_start, top, bottom, left, right;
+
+    if (dst != src && !grow_region( dst, src->numRects )) return FALSE;
+    out = dst->rects;
+
+    for (i = 0; i < src->numRects; i = j)
+    {
+        top = max( src->rects[i].top, clip.top );
+        bottom = min( src->rects[i].bottom, clip.bottom );
+        if (src->rects[i].top >= clip.bottom) break;
+        for (j = i + 1; j < src->numRects && src->rects[j].top == src->rects[i].top; j++) ;
+        if (top >= bottom) continue;
+
+        cur_start = n;
+        for (k = i; k < j; k++)
+        {
+            left = max( src->rects[k].left, clip.left );
+            right = min( src->rects[k].right, clip.right );
+            if (left >= right) continue;
+            out[n].left = left;
+            out[n].top = top;
+            out[n].right = right;
+            out[n].bottom = bottom;
+            n++;
+        }
+        if (n == cur_start) continue;
+
+        /* merge with the previous band if it has the same rectangles */
+        if (prev_start != -1 && n - cur_start == cur_start - prev_start && out[prev_start].bottom == top)
+        {
+            for (k = 0; k < cur_start - prev_start; k++)
+                if (out[prev_start + k].left != out[cur_start + k].left ||
+                    out[prev_start + k].right != out[cur_start + k].right) break;
+            if (k == cur_start - prev_start)
+            {
+                for (k = prev_start; k < cur_start; k++) out[k].bottom = bottom;
+                n = cur_start;
+                continue;
+            }
+        }
+        prev_start = cur_start;
+    }
+    dst->numRects = n;
+    return TRUE;
+}
+
 /***********************************************************************
  *	     REGION_IntersectRegion
  */
@@ -1858,6 +1915,14 @@ static BOOL REGION_IntersectRegion(WINEREGION *newReg, WINEREGION *reg1,
     if ( (!(reg1->numRects)) || (!(reg2->numRects))  ||
 	(!overlapping(&reg1->extents, &reg2->extents)))
 	newReg->numRects = 0;
+    else if (reg2->numRects == 1)
+    {
+        if (!REGION_IntersectRectRegion( newReg, &reg2->extents, reg1 )) return FALSE;
+    }
+    else if (reg1->numRects == 1)
+    {
+        if (!REGION_IntersectRectRegion( newReg, &reg1->extents, reg2 )) return FALSE;
+    }
     else
 	if (!REGION_RegionOp (newReg, reg1, reg2, REGION_IntersectO, NULL, NULL)) return FALSE;
 
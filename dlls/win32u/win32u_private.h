@@ -58,6 +58,7 @@ extern void register_window_surface( struct window_surface *old,
 extern void window_surface_lock( struct window_surface *surface );
 extern void window_surface_unlock( struct window_surface *surface );
 extern void window_surface_flush( struct window_surface *surface );
+extern void window_surface_add_bounds( struct window_surface *surface, const RECT *rect );
 extern void window_surface_set_clip( struct window_surface *surface, HRGN clip_region );
 extern void window_surface_set_layered( struct window_surface *surface, COLORREF color_key, UINT alpha_bits, UINT alpha_mask );
 
@@ -1213,6 +1213,16 @@ static LONG_PTR get_window_long_size( HWND hwnd, INT offset, UINT size, BOOL ans
             RtlSetLastWin32Error( ERROR_ACCESS_DENIED );
             return 0;
         }
+        if (offset == GWL_STYLE || offset == GWL_EXSTYLE)
+        {
+            struct object_lock lock = OBJECT_LOCK_INIT;
+            const window_shm_t *window_shm = NULL;
+            NTSTATUS status;
+
+            while ((status = get_shared_window( hwnd, &lock, &window_shm )) == STATUS_PENDING)
+                retval = offset == GWL_STYLE ? window_shm->style : window_shm->ex_style;
+            if (!status) return retval;
+        }
         SERVER_START_REQ( get_window_info )
         {
             req->handle = wine_server_user_handle( hwnd );
@@ -127,6 +127,56 @@ static inline float from_sRGB_component(float f)
     return powf((f + 0.055f) / 1.055f, 2.4f);
 }
 
+static float srgb8_to_linear[256];
+
+static BOOL WINAPI init_srgb8_to_linear(INIT_ONCE *once, void *param, void **context)
+{
+    unsigned int i;
+
+    for (i = 0; i < ARRAY_SIZE(srgb8_to_linear); ++i)
+        srgb8_to_linear[i] = from_sRGB_component(i / 255.0f);
+
+    return TRUE;
+}
+
+/* Same as from_sRGB_component(c / 255.0f), using a lookup table. */
+static const float *get_srgb8_to_linear_table(void)
+{
+    static INIT_ONCE once = INIT_ONCE_STATIC_INIT;
+
+    InitOnceExecuteOnce(&once, init_srgb8_to_linear, NULL, NULL);
+    return srgb8_to_linear;
+}
+
+/* Premultiplies 32bpp pixels with alpha in the last byte, (c * alpha + 127) / 255 is
+   computed without division. */
+static void premultiply_32bpp_rows(BYTE *bits, UINT stride, INT width, INT height)
+{
+    unsigned int t;
+    INT x, y;
+    BYTE *p;
+
+    for (y = 0; y < height; y++)
+    {
+        p = bits + stride * y;
+        for (x = 0; x < width; x++, p += 4)
+        {
+            BYTE alpha = p[3];
+
+            if (alpha == 255) continue;
+            if (!alpha)
+            {
+                p[0] = p[1] = p[2] = 0;
+                continue;
+            }
+
+            t = p[0] * alpha + 128; p[0] = (t + (t >> 8)) >> 8;
+            t = p[1] * alpha + 128; p[1] = (t + (t >> 8)) >> 8;
+            t = p[2] * alpha + 128; p[2] = (t + (t >> 8)) >> 8;
+        }
+    }
+}
+
 #if 0 /* FIXME: enable once needed */
 
 static void from_sRGB(BYTE *bgr)
@@ -1195,21 +1245,7 @@ static HRESULT copypixels_to_32bppPBGRA(struct FormatConverter *This, const WICR
     default:
         hr = copypixels_to_32bppBGRA(This, prc, cbStride, cbBufferSize, pbBuffer, source_format);
         if (SUCCEEDED(hr) && prc)
-        {
-            INT x, y;
-
-            for (y=0; y<prc->Height; y++)
-                for (x=0; x<prc->Width; x++)
-                {
-                    BYTE alpha = pbBuffer[cbStride*y+4*x+3];
-                    if (alpha != 255)
-                    {
-                        pbBuffer[cbStride*y+4*x] = (pbBuffer[cbStride*y+4*x] * alpha + 127) / 255;
-                        pbBuffer[cbStride*y+4*x+1] = (pbBuffer[cbStride*y+4*x+1] * alpha + 127) / 255;
-                        pbBuffer[cbStride*y+4*x+2] = (pbBuffer[cbStride*y+4*x+2] * alpha + 127) / 255;
-                    }
-                }
-        }
+            premultiply_32bpp_rows(pbBuffer, cbStride, prc->Width, prc->Height);
         return hr;
     }
 }
@@ -1228,21 +1264,7 @@ static HRESULT copypixels_to_32bppPRGBA(struct FormatConverter *This, const WICR
     default:
         hr = copypixels_to_32bppRGBA(This, prc, cbStride, cbBufferSize, pbBuffer, source_format);
         if (SUCCEEDED(hr) && prc)
-        {
-            INT x, y;
-
-            for (y=0; y<prc->Height; y++)
-                for (x=0; x<prc->Width; x++)
-                {
-                    BYTE alpha = pbBuffer[cbStride*y+4*x+3];
-                    if (alpha != 255)
-                    {
-                        pbBuffer[cbStride*y+4*x] = (pbBuffer[cbStride*y+4*x] * alpha + 127) / 255;
-                        pbBuffer[cbStride*y+4*x+1] = (pbBuffer[cbStride*y+4*x+1] * alpha + 127) / 255;
-                        pbBuffer[cbStride*y+4*x+2] = (pbBuffer[cbStride*y+4*x+2] * alpha + 127) / 255;
-                    }
-                }
-        }
+            premultiply_32bpp_rows(pbBuffer, cbStride, prc->Width, prc->Height);
         return hr;
     }
 }
@@ -2182,6 +2204,8 @@ static HRESULT copypixels_to_128bppRGBAFloat(struct FormatConverter *This, const
         hr = IWICBitmapSource_CopyPixels(This->source, prc, srcstride, srcdatasize, srcdata);
         if (SUCCEEDED(hr))
         {
+            const float *to_linear = get_srgb8_to_linear_table();
+
             srcrow = srcdata;
             dstrow = pbBuffer;
             for (y = 0; y < prc->Height; y++)
@@ -2190,9 +2214,9 @@ static HRESULT copypixels_to_128bppRGBAFloat(struct FormatConverter *This, const
                 dstpixel= (float *)dstrow;
                 for (x = 0; x < prc->Width; x++)
                 {
-                    dstpixel[2] = from_sRGB_component(*srcpixel++ / 255.0f);
-                    dstpixel[1] = from_sRGB_component(*srcpixel++ / 255.0f);
-                    dstpixel[0] = from_sRGB_component(*srcpixel++ / 255.0f);
+                    dstpixel[2] = to_linear[*srcpixel++];
+                    dstpixel[1] = to_linear[*srcpixel++];
+                    dstpixel[0] = to_linear[*srcpixel++];
                     dstpixel[3] = 1.0f;
 
                     dstpixel += 4;
@@ -2227,6 +2251,8 @@ static HRESULT copypixels_to_128bppRGBAFloat(struct FormatConverter *This, const
         hr = IWICBitmapSource_CopyPixels(This->source, prc, srcstride, srcdatasize, srcdata);
         if (SUCCEEDED(hr))
         {
+            const float *to_linear = get_srgb8_to_linear_table();
+
             srcrow = srcdata;
             dstrow = pbBuffer;
             for (y = 0; y < prc->Height; y++)
@@ -2235,9 +2261,9 @@ static HRESULT copypixels_to_128bppRGBAFloat(struct FormatConverter *This, const
                 dstpixel= (float *)dstrow;
                 for (x = 0; x < prc->Width; x++)
                 {
-                    dstpixel[2] = from_sRGB_component(*srcpixel++ / 255.0f);
-                    dstpixel[1] = from_sRGB_component(*srcpixel++ / 255.0f);
-                    dstpixel[0] = from_sRGB_component(*srcpixel++ / 255.0f);
+                    dstpixel[2] = to_linear[*srcpixel++];
+                    dstpixel[1] = to_linear[*srcpixel++];
+                    dstpixel[0] = to_linear[*srcpixel++];
                     dstpixel[3] = *srcpixel++ / 255.0f;
 
                     dstpixel += 4;
@@ -85,8 +85,10 @@ struct jpeg_decoder {
     struct jpeg_error_mgr jerr;
     struct jpeg_source_mgr source_mgr;
     BYTE source_buffer[1024];
+    ULONGLONG source_pos;
     UINT stride;
     BYTE *image_data;
+    BOOL decode_failed;
 };
 
 static inline struct jpeg_decoder *impl_from_decoder(struct decoder* iface)
@@ -118,7 +120,10 @@ static boolean source_mgr_fill_input_buffer(j_decompress_ptr cinfo)
     HRESULT hr;
     ULONG bytesread;
 
-    hr = stream_read(This->stream, This->source_buffer, 1024, &bytesread);
+    /* Scanlines are decoded on demand, metadata readers could have moved the stream in between. */
+    hr = stream_seek(This->stream, This->source_pos, STREAM_SEEK_SET, NULL);
+    if (SUCCEEDED(hr))
+        hr = stream_read(This->stream, This->source_buffer, 1024, &bytesread);
 
     if (FAILED(hr) || bytesread == 0)
     {
@@ -126,6 +131,7 @@ static boolean source_mgr_fill_input_buffer(j_decompress_ptr cinfo)
     }
     else
     {
+        This->source_pos += bytesread;
         This->source_mgr.next_input_byte = This->source_buffer;
         This->source_mgr.bytes_in_buffer = bytesread;
         return TRUE;
@@ -138,7 +144,7 @@ static void source_mgr_skip_input_data(j_decompress_ptr cinfo, long num_bytes)
 
     if (num_bytes > This->source_mgr.bytes_in_buffer)
     {
-        stream_seek(This->stream, num_bytes - This->source_mgr.bytes_in_buffer, STREAM_SEEK_CUR, NULL);
+        This->source_pos += num_bytes - This->source_mgr.bytes_in_buffer;
         This->source_mgr.bytes_in_buffer = 0;
     }
     else if (num_bytes > 0)
@@ -152,12 +158,68 @@ static void source_mgr_term_source(j_decompress_ptr cinfo)
 {
 }
 
+/* Decodes scanlines up to, but not including, given one. */
+static HRESULT jpeg_decoder_read_scanlines(struct jpeg_decoder *This, UINT end)
+{
+    jmp_buf jmpbuf;
+    UINT i, j;
+
+    if (This->decode_failed)
+        return E_FAIL;
+
+    This->cinfo.client_data = jmpbuf;
+
+    if (setjmp(jmpbuf))
+    {
+        This->decode_failed = TRUE;
+        return E_FAIL;
+    }
+
+    end = min(end, This->cinfo.output_height);
+
+    while (This->cinfo.output_scanline < end)
+    {
+        UINT first_scanline = This->cinfo.output_scanline;
+        UINT max_rows;
+        JSAMPROW out_rows[4];
+        JDIMENSION ret;
+
+        max_rows = min(This->cinfo.output_height-first_scanline, 4);
+        for (i=0; i<max_rows; i++)
+            out_rows[i] = This->image_data + This->stride * (first_scanline+i);
+
+        ret = jpeg_read_scanlines(&This->cinfo, out_rows, max_rows);
+        if (ret == 0)
+        {
+            ERR("read_scanlines failed\n");
+            This->decode_failed = TRUE;
+            return E_FAIL;
+        }
+
+        if (This->frame.bpp == 24)
+        {
+            /* libjpeg gives us RGB data and we want BGR, so byteswap the data */
+            reverse_bgr8(3, out_rows[0], This->cinfo.output_width, ret, This->stride);
+        }
+
+        if (This->cinfo.out_color_space == JCS_CMYK && This->cinfo.saw_Adobe_marker)
+        {
+            /* Adobe JPEG's have inverted CMYK data. */
+            for (i=0; i<ret; i++)
+                for (j=0; j<This->stride; j++)
+                    out_rows[i][j] ^= 0xff;
+        }
+    }
+
+    return S_OK;
+}
+
 static HRESULT CDECL jpeg_decoder_initialize(struct decoder* iface, IStream *stream, struct decoder_stat *st)
 {
     struct jpeg_decoder *This = impl_from_decoder(iface);
     int ret;
     jmp_buf jmpbuf;
-    UINT data_size, i;
+    UINT data_size;
 
     if (This->cinfo_initialized)
         return WINCODEC_ERR_WRONGSTATE;
@@ -179,8 +241,7 @@ static HRESULT CDECL jpeg_decoder_initialize(struct decoder* iface, IStream *str
     This->cinfo_initialized = TRUE;
 
     This->stream = stream;
-
-    stream_seek(This->stream, 0, STREAM_SEEK_SET, NULL);
+    This->source_pos = 0;
 
     This->source_mgr.bytes_in_buffer = 0;
     This->source_mgr.init_source = source_mgr_init_source;
@@ -259,44 +320,11 @@ static HRESULT CDECL jpeg_decoder_initialize(struct decoder* iface, IStream *str
         /* overflow in multiplication */
         return E_OUTOFMEMORY;
 
+    /* Scanlines are decoded when pixels are requested. */
     This->image_data = malloc(data_size);
     if (!This->image_data)
         return E_OUTOFMEMORY;
 
-    while (This->cinfo.output_scanline < This->cinfo.output_height)
-    {
-        UINT first_scanline = This->cinfo.output_scanline;
-        UINT max_rows;
-        JSAMPROW out_rows[4];
-        JDIMENSION ret;
-
-        max_rows = min(This->cinfo.output_height-first_scanline, 4);
-        for (i=0; i<max_rows; i++)
-            out_rows[i] = This->image_data + This->stride * (first_scanline+i);
-
-        ret = jpeg_read_scanlines(&This->cinfo, out_rows, max_rows);
-        if (ret == 0)
-        {
-            ERR("read_scanlines failed\n");
-            return E_FAIL;
-        }
-    }
-
-    if (This->frame.bpp == 24)
-    {
-        /* libjpeg gives us RGB data and we want BGR, so byteswap the data */
-        reverse_bgr8(3, This->image_data,
-            This->cinfo.output_width, This->cinfo.output_height,
-            This->stride);
-    }
-
-    if (This->cinfo.out_color_space == JCS_CMYK && This->cinfo.saw_Adobe_marker)
-    {
-        /* Adobe JPEG's have inverted CMYK data. */
-        for (i=0; i<data_size; i++)
-            This->image_data[i] ^= 0xff;
-    }
-
     st->frame_count = 1;
     st->flags = WICBitmapDecoderCapabilityCanDecodeAllImages |
                 WICBitmapDecoderCapabilityCanDecodeSomeImages |
@@ -322,6 +350,12 @@ static HRESULT CDECL jpeg_decoder_copy_pixels(struct decoder* iface, UINT frame,
     const WICRect *prc, UINT stride, UINT buffersize, BYTE *buffer)
 {
     struct jpeg_decoder *This = impl_from_decoder(iface);
+    HRESULT hr;
+
+    if (FAILED(hr = jpeg_decoder_read_scanlines(This, prc && prc->Y >= 0 && prc->Height >= 0 ?
+            prc->Y + prc->Height : This->frame.height)))
+        return hr;
+
     return copy_pixels(This->frame.bpp, This->image_data,
         This->frame.width, This->frame.height, This->stride,
         prc, stride, buffersize, buffer);
@@ -447,6 +481,7 @@ HRESULT CDECL jpeg_decoder_create(struct decoder_info *info, struct decoder **re
     This->cinfo_initialized = FALSE;
     This->stream = NULL;
     This->image_data = NULL;
+    This->decode_failed = FALSE;
     *result = &This->decoder;
 
     info->container_format = GUID_ContainerFormatJpeg;
@@ -258,16 +258,14 @@ static HRESULT WINAPI BitmapScaler_CopyPixels(IWICBitmapScaler *iface,
     }
 
     /* MSDN recommends calling CopyPixels once for each scanline from top to
-     * bottom, and claims codecs optimize for this. Ideally, when called in this
-     * way, we should avoid requesting a scanline from the source more than
-     * once, by saving the data that will be useful for the next scanline after
-     * the call returns. The GetRequiredSourceRect/CopyScanline functions are
-     * designed to make it possible to do this in a generic way, but for now we
-     * just grab all the data we need in each call. */
+     * bottom, and claims codecs optimize for this. Source rows are requested
+     * for each destination scanline separately, and kept if the next scanline
+     * needs the same ones, so that large reductions only read the rows that
+     * are actually sampled and memory use doesn't depend on the source size. */
 
     This->fn_get_required_source_rect(This, dest_rect.X, dest_rect.Y, &src_rect_ul);
     This->fn_get_required_source_rect(This, dest_rect.X+dest_rect.Width-1,
-        dest_rect.Y+dest_rect.Height-1, &src_rect_br);
+        dest_rect.Y, &src_rect_br);
 
     src_rect.X = src_rect_ul.X;
     src_rect.Y = src_rect_ul.Y;
@@ -291,16 +289,23 @@ static HRESULT WINAPI BitmapScaler_CopyPixels(IWICBitmapScaler *iface,
     for (y=0; y<src_rect.Height; y++)
         src_rows[y] = src_bits + y * src_bytesperrow;
 
-    hr = IWICBitmapSource_CopyPixels(This->source, &src_rect, src_bytesperrow,
-        buffer_size, src_bits);
+    hr = S_OK;
+    src_rect.Y = -1;
 
-    if (SUCCEEDED(hr))
+    for (y=0; y < dest_rect.Height && SUCCEEDED(hr); y++)
     {
-        for (y=0; y < dest_rect.Height; y++)
+        This->fn_get_required_source_rect(This, dest_rect.X, dest_rect.Y+y, &src_rect_ul);
+
+        if (src_rect_ul.Y != src_rect.Y)
         {
+            src_rect.Y = src_rect_ul.Y;
+            hr = IWICBitmapSource_CopyPixels(This->source, &src_rect, src_bytesperrow,
+                buffer_size, src_bits);
+        }
+
+        if (SUCCEEDED(hr))
             This->fn_copy_scanline(This, dest_rect.X, dest_rect.Y+y, dest_rect.Width,
                 src_rows, src_rect.X, src_rect.Y, pbBuffer + cbStride * y);
-        }
     }
 
     free(src_rows);
@@ -702,6 +702,7 @@ static void process_hid_report(DEVICE_OBJECT *device, BYTE *report_buf, DWORD re
     if (ext->state != DEVICE_STATE_STARTED)
     {
         RtlLeaveCriticalSection(&ext->cs);
+        RtlFreeHeap(GetProcessHeap(), 0, report);
         return;
     }
 
@@ -711,6 +712,7 @@ static void process_hid_report(DEVICE_OBJECT *device, BYTE *report_buf, DWORD re
     {
         WARN("Ignoring report with unexpected id %#x\n", *report_buf);
         RtlLeaveCriticalSection(&ext->cs);
+        RtlFreeHeap(GetProcessHeap(), 0, report);
         return;
     }
 
@@ -718,12 +720,11 @@ static void process_hid_report(DEVICE_OBJECT *device, BYTE *report_buf, DWORD re
 
     memcpy(last_report->buffer, report_buf, report_len);
 
-    if ((irp = pop_pending_read(ext)))
-    {
-        deliver_next_report(ext, irp);
-        IoCompleteRequest(irp, IO_NO_INCREMENT);
-    }
+    if ((irp = pop_pending_read(ext))) deliver_next_report(ext, irp);
     RtlLeaveCriticalSection(&ext->cs);
+
+    /* complete outside of the lock, the woken hidclass thread sends its next read right away */
+    if (irp) IoCompleteRequest(irp, IO_NO_INCREMENT);
 }
 
 static NTSTATUS handle_IRP_MN_QUERY_DEVICE_RELATIONS(IRP *irp)
@@ -1414,6 +1414,9 @@ static void wined3d_context_gl_cleanup(struct wined3d_context_gl *context_gl)
         if (context_gl->free_occlusion_query_count)
             GL_EXTCALL(glDeleteQueries(context_gl->free_occlusion_query_count, context_gl->free_occlusion_queries));
 
+        for (i = 0; i < context_gl->free_query_buffer_count; ++i)
+            GL_EXTCALL(glDeleteBuffers(1, &context_gl->free_query_buffers[i].id));
+
         checkGLcall("context cleanup");
     }
     free(context_gl->submitted.fences);
@@ -1422,6 +1425,7 @@ static void wined3d_context_gl_cleanup(struct wined3d_context_gl *context_gl)
     free(context_gl->free_timestamp_queries);
     free(context_gl->free_fences);
     free(context_gl->free_occlusion_queries);
+    free(context_gl->free_query_buffers);
 
     LIST_FOR_EACH_ENTRY(pipeline_statistics_query, &context_gl->pipeline_statistics_queries,
             struct wined3d_pipeline_statistics_query, entry)
@@ -2224,6 +2228,12 @@ HRESULT wined3d_context_gl_init(struct wined3d_context_gl *context_gl, struct wi
         gl_info->gl_ops.gl.p_glEnable(GL_TEXTURE_CUBE_MAP_SEAMLESS);
         checkGLcall("enable seamless cube map filtering");
     }
+    if (gl_info->supported[ARB_PARALLEL_SHADER_COMPILE])
+    {
+        /* Let the driver compile the shader stages of a program concurrently. */
+        GL_EXTCALL(glMaxShaderCompilerThreadsARB(~0u));
+        checkGLcall("glMaxShaderCompilerThreadsARB");
+    }
     if (gl_info->supported[ARB_CLIP_CONTROL])
         GL_EXTCALL(glPointParameteri(GL_POINT_SPRITE_COORD_ORIGIN, GL_LOWER_LEFT));
 
@@ -755,6 +755,9 @@ static void wined3d_cs_exec_present(struct wined3d_cs *cs, const void *data)
         }
     }
 
+    if (swapchain->present_semaphore)
+        ReleaseSemaphore(swapchain->present_semaphore, 1, NULL);
+
     InterlockedDecrement(&cs->pending_presents);
     if (InterlockedCompareExchange(&cs->waiting_for_present, FALSE, TRUE))
         SetEvent(cs->present_event);
@@ -4610,8 +4613,7 @@ HRESULT CDECL wined3d_deferred_context_record_command_list(struct wined3d_device
     memory = malloc(sizeof(*object) + deferred->resource_count * sizeof(*object->resources)
             + deferred->upload_count * sizeof(*object->uploads)
             + deferred->command_list_count * sizeof(*object->command_lists)
-            + deferred->query_count * sizeof(*object->queries)
-            + deferred->data_size);
+            + deferred->query_count * sizeof(*object->queries));
 
     if (!memory)
     {
@@ -4650,9 +4652,12 @@ HRESULT CDECL wined3d_deferred_context_record_command_list(struct wined3d_device
     memcpy(object->queries, deferred->queries, deferred->query_count * sizeof(*object->queries));
     /* Transfer our references to the queries to the command list. */
 
-    object->data = memory;
+    /* Hand the recorded packets over instead of copying them, and give the
+     * deferred context a fresh buffer of the same size for the next list. */
+    object->data = deferred->data;
     object->data_size = deferred->data_size;
-    memcpy(object->data, deferred->data, deferred->data_size);
+    if (!(deferred->data = malloc(deferred->data_capacity)))
+        deferred->data_capacity = 0;
 
     deferred->data_size = 0;
     deferred->resource_count = 0;
@@ -4716,6 +4721,7 @@ static void wined3d_command_list_destroy_object(void *object)
         }
     }
 
+    free(list->data);
     free(list);
 }
 
@@ -482,14 +482,11 @@ static void shader_glsl_append_imm_ivec(struct wined3d_string_buffer *buffer,
 }
 
 /* Context activation is done by the caller. */
-void print_glsl_info_log(const struct wined3d_gl_info *gl_info, GLuint id, BOOL program)
+static void print_glsl_log(const struct wined3d_gl_info *gl_info, GLuint id, BOOL program)
 {
     int length = 0;
     char *log;
 
-    if (!WARN_ON(d3d_shader) && !FIXME_ON(d3d_shader))
-        return;
-
     if (program)
         GL_EXTCALL(glGetProgramiv(id, GL_INFO_LOG_LENGTH, &length));
     else
@@ -533,6 +530,20 @@ void print_glsl_info_log(const struct wined3d_gl_info *gl_info, GLuint id, BOOL
     }
 }
 
+/* Context activation is done by the caller. */
+void print_glsl_info_log(const struct wined3d_gl_info *gl_info, GLuint id, BOOL program)
+{
+    if (!WARN_ON(d3d_shader) && !FIXME_ON(d3d_shader))
+        return;
+
+    /* Querying the info log of a shader waits for a parallel compile to
+     * finish. Compile errors still show up when the program fails to link. */
+    if (!program && gl_info->supported[ARB_PARALLEL_SHADER_COMPILE] && !WARN_ON(d3d_shader))
+        return;
+
+    print_glsl_log(gl_info, id, program);
+}
+
 /* Context activation is done by the caller. */
 static void shader_glsl_compile(const struct wined3d_gl_info *gl_info, GLuint shader, const char *src)
 {
@@ -601,6 +612,8 @@ static void shader_glsl_dump_program_source(const struct wined3d_gl_info *gl_inf
         FIXME("    GL_SHADER_TYPE: %s.\n", debug_gl_shader_type(tmp));
         GL_EXTCALL(glGetShaderiv(shaders[i], GL_COMPILE_STATUS, &tmp));
         FIXME("    GL_COMPILE_STATUS: %d.\n", tmp);
+        if (!tmp && gl_info->supported[ARB_PARALLEL_SHADER_COMPILE] && !WARN_ON(d3d_shader))
+            print_glsl_log(gl_info, shaders[i], FALSE);
         FIXME("\n");
         while ((line = wined3d_get_line(&ptr, end)))
         {
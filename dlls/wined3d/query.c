@@ -24,6 +24,8 @@
 
 WINE_DEFAULT_DEBUG_CHANNEL(d3d);
 
+#define WINED3D_MAX_FREE_QUERY_BUFFERS 64
+
 static void wined3d_query_buffer_invalidate(struct wined3d_query *query)
 {
     /* map[0] != map[1]: exact values do not have any significance. */
@@ -41,6 +43,22 @@ static void wined3d_query_create_buffer_object(struct wined3d_context_gl *contex
     const GLuint map_flags = GL_MAP_READ_BIT | GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
     const struct wined3d_gl_info *gl_info = context_gl->gl_info;
     GLuint buffer_object;
+    unsigned int i;
+
+    /* Reuse a free buffer object whose last result has landed. */
+    for (i = context_gl->free_query_buffer_count; i--;)
+    {
+        struct wined3d_gl_query_buffer *buffer = &context_gl->free_query_buffers[i];
+
+        if (buffer->map_ptr[0] != buffer->map_ptr[1])
+            continue;
+
+        query->buffer_object = buffer->id;
+        query->map_ptr = buffer->map_ptr;
+        *buffer = context_gl->free_query_buffers[--context_gl->free_query_buffer_count];
+        wined3d_query_buffer_invalidate(query);
+        return;
+    }
 
     GL_EXTCALL(glGenBuffers(1, &buffer_object));
     GL_EXTCALL(glBindBuffer(GL_QUERY_BUFFER, buffer_object));
@@ -56,9 +74,21 @@ static void wined3d_query_create_buffer_object(struct wined3d_context_gl *contex
 void wined3d_query_gl_destroy_buffer_object(struct wined3d_context_gl *context_gl, struct wined3d_query *query)
 {
     const struct wined3d_gl_info *gl_info = context_gl->gl_info;
+    struct wined3d_gl_query_buffer *buffer;
 
-    GL_EXTCALL(glDeleteBuffers(1, &query->buffer_object));
-    checkGLcall("query buffer object destruction");
+    if (context_gl->free_query_buffer_count < WINED3D_MAX_FREE_QUERY_BUFFERS
+            && wined3d_array_reserve((void **)&context_gl->free_query_buffers, &context_gl->free_query_buffer_size,
+            context_gl->free_query_buffer_count + 1, sizeof(*context_gl->free_query_buffers)))
+    {
+        buffer = &context_gl->free_query_buffers[context_gl->free_query_buffer_count++];
+        buffer->id = query->buffer_object;
+        buffer->map_ptr = query->map_ptr;
+    }
+    else
+    {
+        GL_EXTCALL(glDeleteBuffers(1, &query->buffer_object));
+        checkGLcall("query buffer object destruction");
+    }
 
     query->buffer_object = 0;
     query->map_ptr = NULL;
@@ -403,6 +403,15 @@ void CDECL wined3d_swapchain_set_palette(struct wined3d_swapchain *swapchain, st
     swapchain->palette = palette;
 }
 
+void CDECL wined3d_swapchain_set_present_semaphore(struct wined3d_swapchain *swapchain, HANDLE semaphore)
+{
+    TRACE("swapchain %p, semaphore %p.\n", swapchain, semaphore);
+
+    wined3d_cs_finish(swapchain->device->cs, WINED3D_CS_QUEUE_DEFAULT);
+
+    swapchain->present_semaphore = semaphore;
+}
+
 HRESULT CDECL wined3d_swapchain_get_gamma_ramp(const struct wined3d_swapchain *swapchain,
         struct wined3d_gamma_ramp *ramp)
 {
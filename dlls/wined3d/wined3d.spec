@@ -311,6 +311,7 @@
 @ cdecl wined3d_swapchain_resize_buffers(ptr long long long long long long)
 @ cdecl wined3d_swapchain_set_gamma_ramp(ptr long ptr)
 @ cdecl wined3d_swapchain_set_palette(ptr ptr)
+@ cdecl wined3d_swapchain_set_present_semaphore(ptr ptr)
 @ cdecl wined3d_swapchain_set_window(ptr ptr)
 
 @ cdecl wined3d_swapchain_state_create(ptr ptr ptr ptr ptr)
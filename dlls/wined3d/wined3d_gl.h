@@ -94,6 +94,7 @@ enum wined3d_gl_extension
     ARB_MULTISAMPLE,
     ARB_MULTITEXTURE,
     ARB_OCCLUSION_QUERY,
+    ARB_PARALLEL_SHADER_COMPILE,
     ARB_PIPELINE_STATISTICS_QUERY,
     ARB_PIXEL_BUFFER_OBJECT,
     ARB_POINT_PARAMETERS,
@@ -462,6 +463,12 @@ union wined3d_gl_fence_object
     GLsync sync;
 };
 
+struct wined3d_gl_query_buffer
+{
+    GLuint id;
+    UINT64 *map_ptr;
+};
+
 enum wined3d_fence_result
 {
     WINED3D_FENCE_OK,
@@ -689,6 +696,12 @@ struct wined3d_context_gl
     SIZE_T free_pipeline_statistics_query_size;
     unsigned int free_pipeline_statistics_query_count;
 
+    /* Query buffer objects no longer owned by a query. Their last result may
+     * still be in flight. */
+    struct wined3d_gl_query_buffer *free_query_buffers;
+    SIZE_T free_query_buffer_size;
+    unsigned int free_query_buffer_count;
+
     GLuint blit_vbo;
 
     unsigned int tex_unit_map[WINED3D_MAX_COMBINED_SAMPLERS];
@@ -4113,6 +4113,7 @@ struct wined3d_swapchain
     RECT front_buffer_update;
     unsigned int swap_interval;
     unsigned int max_frame_latency;
+    HANDLE present_semaphore;
 
     /* Performance tracking */
     LARGE_INTEGER last_present_time;
@@ -892,10 +892,7 @@ bool wg_video_format_is_rgb(enum wg_video_format format)
 BOOL WINAPI DllMain(HINSTANCE instance, DWORD reason, void *reserved)
 {
     if (reason == DLL_PROCESS_ATTACH)
-    {
         DisableThreadLibraryCalls(instance);
-        __wine_init_unix_call();
-    }
     return TRUE;
 }
 
@@ -1055,6 +1052,11 @@ static BOOL CALLBACK init_gstreamer_proc(INIT_ONCE *once, void *param, void **ct
     };
     HINSTANCE handle;
 
+    /* Load the unix library, and with it GStreamer, only when it's actually needed.
+     * All the unix calls go through objects created after init_gstreamer(). */
+    if (__wine_init_unix_call())
+        return FALSE;
+
     if (WINE_UNIX_CALL(unix_wg_init_gstreamer, &params))
         return FALSE;
 
@@ -107,6 +107,7 @@ static gpointer wg_allocator_map(GstMemory *gst_memory, GstMapInfo *info, gsize
 {
     WgAllocator *allocator = (WgAllocator *)gst_memory->allocator;
     WgMemory *memory = (WgMemory *)gst_memory;
+    struct wg_sample *sample;
 
     if (gst_memory->parent)
         return wg_allocator_map(gst_memory->parent, info, maxsize);
@@ -115,6 +116,18 @@ static gpointer wg_allocator_map(GstMemory *gst_memory, GstMapInfo *info, gsize
 
     pthread_mutex_lock(&allocator->mutex);
 
+    /* Buffer pools often allocate their memory before any output sample has
+     * been provided. As long as such memory has never been mapped it holds no
+     * data, and can still be backed by the pending sample instead of being
+     * decoded into unix memory and copied later. */
+    if (!memory->sample && !memory->unix_memory && (sample = allocator->next_sample)
+            && sample->max_size >= memory->parent.maxsize)
+    {
+        memory->sample = sample;
+        allocator->next_sample = NULL;
+        GST_INFO("Attached sample %p to memory %p", sample, memory);
+    }
+
     if (!memory->sample)
         info->data = get_unix_memory_data(memory);
     else
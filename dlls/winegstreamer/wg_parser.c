@@ -95,7 +95,9 @@ struct wg_parser
 
     gchar *sink_caps;
 
-    struct input_cache_chunk input_cache_chunks[4];
+    /* Seeking demuxers keep going back to their index (MP4 moov, Matroska
+     * cues, ...), so keep enough chunks that it survives a few jumps. */
+    struct input_cache_chunk input_cache_chunks[16];
 };
 static const unsigned int input_cache_chunk_size = 512 << 10;
 
@@ -713,6 +713,8 @@ static void convert_channel_map(const pa_channel_map *pa_map, WAVEFORMATEXTENSIB
     fmt->dwChannelMask = pa_mask;
 }
 
+static const REFERENCE_TIME pulse_min_period = 30000; /* 3 ms */
+
 static void pulse_probe_settings(int render, const char *pulse_name, WAVEFORMATEXTENSIBLE *fmt, REFERENCE_TIME *def_period, REFERENCE_TIME *min_period)
 {
     WAVEFORMATEX *wfx = &fmt->Format;
@@ -768,7 +770,13 @@ static void pulse_probe_settings(int render, const char *pulse_name, WAVEFORMATE
         pa_stream_unref(stream);
 
     if (length)
-        *def_period = *min_period = pa_bytes_to_usec(10 * length, &ss);
+    {
+        /* Streams are connected with PA_STREAM_ADJUST_LATENCY and ask for their
+         * period as minreq/fragsize, so the server can run below the default
+         * quantum probed here; PipeWire lowers its graph quantum on request. */
+        *def_period = pa_bytes_to_usec(10 * length, &ss);
+        *min_period = min(*def_period, pulse_min_period);
+    }
 
     wfx->wFormatTag = WAVE_FORMAT_EXTENSIBLE;
     wfx->cbSize = sizeof(WAVEFORMATEXTENSIBLE) - sizeof(WAVEFORMATEX);
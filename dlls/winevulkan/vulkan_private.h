@@ -61,17 +61,23 @@ NTSTATUS vk_is_available_device_function(void *arg);
 NTSTATUS vk_is_available_instance_function32(void *arg);
 NTSTATUS vk_is_available_device_function32(void *arg);
 
+#define CONVERSION_CONTEXT_CHUNK_SIZE 8192
+
 struct conversion_context
 {
     char buffer[2048];
     uint32_t used;
     struct list alloc_entries;
+    char *chunk_ptr;
+    size_t chunk_left;
 };
 
 static inline void init_conversion_context(struct conversion_context *pool)
 {
     pool->used = 0;
     list_init(&pool->alloc_entries);
+    pool->chunk_ptr = NULL;
+    pool->chunk_left = 0;
 }
 
 static inline void free_conversion_context(struct conversion_context *pool)
@@ -83,18 +89,36 @@ static inline void free_conversion_context(struct conversion_context *pool)
 
 static inline void *conversion_context_alloc(struct conversion_context *pool, size_t size)
 {
+    size_t aligned_size = (size + sizeof(UINT64) - 1) & ~(sizeof(UINT64) - 1);
+
     if (pool->used + size <= sizeof(pool->buffer))
     {
         void *ret = pool->buffer + pool->used;
-        pool->used += (size + sizeof(UINT64) - 1) & ~(sizeof(UINT64) - 1);
+        pool->used += aligned_size;
+        return ret;
+    }
+    else if (aligned_size <= pool->chunk_left)
+    {
+        void *ret = pool->chunk_ptr;
+        pool->chunk_ptr += aligned_size;
+        pool->chunk_left -= aligned_size;
         return ret;
     }
     else
     {
+        /* Carve small allocations out of larger chunks, so that big
+         * structure arrays don't cost one heap allocation per element. */
+        size_t alloc_size = max(aligned_size, CONVERSION_CONTEXT_CHUNK_SIZE);
         struct list *entry;
-        if (!(entry = malloc(sizeof(*entry) + size)))
+
+        if (!(entry = malloc(sizeof(*entry) + alloc_size)))
             return NULL;
         list_add_tail(&pool->alloc_entries, entry);
+        if (alloc_size > aligned_size)
+        {
+            pool->chunk_ptr = (char *)(entry + 1) + aligned_size;
+            pool->chunk_left = alloc_size - aligned_size;
+        }
         return entry + 1;
     }
 }
@@ -407,7 +407,17 @@ static BOOL wayland_window_surface_flush(struct window_surface *window_surface,
         goto done;
     }
 
-    if ((latest_buffer = get_window_surface_contents(window_surface->hwnd)))
+    /* When the flush covers the whole buffer, which is the common case for
+     * fullscreen applications, all the pixel data come from the window_surface
+     * and there is no need to look at the latest buffer. */
+    if (rect->left + dirty->left <= 0 && rect->top + dirty->top <= 0 &&
+        rect->left + dirty->right >= shm_buffer->width &&
+        rect->top + dirty->bottom >= shm_buffer->height)
+    {
+        TRACE("full buffer flush\n");
+        copy_from_window_region = surface_damage_region;
+    }
+    else if ((latest_buffer = get_window_surface_contents(window_surface->hwnd)))
     {
         TRACE("latest_window_buffer=%p\n", latest_buffer);
         /* If we have a latest buffer, use it as the source of all pixel
@@ -1790,12 +1790,6 @@ static BOOL X11DRV_CLIPBOARD_GetProperty(Display *display, Window w, Atom prop,
 }
 
 
-struct clipboard_data_packet {
-    struct list entry;
-    unsigned long size;
-    unsigned char *data;
-};
-
 /**************************************************************************
  *		read_property
  *
@@ -1817,32 +1811,29 @@ static BOOL read_property( Display *display, Window w, Atom prop,
 
     if (*type == x11drv_atom(INCR))
     {
-        unsigned char *buf;
-        unsigned long bufsize = 0;
-        struct list packets;
-        struct clipboard_data_packet *packet, *packet2;
+        unsigned char *buf = NULL, *new_buf;
+        size_t bufsize = 0, capacity = 0;
         BOOL res;
 
         free( *data );
         *data = NULL;
 
-        list_init(&packets);
-
         for (;;)
         {
             int i;
             unsigned char *prop_data;
             size_t prop_size;
 
-            /* Wait until PropertyNotify is received */
+            /* Wait until PropertyNotify is received. Only sleep when the queue is
+             * empty, deleting the previous chunk queues a notification of its own. */
             for (i = 0; i < SELECTION_RETRIES; i++)
             {
                 Bool res;
 
-                res = XCheckTypedWindowEvent(display, w, PropertyNotify, &xe);
-                if (res && xe.xproperty.atom == prop &&
-                    xe.xproperty.state == PropertyNewValue)
-                    break;
+                while ((res = XCheckTypedWindowEvent(display, w, PropertyNotify, &xe)))
+                    if (xe.xproperty.atom == prop && xe.xproperty.state == PropertyNewValue)
+                        break;
+                if (res) break;
                 selection_sleep();
             }
 
@@ -1861,44 +1852,32 @@ static BOOL read_property( Display *display, Window w, Atom prop,
                 break;
             }
 
-            packet = malloc( sizeof(*packet) );
-            if (!packet)
-            {
-                free( prop_data );
-                res = FALSE;
-                break;
-            }
-
-            packet->size = prop_size;
-            packet->data = prop_data;
-            list_add_tail(&packets, &packet->entry);
-            bufsize += prop_size;
-        }
-
-        if (res)
-        {
-            buf = malloc( bufsize + 1 );
-            if (buf)
+            /* append the chunk directly, growing the buffer geometrically */
+            if (bufsize + prop_size + 1 > capacity)
             {
-                unsigned long bytes_copied = 0;
-                *datasize = bufsize;
-                LIST_FOR_EACH_ENTRY( packet, &packets, struct clipboard_data_packet, entry)
+                size_t new_capacity = max( capacity * 2, bufsize + prop_size + 1 );
+                if (!(new_buf = realloc( buf, new_capacity )))
                 {
-                    memcpy(&buf[bytes_copied], packet->data, packet->size);
-                    bytes_copied += packet->size;
+                    free( prop_data );
+                    res = FALSE;
+                    break;
                 }
-                buf[bufsize] = 0;
-                *data = buf;
+                buf = new_buf;
+                capacity = new_capacity;
             }
-            else
-                res = FALSE;
+            memcpy( buf + bufsize, prop_data, prop_size );
+            bufsize += prop_size;
+            free( prop_data );
         }
 
-        LIST_FOR_EACH_ENTRY_SAFE( packet, packet2, &packets, struct clipboard_data_packet, entry)
+        if (res && !buf && !(buf = malloc( 1 ))) res = FALSE;
+        if (res)
         {
-            free( packet->data );
-            free( packet );
+            buf[bufsize] = 0;
+            *datasize = bufsize;
+            *data = buf;
         }
+        else free( buf );
 
         return res;
     }
@@ -1308,7 +1308,7 @@ static BOOL xrenderdrv_ExtTextOut( PHYSDEV dev, INT x, INT y, UINT flags,
     struct xrender_physdev *physdev = get_xrender_dev( dev );
     gsCacheEntry *entry;
     gsCacheEntryFormat *formatEntry;
-    unsigned int idx;
+    unsigned int idx, nelts = 0;
     DWORD text_color;
     Picture pict, tile_pict = 0;
     XGlyphElt16 *elts;
@@ -1392,14 +1392,22 @@ static BOOL xrenderdrv_ExtTextOut( PHYSDEV dev, INT x, INT y, UINT flags,
     reset_bounds( &bounds );
     for(idx = 0; idx < count; idx++)
     {
-        elts[idx].glyphset = formatEntry->glyphset;
-        elts[idx].chars = wstr + idx;
-        elts[idx].nchars = 1;
-        elts[idx].xOff = desired.x - current.x;
-        elts[idx].yOff = desired.y - current.y;
+        /* Glyphs that start where the previous one ended share its element,
+         * which keeps the request much smaller for runs of regular text. */
+        if(nelts && desired.x == current.x && desired.y == current.y)
+            elts[nelts - 1].nchars++;
+        else
+        {
+            elts[nelts].glyphset = formatEntry->glyphset;
+            elts[nelts].chars = wstr + idx;
+            elts[nelts].nchars = 1;
+            elts[nelts].xOff = desired.x - current.x;
+            elts[nelts].yOff = desired.y - current.y;
+            nelts++;
+        }
 
-        current.x += (elts[idx].xOff + formatEntry->gis[wstr[idx]].xOff);
-        current.y += (elts[idx].yOff + formatEntry->gis[wstr[idx]].yOff);
+        current.x = desired.x + formatEntry->gis[wstr[idx]].xOff;
+        current.y = desired.y + formatEntry->gis[wstr[idx]].yOff;
 
         rect.left   = desired.x - physdev->x11dev->dc_rect.left - formatEntry->gis[wstr[idx]].x;
         rect.top    = desired.y - physdev->x11dev->dc_rect.top - formatEntry->gis[wstr[idx]].y;
@@ -1432,7 +1440,7 @@ static BOOL xrenderdrv_ExtTextOut( PHYSDEV dev, INT x, INT y, UINT flags,
                             tile_pict,
                             pict,
                             formatEntry->font_format,
-                            0, 0, 0, 0, elts, count);
+                            0, 0, 0, 0, elts, nelts);
     free( elts );
 
     pthread_mutex_unlock( &xrender_mutex );
@@ -1929,36 +1929,50 @@ static DWORD refill_buffer( struct request *request, BOOL notify )
     return ERROR_SUCCESS;
 }
 
+static BOOL keep_connection_alive( struct request *request )
+{
+    WCHAR connection[20];
+    DWORD size = sizeof(connection);
+
+    if (request->netconn->socket == -1) return FALSE;
+    if (request->hdr.disable_flags & WINHTTP_DISABLE_KEEP_ALIVE) return FALSE;
+    if (!query_headers( request, WINHTTP_QUERY_CONNECTION, NULL, connection, &size, NULL ) ||
+        !query_headers( request, WINHTTP_QUERY_PROXY_CONNECTION, NULL, connection, &size, NULL ))
+    {
+        if (!wcsicmp( connection, L"close" )) return FALSE;
+    }
+    else if (!wcscmp( request->version, L"HTTP/1.0" )) return FALSE;
+
+    size = sizeof(connection);
+    if ((!query_headers( request, WINHTTP_QUERY_CONNECTION | WINHTTP_QUERY_FLAG_REQUEST_HEADERS, NULL, connection, &size, NULL )
+         || !query_headers( request, WINHTTP_QUERY_PROXY_CONNECTION | WINHTTP_QUERY_FLAG_REQUEST_HEADERS, NULL, connection, &size, NULL ))
+        && !wcsicmp( connection, L"close" )) return FALSE;
+
+    return TRUE;
+}
+
 static void finished_reading( struct request *request )
 {
-    BOOL close = FALSE, close_request_headers;
+    BOOL close_request_headers;
     WCHAR connection[20];
     DWORD size = sizeof(connection);
 
     if (!request->netconn) return;
 
-    if (request->netconn->socket == -1) close = TRUE;
-    else if (request->hdr.disable_flags & WINHTTP_DISABLE_KEEP_ALIVE) close = TRUE;
-    else if (!query_headers( request, WINHTTP_QUERY_CONNECTION, NULL, connection, &size, NULL ) ||
-             !query_headers( request, WINHTTP_QUERY_PROXY_CONNECTION, NULL, connection, &size, NULL ))
+    if (keep_connection_alive( request ))
     {
-        if (!wcsicmp( connection, L"close" )) close = TRUE;
+        cache_connection( request->netconn );
+        request->netconn = NULL;
+        return;
     }
-    else if (!wcscmp( request->version, L"HTTP/1.0" )) close = TRUE;
 
-    size = sizeof(connection);
     close_request_headers =
             (!query_headers( request, WINHTTP_QUERY_CONNECTION | WINHTTP_QUERY_FLAG_REQUEST_HEADERS, NULL, connection, &size, NULL )
              || !query_headers( request, WINHTTP_QUERY_PROXY_CONNECTION | WINHTTP_QUERY_FLAG_REQUEST_HEADERS, NULL, connection, &size, NULL ))
              && !wcsicmp( connection, L"close" );
-    if (close || close_request_headers)
-    {
-        if (close_request_headers) send_callback( &request->hdr, WINHTTP_CALLBACK_STATUS_CLOSING_CONNECTION, 0, 0 );
-        netconn_release( request->netconn );
-        if (close_request_headers) send_callback( &request->hdr, WINHTTP_CALLBACK_STATUS_CONNECTION_CLOSED, 0, 0 );
-    }
-    else
-        cache_connection( request->netconn );
+    if (close_request_headers) send_callback( &request->hdr, WINHTTP_CALLBACK_STATUS_CLOSING_CONNECTION, 0, 0 );
+    netconn_release( request->netconn );
+    if (close_request_headers) send_callback( &request->hdr, WINHTTP_CALLBACK_STATUS_CONNECTION_CLOSED, 0, 0 );
     request->netconn = NULL;
 }
 
@@ -3028,7 +3042,18 @@ static DWORD receive_response( struct request *request )
 
         if (handle_authorization( request, status )) goto done;
     }
-    else goto done;
+    else
+    {
+        /* a response without a body doesn't need the connection any more, hand it back to the pool
+         * right away instead of waiting for the application to read the (empty) body */
+        if (status != HTTP_STATUS_SWITCH_PROTOCOLS && request->netconn && end_of_read_data( request ) &&
+            keep_connection_alive( request ))
+        {
+            cache_connection( request->netconn );
+            request->netconn = NULL;
+        }
+        goto done;
+    }
 
     request->state = REQUEST_RESPONSE_RECURSIVE_REQUEST;
     return async_mode ? queue_receive_response( request ) : receive_response( request );
@@ -2202,6 +2202,9 @@ static BOOL urlcache_entry_delete(const cache_container *pContainer,
     return TRUE;
 }
 
+/* number of kept entries FreeUrlCacheSpaceW walks before releasing the index lock */
+#define FREE_CACHE_YIELD_INTERVAL 256
+
 static HANDLE free_cache_running;
 static HANDLE dll_unload_event;
 static DWORD WINAPI handle_full_cache_worker(void *param)
@@ -2389,7 +2392,7 @@ BOOL WINAPI FreeUrlCacheSpaceW(LPCWSTR cache_path, DWORD size, DWORD filter)
         entry_url *url_entry;
         ULONGLONG desired_size, cur_size;
         DWORD delete_factor, hash_table_off, hash_table_entry;
-        DWORD rate[100], rate_no;
+        DWORD rate[100], rate_no, skipped = 0;
         FILETIME cur_time;
 
         if((path_len || container->cache_prefix[0]!=0) &&
@@ -2466,16 +2469,20 @@ BOOL WINAPI FreeUrlCacheSpaceW(LPCWSTR cache_path, DWORD size, DWORD filter)
 
                 if(header->cache_usage.QuadPart+header->exempt_usage.QuadPart <= desired_size)
                     break;
+            } else if(++skipped < FREE_CACHE_YIELD_INTERVAL) {
+                continue;
+            }
 
-                /* Allow other threads to use cache while cleaning */
-                cache_container_unlock_index(container, header);
-                if(WaitForSingleObject(dll_unload_event, 0) == WAIT_OBJECT_0) {
-                    TRACE("got dll_unload_event - finishing\n");
-                    return TRUE;
-                }
-                Sleep(0);
-                header = cache_container_lock_index(container);
+            /* Allow other threads to use cache while cleaning, also when walking
+             * long runs of entries that are kept so that lookups don't stall */
+            skipped = 0;
+            cache_container_unlock_index(container, header);
+            if(WaitForSingleObject(dll_unload_event, 0) == WAIT_OBJECT_0) {
+                TRACE("got dll_unload_event - finishing\n");
+                return TRUE;
             }
+            Sleep(0);
+            header = cache_container_lock_index(container);
         }
 
         TRACE("cache size after cleaning 0x%s/0x%s\n",
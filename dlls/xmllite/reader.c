@@ -977,6 +977,16 @@ static void readerinput_shrinkraw(xmlreaderinput *readerinput, int len)
     buffer->cur = 0;
 }
 
+/* drops 'len' bytes of raw data following current position, incomplete code unit is kept */
+static void readerinput_consumeraw(xmlreaderinput *readerinput, int len)
+{
+    encoded_buffer *buffer = &readerinput->buffer->encoded;
+
+    buffer->written -= buffer->cur + len;
+    memmove(buffer->data, buffer->data + buffer->cur + len, buffer->written);
+    buffer->cur = 0;
+}
+
 static void fixup_buffer_cr(encoded_buffer *buffer, int off)
 {
     BOOL prev_cr = buffer->prev_cr;
@@ -984,6 +994,15 @@ static void fixup_buffer_cr(encoded_buffer *buffer, int off)
     WCHAR *dest;
 
     src = dest = (WCHAR*)buffer->data + off;
+
+    /* nothing needs to be moved until the first CR */
+    if (!prev_cr)
+    {
+        while ((const char*)src < buffer->data + buffer->written && *src != '\r')
+            src++;
+        dest = (WCHAR*)src;
+    }
+
     while ((const char*)src < buffer->data + buffer->written)
     {
         if (*src == '\r')
@@ -1026,9 +1045,11 @@ static void readerinput_switchencoding(xmlreaderinput *readerinput, xml_encoding
     /* just copy in this case */
     if (enc == XmlEncoding_UTF16)
     {
-        readerinput_grow(readerinput, len);
+        len &= ~1;
+        readerinput_grow(readerinput, len / sizeof(WCHAR));
         memcpy(dest->data, src->data + src->cur, len);
         dest->written += len;
+        readerinput_consumeraw(readerinput, len);
     }
     else
     {
@@ -1080,9 +1101,11 @@ static HRESULT reader_more(xmlreader *reader)
     /* just copy for UTF-16 case */
     if (cp == 1200)
     {
-        readerinput_grow(readerinput, len);
+        len &= ~1;
+        readerinput_grow(readerinput, len / sizeof(WCHAR));
         memcpy(dest->data + dest->written, src->data + src->cur, len);
         dest->written += len;
+        readerinput_consumeraw(readerinput, len);
     }
     else
     {
@@ -1160,13 +1183,17 @@ static void reader_skipn(xmlreader *reader, int n)
 /* [3] S ::= (#x20 | #x9 | #xD | #xA)+ */
 static int reader_skipspaces(xmlreader *reader)
 {
+    encoded_buffer *buffer = &reader->input->buffer->utf16;
     const WCHAR *ptr = reader_get_ptr(reader);
     UINT start = reader_get_cur(reader);
 
     while (is_wchar_space(*ptr))
     {
-        reader_skipn(reader, 1);
-        ptr = reader_get_ptr(reader);
+        reader_update_position(reader, *ptr);
+        buffer->cur++;
+        /* more data is only needed at the end of what's been converted so far */
+        if (!*++ptr)
+            ptr = reader_get_ptr(reader);
     }
 
     return reader_get_cur(reader) - start;
@@ -2465,10 +2492,13 @@ static HRESULT reader_parse_chardata(xmlreader *reader)
         /* this covers a case when text has leading whitespace chars */
         if (!is_wchar_space(*ptr)) reader->nodetype = XmlNodeType_Text;
 
-        if (!reader_cmp(reader, L"&"))
+        if (*ptr == '&')
             reader_parse_reference(reader);
         else
-            reader_skipn(reader, 1);
+        {
+            reader_update_position(reader, *ptr);
+            reader->input->buffer->utf16.cur++;
+        }
 
         ptr = reader_get_ptr(reader);
     }
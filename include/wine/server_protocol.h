@@ -878,6 +878,15 @@ struct cursor_pos
     lparam_t info;
 };
 
+struct completion_msg
+{
+    apc_param_t   ckey;
+    apc_param_t   cvalue;
+    apc_param_t   information;
+    unsigned int  status;
+    int           __pad;
+};
+
 struct directory_entry
 {
     data_size_t name_len;
@@ -1040,6 +1049,8 @@ typedef volatile struct
 {
     struct obj_locator   class;
     unsigned int         dpi_context;
+    unsigned int         style;
+    unsigned int         ex_style;
 } window_shm_t;
 
 typedef volatile union
@@ -5527,6 +5538,7 @@ struct remove_completion_reply
     apc_param_t   information;
     unsigned int  status;
     obj_handle_t  wait_handle;
+    /* VARARG(msgs,completion_msgs); */
 };
 
 
@@ -7093,6 +7105,6 @@ union generic_reply
     struct d3dkmt_mutex_release_reply d3dkmt_mutex_release_reply;
 };
 
-#define SERVER_PROTOCOL_VERSION 930
+#define SERVER_PROTOCOL_VERSION 932
 
 #endif /* __WINE_WINE_SERVER_PROTOCOL_H */
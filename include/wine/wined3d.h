@@ -2920,6 +2920,7 @@ HRESULT __cdecl wined3d_swapchain_resize_buffers(struct wined3d_swapchain *swapc
 HRESULT __cdecl wined3d_swapchain_set_gamma_ramp(const struct wined3d_swapchain *swapchain,
         uint32_t flags, const struct wined3d_gamma_ramp *ramp);
 void __cdecl wined3d_swapchain_set_palette(struct wined3d_swapchain *swapchain, struct wined3d_palette *palette);
+void __cdecl wined3d_swapchain_set_present_semaphore(struct wined3d_swapchain *swapchain, HANDLE semaphore);
 void __cdecl wined3d_swapchain_set_window(struct wined3d_swapchain *swapchain, HWND window);
 
 HRESULT __cdecl wined3d_swapchain_state_create(const struct wined3d_swapchain_desc *desc,
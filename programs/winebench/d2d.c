@@ -0,0 +1,266 @@
+/*
+ * Direct2D rendering benchmarks
+ *
+ * Copyright 2026 the Wine project
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#define COBJMACROS
+#include <stdlib.h>
+#include <string.h>
+
+#include <windows.h>
+#include <winternl.h>
+#include "initguid.h"
+#include "d2d1.h"
+#include "wincodec.h"
+
+#include "winebench.h"
+
+#define RECT_COUNT  1000
+#define PATH_COUNT  50
+#define CLIP_CELLS  16
+
+static struct
+{
+    BOOL com_initialized;
+    IWICImagingFactory *wic_factory;
+    IWICBitmap *bitmap;
+    ID2D1Factory *factory;
+    ID2D1RenderTarget *target;
+    ID2D1SolidColorBrush *brush;
+    ID2D1LinearGradientBrush *gradient;
+    ID2D1PathGeometry *paths[PATH_COUNT];
+} d2d;
+
+static D2D1_COLOR_F random_color(unsigned int *seed, float alpha)
+{
+    D2D1_COLOR_F color;
+
+    color.r = (bench_rand(seed) & 0xff) / 255.0f;
+    color.g = (bench_rand(seed) & 0xff) / 255.0f;
+    color.b = (bench_rand(seed) & 0xff) / 255.0f;
+    color.a = alpha;
+    return color;
+}
+
+static BOOL d2d_setup(void)
+{
+    static const D2D1_COLOR_F black = {0.0f, 0.0f, 0.0f, 1.0f};
+    D2D1_RENDER_TARGET_PROPERTIES desc;
+
+    if (FAILED(CoInitializeEx(NULL, COINIT_MULTITHREADED))) return FALSE;
+    d2d.com_initialized = TRUE;
+    if (FAILED(CoCreateInstance(&CLSID_WICImagingFactory, NULL, CLSCTX_INPROC_SERVER,
+                                &IID_IWICImagingFactory, (void **)&d2d.wic_factory)))
+        return FALSE;
+    if (FAILED(IWICImagingFactory_CreateBitmap(d2d.wic_factory, FRAME_WIDTH, FRAME_HEIGHT,
+                                               &GUID_WICPixelFormat32bppPBGRA, WICBitmapCacheOnDemand,
+                                               &d2d.bitmap)))
+        return FALSE;
+    if (FAILED(D2D1CreateFactory(D2D1_FACTORY_TYPE_SINGLE_THREADED, &IID_ID2D1Factory, NULL,
+                                 (void **)&d2d.factory)))
+        return FALSE;
+
+    desc.type = D2D1_RENDER_TARGET_TYPE_DEFAULT;
+    desc.pixelFormat.format = DXGI_FORMAT_B8G8R8A8_UNORM;
+    desc.pixelFormat.alphaMode = D2D1_ALPHA_MODE_PREMULTIPLIED;
+    desc.dpiX = 96.0f;
+    desc.dpiY = 96.0f;
+    desc.usage = D2D1_RENDER_TARGET_USAGE_NONE;
+    desc.minLevel = D2D1_FEATURE_LEVEL_DEFAULT;
+    if (FAILED(ID2D1Factory_CreateWicBitmapRenderTarget(d2d.factory, d2d.bitmap, &desc, &d2d.target)))
+        return FALSE;
+    return SUCCEEDED(ID2D1RenderTarget_CreateSolidColorBrush(d2d.target, &black, NULL, &d2d.brush));
+}
+
+static void d2d_cleanup(void)
+{
+    unsigned int i;
+
+    for (i = 0; i < PATH_COUNT; i++)
+        if (d2d.paths[i]) ID2D1PathGeometry_Release(d2d.paths[i]);
+    if (d2d.gradient) ID2D1LinearGradientBrush_Release(d2d.gradient);
+    if (d2d.brush) ID2D1SolidColorBrush_Release(d2d.brush);
+    if (d2d.target) ID2D1RenderTarget_Release(d2d.target);
+    if (d2d.factory) ID2D1Factory_Release(d2d.factory);
+    if (d2d.bitmap) IWICBitmap_Release(d2d.bitmap);
+    if (d2d.wic_factory) IWICImagingFactory_Release(d2d.wic_factory);
+    if (d2d.com_initialized) CoUninitialize();
+    memset(&d2d, 0, sizeof(d2d));
+}
+
+static DWORD d2d_checksum(void)
+{
+    BYTE *bits;
+    DWORD crc = 0;
+
+    if (!(bits = malloc(FRAME_WIDTH * FRAME_HEIGHT * 4))) return 0;
+    if (SUCCEEDED(IWICBitmap_CopyPixels(d2d.bitmap, NULL, FRAME_WIDTH * 4, FRAME_WIDTH * FRAME_HEIGHT * 4, bits)))
+        crc = RtlComputeCrc32(0, bits, FRAME_WIDTH * FRAME_HEIGHT * 4);
+    free(bits);
+    return crc;
+}
+
+/* many small rectangles */
+
+static void fill_rects(void)
+{
+    static const D2D1_COLOR_F white = {1.0f, 1.0f, 1.0f, 1.0f};
+    unsigned int i, seed = 1;
+    D2D1_COLOR_F color;
+    D2D1_RECT_F rect;
+
+    ID2D1RenderTarget_Clear(d2d.target, &white);
+    for (i = 0; i < RECT_COUNT; i++)
+    {
+        rect.left = bench_rand(&seed) % (FRAME_WIDTH - 16);
+        rect.top = bench_rand(&seed) % (FRAME_HEIGHT - 16);
+        rect.right = rect.left + 16.0f;
+        rect.bottom = rect.top + 16.0f;
+        color = random_color(&seed, 1.0f);
+        ID2D1SolidColorBrush_SetColor(d2d.brush, &color);
+        ID2D1RenderTarget_FillRectangle(d2d.target, &rect, (ID2D1Brush *)d2d.brush);
+    }
+}
+
+static void d2d_rects_run(ULONG64 count)
+{
+    while (count--)
+    {
+        ID2D1RenderTarget_BeginDraw(d2d.target);
+        fill_rects();
+        ID2D1RenderTarget_EndDraw(d2d.target, NULL, NULL);
+    }
+}
+
+/* antialiased bezier shapes over a gradient background */
+
+static BOOL d2d_path_setup(void)
+{
+    static const D2D1_GRADIENT_STOP stops[] =
+    {
+        {0.0f, {0.125f, 0.25f, 0.5f, 1.0f}},
+        {1.0f, {0.94f, 0.88f, 0.75f, 1.0f}},
+    };
+    D2D1_LINEAR_GRADIENT_BRUSH_PROPERTIES desc = {{0.0f, 0.0f}, {0.0f, FRAME_HEIGHT}};
+    ID2D1GradientStopCollection *collection;
+    ID2D1GeometrySink *sink;
+    D2D1_BEZIER_SEGMENT bezier;
+    D2D1_POINT_2F start;
+    unsigned int i, seed = 1;
+    HRESULT hr;
+
+    if (!d2d_setup()) return FALSE;
+    if (FAILED(ID2D1RenderTarget_CreateGradientStopCollection(d2d.target, stops, ARRAY_SIZE(stops),
+                                                              D2D1_GAMMA_2_2, D2D1_EXTEND_MODE_CLAMP,
+                                                              &collection)))
+        return FALSE;
+    hr = ID2D1RenderTarget_CreateLinearGradientBrush(d2d.target, &desc, NULL, collection, &d2d.gradient);
+    ID2D1GradientStopCollection_Release(collection);
+    if (FAILED(hr)) return FALSE;
+
+    /* the geometries are created once, the benchmark measures filling them */
+    for (i = 0; i < PATH_COUNT; i++)
+    {
+        if (FAILED(ID2D1Factory_CreatePathGeometry(d2d.factory, &d2d.paths[i]))) return FALSE;
+        if (FAILED(ID2D1PathGeometry_Open(d2d.paths[i], &sink))) return FALSE;
+        start.x = bench_rand(&seed) % FRAME_WIDTH;
+        start.y = bench_rand(&seed) % FRAME_HEIGHT;
+        bezier.point1.x = bench_rand(&seed) % FRAME_WIDTH;
+        bezier.point1.y = bench_rand(&seed) % FRAME_HEIGHT;
+        bezier.point2.x = bench_rand(&seed) % FRAME_WIDTH;
+        bezier.point2.y = bench_rand(&seed) % FRAME_HEIGHT;
+        bezier.point3.x = bench_rand(&seed) % FRAME_WIDTH;
+        bezier.point3.y = bench_rand(&seed) % FRAME_HEIGHT;
+        ID2D1GeometrySink_BeginFigure(sink, start, D2D1_FIGURE_BEGIN_FILLED);
+        ID2D1GeometrySink_AddBezier(sink, &bezier);
+        ID2D1GeometrySink_EndFigure(sink, D2D1_FIGURE_END_CLOSED);
+        hr = ID2D1GeometrySink_Close(sink);
+        ID2D1GeometrySink_Release(sink);
+        if (FAILED(hr)) return FALSE;
+    }
+    return TRUE;
+}
+
+static void d2d_path_run(ULONG64 count)
+{
+    static const D2D1_RECT_F frame = {0.0f, 0.0f, FRAME_WIDTH, FRAME_HEIGHT};
+    unsigned int i, seed;
+    D2D1_COLOR_F color;
+
+    while (count--)
+    {
+        seed = 1;
+        ID2D1RenderTarget_BeginDraw(d2d.target);
+        ID2D1RenderTarget_FillRectangle(d2d.target, &frame, (ID2D1Brush *)d2d.gradient);
+        for (i = 0; i < PATH_COUNT; i++)
+        {
+            color = random_color(&seed, 0.75f);
+            ID2D1SolidColorBrush_SetColor(d2d.brush, &color);
+            ID2D1RenderTarget_FillGeometry(d2d.target, (ID2D1Geometry *)d2d.paths[i],
+                                           (ID2D1Brush *)d2d.brush, NULL);
+        }
+        ID2D1RenderTarget_EndDraw(d2d.target, NULL, NULL);
+    }
+}
+
+/* full-frame fills through many axis-aligned clips */
+
+static void d2d_clip_run(ULONG64 count)
+{
+    static const D2D1_COLOR_F white = {1.0f, 1.0f, 1.0f, 1.0f};
+    static const D2D1_RECT_F frame = {0.0f, 0.0f, FRAME_WIDTH, FRAME_HEIGHT};
+    float w = FRAME_WIDTH / CLIP_CELLS, h = FRAME_HEIGHT / CLIP_CELLS;
+    unsigned int seed;
+    D2D1_COLOR_F color;
+    D2D1_RECT_F clip;
+    int x, y;
+
+    while (count--)
+    {
+        seed = 1;
+        ID2D1RenderTarget_BeginDraw(d2d.target);
+        ID2D1RenderTarget_Clear(d2d.target, &white);
+        for (y = 0; y < CLIP_CELLS; y++)
+        {
+            for (x = y & 1; x < CLIP_CELLS; x += 2)
+            {
+                clip.left = x * w;
+                clip.top = y * h;
+                clip.right = clip.left + w;
+                clip.bottom = clip.top + h;
+                color = random_color(&seed, 1.0f);
+                ID2D1SolidColorBrush_SetColor(d2d.brush, &color);
+                ID2D1RenderTarget_PushAxisAlignedClip(d2d.target, &clip, D2D1_ANTIALIAS_MODE_ALIASED);
+                ID2D1RenderTarget_FillRectangle(d2d.target, &frame, (ID2D1Brush *)d2d.brush);
+                ID2D1RenderTarget_PopAxisAlignedClip(d2d.target);
+            }
+        }
+        ID2D1RenderTarget_EndDraw(d2d.target, NULL, NULL);
+    }
+}
+
+const struct benchmark d2d_benchmarks[] =
+{
+    { L"d2d_rects", "Direct2D: 16x16 solid rectangle fills", d2d_setup, d2d_rects_run, d2d_cleanup,
+      RECT_COUNT + 1, d2d_checksum },
+    { L"d2d_path", "Direct2D: antialiased bezier geometries over a linear gradient", d2d_path_setup,
+      d2d_path_run, d2d_cleanup, PATH_COUNT + 1, d2d_checksum },
+    { L"d2d_clip", "Direct2D: full-frame fills through checkerboard axis-aligned clips", d2d_setup,
+      d2d_clip_run, d2d_cleanup, CLIP_CELLS * CLIP_CELLS / 2 + 1, d2d_checksum },
+    { NULL }
+};
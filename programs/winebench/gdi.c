@@ -0,0 +1,282 @@
+/*
+ * GDI rendering benchmarks
+ *
+ * Copyright 2026 the Wine project
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#include <windows.h>
+#include <winternl.h>
+
+#include "winebench.h"
+
+#define RECT_COUNT  1000
+#define TEXT_LINES  40
+#define PATH_COUNT  50
+#define CLIP_CELLS  16    /* clip region is a CLIP_CELLS x CLIP_CELLS checkerboard */
+#define SOURCE_SIZE 256
+
+static const WCHAR text_line[] =
+    L"The quick brown fox jumps over the lazy dog. 0123456789 !\"#$%&'()*+,-./:;<=>?@[\\]^_`{|}~";
+
+static struct
+{
+    HDC dc;
+    HBITMAP bitmap, old_bitmap;
+    DWORD *bits;
+    HDC src_dc;
+    HBITMAP src_bitmap, old_src_bitmap;
+    HFONT font, old_font;
+    HRGN clip;
+} gdi;
+
+static HBITMAP create_dib(HDC dc, int width, int height, DWORD **bits)
+{
+    BITMAPINFO info = {{0}};
+
+    info.bmiHeader.biSize = sizeof(info.bmiHeader);
+    info.bmiHeader.biWidth = width;
+    info.bmiHeader.biHeight = -height;
+    info.bmiHeader.biPlanes = 1;
+    info.bmiHeader.biBitCount = 32;
+    info.bmiHeader.biCompression = BI_RGB;
+    return CreateDIBSection(dc, &info, DIB_RGB_COLORS, (void **)bits, NULL, 0);
+}
+
+static BOOL gdi_setup(void)
+{
+    if (!(gdi.dc = CreateCompatibleDC(0))) return FALSE;
+    if (!(gdi.bitmap = create_dib(gdi.dc, FRAME_WIDTH, FRAME_HEIGHT, &gdi.bits))) return FALSE;
+    gdi.old_bitmap = SelectObject(gdi.dc, gdi.bitmap);
+    SelectObject(gdi.dc, GetStockObject(DC_BRUSH));
+    SelectObject(gdi.dc, GetStockObject(NULL_PEN));
+    return TRUE;
+}
+
+static void gdi_cleanup(void)
+{
+    if (gdi.bitmap)
+    {
+        SelectObject(gdi.dc, gdi.old_bitmap);
+        DeleteObject(gdi.bitmap);
+        gdi.bitmap = NULL;
+    }
+    DeleteDC(gdi.dc);
+}
+
+static DWORD gdi_checksum(void)
+{
+    GdiFlush();
+    return RtlComputeCrc32(0, (const BYTE *)gdi.bits, FRAME_WIDTH * FRAME_HEIGHT * 4);
+}
+
+static COLORREF random_color(unsigned int *seed)
+{
+    BYTE r = bench_rand(seed), g = bench_rand(seed), b = bench_rand(seed);
+
+    return RGB(r, g, b);
+}
+
+static void gdi_clear(void)
+{
+    SetDCBrushColor(gdi.dc, RGB(255, 255, 255));
+    PatBlt(gdi.dc, 0, 0, FRAME_WIDTH, FRAME_HEIGHT, PATCOPY);
+}
+
+/* many small rectangles */
+
+static void gdi_rects_run(ULONG64 count)
+{
+    unsigned int i, seed;
+    int x, y;
+
+    while (count--)
+    {
+        seed = 1;
+        gdi_clear();
+        for (i = 0; i < RECT_COUNT; i++)
+        {
+            x = bench_rand(&seed) % (FRAME_WIDTH - 16);
+            y = bench_rand(&seed) % (FRAME_HEIGHT - 16);
+            SetDCBrushColor(gdi.dc, random_color(&seed));
+            PatBlt(gdi.dc, x, y, 16, 16, PATCOPY);
+        }
+    }
+}
+
+/* a page of text */
+
+static BOOL gdi_text_setup(void)
+{
+    if (!gdi_setup()) return FALSE;
+    if (!(gdi.font = CreateFontW(-11, 0, 0, 0, FW_NORMAL, FALSE, FALSE, FALSE, DEFAULT_CHARSET,
+                                 OUT_DEFAULT_PRECIS, CLIP_DEFAULT_PRECIS, ANTIALIASED_QUALITY,
+                                 DEFAULT_PITCH, L"Tahoma")))
+        return FALSE;
+    gdi.old_font = SelectObject(gdi.dc, gdi.font);
+    SetBkMode(gdi.dc, TRANSPARENT);
+    return TRUE;
+}
+
+static void gdi_text_cleanup(void)
+{
+    if (gdi.font)
+    {
+        SelectObject(gdi.dc, gdi.old_font);
+        DeleteObject(gdi.font);
+        gdi.font = NULL;
+    }
+    gdi_cleanup();
+}
+
+static void gdi_text_run(ULONG64 count)
+{
+    unsigned int i;
+
+    while (count--)
+    {
+        gdi_clear();
+        for (i = 0; i < TEXT_LINES; i++)
+            ExtTextOutW(gdi.dc, 4, 4 + i * 12, 0, NULL, text_line, ARRAY_SIZE(text_line) - 1, NULL);
+    }
+}
+
+/* filled bezier shapes over a gradient background */
+
+static void gdi_path_run(ULONG64 count)
+{
+    static const GRADIENT_RECT gradient_rect = {0, 1};
+    TRIVERTEX vertices[2] =
+    {
+        {0, 0, 0x2000, 0x4000, 0x8000, 0},
+        {FRAME_WIDTH, FRAME_HEIGHT, 0xf000, 0xe000, 0xc000, 0},
+    };
+    unsigned int i, j, seed;
+    POINT points[7];
+
+    while (count--)
+    {
+        seed = 1;
+        GdiGradientFill(gdi.dc, vertices, 2, (void *)&gradient_rect, 1, GRADIENT_FILL_RECT_V);
+        for (i = 0; i < PATH_COUNT; i++)
+        {
+            for (j = 0; j < ARRAY_SIZE(points); j++)
+            {
+                points[j].x = bench_rand(&seed) % FRAME_WIDTH;
+                points[j].y = bench_rand(&seed) % FRAME_HEIGHT;
+            }
+            SetDCBrushColor(gdi.dc, random_color(&seed));
+            BeginPath(gdi.dc);
+            PolyBezier(gdi.dc, points, ARRAY_SIZE(points));
+            CloseFigure(gdi.dc);
+            EndPath(gdi.dc);
+            FillPath(gdi.dc);
+        }
+    }
+}
+
+/* image scaling */
+
+static BOOL gdi_stretch_setup(void)
+{
+    DWORD *bits;
+    int x, y;
+
+    if (!gdi_setup()) return FALSE;
+    if (!(gdi.src_dc = CreateCompatibleDC(gdi.dc))) return FALSE;
+    if (!(gdi.src_bitmap = create_dib(gdi.src_dc, SOURCE_SIZE, SOURCE_SIZE, &bits))) return FALSE;
+    gdi.old_src_bitmap = SelectObject(gdi.src_dc, gdi.src_bitmap);
+    for (y = 0; y < SOURCE_SIZE; y++)
+        for (x = 0; x < SOURCE_SIZE; x++)
+            bits[y * SOURCE_SIZE + x] = (x << 16) | (y << 8) | ((x ^ y) & 0xff);
+    SetStretchBltMode(gdi.dc, HALFTONE);
+    return TRUE;
+}
+
+static void gdi_stretch_cleanup(void)
+{
+    if (gdi.src_bitmap)
+    {
+        SelectObject(gdi.src_dc, gdi.old_src_bitmap);
+        DeleteObject(gdi.src_bitmap);
+        gdi.src_bitmap = NULL;
+    }
+    DeleteDC(gdi.src_dc);
+    gdi_cleanup();
+}
+
+static void gdi_stretch_run(ULONG64 count)
+{
+    while (count--)
+        StretchBlt(gdi.dc, 0, 0, FRAME_WIDTH, FRAME_HEIGHT, gdi.src_dc, 0, 0, SOURCE_SIZE, SOURCE_SIZE, SRCCOPY);
+}
+
+/* rectangles drawn through a complex clip region */
+
+static BOOL gdi_clip_setup(void)
+{
+    HRGN cell;
+    int x, y, w = FRAME_WIDTH / CLIP_CELLS, h = FRAME_HEIGHT / CLIP_CELLS;
+
+    if (!gdi_setup()) return FALSE;
+    if (!(gdi.clip = CreateRectRgn(0, 0, 0, 0))) return FALSE;
+    for (y = 0; y < CLIP_CELLS; y++)
+    {
+        for (x = y & 1; x < CLIP_CELLS; x += 2)
+        {
+            cell = CreateRectRgn(x * w, y * h, (x + 1) * w, (y + 1) * h);
+            CombineRgn(gdi.clip, gdi.clip, cell, RGN_OR);
+            DeleteObject(cell);
+        }
+    }
+    return TRUE;
+}
+
+static void gdi_clip_cleanup(void)
+{
+    if (gdi.clip)
+    {
+        DeleteObject(gdi.clip);
+        gdi.clip = NULL;
+    }
+    gdi_cleanup();
+}
+
+static void gdi_clip_run(ULONG64 count)
+{
+    while (count--)
+    {
+        SelectClipRgn(gdi.dc, NULL);
+        gdi_clear();
+        SelectClipRgn(gdi.dc, gdi.clip);
+        gdi_rects_run(1);
+    }
+}
+
+const struct benchmark gdi_benchmarks[] =
+{
+    { L"gdi_rects", "GDI: 16x16 PatBlt fills", gdi_setup, gdi_rects_run, gdi_cleanup,
+      RECT_COUNT + 1, gdi_checksum },
+    { L"gdi_text", "GDI: page of antialiased ExtTextOut lines", gdi_text_setup, gdi_text_run, gdi_text_cleanup,
+      TEXT_LINES + 1, gdi_checksum },
+    { L"gdi_path", "GDI: bezier FillPath shapes over a GradientFill", gdi_setup, gdi_path_run, gdi_cleanup,
+      PATH_COUNT + 1, gdi_checksum },
+    { L"gdi_stretch", "GDI: HALFTONE StretchBlt of a 256x256 image", gdi_stretch_setup, gdi_stretch_run,
+      gdi_stretch_cleanup, 1, gdi_checksum },
+    { L"gdi_clip", "GDI: PatBlt fills through a checkerboard clip region", gdi_clip_setup, gdi_clip_run,
+      gdi_clip_cleanup, RECT_COUNT + 2, gdi_checksum },
+    { NULL }
+};
@@ -0,0 +1,222 @@
+/*
+ * GDI+ rendering benchmarks
+ *
+ * Copyright 2026 the Wine project
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <windows.h>
+#include <winternl.h>
+#include "objbase.h"
+#include "gdiplus.h"
+
+#include "winebench.h"
+
+#define RECT_COUNT  1000
+#define TEXT_LINES  40
+#define PATH_COUNT  50
+#define SOURCE_SIZE 256
+
+static const WCHAR text_line[] =
+    L"The quick brown fox jumps over the lazy dog. 0123456789 !\"#$%&'()*+,-./:;<=>?@[\\]^_`{|}~";
+
+static struct
+{
+    ULONG_PTR token;
+    DWORD *bits;
+    GpBitmap *bitmap;
+    GpGraphics *graphics;
+    GpSolidFill *brush;
+    GpLineGradient *gradient;
+    GpPath *path;
+    GpFont *font;
+    GpBitmap *source;
+} gdip;
+
+static ARGB random_color(unsigned int *seed)
+{
+    BYTE r = bench_rand(seed), g = bench_rand(seed), b = bench_rand(seed);
+
+    return 0xff000000 | (r << 16) | (g << 8) | b;
+}
+
+static BOOL gdip_setup(void)
+{
+    struct GdiplusStartupInput input = {1};
+
+    if (GdiplusStartup(&gdip.token, &input, NULL) != Ok) return FALSE;
+    if (!(gdip.bits = malloc(FRAME_WIDTH * FRAME_HEIGHT * 4))) return FALSE;
+    if (GdipCreateBitmapFromScan0(FRAME_WIDTH, FRAME_HEIGHT, FRAME_WIDTH * 4, PixelFormat32bppPARGB,
+                                  (BYTE *)gdip.bits, &gdip.bitmap) != Ok)
+        return FALSE;
+    if (GdipGetImageGraphicsContext((GpImage *)gdip.bitmap, &gdip.graphics) != Ok) return FALSE;
+    return GdipCreateSolidFill(0xff000000, &gdip.brush) == Ok;
+}
+
+static void gdip_cleanup(void)
+{
+    if (gdip.source) GdipDisposeImage((GpImage *)gdip.source);
+    if (gdip.font) GdipDeleteFont(gdip.font);
+    if (gdip.path) GdipDeletePath(gdip.path);
+    if (gdip.gradient) GdipDeleteBrush((GpBrush *)gdip.gradient);
+    if (gdip.brush) GdipDeleteBrush((GpBrush *)gdip.brush);
+    if (gdip.graphics) GdipDeleteGraphics(gdip.graphics);
+    if (gdip.bitmap) GdipDisposeImage((GpImage *)gdip.bitmap);
+    free(gdip.bits);
+    if (gdip.token) GdiplusShutdown(gdip.token);
+    memset(&gdip, 0, sizeof(gdip));
+}
+
+static DWORD gdip_checksum(void)
+{
+    GdipFlush(gdip.graphics, FlushIntentionSync);
+    return RtlComputeCrc32(0, (const BYTE *)gdip.bits, FRAME_WIDTH * FRAME_HEIGHT * 4);
+}
+
+/* many small rectangles */
+
+static void gdip_rects_run(ULONG64 count)
+{
+    unsigned int i, seed;
+    int x, y;
+
+    while (count--)
+    {
+        seed = 1;
+        GdipGraphicsClear(gdip.graphics, 0xffffffff);
+        for (i = 0; i < RECT_COUNT; i++)
+        {
+            x = bench_rand(&seed) % (FRAME_WIDTH - 16);
+            y = bench_rand(&seed) % (FRAME_HEIGHT - 16);
+            GdipSetSolidFillColor(gdip.brush, random_color(&seed));
+            GdipFillRectangleI(gdip.graphics, (GpBrush *)gdip.brush, x, y, 16, 16);
+        }
+    }
+}
+
+/* a page of text */
+
+static BOOL gdip_text_setup(void)
+{
+    GpFontFamily *family;
+    GpStatus status;
+
+    if (!gdip_setup()) return FALSE;
+    if (GdipGetGenericFontFamilySansSerif(&family) != Ok) return FALSE;
+    status = GdipCreateFont(family, 11.0f, FontStyleRegular, UnitPixel, &gdip.font);
+    GdipDeleteFontFamily(family);
+    if (status != Ok) return FALSE;
+    GdipSetTextRenderingHint(gdip.graphics, TextRenderingHintAntiAlias);
+    GdipSetSolidFillColor(gdip.brush, 0xff000000);
+    return TRUE;
+}
+
+static void gdip_text_run(ULONG64 count)
+{
+    RectF rect = {4.0f, 0.0f, FRAME_WIDTH - 8.0f, 12.0f};
+    unsigned int i;
+
+    while (count--)
+    {
+        GdipGraphicsClear(gdip.graphics, 0xffffffff);
+        for (i = 0; i < TEXT_LINES; i++)
+        {
+            rect.Y = 4.0f + i * 12;
+            GdipDrawString(gdip.graphics, text_line, ARRAY_SIZE(text_line) - 1, gdip.font, &rect, NULL,
+                           (GpBrush *)gdip.brush);
+        }
+    }
+}
+
+/* antialiased bezier shapes over a gradient background */
+
+static BOOL gdip_path_setup(void)
+{
+    static const GpPoint start = {0, 0}, end = {0, FRAME_HEIGHT};
+
+    if (!gdip_setup()) return FALSE;
+    if (GdipCreateLineBrushI(&start, &end, 0xff204080, 0xfff0e0c0, WrapModeTileFlipXY, &gdip.gradient) != Ok)
+        return FALSE;
+    if (GdipCreatePath(FillModeAlternate, &gdip.path) != Ok) return FALSE;
+    GdipSetSmoothingMode(gdip.graphics, SmoothingModeAntiAlias);
+    return TRUE;
+}
+
+static void gdip_path_run(ULONG64 count)
+{
+    unsigned int i, j, seed;
+    INT coords[8];
+
+    while (count--)
+    {
+        seed = 1;
+        GdipFillRectangleI(gdip.graphics, (GpBrush *)gdip.gradient, 0, 0, FRAME_WIDTH, FRAME_HEIGHT);
+        for (i = 0; i < PATH_COUNT; i++)
+        {
+            GdipResetPath(gdip.path);
+            for (j = 0; j < ARRAY_SIZE(coords); j += 2)
+            {
+                coords[j] = bench_rand(&seed) % FRAME_WIDTH;
+                coords[j + 1] = bench_rand(&seed) % FRAME_HEIGHT;
+            }
+            GdipAddPathBezierI(gdip.path, coords[0], coords[1], coords[2], coords[3],
+                               coords[4], coords[5], coords[6], coords[7]);
+            GdipClosePathFigure(gdip.path);
+            GdipSetSolidFillColor(gdip.brush, (random_color(&seed) & 0x00ffffff) | 0xc0000000);
+            GdipFillPath(gdip.graphics, (GpBrush *)gdip.brush, gdip.path);
+        }
+    }
+}
+
+/* image scaling */
+
+static BOOL gdip_stretch_setup(void)
+{
+    static DWORD bits[SOURCE_SIZE * SOURCE_SIZE];
+    int x, y;
+
+    if (!gdip_setup()) return FALSE;
+    for (y = 0; y < SOURCE_SIZE; y++)
+        for (x = 0; x < SOURCE_SIZE; x++)
+            bits[y * SOURCE_SIZE + x] = 0xff000000 | (x << 16) | (y << 8) | ((x ^ y) & 0xff);
+    if (GdipCreateBitmapFromScan0(SOURCE_SIZE, SOURCE_SIZE, SOURCE_SIZE * 4, PixelFormat32bppARGB,
+                                  (BYTE *)bits, &gdip.source) != Ok)
+        return FALSE;
+    GdipSetInterpolationMode(gdip.graphics, InterpolationModeHighQualityBilinear);
+    return TRUE;
+}
+
+static void gdip_stretch_run(ULONG64 count)
+{
+    while (count--)
+        GdipDrawImageRectI(gdip.graphics, (GpImage *)gdip.source, 0, 0, FRAME_WIDTH, FRAME_HEIGHT);
+}
+
+const struct benchmark gdiplus_benchmarks[] =
+{
+    { L"gdip_rects", "GDI+: 16x16 solid rectangle fills", gdip_setup, gdip_rects_run, gdip_cleanup,
+      RECT_COUNT + 1, gdip_checksum },
+    { L"gdip_text", "GDI+: page of antialiased DrawString lines", gdip_text_setup, gdip_text_run, gdip_cleanup,
+      TEXT_LINES + 1, gdip_checksum },
+    { L"gdip_path", "GDI+: antialiased bezier paths over a linear gradient", gdip_path_setup, gdip_path_run,
+      gdip_cleanup, PATH_COUNT + 1, gdip_checksum },
+    { L"gdip_stretch", "GDI+: bilinear DrawImage of a 256x256 image", gdip_stretch_setup, gdip_stretch_run,
+      gdip_cleanup, 1, gdip_checksum },
+    { NULL }
+};
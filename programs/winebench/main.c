@@ -0,0 +1,493 @@
+/*
+ * Micro-benchmarks for server round-trips, system calls and rendering
+ *
+ * Copyright 2026 the Wine project
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "ntstatus.h"
+#define WIN32_NO_STATUS
+#include <windows.h>
+#include <winternl.h>
+
+#include "winebench.h"
+#include "wine/debug.h"
+
+WINE_DEFAULT_DEBUG_CHANNEL(winebench);
+
+#define MAX_SAMPLES 100
+
+static struct
+{
+    HANDLE event;
+    HANDLE ping, pong;
+    HANDLE mutex;
+    HANDLE file;
+    HANDLE thread;
+    DWORD thread_id;
+    HWND hwnd;
+    HKEY key;
+    volatile LONG stop;
+    WCHAR path[MAX_PATH];
+} ctx;
+
+static const WCHAR bench_keyW[] = L"Software\\Wine\\WineBench";
+
+/* events */
+
+static BOOL event_setup(void)
+{
+    return !!(ctx.event = CreateEventW(NULL, TRUE, TRUE, NULL));
+}
+
+static void event_cleanup(void)
+{
+    CloseHandle(ctx.event);
+}
+
+static void event_set_run(ULONG64 count)
+{
+    while (count--) SetEvent(ctx.event);
+}
+
+static void event_wait_run(ULONG64 count)
+{
+    while (count--) WaitForSingleObject(ctx.event, 0);
+}
+
+/* cross-thread event ping-pong */
+
+static DWORD WINAPI pong_thread(void *arg)
+{
+    for (;;)
+    {
+        WaitForSingleObject(ctx.ping, INFINITE);
+        if (ctx.stop) break;
+        SetEvent(ctx.pong);
+    }
+    return 0;
+}
+
+static BOOL pingpong_setup(void)
+{
+    ctx.stop = 0;
+    if (!(ctx.ping = CreateEventW(NULL, FALSE, FALSE, NULL))) return FALSE;
+    if (!(ctx.pong = CreateEventW(NULL, FALSE, FALSE, NULL))) return FALSE;
+    return !!(ctx.thread = CreateThread(NULL, 0, pong_thread, NULL, 0, NULL));
+}
+
+static void pingpong_run(ULONG64 count)
+{
+    while (count--) SignalObjectAndWait(ctx.ping, ctx.pong, INFINITE, FALSE);
+}
+
+static void pingpong_cleanup(void)
+{
+    ctx.stop = 1;
+    SetEvent(ctx.ping);
+    WaitForSingleObject(ctx.thread, INFINITE);
+    CloseHandle(ctx.thread);
+    CloseHandle(ctx.pong);
+    CloseHandle(ctx.ping);
+}
+
+/* mutexes */
+
+static BOOL mutex_setup(void)
+{
+    return !!(ctx.mutex = CreateMutexW(NULL, FALSE, NULL));
+}
+
+static void mutex_run(ULONG64 count)
+{
+    while (count--)
+    {
+        WaitForSingleObject(ctx.mutex, INFINITE);
+        ReleaseMutex(ctx.mutex);
+    }
+}
+
+static void mutex_cleanup(void)
+{
+    CloseHandle(ctx.mutex);
+}
+
+/* files */
+
+static BOOL file_setup(void)
+{
+    static const char data[4096];
+    WCHAR dir[MAX_PATH];
+    DWORD written;
+
+    if (!GetTempPathW(ARRAY_SIZE(dir), dir) || !GetTempFileNameW(dir, L"wbn", 0, ctx.path)) return FALSE;
+    ctx.file = CreateFileW(ctx.path, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE,
+                           NULL, CREATE_ALWAYS, 0, NULL);
+    if (ctx.file == INVALID_HANDLE_VALUE) return FALSE;
+    return WriteFile(ctx.file, data, sizeof(data), &written, NULL);
+}
+
+static void file_cleanup(void)
+{
+    CloseHandle(ctx.file);
+    DeleteFileW(ctx.path);
+}
+
+static void file_open_run(ULONG64 count)
+{
+    HANDLE file;
+
+    while (count--)
+    {
+        file = CreateFileW(ctx.path, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE,
+                           NULL, OPEN_EXISTING, 0, NULL);
+        CloseHandle(file);
+    }
+}
+
+static void file_query_run(ULONG64 count)
+{
+    FILE_STANDARD_INFORMATION info;
+    IO_STATUS_BLOCK io;
+
+    while (count--) NtQueryInformationFile(ctx.file, &io, &info, sizeof(info), FileStandardInformation);
+}
+
+static void file_read_run(ULONG64 count)
+{
+    OVERLAPPED ovl = {0};
+    char buffer[4096];
+    DWORD size;
+
+    while (count--) ReadFile(ctx.file, buffer, sizeof(buffer), &size, &ovl);
+}
+
+/* messages */
+
+static BOOL post_setup(void)
+{
+    MSG msg;
+
+    /* make sure the thread has a message queue */
+    PeekMessageW(&msg, NULL, 0, 0, PM_NOREMOVE);
+    return TRUE;
+}
+
+static void post_run(ULONG64 count)
+{
+    DWORD tid = GetCurrentThreadId();
+    MSG msg;
+
+    while (count--)
+    {
+        PostThreadMessageW(tid, WM_USER, 0, 0);
+        GetMessageW(&msg, NULL, 0, 0);
+    }
+}
+
+static void peek_run(ULONG64 count)
+{
+    MSG msg;
+
+    while (count--) PeekMessageW(&msg, NULL, 0, 0, PM_NOREMOVE);
+}
+
+static DWORD WINAPI window_thread(void *arg)
+{
+    MSG msg;
+
+    ctx.hwnd = CreateWindowW(L"static", NULL, 0, 0, 0, 0, 0, HWND_MESSAGE, NULL, NULL, NULL);
+    SetEvent(arg);
+    if (!ctx.hwnd) return 1;
+
+    while (GetMessageW(&msg, NULL, 0, 0)) DispatchMessageW(&msg);
+    DestroyWindow(ctx.hwnd);
+    return 0;
+}
+
+static BOOL send_setup(void)
+{
+    HANDLE ready;
+
+    if (!(ready = CreateEventW(NULL, FALSE, FALSE, NULL))) return FALSE;
+    ctx.hwnd = NULL;
+    ctx.thread = CreateThread(NULL, 0, window_thread, ready, 0, &ctx.thread_id);
+    if (ctx.thread) WaitForSingleObject(ready, INFINITE);
+    CloseHandle(ready);
+    return ctx.hwnd != NULL;
+}
+
+static void send_run(ULONG64 count)
+{
+    while (count--) SendMessageW(ctx.hwnd, WM_USER, 0, 0);
+}
+
+static void send_cleanup(void)
+{
+    if (!ctx.thread) return;
+    PostThreadMessageW(ctx.thread_id, WM_QUIT, 0, 0);
+    WaitForSingleObject(ctx.thread, INFINITE);
+    CloseHandle(ctx.thread);
+}
+
+/* registry */
+
+static BOOL reg_setup(void)
+{
+    DWORD value = 0;
+
+    if (RegCreateKeyExW(HKEY_CURRENT_USER, bench_keyW, 0, NULL, REG_OPTION_VOLATILE,
+                        KEY_ALL_ACCESS, NULL, &ctx.key, NULL))
+        return FALSE;
+    return !RegSetValueExW(ctx.key, L"Value", 0, REG_DWORD, (BYTE *)&value, sizeof(value));
+}
+
+static void reg_cleanup(void)
+{
+    RegCloseKey(ctx.key);
+    RegDeleteKeyW(HKEY_CURRENT_USER, bench_keyW);
+}
+
+static void reg_open_run(ULONG64 count)
+{
+    HKEY key;
+
+    while (count--)
+    {
+        RegOpenKeyExW(HKEY_CURRENT_USER, bench_keyW, 0, KEY_READ, &key);
+        RegCloseKey(key);
+    }
+}
+
+static void reg_query_run(ULONG64 count)
+{
+    DWORD value, size;
+
+    while (count--)
+    {
+        size = sizeof(value);
+        RegQueryValueExW(ctx.key, L"Value", NULL, NULL, (BYTE *)&value, &size);
+    }
+}
+
+/* string operations used by path and name lookups */
+
+static UNICODE_STRING path1 = RTL_CONSTANT_STRING(L"C:\\windows\\system32\\drivers\\etc\\hosts");
+static UNICODE_STRING path2 = RTL_CONSTANT_STRING(L"c:\\Windows\\System32\\Drivers\\Etc\\HOSTS");
+
+static void str_compare_run(ULONG64 count)
+{
+    while (count--) RtlCompareUnicodeString(&path1, &path2, TRUE);
+}
+
+static void str_hash_run(ULONG64 count)
+{
+    ULONG hash;
+
+    while (count--) RtlHashUnicodeString(&path2, TRUE, HASH_STRING_ALGORITHM_X65599, &hash);
+}
+
+static void str_normalize_run(ULONG64 count)
+{
+    WCHAR buffer[MAX_PATH];
+    INT len;
+
+    while (count--)
+    {
+        len = ARRAY_SIZE(buffer);
+        RtlNormalizeString(NormalizationC, path1.Buffer, path1.Length / sizeof(WCHAR), buffer, &len);
+    }
+}
+
+static const struct benchmark server_benchmarks[] =
+{
+    { L"event_set",  "SetEvent on a signaled event", event_setup, event_set_run, event_cleanup },
+    { L"event_wait", "WaitForSingleObject on a signaled event", event_setup, event_wait_run, event_cleanup },
+    { L"event_pingpong", "event round-trip with another thread", pingpong_setup, pingpong_run, pingpong_cleanup },
+    { L"mutex", "mutex acquire and release", mutex_setup, mutex_run, mutex_cleanup },
+    { L"file_open", "CreateFile and CloseHandle of an existing file", file_setup, file_open_run, file_cleanup },
+    { L"file_query", "NtQueryInformationFile(FileStandardInformation)", file_setup, file_query_run, file_cleanup },
+    { L"file_read", "4KB ReadFile", file_setup, file_read_run, file_cleanup },
+    { L"msg_peek", "PeekMessage on an empty queue", post_setup, peek_run, NULL },
+    { L"msg_post", "PostThreadMessage and GetMessage", post_setup, post_run, NULL },
+    { L"msg_send", "SendMessage to another thread", send_setup, send_run, send_cleanup },
+    { L"reg_open", "RegOpenKeyEx and RegCloseKey", reg_setup, reg_open_run, reg_cleanup },
+    { L"reg_query", "RegQueryValueEx of a DWORD value", reg_setup, reg_query_run, reg_cleanup },
+    { L"str_compare", "case-insensitive RtlCompareUnicodeString of a path", NULL, str_compare_run, NULL },
+    { L"str_hash", "case-insensitive RtlHashUnicodeString of a path", NULL, str_hash_run, NULL },
+    { L"str_normalize", "RtlNormalizeString(NormalizationC) of a path", NULL, str_normalize_run, NULL },
+    { NULL }
+};
+
+static const struct benchmark *suites[] =
+{
+    server_benchmarks,
+    gdi_benchmarks,
+    gdiplus_benchmarks,
+    d2d_benchmarks,
+};
+
+static ULONG64 elapsed_ns(const LARGE_INTEGER *start, const LARGE_INTEGER *end, const LARGE_INTEGER *freq)
+{
+    ULONG64 ticks = end->QuadPart - start->QuadPart;
+    return ticks / freq->QuadPart * 1000000000 + ticks % freq->QuadPart * 1000000000 / freq->QuadPart;
+}
+
+static ULONG64 time_run(const struct benchmark *bench, ULONG64 count, const LARGE_INTEGER *freq)
+{
+    LARGE_INTEGER start, end;
+
+    QueryPerformanceCounter(&start);
+    bench->run(count);
+    QueryPerformanceCounter(&end);
+    return elapsed_ns(&start, &end, freq);
+}
+
+static int __cdecl compare_double(const void *a, const void *b)
+{
+    double x = *(const double *)a, y = *(const double *)b;
+    return x < y ? -1 : x > y;
+}
+
+static BOOL run_benchmark(const struct benchmark *bench, unsigned int samples, ULONG64 sample_ns, BOOL csv)
+{
+    double results[MAX_SAMPLES], mean = 0, var = 0, stddev, median;
+    LARGE_INTEGER freq;
+    ULONG64 count = 1, ns;
+    DWORD crc = 0;
+    unsigned int i;
+
+    QueryPerformanceFrequency(&freq);
+
+    if (bench->setup && !bench->setup())
+    {
+        ERR("failed to set up benchmark %s, error %lu\n", debugstr_w(bench->name), GetLastError());
+        if (bench->cleanup) bench->cleanup();
+        return FALSE;
+    }
+
+    /* calibrate the iteration count so that each sample takes about sample_ns,
+     * this also serves as a warm-up run */
+    while ((ns = time_run(bench, count, &freq)) < sample_ns / 8) count *= 2;
+    count = max(1, count * sample_ns / max(ns, 1));
+
+    for (i = 0; i < samples; i++)
+        results[i] = (double)time_run(bench, count, &freq) / count;
+
+    if (bench->checksum) crc = bench->checksum();
+    if (bench->cleanup) bench->cleanup();
+
+    for (i = 0; i < samples; i++) mean += results[i];
+    mean /= samples;
+    for (i = 0; i < samples; i++) var += (results[i] - mean) * (results[i] - mean);
+    if (samples > 1) var /= samples - 1;
+    stddev = mean ? 100 * sqrt(var) / mean : 0.0;
+    qsort(results, samples, sizeof(*results), compare_double);
+    median = results[samples / 2];
+
+    if (csv)
+    {
+        printf("%ls,%.1f,%.1f,%.1f,%.2f,%u,%I64u,", bench->name, median, results[0],
+               results[samples - 1], stddev, samples, count);
+        if (bench->primitives) printf("%.1f,%08lx\n", median / bench->primitives, crc);
+        else printf(",\n");
+    }
+    else
+    {
+        printf("%-16ls %10.1f ns/op  min %10.1f  max %10.1f  stddev %5.2f%%  (%u x %I64u)\n", bench->name,
+               median, results[0], results[samples - 1], stddev, samples, count);
+        if (bench->primitives)
+            printf("%-16s %10.1f fps    %10.1f ns/primitive  crc %08lx\n", "",
+                   1e9 / median, median / bench->primitives, crc);
+    }
+    fflush(stdout);
+    return TRUE;
+}
+
+static void usage(void)
+{
+    const struct benchmark *bench;
+    unsigned int i;
+
+    printf("Usage: winebench [-l] [-c] [-n samples] [-t milliseconds] [benchmark...]\n\n"
+           "  -l    list the available benchmarks\n"
+           "  -c    print comma-separated values:\n"
+           "        name,median,min,max,stddev%%,samples,iterations,ns/primitive,crc\n"
+           "  -n    number of samples for each benchmark (default 9)\n"
+           "  -t    duration of each sample in milliseconds (default 50)\n\n"
+           "Benchmark names can be prefixes, all benchmarks are run if none is given.\n"
+           "Times are reported in nanoseconds per operation. Rendering benchmarks draw one\n"
+           "%ux%u frame per operation and also report the CRC32 of the frame, which can be\n"
+           "compared against a reference run to catch rendering changes.\n\nBenchmarks:\n",
+           FRAME_WIDTH, FRAME_HEIGHT);
+    for (i = 0; i < ARRAY_SIZE(suites); i++)
+        for (bench = suites[i]; bench->name; bench++)
+            printf("  %-16ls %s\n", bench->name, bench->description);
+}
+
+static BOOL is_selected(const WCHAR *name, int argc, WCHAR *argv[], int first)
+{
+    int i;
+
+    if (first >= argc) return TRUE;
+    for (i = first; i < argc; i++)
+        if (!wcsncmp(name, argv[i], wcslen(argv[i]))) return TRUE;
+    return FALSE;
+}
+
+int __cdecl wmain(int argc, WCHAR *argv[])
+{
+    unsigned int i, samples = 9, sample_ms = 50, failures = 0;
+    const struct benchmark *bench;
+    BOOL csv = FALSE;
+    int arg;
+
+    for (arg = 1; arg < argc && (argv[arg][0] == '-' || argv[arg][0] == '/'); arg++)
+    {
+        if (!wcscmp(argv[arg] + 1, L"l"))
+        {
+            usage();
+            return 0;
+        }
+        else if (!wcscmp(argv[arg] + 1, L"c")) csv = TRUE;
+        else if (!wcscmp(argv[arg] + 1, L"n") && arg + 1 < argc)
+            samples = min(max(1, wcstoul(argv[++arg], NULL, 10)), MAX_SAMPLES);
+        else if (!wcscmp(argv[arg] + 1, L"t") && arg + 1 < argc)
+            sample_ms = max(1, wcstoul(argv[++arg], NULL, 10));
+        else
+        {
+            usage();
+            return 1;
+        }
+    }
+
+    SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_HIGHEST);
+
+    for (i = 0; i < ARRAY_SIZE(suites); i++)
+    {
+        for (bench = suites[i]; bench->name; bench++)
+        {
+            if (!is_selected(bench->name, argc, argv, arg)) continue;
+            if (!run_benchmark(bench, samples, (ULONG64)sample_ms * 1000000, csv)) failures++;
+        }
+    }
+
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,46 @@
+/*
+ * Copyright 2026 the Wine project
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#include <windows.h>
+
+struct benchmark
+{
+    const WCHAR *name;
+    const char *description;
+    BOOL (*setup)(void);
+    void (*run)(ULONG64 count);
+    void (*cleanup)(void);
+    unsigned int primitives;    /* primitives drawn by each run, for rendering benchmarks */
+    DWORD (*checksum)(void);    /* checksum of the rendered frame, for rendering benchmarks */
+};
+
+/* all rendering benchmarks draw a frame of this size */
+#define FRAME_WIDTH  640
+#define FRAME_HEIGHT 480
+
+/* deterministic pseudo-random numbers, so that every run draws the same frame */
+static inline unsigned int bench_rand(unsigned int *seed)
+{
+    *seed = *seed * 1103515245 + 12345;
+    return (*seed >> 16) & 0x7fff;
+}
+
+/* benchmark tables, terminated by an entry with a NULL name */
+extern const struct benchmark gdi_benchmarks[];
+extern const struct benchmark gdiplus_benchmarks[];
+extern const struct benchmark d2d_benchmarks[];
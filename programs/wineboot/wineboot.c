@@ -1658,31 +1658,43 @@ static void update_wineprefix( BOOL force )
 
     if (update_timestamp( config_dir, st.st_mtime ) || force)
     {
-        HANDLE process;
-        DWORD count = 0;
+        HANDLE processes[ARRAY_SIZE(machines)];
+        DWORD i, count = 0;
 
-        if ((process = start_rundll32( inf_path, L"PreInstall", IMAGE_FILE_MACHINE_TARGET_HOST )))
+        if ((processes[0] = start_rundll32( inf_path, L"PreInstall", IMAGE_FILE_MACHINE_TARGET_HOST )))
         {
             HWND hwnd = show_wait_window();
+            BOOL started = FALSE;
+
+            count = 1;
             for (;;)
             {
-                if (process)
+                if (count)
                 {
                     MSG msg;
-                    DWORD res = MsgWaitForMultipleObjects( 1, &process, FALSE, INFINITE, QS_ALLINPUT );
-                    if (res != WAIT_OBJECT_0)
+                    DWORD res = MsgWaitForMultipleObjects( count, processes, FALSE, INFINITE, QS_ALLINPUT );
+                    if (res >= WAIT_OBJECT_0 + count)
                     {
                         while (PeekMessageW( &msg, 0, 0, 0, PM_REMOVE )) DispatchMessageW( &msg );
                         continue;
                     }
-                    CloseHandle( process );
+                    CloseHandle( processes[res - WAIT_OBJECT_0] );
+                    processes[res - WAIT_OBJECT_0] = processes[--count];
+                    if (count) continue;
+                }
+                if (started) break;
+
+                /* the installs for the various architectures don't depend on each other,
+                 * only on PreInstall, so run them in parallel */
+                for (i = 0; machines[i].Machine && count < ARRAY_SIZE(processes); i++)
+                {
+                    if (machines[i].Native)
+                        processes[count] = start_rundll32( inf_path, L"DefaultInstall", IMAGE_FILE_MACHINE_TARGET_HOST );
+                    else
+                        processes[count] = start_rundll32( inf_path, L"Wow64Install", machines[i].Machine );
+                    if (processes[count]) count++;
                 }
-                if (!machines[count].Machine) break;
-                if (machines[count].Native)
-                    process = start_rundll32( inf_path, L"DefaultInstall", IMAGE_FILE_MACHINE_TARGET_HOST );
-                else
-                    process = start_rundll32( inf_path, L"Wow64Install", machines[count].Machine );
-                count++;
+                started = TRUE;
             }
             DestroyWindow( hwnd );
         }
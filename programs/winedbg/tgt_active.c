@@ -28,6 +28,7 @@
 #include "resource.h"
 #include "winternl.h"
 #include "wine/debug.h"
+#include "wine/rbtree.h"
 
 WINE_DEFAULT_DEBUG_CHANNEL(winedbg);
 
@@ -1029,6 +1030,200 @@ enum dbg_start dbg_active_minidump(int argc, char* argv[])
     return start_ok;
 }
 
+#define PROFILE_MAX_FRAMES 128
+
+struct profile_frame
+{
+    DWORD64             pc;
+    DWORD               inline_ctx;
+};
+
+struct profile_stack
+{
+    struct rb_entry     entry;
+    unsigned            count;
+    unsigned            num_frames;
+    struct profile_frame frames[PROFILE_MAX_FRAMES];
+};
+
+static int profile_stack_compare(const void *key, const struct rb_entry *entry)
+{
+    const struct profile_stack *a = key, *b = RB_ENTRY_VALUE(entry, const struct profile_stack, entry);
+
+    if (a->num_frames != b->num_frames) return a->num_frames < b->num_frames ? -1 : 1;
+    return memcmp(a->frames, b->frames, a->num_frames * sizeof(a->frames[0]));
+}
+
+static void profile_stack_free(struct rb_entry *entry, void *context)
+{
+    free(RB_ENTRY_VALUE(entry, struct profile_stack, entry));
+}
+
+/******************************************************************
+ *		profile_sample_thread
+ *
+ * Suspends a thread just long enough to unwind its stack into sample.
+ */
+static unsigned profile_sample_thread(struct dbg_thread* thread, struct profile_stack* sample)
+{
+    struct backend_cpu* cpu = thread->process->be_cpu;
+    STACKFRAME_EX       sf;
+    dbg_ctx_t           ctx;
+    unsigned            nf = 0;
+
+    if (SuspendThread(thread->handle) == (DWORD)-1) return 0;
+    if (cpu->get_context(thread->handle, &ctx))
+    {
+        memset(&sf, 0, sizeof(sf));
+        sf.StackFrameSize = sizeof(sf);
+        cpu->get_addr(thread->handle, &ctx, be_cpu_addr_frame, &sf.AddrFrame);
+        cpu->get_addr(thread->handle, &ctx, be_cpu_addr_pc, &sf.AddrPC);
+        cpu->get_addr(thread->handle, &ctx, be_cpu_addr_stack, &sf.AddrStack);
+        sf.InlineFrameContext = INLINE_FRAME_CONTEXT_INIT;
+
+        /* only flat mode code is sampled */
+        while (nf < PROFILE_MAX_FRAMES && sf.AddrPC.Mode == AddrModeFlat && sf.AddrFrame.Mode == AddrModeFlat &&
+               StackWalkEx(cpu->machine, thread->process->handle, thread->handle, &sf, &ctx, NULL,
+                           SymFunctionTableAccess64, SymGetModuleBase64, NULL, SYM_STKWALK_DEFAULT))
+        {
+            sample->frames[nf].pc = sf.AddrPC.Offset;
+            sample->frames[nf].inline_ctx = sf.InlineFrameContext;
+            nf++;
+        }
+    }
+    ResumeThread(thread->handle);
+    return sample->num_frames = nf;
+}
+
+static void profile_print_frame(HANDLE hProcess, const struct profile_frame* frame)
+{
+    char                buffer[sizeof(SYMBOL_INFO) + 256];
+    SYMBOL_INFO*        si = (SYMBOL_INFO*)buffer;
+    IMAGEHLP_MODULE64   im;
+    DWORD64             disp;
+
+    im.SizeOfStruct = sizeof(im);
+    if (SymGetModuleInfo64(hProcess, frame->pc, &im))
+        dbg_printf("%s!", im.ModuleName);
+    si->SizeOfStruct = sizeof(*si);
+    si->MaxNameLen   = 256;
+    if (SymFromInlineContext(hProcess, frame->pc, frame->inline_ctx, &disp, si))
+        dbg_printf("%s", si->Name);
+    else
+        dbg_printf("0x%I64x", frame->pc);
+}
+
+/******************************************************************
+ *		dbg_active_profile
+ *
+ * Attaches to <pid> and samples the stacks of all its threads every
+ * 1/<hz> second for <seconds>, then prints them as folded stacks
+ * (one "root;...;leaf count" line per distinct stack) on stdout.
+ * Handles the <pid> [<seconds> [<hz>]] forms
+ */
+enum dbg_start dbg_active_profile(int argc, char* argv[])
+{
+    DWORD_PTR           seconds = 10, hz = 100;
+    struct rb_tree      stacks;
+    struct profile_stack* sample;
+    struct profile_stack* stack;
+    struct dbg_thread*  thread;
+    struct list*        first;
+    enum dbg_start      ds;
+    DEBUG_EVENT         de;
+    DWORD64             now, next, end;
+    DWORD               interval;
+    unsigned            num_samples = 0, i;
+    BOOL                stopped = FALSE;
+
+    dbg_houtput = GetStdHandle(STD_ERROR_HANDLE);
+    DBG_IVAR(BreakOnDllLoad) = 0;
+
+    argc--; argv++;
+    if (argc < 1 || argc > 3) return start_error_parse;
+    if (argc >= 2 && (!str2int(argv[1], &seconds) || !seconds)) return start_error_parse;
+    if (argc >= 3 && (!str2int(argv[2], &hz) || !hz || hz > 1000)) return start_error_parse;
+    if ((ds = dbg_active_attach(1, argv)) != start_ok) return ds;
+
+    if (dbg_curr_process->active_debuggee)
+        dbg_active_wait_for_first_exception();
+    if (!dbg_num_processes()) return start_error_init;
+    dbg_resume_debuggee(DBG_CONTINUE);
+
+    if (!(sample = malloc(sizeof(*sample))))
+    {
+        dbg_curr_process->process_io->close_process(dbg_curr_process, FALSE);
+        return start_error_init;
+    }
+    rb_init(&stacks, profile_stack_compare);
+
+    dbg_printf("Profiling pid %04lx for %Iu seconds at %Iu Hz\n", dbg_curr_pid, seconds, hz);
+    interval = 1000 / hz;
+    next = GetTickCount64();
+    end = next + seconds * 1000;
+    de.dwDebugEventCode = 0;
+    while (dbg_num_processes() && (now = GetTickCount64()) < end)
+    {
+        if (now < next)
+        {
+            if (!WaitForDebugEvent(&de, next - now)) continue;
+            /* keep the process around so that the samples can still be symbolized */
+            if (de.dwDebugEventCode == EXIT_PROCESS_DEBUG_EVENT) break;
+            if ((stopped = dbg_handle_debug_event(&de))) break;
+            de.dwDebugEventCode = 0;
+            continue;
+        }
+        LIST_FOR_EACH_ENTRY(thread, &dbg_curr_process->threads, struct dbg_thread, entry)
+        {
+            if (!profile_sample_thread(thread, sample)) continue;
+            if ((stack = RB_ENTRY_VALUE(rb_get(&stacks, sample), struct profile_stack, entry)))
+                stack->count++;
+            else if ((stack = malloc(FIELD_OFFSET(struct profile_stack, frames[sample->num_frames]))))
+            {
+                memcpy(stack, sample, FIELD_OFFSET(struct profile_stack, frames[sample->num_frames]));
+                stack->count = 1;
+                rb_put(&stacks, stack, &stack->entry);
+            }
+        }
+        num_samples++;
+        /* don't try to catch up on missed samples */
+        if ((next += interval) < now) next = now + interval;
+    }
+    free(sample);
+
+    if (dbg_num_processes())
+    {
+        /* resynchronize builtin dbghelp's internal ELF module list */
+        SymLoadModule(dbg_curr_process->handle, 0, 0, 0, 0, 0);
+
+        dbg_printf("Collected %u samples\n", num_samples);
+        dbg_houtput = GetStdHandle(STD_OUTPUT_HANDLE);
+        RB_FOR_EACH_ENTRY(stack, &stacks, struct profile_stack, entry)
+        {
+            for (i = stack->num_frames; i > 0; i--)
+            {
+                profile_print_frame(dbg_curr_process->handle, &stack->frames[i - 1]);
+                if (i > 1) dbg_printf(";");
+            }
+            dbg_printf(" %u\n", stack->count);
+        }
+        dbg_houtput = GetStdHandle(STD_ERROR_HANDLE);
+
+        if (de.dwDebugEventCode == EXIT_PROCESS_DEBUG_EVENT)
+            dbg_handle_debug_event(&de);
+        else
+        {
+            /* the thread of the last debug event could be gone by now */
+            if (!stopped && (first = list_head(&dbg_curr_process->threads)))
+                dbg_curr_thread = LIST_ENTRY(first, struct dbg_thread, entry);
+            dbg_curr_process->process_io->close_process(dbg_curr_process, FALSE);
+        }
+    }
+    rb_destroy(&stacks, profile_stack_free, NULL);
+
+    return start_ok;
+}
+
 static BOOL tgt_process_active_close_process(struct dbg_process* pcs, BOOL kill)
 {
     if (kill)
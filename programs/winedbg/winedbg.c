@@ -625,6 +625,9 @@ static int dbg_winedbg_usage(BOOL advanced)
                "                           gdb (proxied) on it\n"
                "   winedbg <file.mdmp>     reload the minidump <file.mdmp> into memory and run\n"
                "                           WineDbg on it\n"
+               "   winedbg --profile <num> [<secs> [<hz>]]\n"
+               "                           sample the stacks of process of wpid <num> and print\n"
+               "                           them as folded stacks\n"
                "   winedbg --help          prints advanced options\n");
     }
     else
@@ -741,6 +744,15 @@ int main(int argc, char** argv)
         case start_error_init:  return -1;
         }
     }
+    if (argc && !strcmp(argv[0], "--profile"))
+    {
+        switch (dbg_active_profile(argc, argv))
+        {
+        case start_ok:          return 0;
+        case start_error_parse: return dbg_winedbg_usage(FALSE);
+        case start_error_init:  return -1;
+        }
+    }
     /* parse options */
     while (argc > 0 && argv[0][0] == '-')
     {
@@ -374,6 +374,29 @@ DECL_HANDLER(add_completion)
 }
 
 /* get completion from completion port */
+/* return as many further queued completions as fit in the reply buffer */
+static void grab_further_completions( struct completion *completion )
+{
+    struct completion_msg *msgs;
+    struct comp_msg *msg;
+    data_size_t i, count = min( completion->depth, get_reply_max_size() / sizeof(*msgs) );
+
+    if (!count || !(msgs = set_reply_data_size( count * sizeof(*msgs) ))) return;
+
+    for (i = 0; i < count; i++)
+    {
+        msg = LIST_ENTRY( list_head( &completion->queue ), struct comp_msg, queue_entry );
+        list_remove( &msg->queue_entry );
+        completion->depth--;
+        msgs[i].ckey        = msg->ckey;
+        msgs[i].cvalue      = msg->cvalue;
+        msgs[i].information = msg->information;
+        msgs[i].status      = msg->status;
+        msgs[i].__pad       = 0;
+        free( msg );
+    }
+}
+
 DECL_HANDLER(remove_completion)
 {
     struct completion* completion = get_completion_obj( current->process, req->handle, IO_COMPLETION_MODIFY_STATE );
@@ -417,6 +440,7 @@ DECL_HANDLER(remove_completion)
         reply->information = msg->information;
         free( msg );
         reply->wait_handle = 0;
+        grab_further_completions( completion );
         if (list_empty( &completion->queue )) reset_sync( completion->sync );
     }
 
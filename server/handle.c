@@ -52,6 +52,7 @@ struct handle_table
     int                  count;       /* number of allocated entries */
     int                  last;        /* last used entry */
     int                  free;        /* first entry that may be free */
+    int                  free_count;  /* number of free entries up to the last used one */
     struct handle_entry *entries;     /* handle entries */
 };
 
@@ -152,8 +153,8 @@ static void handle_table_dump( struct object *obj, int verbose )
 
     assert( obj->ops == &handle_table_ops );
 
-    fprintf( stderr, "Handle table last=%d count=%d process=%p\n",
-             table->last, table->count, table->process );
+    fprintf( stderr, "Handle table last=%d count=%d used=%d process=%p\n",
+             table->last, table->count, table->last + 1 - table->free_count, table->process );
     if (!verbose) return;
     entry = table->entries;
     for (i = 0; i <= table->last; i++, entry++)
@@ -210,6 +211,7 @@ struct handle_table *alloc_handle_table( struct process *process, int count )
     table->count   = count;
     table->last    = -1;
     table->free    = 0;
+    table->free_count = 0;
     if ((table->entries = mem_alloc( count * sizeof(*table->entries) ))) return table;
     release_object( table );
     return NULL;
@@ -235,15 +237,21 @@ static int grow_handle_table( struct handle_table *table )
 /* allocate the first free entry in the handle table */
 static obj_handle_t alloc_entry( struct handle_table *table, void *obj, unsigned int access )
 {
-    struct handle_entry *entry = table->entries + table->free;
+    struct handle_entry *entry;
     int i;
 
-    for (i = table->free; i <= table->last; i++, entry++) if (!entry->ptr) goto found;
-    if (i >= table->count)
+    if (table->free_count)
     {
-        if (!grow_handle_table( table )) return 0;
-        entry = table->entries + i;  /* the entries may have moved */
+        /* there is a hole below the last entry, reuse it */
+        entry = table->entries + table->free;
+        for (i = table->free; i <= table->last; i++, entry++) if (!entry->ptr) break;
+        assert( i <= table->last );
+        table->free_count--;
+        goto found;
     }
+    i = table->last + 1;
+    if (i >= table->count && !grow_handle_table( table )) return 0;
+    entry = table->entries + i;
     table->last = i;
  found:
     table->free = i + 1;
@@ -348,6 +356,7 @@ static void shrink_handle_table( struct handle_table *table )
     {
         if (entry->ptr) break;
         table->last--;
+        table->free_count--;
         entry--;
     }
     if (table->last >= count / 4) return;  /* no need to shrink */
@@ -418,6 +427,8 @@ struct handle_table *copy_handle_table( struct process *process, struct process
             }
         }
     }
+    for (i = 0; i <= table->last; i++) if (!table->entries[i].ptr) table->free_count++;
+
     /* attempt to shrink the table */
     shrink_handle_table( table );
     return table;
@@ -438,6 +449,7 @@ unsigned int close_handle( struct process *process, obj_handle_t handle )
 
     table = handle_is_global(handle) ? global_table : process->handles;
     table->entries[index].ptr = NULL;
+    table->free_count++;
     if (index < table->free) table->free = index;
     if (index == table->last) shrink_handle_table( table );
     release_object_from_handle( obj );
@@ -660,11 +672,11 @@ obj_handle_t open_object( struct process *process, obj_handle_t parent, unsigned
     return handle;
 }
 
-/* return the size of the handle table of a given process */
+/* return the number of handles in use in the handle table of a given process */
 unsigned int get_handle_table_count( struct process *process )
 {
     if (!process->handles) return 0;
-    return process->handles->count;
+    return process->handles->last + 1 - process->handles->free_count;
 }
 
 /* close a handle */
@@ -28,6 +28,9 @@
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <sys/mman.h>
+#ifdef HAVE_SYS_SYSCALL_H
+# include <sys/syscall.h>
+#endif
 #include <unistd.h>
 
 #include "ntstatus.h"
@@ -358,6 +361,53 @@ static int check_current_dir_for_exec(void)
     return (ret != MAP_FAILED);
 }
 
+/* create an anonymous memory file, which avoids going through the file system */
+static int create_memfd( file_pos_t size )
+{
+#if defined(__linux__) && defined(__NR_memfd_create)
+    static int use_memfd = -1;
+    void *ret;
+    int fd;
+
+    if (!use_memfd) return -1;
+    if ((fd = syscall( __NR_memfd_create, "wine-mapping", 1 /* MFD_CLOEXEC */ )) == -1)
+    {
+        use_memfd = 0;
+        return -1;
+    }
+
+    /* memfds can be forbidden from being mapped executable */
+    if (use_memfd == -1)
+    {
+        use_memfd = 0;
+        if (grow_file( fd, 1 ))
+        {
+            ret = mmap( NULL, get_page_size(), PROT_READ | PROT_EXEC, MAP_PRIVATE, fd, 0 );
+            if (ret != MAP_FAILED)
+            {
+                munmap( ret, get_page_size() );
+                use_memfd = 1;
+            }
+        }
+        if (!use_memfd || ftruncate( fd, 0 ) == -1)
+        {
+            close( fd );
+            return -1;
+        }
+    }
+
+    /* the file is sparse, pages only get allocated when they are written to */
+    if (!grow_file( fd, size ))
+    {
+        close( fd );
+        return -1;
+    }
+    return fd;
+#else
+    return -1;
+#endif
+}
+
 /* create a temp file for anonymous mappings */
 static int create_temp_file( file_pos_t size )
 {
@@ -365,6 +415,8 @@ static int create_temp_file( file_pos_t size )
     char tmpfn[16];
     int fd;
 
+    if ((fd = create_memfd( size )) != -1) return fd;
+
     if (temp_dir_fd == -1)
     {
         temp_dir_fd = server_dir_fd;
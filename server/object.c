@@ -48,9 +48,12 @@
 struct namespace
 {
     unsigned int        hash_size;       /* size of hash table */
-    struct list         names[1];        /* array of hash entry lists */
+    unsigned int        count;           /* upper bound of the number of names in the table */
+    struct list        *names;           /* array of hash entry lists */
 };
 
+#define MAX_NAMESPACE_HASH_SIZE 0x10000  /* don't grow the hash table beyond this size */
+
 
 struct type_descr no_type =
 {
@@ -239,10 +242,45 @@ void *memdup( const void *data, size_t len )
 
 /*****************************************************************/
 
+/* grow the hash table of a namespace if it has gotten too crowded */
+static void namespace_check_size( struct namespace *namespace )
+{
+    struct object_name *ptr, *next;
+    unsigned int i, count = 0, new_size;
+    struct list *new_names;
+
+    /* names are unlinked without going through the namespace, so we only have an upper bound */
+    if (namespace->count < 4 * namespace->hash_size) return;
+    if (namespace->hash_size >= MAX_NAMESPACE_HASH_SIZE) return;
+
+    for (i = 0; i < namespace->hash_size; i++) count += list_count( &namespace->names[i] );
+    namespace->count = count;
+    if (count < 2 * namespace->hash_size) return;
+
+    new_size = 4 * namespace->hash_size - 1;
+    if (!(new_names = malloc( new_size * sizeof(*new_names) ))) return;
+    for (i = 0; i < new_size; i++) list_init( &new_names[i] );
+
+    for (i = 0; i < namespace->hash_size; i++)
+    {
+        LIST_FOR_EACH_ENTRY_SAFE( ptr, next, &namespace->names[i], struct object_name, entry )
+        {
+            list_remove( &ptr->entry );
+            list_add_tail( &new_names[hash_strW( ptr->name, ptr->len, new_size )], &ptr->entry );
+        }
+    }
+    free( namespace->names );
+    namespace->names = new_names;
+    namespace->hash_size = new_size;
+}
+
 void namespace_add( struct namespace *namespace, struct object_name *ptr )
 {
-    unsigned int hash = hash_strW( ptr->name, ptr->len, namespace->hash_size );
+    unsigned int hash;
 
+    namespace->count++;
+    namespace_check_size( namespace );
+    hash = hash_strW( ptr->name, ptr->len, namespace->hash_size );
     list_add_head( &namespace->names[hash], &ptr->entry );
 }
 
@@ -609,15 +647,26 @@ struct namespace *create_namespace( unsigned int hash_size )
     struct namespace *namespace;
     unsigned int i;
 
-    namespace = mem_alloc( sizeof(*namespace) + (hash_size - 1) * sizeof(namespace->names[0]) );
-    if (namespace)
+    if (!(namespace = mem_alloc( sizeof(*namespace) ))) return NULL;
+    if (!(namespace->names = mem_alloc( hash_size * sizeof(namespace->names[0]) )))
     {
-        namespace->hash_size      = hash_size;
-        for (i = 0; i < hash_size; i++) list_init( &namespace->names[i] );
+        free( namespace );
+        return NULL;
     }
+    namespace->hash_size      = hash_size;
+    namespace->count          = 0;
+    for (i = 0; i < hash_size; i++) list_init( &namespace->names[i] );
     return namespace;
 }
 
+/* free a namespace */
+void free_namespace( struct namespace *namespace )
+{
+    if (!namespace) return;
+    free( namespace->names );
+    free( namespace );
+}
+
 /* functions for unimplemented/default object operations */
 
 int no_add_queue( struct object *obj, struct wait_queue_entry *entry )
@@ -272,7 +272,12 @@ static void dump_value( const struct key_value *value, FILE *f )
     else count += fprintf( f, "hex(%x):", value->type );
     for (i = 0; i < value->len; i++)
     {
-        count += fprintf( f, "%02x", *((unsigned char *)value->data + i) );
+        static const char hex[] = "0123456789abcdef";
+        unsigned char ch = *((unsigned char *)value->data + i);
+
+        fputc( hex[ch >> 4], f );
+        fputc( hex[ch & 0x0f], f );
+        count += 2;
         if (i < value->len-1)
         {
             fputc( ',', f );
@@ -286,20 +291,34 @@ static void dump_value( const struct key_value *value, FILE *f )
     fputc( '\n', f );
 }
 
+/* compare the name of a key with a given name, ignoring case */
+static inline int compare_key_name( const struct key *key, const struct unicode_str *name )
+{
+    data_size_t len = min( key->obj.name->len, name->len );
+    int res = memicmp_strW( key->obj.name->name, name->str, len );
+    if (!res) res = key->obj.name->len - name->len;
+    return res;
+}
+
 /* find the named child of a given key and return its index */
 static struct key *find_subkey( const struct key *key, const struct unicode_str *name, int *index )
 {
     int i, min, max, res;
-    data_size_t len;
 
     min = 0;
     max = key->last_subkey;
+
+    /* subkeys are often created in sorted order, e.g. when loading a file, so check the end first */
+    if (max >= 0 && (res = compare_key_name( key->subkeys[max], name )) <= 0)
+    {
+        *index = res ? max + 1 : max;
+        return res ? NULL : key->subkeys[max];
+    }
+
     while (min <= max)
     {
         i = (min + max) / 2;
-        len = min( key->subkeys[i]->obj.name->len, name->len );
-        res = memicmp_strW( key->subkeys[i]->obj.name->name, name->str, len );
-        if (!res) res = key->subkeys[i]->obj.name->len - name->len;
+        res = compare_key_name( key->subkeys[i], name );
         if (!res)
         {
             *index = i;
@@ -312,6 +331,19 @@ static struct key *find_subkey( const struct key *key, const struct unicode_str
     return NULL;
 }
 
+/* return the index of a key in the subkeys array of its parent */
+static int get_subkey_index( const struct key *parent, const struct key *key )
+{
+    struct unicode_str name;
+    int index;
+
+    name.str = key->obj.name->name;
+    name.len = key->obj.name->len;
+    find_subkey( parent, &name, &index );
+    assert( parent->subkeys[index] == key );
+    return index;
+}
+
 /* try to grow the array of subkeys; return 1 if OK, 0 on error */
 static int grow_subkeys( struct key *key )
 {
@@ -583,7 +615,7 @@ static int key_link_name( struct object *obj, struct object_name *name, struct o
     struct key *key = (struct key *)obj;
     struct key *parent_key = (struct key *)parent;
     struct unicode_str tmp;
-    int i, index;
+    int index;
 
     if (parent->ops != &key_ops)
     {
@@ -602,8 +634,9 @@ static int key_link_name( struct object *obj, struct object_name *name, struct o
     tmp.len = name->len;
     find_subkey( parent_key, &tmp, &index );
 
-    for (i = ++parent_key->last_subkey; i > index; i--)
-        parent_key->subkeys[i] = parent_key->subkeys[i - 1];
+    memmove( parent_key->subkeys + index + 1, parent_key->subkeys + index,
+             (parent_key->last_subkey - index + 1) * sizeof(*parent_key->subkeys) );
+    parent_key->last_subkey++;
     parent_key->subkeys[index] = (struct key *)grab_object( key );
     if (is_wow6432node( name->name, name->len ) &&
         !is_wow6432node( parent_key->obj.name->name, parent_key->obj.name->len ))
@@ -626,9 +659,9 @@ static void key_unlink_name( struct object *obj, struct object_name *name )
         return;
     }
 
-    for (i = 0; i <= parent->last_subkey; i++) if (parent->subkeys[i] == key) break;
-    assert( i <= parent->last_subkey );
-    for ( ; i < parent->last_subkey; i++) parent->subkeys[i] = parent->subkeys[i + 1];
+    i = get_subkey_index( parent, key );
+    memmove( parent->subkeys + i, parent->subkeys + i + 1,
+             (parent->last_subkey - i) * sizeof(*parent->subkeys) );
     parent->last_subkey--;
     name->parent = NULL;
     if (parent->wow6432node == key) parent->wow6432node = NULL;
@@ -1004,7 +1037,7 @@ static void rename_key( struct key *key, const struct unicode_str *new_name )
     struct object_name *new_name_ptr;
     struct key *parent = get_parent( key );
     data_size_t len;
-    int i, index, cur_index;
+    int index, cur_index;
 
     /* changing to a path is not allowed */
     len = get_path_element( new_name->str, new_name->len );
@@ -1035,17 +1068,18 @@ static void rename_key( struct key *key, const struct unicode_str *new_name )
     new_name_ptr->parent = &parent->obj;
     memcpy( new_name_ptr->name, new_name->str, new_name->len );
 
-    for (cur_index = 0; cur_index <= parent->last_subkey; cur_index++)
-        if (parent->subkeys[cur_index] == key) break;
+    cur_index = get_subkey_index( parent, key );
 
     if (cur_index < index)
     {
         --index;
-        for (i = cur_index; i < index; ++i) parent->subkeys[i] = parent->subkeys[i+1];
+        memmove( parent->subkeys + cur_index, parent->subkeys + cur_index + 1,
+                 (index - cur_index) * sizeof(*parent->subkeys) );
     }
     else if (cur_index > index)
     {
-        for (i = cur_index; i > index; --i) parent->subkeys[i] = parent->subkeys[i-1];
+        memmove( parent->subkeys + index + 1, parent->subkeys + index,
+                 (cur_index - index) * sizeof(*parent->subkeys) );
     }
     parent->subkeys[index] = key;
 
@@ -1117,20 +1151,34 @@ static int grow_values( struct key *key )
     return 1;
 }
 
+/* compare the name of a value with a given name, ignoring case */
+static inline int compare_value_name( const struct key_value *value, const struct unicode_str *name )
+{
+    data_size_t len = min( value->namelen, name->len );
+    int res = memicmp_strW( value->name, name->str, len );
+    if (!res) res = value->namelen - name->len;
+    return res;
+}
+
 /* find the named value of a given key and return its index in the array */
 static struct key_value *find_value( const struct key *key, const struct unicode_str *name, int *index )
 {
     int i, min, max, res;
-    data_size_t len;
 
     min = 0;
     max = key->last_value;
+
+    /* values are often created in sorted order too, check the end first */
+    if (max >= 0 && (res = compare_value_name( &key->values[max], name )) <= 0)
+    {
+        *index = res ? max + 1 : max;
+        return res ? NULL : &key->values[max];
+    }
+
     while (min <= max)
     {
         i = (min + max) / 2;
-        len = min( key->values[i].namelen, name->len );
-        res = memicmp_strW( key->values[i].name, name->str, len );
-        if (!res) res = key->values[i].namelen - name->len;
+        res = compare_value_name( &key->values[i], name );
         if (!res)
         {
             *index = i;
@@ -1148,7 +1196,6 @@ static struct key_value *insert_value( struct key *key, const struct unicode_str
 {
     struct key_value *value;
     WCHAR *new_name = NULL;
-    int i;
 
     if (name->len > MAX_VALUE_LEN * sizeof(WCHAR))
     {
@@ -1160,7 +1207,9 @@ static struct key_value *insert_value( struct key *key, const struct unicode_str
         if (!grow_values( key )) return NULL;
     }
     if (name->len && !(new_name = memdup( name->str, name->len ))) return NULL;
-    for (i = ++key->last_value; i > index; i--) key->values[i] = key->values[i - 1];
+    memmove( key->values + index + 1, key->values + index,
+             (key->last_value - index + 1) * sizeof(*key->values) );
+    key->last_value++;
     value = &key->values[index];
     value->name    = new_name;
     value->namelen = name->len;
@@ -1310,7 +1359,7 @@ static void enum_value( struct key *key, int i, int info_class, struct enum_key_
 static void delete_value( struct key *key, const struct unicode_str *name )
 {
     struct key_value *value;
-    int i, index, nb_values;
+    int index, nb_values;
 
     if (key->flags & KEY_PREDEF)
     {
@@ -1326,7 +1375,8 @@ static void delete_value( struct key *key, const struct unicode_str *name )
     if (debug_level > 1) dump_operation( key, value, "Delete" );
     free( value->name );
     free( value->data );
-    for (i = index; i < key->last_value; i++) key->values[i] = key->values[i + 1];
+    memmove( key->values + index, key->values + index + 1,
+             (key->last_value - index) * sizeof(*key->values) );
     key->last_value--;
     touch_key( key, REG_NOTIFY_CHANGE_LAST_SET );
 
@@ -1561,20 +1611,35 @@ static int load_key_option( struct key *key, const char *buffer, struct file_loa
     return 1;
 }
 
+/* convert a hex digit to its value, or return -1 if not a hex digit */
+static inline int hex_digit_value( char ch )
+{
+    if (ch >= '0' && ch <= '9') return ch - '0';
+    if (ch >= 'a' && ch <= 'f') return ch - 'a' + 10;
+    if (ch >= 'A' && ch <= 'F') return ch - 'A' + 10;
+    return -1;
+}
+
 /* parse a comma-separated list of hex digits */
 static int parse_hex( unsigned char *dest, data_size_t *len, const char *buffer )
 {
     const char *p = buffer;
     data_size_t count = 0;
-    char *end;
+    int digit;
 
-    while (isxdigit(*p))
+    while ((digit = hex_digit_value( *p )) != -1)
     {
-        unsigned int val = strtoul( p, &end, 16 );
-        if (end == p || val > 0xff) return -1;
+        unsigned int val = 0;
+
+        /* this is called for every byte of binary data, so avoid going through strtoul */
+        do
+        {
+            val = (val << 4) | digit;
+            if (val > 0xff) return -1;
+        } while ((digit = hex_digit_value( *++p )) != -1);
+
         if (count++ >= *len) return -1;  /* dest buffer overflow */
         *dest++ = val;
-        p = end;
         while (isspace(*p)) p++;
         if (*p == ',') p++;
         while (isspace(*p)) p++;
@@ -1724,8 +1789,8 @@ static void load_keys( struct key *key, const char *filename, FILE *f, int prefi
 
     info.filename = filename;
     info.file   = f;
-    info.len    = 4;
-    info.tmplen = 4;
+    info.len    = 256;
+    info.tmplen = 256;
     info.line   = 0;
     if (!(info.buffer = mem_alloc( info.len ))) return;
     if (!(info.tmp = mem_alloc( info.tmplen )))
@@ -2107,6 +2172,9 @@ static int save_branch( struct key *key, const char *filename )
         dump_operation( key, NULL, "saving" );
     }
 
+    /* hives can be large, use a bigger buffer than the stdio default */
+    setvbuf( f, NULL, _IOFBF, 65536 );
+
     save_all_subkeys( key, f );
     ret = !fclose(f);
 
@@ -125,6 +125,8 @@ char *server_dir = NULL;   /* server directory */
 int server_dir_fd = -1;    /* file descriptor for the server dir */
 int config_dir_fd = -1;    /* file descriptor for the config dir */
 
+struct request_stats request_stats[REQ_NB_REQUESTS];  /* per-request statistics */
+
 static struct master_socket *master_socket;  /* the master socket object */
 static struct timeout_user *master_timeout;
 
@@ -302,7 +304,25 @@ static void call_req_handler( struct thread *thread )
     if (debug_level) trace_request();
 
     if (req < REQ_NB_REQUESTS)
+    {
+        struct request_stats *stats = &request_stats[req];
+        timeout_t start = monotonic_counter(), elapsed;
+        unsigned int bucket = 0;
+
         req_handlers[req]( &current->req, &reply );
+
+        elapsed = monotonic_counter() - start;
+        stats->count++;
+        stats->total_time += elapsed;
+        thread->process->req_count++;
+        thread->process->req_time += elapsed;
+        while (elapsed > 1 && bucket < ARRAY_SIZE(stats->hist) - 1)
+        {
+            elapsed >>= 1;
+            bucket++;
+        }
+        stats->hist[bucket]++;
+    }
     else
         set_error( STATUS_NOT_IMPLEMENTED );
 
@@ -324,6 +344,9 @@ static void call_req_handler( struct thread *thread )
     current = NULL;
 }
 
+/* size of the request data buffer kept around between requests */
+#define REQ_BUFFER_SIZE 1024
+
 /* read a request from a thread */
 void read_request( struct thread *thread )
 {
@@ -331,20 +354,53 @@ void read_request( struct thread *thread )
 
     if (!thread->req_toread)  /* no pending request */
     {
-        if ((ret = read( get_unix_fd( thread->request_fd ), &thread->req,
-                         sizeof(thread->req) )) != sizeof(thread->req)) goto error;
-        if (!(thread->req_toread = thread->req.request_header.request_size))
+        struct iovec vec[2];
+        unsigned int size;
+
+        if (!thread->req_data)
         {
-            /* no data, handle request at once */
-            call_req_handler( thread );
-            return;
+            if (!(thread->req_data = malloc( REQ_BUFFER_SIZE )))
+            {
+                fatal_protocol_error( thread, "no memory for request buffer\n" );
+                return;
+            }
+            thread->req_bufsize = REQ_BUFFER_SIZE;
         }
-        if (!(thread->req_data = malloc( thread->req_toread )))
+
+        /* the client writes the header and data in one go, so try to read them in a single call */
+        vec[0].iov_base = &thread->req;
+        vec[0].iov_len  = sizeof(thread->req);
+        vec[1].iov_base = thread->req_data;
+        vec[1].iov_len  = thread->req_bufsize;
+        if ((ret = readv( get_unix_fd( thread->request_fd ), vec, 2 )) < (int)sizeof(thread->req))
+            goto error;
+
+        ret -= sizeof(thread->req);
+        size = thread->req.request_header.request_size;
+        if ((unsigned int)ret > size)
         {
-            fatal_protocol_error( thread, "no memory for %u bytes request %d\n",
-                                  thread->req_toread, thread->req.request_header.req );
+            fatal_protocol_error( thread, "extra data after request %d\n",
+                                  thread->req.request_header.req );
             return;
         }
+        if (!(thread->req_toread = size - ret))
+        {
+            call_req_handler( thread );
+            goto done;
+        }
+        if (size > thread->req_bufsize)
+        {
+            void *data = realloc( thread->req_data, size );
+
+            if (!data)
+            {
+                fatal_protocol_error( thread, "no memory for %u bytes request %d\n",
+                                      size, thread->req.request_header.req );
+                return;
+            }
+            thread->req_data = data;
+            thread->req_bufsize = size;
+        }
     }
 
     /* read the variable sized data */
@@ -358,9 +414,7 @@ void read_request( struct thread *thread )
         if (!(thread->req_toread -= ret))
         {
             call_req_handler( thread );
-            free( thread->req_data );
-            thread->req_data = NULL;
-            return;
+            goto done;
         }
     }
 
@@ -371,6 +425,16 @@ error:
         fatal_protocol_error( thread, "partial read %d\n", ret );
     else if (errno != EWOULDBLOCK && (EWOULDBLOCK == EAGAIN || errno != EAGAIN))
         fatal_protocol_error( thread, "read: %s\n", strerror( errno ));
+    return;
+
+done:
+    /* don't keep large buffers around */
+    if (thread->req_bufsize > REQ_BUFFER_SIZE)
+    {
+        free( thread->req_data );
+        thread->req_data = NULL;
+        thread->req_bufsize = 0;
+    }
 }
 
 /* receive a file descriptor on the process socket */
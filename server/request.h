@@ -65,6 +65,17 @@ extern int server_dir_fd, config_dir_fd;
 
 extern void trace_request(void);
 extern void trace_reply( enum request req, const union generic_reply *reply );
+extern void dump_request_stats(void);
+
+/* statistics about the handling of a request type */
+struct request_stats
+{
+    unsigned int count;       /* number of requests handled */
+    timeout_t    total_time;  /* total time spent in the handler */
+    unsigned int hist[24];    /* histogram of handler times, by log2 of the time in ticks */
+};
+
+extern struct request_stats request_stats[REQ_NB_REQUESTS];
 
 /* get current tick count to return to client */
 static inline unsigned int get_tick_count(void)
@@ -1448,7 +1448,13 @@ static void sock_poll_event( struct fd *fd, int event )
         if (sock->reset)
             event &= ~(POLLIN | POLLERR | POLLHUP);
 
+#ifdef POLLRDHUP
+        /* we ask for POLLRDHUP along with POLLIN on stream sockets, so plain
+         * POLLIN means there is data and there's nothing to check */
+        if (sock->type == WS_SOCK_STREAM && (event & POLLIN) && (event & (POLLRDHUP | POLLERR | POLLHUP)))
+#else
         if (sock->type == WS_SOCK_STREAM && (event & POLLIN))
+#endif
         {
             char dummy;
             int nr;
@@ -1533,6 +1539,11 @@ static int poll_flags_from_afd( struct sock *sock, int flags )
         ev |= is_oobinline( sock ) ? POLLIN : POLLPRI;
     if (flags & AFD_POLL_WRITE)
         ev |= POLLOUT;
+#ifdef POLLRDHUP
+    /* see sock_poll_event() */
+    if ((ev & POLLIN) && sock->type == WS_SOCK_STREAM)
+        ev |= POLLRDHUP;
+#endif
 
     return ev;
 }
@@ -1649,6 +1660,13 @@ static int sock_get_poll_events( struct fd *fd )
         break;
     }
 
+#ifdef POLLRDHUP
+    /* POLLIN may have been cleared above, and POLLRDHUP on its own would keep
+     * firing after a hangup. */
+    ev &= ~POLLRDHUP;
+    if (sock->type == WS_SOCK_STREAM && (ev & POLLIN))
+        ev |= POLLRDHUP;
+#endif
     return ev;
 }
 
@@ -56,6 +56,7 @@
 #include "ws2tcpip.h"
 #include "tcpmib.h"
 #include "file.h"
+#include "process.h"
 #include "request.h"
 #include "security.h"
 #include "unicode.h"
@@ -1049,6 +1050,25 @@ static void dump_varargs_cursor_positions( const char *prefix, data_size_t size
     remove_data( size );
 }
 
+static void dump_varargs_completion_msgs( const char *prefix, data_size_t size )
+{
+    const struct completion_msg *msg = cur_data;
+    data_size_t len = size / sizeof(*msg);
+
+    fprintf( stderr, "%s{", prefix );
+    while (len > 0)
+    {
+        dump_uint64( "{ckey=", &msg->ckey );
+        dump_uint64( ",cvalue=", &msg->cvalue );
+        dump_uint64( ",information=", &msg->information );
+        fprintf( stderr, ",status=%s}", get_status_name( msg->status ) );
+        msg++;
+        if (--len) fputc( ',', stderr );
+    }
+    fputc( '}', stderr );
+    remove_data( size );
+}
+
 static void dump_varargs_message_data( const char *prefix, data_size_t size )
 {
     /* FIXME: dump the structured data */
@@ -1575,6 +1595,37 @@ void trace_request(void)
     else fprintf( stderr, "%04x: %d(?)\n", current->id, req );
 }
 
+static int dump_process_request_stats( struct process *process, void *arg )
+{
+    if (process->req_count)
+        fprintf( stderr, "%04x %10u %12lu\n", process->id, process->req_count,
+                 (unsigned long)(process->req_time / 10) );
+    return 0;
+}
+
+void dump_request_stats(void)
+{
+    unsigned int i, j, last;
+
+    fprintf( stderr, "%-32s %10s %12s %10s  %s\n", "request", "count", "total(us)", "avg(us)",
+             "histogram of handler times (log2 of 100ns units)" );
+    for (i = 0; i < REQ_NB_REQUESTS; i++)
+    {
+        const struct request_stats *stats = &request_stats[i];
+
+        if (!stats->count) continue;
+        fprintf( stderr, "%-32s %10u %12lu %10lu ", req_names[i], stats->count,
+                 (unsigned long)(stats->total_time / 10),
+                 (unsigned long)(stats->total_time / 10 / stats->count) );
+        for (last = ARRAY_SIZE(stats->hist); last > 0; last--) if (stats->hist[last - 1]) break;
+        for (j = 0; j < last; j++) fprintf( stderr, " %u", stats->hist[j] );
+        fputc( '\n', stderr );
+    }
+
+    fprintf( stderr, "\n%-4s %10s %12s\n", "pid", "count", "total(us)" );
+    enum_processes( dump_process_request_stats, NULL );
+}
+
 void trace_reply( enum request req, const union generic_reply *reply )
 {
     if (req < REQ_NB_REQUESTS)
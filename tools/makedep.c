@@ -120,6 +120,21 @@ static const struct
 static struct list files[HASH_SIZE];
 static struct list global_includes[HASH_SIZE];
 
+/* parsed file information saved across runs */
+struct cache_entry
+{
+    struct list        entry;
+    struct file       *file;          /* parsed file */
+    unsigned int       flags;         /* file flags as set by the parser */
+    long long          mtime;         /* modification time of the parsed file */
+    long long          size;          /* size of the parsed file */
+    bool               used;          /* entry is still valid for this run */
+};
+
+static struct list cache_entries[HASH_SIZE];
+static const char cache_file_name[] = ".makedep.cache";
+static const char cache_signature[] = "makedep cache 1";
+
 enum install_rules { INSTALL_LIB, INSTALL_DEV, INSTALL_UNIXLIB, INSTALL_TEST, NB_INSTALL_RULES };
 static const char *install_targets[NB_INSTALL_RULES] = { "install-lib", "install-dev", "install-unixlib", "install-test" };
 static const char *install_variables[NB_INSTALL_RULES] = { "INSTALL_LIB", "INSTALL_DEV", "INSTALL_UNIXLIB", "INSTALL_TEST" };
@@ -1263,12 +1278,95 @@ static const struct
     { ".sfd", parse_sfd_file }
 };
 
+/*******************************************************************
+ *         get_file_time
+ */
+static long long get_file_time( const struct stat *st )
+{
+#ifdef HAVE_STRUCT_STAT_ST_MTIM
+    return st->st_mtime * 1000000000ll + st->st_mtim.tv_nsec;
+#elif defined(HAVE_STRUCT_STAT_ST_MTIMESPEC)
+    return st->st_mtime * 1000000000ll + st->st_mtimespec.tv_nsec;
+#else
+    return st->st_mtime;
+#endif
+}
+
+
+/*******************************************************************
+ *         find_cache_entry
+ */
+static struct cache_entry *find_cache_entry( const char *name, unsigned int hash )
+{
+    struct cache_entry *cache;
+
+    LIST_FOR_EACH_ENTRY( cache, &cache_entries[hash], struct cache_entry, entry )
+        if (!strcmp( name, cache->file->name )) return cache;
+    return NULL;
+}
+
+
+/*******************************************************************
+ *         load_cache
+ *
+ * Load the files parsed by a previous run.
+ */
+static void load_cache(void)
+{
+    struct cache_entry *cache = NULL;
+    struct dependency *dep;
+    unsigned int hash, type;
+    char *buffer;
+    FILE *f;
+    int pos;
+
+    if (!(f = fopen( cache_file_name, "r" ))) return;
+
+    if ((buffer = get_line( f )) && !strcmp( buffer, cache_signature ))
+    {
+        while ((buffer = get_line( f )))
+        {
+            if (buffer[0] == 'F')
+            {
+                cache = xmalloc( sizeof(*cache) );
+                memset( cache, 0, sizeof(*cache) );
+                if (sscanf( buffer, "F %lld %lld %u %n", &cache->mtime, &cache->size,
+                            &cache->flags, &pos ) < 3 || !buffer[pos])
+                {
+                    free( cache );
+                    break;
+                }
+                cache->file = add_file( buffer + pos );
+                hash = hash_filename( cache->file->name );
+                list_add_tail( &cache_entries[hash], &cache->entry );
+            }
+            else if (buffer[0] == 'D' && cache)
+            {
+                dep = ARRAY_ADD( &cache->file->deps, struct dependency );
+                if (sscanf( buffer, "D %d %u %n", &dep->line, &type, &pos ) < 2 || !buffer[pos])
+                {
+                    cache->file->deps.count--;
+                    break;
+                }
+                dep->type = type;
+                dep->name = xstrdup( buffer + pos );
+            }
+            else break;
+        }
+    }
+    fclose( f );
+    input_line = 0;
+}
+
+
 /*******************************************************************
  *         load_file
  */
 static struct file *load_file( const char *name )
 {
+    struct cache_entry *cache;
     struct file *file;
+    struct stat st;
     FILE *f;
     unsigned int i, hash = hash_filename( name );
 
@@ -1277,6 +1375,18 @@ static struct file *load_file( const char *name )
 
     if (!(f = fopen( name, "r" ))) return NULL;
 
+    cache = find_cache_entry( name, hash );
+    if (fstat( fileno( f ), &st ) == -1) st.st_size = -1;
+    else if (cache && cache->mtime == get_file_time( &st ) && cache->size == st.st_size)
+    {
+        fclose( f );
+        file = cache->file;
+        file->flags = cache->flags;
+        list_add_tail( &files[hash], &file->entry );
+        cache->used = true;
+        return file;
+    }
+
     file = add_file( name );
     list_add_tail( &files[hash], &file->entry );
     input_file_name = file->name;
@@ -1292,6 +1402,22 @@ static struct file *load_file( const char *name )
     fclose( f );
     input_file_name = NULL;
 
+    /* custom arguments are not saved, so only cache files without them */
+    if (st.st_size != -1 && !file->args)
+    {
+        if (!cache)
+        {
+            cache = xmalloc( sizeof(*cache) );
+            list_add_tail( &cache_entries[hash], &cache->entry );
+        }
+        cache->file  = file;
+        cache->flags = file->flags;
+        cache->mtime = get_file_time( &st );
+        cache->size  = st.st_size;
+        cache->used  = true;
+    }
+    else if (cache) cache->used = false;
+
     return file;
 }
 
@@ -4355,6 +4481,33 @@ static bool are_files_identical( FILE *file1, FILE *file2 )
 }
 
 
+/*******************************************************************
+ *         save_cache
+ *
+ * Save the parsed files for the next run.
+ */
+static void save_cache(void)
+{
+    struct cache_entry *cache;
+    unsigned int i;
+    FILE *f = create_temp_file( cache_file_name );
+
+    fprintf( f, "%s\n", cache_signature );
+    for (i = 0; i < HASH_SIZE; i++)
+    {
+        LIST_FOR_EACH_ENTRY( cache, &cache_entries[i], struct cache_entry, entry )
+        {
+            if (!cache->used) continue;
+            fprintf( f, "F %lld %lld %u %s\n", cache->mtime, cache->size, cache->flags, cache->file->name );
+            ARRAY_FOR_EACH( dep, &cache->file->deps, const struct dependency )
+                fprintf( f, "D %d %u %s\n", dep->line, dep->type, dep->name );
+        }
+    }
+    if (fclose( f )) fatal_error( "failed to write %s\n", cache_file_name );
+    rename_temp_file( cache_file_name );
+}
+
+
 /*******************************************************************
  *         rename_temp_file_if_changed
  */
@@ -4598,6 +4751,7 @@ static void output_top_makefile( struct makefile *make )
     output( "config.status: %s\n", root_src_dir_path( "configure" ));
     output( "\t@./config.status --recheck\n" );
     strarray_add( &make->distclean_files, "config.status" );
+    strarray_add( &make->distclean_files, cache_file_name );
     output( "include/config.h: include/stamp-h\n" );
     output( "include/stamp-h: %s config.status\n", root_src_dir_path( "include/config.h.in" ));
     output( "\t@./config.status include/config.h include/stamp-h\n" );
@@ -4873,6 +5027,7 @@ int main( int argc, char *argv[] )
 
     for (i = 0; i < HASH_SIZE; i++) list_init( &files[i] );
     for (i = 0; i < HASH_SIZE; i++) list_init( &global_includes[i] );
+    for (i = 0; i < HASH_SIZE; i++) list_init( &cache_entries[i] );
 
     top_makefile = parse_makefile( NULL );
 
@@ -4979,10 +5134,12 @@ int main( int argc, char *argv[] )
 
     for (i = 0; i < subdirs.count; i++) submakes[i] = parse_makefile( subdirs.str[i] );
 
+    load_cache();
     load_sources( top_makefile );
     load_sources( include_makefile );
     for (i = 0; i < subdirs.count; i++)
         if (submakes[i] != include_makefile) load_sources( submakes[i] );
+    save_cache();
 
     output_dependencies( top_makefile );
     for (i = 0; i < subdirs.count; i++) output_dependencies( submakes[i] );